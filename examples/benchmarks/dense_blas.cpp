@@ -23,11 +23,81 @@
 #include "viennacl/vector_proxy.hpp"
 
 #include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_1.hpp"
+#include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/lu.hpp"
 
 #include <iomanip>
 #include <stdlib.h>
+#include <algorithm>
+
+#if !defined(VIENNACL_WITH_OPENCL) && !defined(VIENNACL_WITH_CUDA)
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+
+/** @brief Previous host GEMM kernel (64x64 blocks, scalar triple loop), kept here as the baseline for the packed micro-kernel GEMM. All matrices column-major. */
+template<class T>
+void reference_gemm(std::vector<T> const & A, std::vector<T> const & B, std::vector<T> & C, std::size_t M, std::size_t N, std::size_t K)
+{
+  static const std::size_t blocksize = 64;
+  std::vector<T> buffer_A(blocksize * blocksize);
+  std::vector<T> buffer_B(blocksize * blocksize);
+  std::vector<T> buffer_C(blocksize * blocksize);
+
+  for (std::size_t offset_i = 0; offset_i < M; offset_i += blocksize)
+    for (std::size_t offset_j = 0; offset_j < N; offset_j += blocksize)
+    {
+      std::fill(buffer_C.begin(), buffer_C.end(), T(0));
+      for (std::size_t offset_k = 0; offset_k < K; offset_k += blocksize)
+      {
+        std::fill(buffer_A.begin(), buffer_A.end(), T(0));
+        std::fill(buffer_B.begin(), buffer_B.end(), T(0));
+        for (std::size_t i = offset_i; i < std::min(offset_i + blocksize, M); ++i)
+          for (std::size_t k = offset_k; k < std::min(offset_k + blocksize, K); ++k)
+            buffer_A[(i - offset_i) * blocksize + (k - offset_k)] = A[i + k * M];
+        for (std::size_t j = offset_j; j < std::min(offset_j + blocksize, N); ++j)
+          for (std::size_t k = offset_k; k < std::min(offset_k + blocksize, K); ++k)
+            buffer_B[(k - offset_k) + (j - offset_j) * blocksize] = B[k + j * K];
+
+        for (std::size_t i = 0; i < blocksize; ++i)
+          for (std::size_t j = 0; j < blocksize; ++j)
+          {
+            T temp = 0;
+            for (std::size_t k = 0; k < blocksize; ++k)
+              temp += buffer_A[i*blocksize + k] * buffer_B[k + j*blocksize];
+            buffer_C[i*blocksize + j] += temp;
+          }
+      }
+      for (std::size_t i = offset_i; i < std::min(offset_i + blocksize, M); ++i)
+        for (std::size_t j = offset_j; j < std::min(offset_j + blocksize, N); ++j)
+          C[i + j * M] = buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
+    }
+}
+#endif
+
+#if !defined(VIENNACL_WITH_OPENCL) && !defined(VIENNACL_WITH_CUDA)
+/** @brief STREAM kernel 'scale': a = alpha * b */
+template<class T>
+void stream_scale(std::vector<T> & a, std::vector<T> const & b, T alpha)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(a.size()); ++i)
+    a[static_cast<std::size_t>(i)] = alpha * b[static_cast<std::size_t>(i)];
+}
+
+/** @brief STREAM kernel 'triad': a = b + alpha * c */
+template<class T>
+void stream_triad(std::vector<T> & a, std::vector<T> const & b, std::vector<T> const & c, T alpha)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(a.size()); ++i)
+    a[static_cast<std::size_t>(i)] = b[static_cast<std::size_t>(i)] + alpha * c[static_cast<std::size_t>(i)];
+}
+#endif
 
 template<class T, class F>
 void init_random(viennacl::matrix<T, F> & M)
@@ -52,6 +122,8 @@ template<class T>
 void bench(size_t BLAS1_N, size_t BLAS2_M, size_t BLAS2_N, size_t BLAS3_M, size_t BLAS3_N, size_t BLAS3_K, std::string const & prefix)
 {
   using viennacl::linalg::inner_prod;
+  using viennacl::linalg::norm_1;
+  using viennacl::linalg::norm_2;
   using viennacl::linalg::prod;
   using viennacl::linalg::lu_factorize;
   using viennacl::trans;
@@ -93,6 +165,21 @@ void bench(size_t BLAS1_N, size_t BLAS2_M, size_t BLAS2_N, size_t BLAS3_M, size_
     BENCHMARK_OP(x = y,                "COPY", std::setprecision(3) << double(2*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
     BENCHMARK_OP(x = y + alpha*x,      "AXPY", std::setprecision(3) << double(3*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
     BENCHMARK_OP(s = inner_prod(x, y), "DOT",  std::setprecision(3) << double(2*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    BENCHMARK_OP(x = alpha * y,        "SCAL", std::setprecision(3) << double(2*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    BENCHMARK_OP(s = norm_1(x),        "ASUM", std::setprecision(3) << double(BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    BENCHMARK_OP(s = norm_2(x),        "NRM2", std::setprecision(3) << double(BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+
+#if !defined(VIENNACL_WITH_OPENCL) && !defined(VIENNACL_WITH_CUDA)
+    // compare against the plain loops and the STREAM kernels (scale, triad), which give the attainable memory bandwidth:
+    viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::SIMD_ISA_SCALAR);
+    BENCHMARK_OP(x = y + alpha*x,      "AXPY-SCALAR", std::setprecision(3) << double(3*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    BENCHMARK_OP(s = inner_prod(x, y), "DOT-SCALAR",  std::setprecision(3) << double(2*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::SIMD_ISA_AVX512);
+
+    std::vector<T> stream_a(BLAS1_N), stream_b(BLAS1_N, T(1)), stream_c(BLAS1_N, T(2));
+    BENCHMARK_OP(stream_scale(stream_a, stream_b, alpha),           "STREAM-SCALE", std::setprecision(3) << double(2*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+    BENCHMARK_OP(stream_triad(stream_a, stream_b, stream_c, alpha), "STREAM-TRIAD", std::setprecision(3) << double(3*BLAS1_N*sizeof(T))/time_spent * 1e-9, "GB/s")
+#endif
   }
 
 
@@ -124,6 +211,38 @@ void bench(size_t BLAS1_N, size_t BLAS2_M, size_t BLAS2_N, size_t BLAS3_M, size_
     BENCHMARK_OP(C = prod(trans(AT), B),         "GEMM-TN",      double(2*BLAS3_M*BLAS3_N*BLAS3_K)/time_spent*1e-9, "GFLOPs/s");
     BENCHMARK_OP(C = prod(trans(AT), trans(BT)), "GEMM-TT",      double(2*BLAS3_M*BLAS3_N*BLAS3_K)/time_spent*1e-9, "GFLOPs/s");
     //BENCHMARK_OP(lu_factorize(A),                "LU-FACTORIZE", double(2*BLAS3_M*BLAS3_K*BLAS3_K)/time_spent*1e-9, "GFLOPs/s");
+
+#if !defined(VIENNACL_WITH_OPENCL) && !defined(VIENNACL_WITH_CUDA)
+    // compare against the portable micro-kernel and the previous blocked kernel:
+    viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::SIMD_ISA_SCALAR);
+    BENCHMARK_OP(C = prod(A, B),                 "GEMM-NN-SCALAR", double(2*BLAS3_M*BLAS3_N*BLAS3_K)/time_spent*1e-9, "GFLOPs/s");
+    viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::SIMD_ISA_AVX512);
+
+    std::vector<T> ref_A(BLAS3_M * BLAS3_K), ref_B(BLAS3_K * BLAS3_N), ref_C(BLAS3_M * BLAS3_N);
+    for (std::size_t i = 0; i < ref_A.size(); ++i) ref_A[i] = T(rand())/T(RAND_MAX);
+    for (std::size_t i = 0; i < ref_B.size(); ++i) ref_B[i] = T(rand())/T(RAND_MAX);
+    BENCHMARK_OP(reference_gemm(ref_A, ref_B, ref_C, BLAS3_M, BLAS3_N, BLAS3_K), "GEMM-NN-REFERENCE", double(2*BLAS3_M*BLAS3_N*BLAS3_K)/time_spent*1e-9, "GFLOPs/s");
+#endif
+  }
+
+  //BLAS3, non-square shapes
+  {
+    std::size_t small_size = 128;
+    std::size_t large_size = 100000;
+
+    viennacl::matrix<T,viennacl::column_major> A_short(small_size, small_size);
+    viennacl::matrix<T,viennacl::column_major> B_wide(small_size, large_size);
+    viennacl::matrix<T,viennacl::column_major> C_wide(small_size, large_size);
+    viennacl::matrix<T,viennacl::column_major> A_wide(small_size, large_size);
+    viennacl::matrix<T,viennacl::column_major> B_tall(large_size, small_size);
+    viennacl::matrix<T,viennacl::column_major> C_small(small_size, small_size);
+    init_random(A_short);
+    init_random(B_wide);
+    init_random(A_wide);
+    init_random(B_tall);
+
+    BENCHMARK_OP(C_wide  = prod(A_short, B_wide), "GEMM-SHORT-WIDE", double(2*small_size*large_size*small_size)/time_spent*1e-9, "GFLOPs/s");
+    BENCHMARK_OP(C_small = prod(A_wide, B_tall),  "GEMM-LARGE-K",    double(2*small_size*small_size*large_size)/time_spent*1e-9, "GFLOPs/s");
   }
 
 
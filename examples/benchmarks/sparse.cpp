@@ -38,11 +38,15 @@
 
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
 #include "viennacl/sliced_ell_matrix.hpp"
+#include "viennacl/bsr_matrix.hpp"
+#include "viennacl/compact_compressed_matrix.hpp"
+#include "viennacl/symmetric_compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/io/matrix_market.hpp"
@@ -94,6 +98,8 @@ int run_benchmark()
   viennacl::ell_matrix<ScalarType, 1> vcl_ell_matrix_1;
   viennacl::hyb_matrix<ScalarType, 1> vcl_hyb_matrix_1;
   viennacl::sliced_ell_matrix<ScalarType> vcl_sliced_ell_matrix_1;
+  viennacl::bsr_matrix<ScalarType, 3> vcl_bsr_matrix_3;
+  viennacl::compact_compressed_matrix<ScalarType, float> vcl_compact_compressed_matrix;
 
   viennacl::vector<ScalarType> vcl_vec1(ublas_vec1.size());
   viennacl::vector<ScalarType> vcl_vec2(ublas_vec1.size());
@@ -108,6 +114,8 @@ int run_benchmark()
   viennacl::copy(ublas_matrix, vcl_ell_matrix_1);
   viennacl::copy(ublas_matrix, vcl_hyb_matrix_1);
   viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix_1);
+  viennacl::copy(ublas_matrix, vcl_bsr_matrix_3);
+  viennacl::copy(ublas_matrix, vcl_compact_compressed_matrix);
   viennacl::copy(ublas_vec1, vcl_vec1);
   viennacl::copy(ublas_vec2, vcl_vec2);
 
@@ -309,6 +317,151 @@ int run_benchmark()
   std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
   std::cout << vcl_vec1[0] << std::endl;
 
+
+  std::cout << "------- Matrix-Vector product with bsr_matrix (3x3 blocks) ----------" << std::endl;
+  std::cout << "Blocks: " << vcl_bsr_matrix_3.nonzero_blocks() << ", fill-in: " << static_cast<double>(vcl_bsr_matrix_3.nnz()) / static_cast<double>(ublas_matrix.nnz()) << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(vcl_bsr_matrix_3, vcl_vec2); //startup calculation
+  viennacl::backend::finish();
+
+  viennacl::copy(vcl_vec1, ublas_vec2);
+  err_cnt = 0;
+  for (std::size_t i=0; i<ublas_vec1.size(); ++i)
+  {
+    if ( fabs(ublas_vec1[i] - ublas_vec2[i]) / std::max(fabs(ublas_vec1[i]), fabs(ublas_vec2[i])) > 1e-2)
+    {
+      std::cout << "Error at index " << i << ": Should: " << ublas_vec1[i] << ", Is: " << ublas_vec2[i] << std::endl;
+      ++err_cnt;
+      if (err_cnt > 5)
+        break;
+    }
+  }
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    vcl_vec1 = viennacl::linalg::prod(vcl_bsr_matrix_3, vcl_vec2);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU time: " << exec_time << std::endl;
+  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << vcl_vec1[0] << std::endl;
+
+
+  std::cout << "------- Matrix-Vector product with compact_compressed_matrix (float values, 16-bit column offsets) ----------" << std::endl;
+  std::cout << "Stored entries: " << vcl_compact_compressed_matrix.nnz() << ", bytes per entry: " << sizeof(float) + sizeof(unsigned short) << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(vcl_compact_compressed_matrix, vcl_vec2); //startup calculation
+  viennacl::backend::finish();
+
+  viennacl::copy(vcl_vec1, ublas_vec2);
+  err_cnt = 0;
+  for (std::size_t i=0; i<ublas_vec1.size(); ++i)
+  {
+    if ( fabs(ublas_vec1[i] - ublas_vec2[i]) / std::max(fabs(ublas_vec1[i]), fabs(ublas_vec2[i])) > 1e-2)
+    {
+      std::cout << "Error at index " << i << ": Should: " << ublas_vec1[i] << ", Is: " << ublas_vec2[i] << std::endl;
+      ++err_cnt;
+      if (err_cnt > 5)
+        break;
+    }
+  }
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    vcl_vec1 = viennacl::linalg::prod(vcl_compact_compressed_matrix, vcl_vec2);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU time: " << exec_time << std::endl;
+  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << vcl_vec1[0] << std::endl;
+
+
+  std::cout << "------- Matrix-Vector product with transposed compressed_matrix ----------" << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(trans(vcl_compressed_matrix_1), vcl_vec2); //startup calculation
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    vcl_vec1 = viennacl::linalg::prod(trans(vcl_compressed_matrix_1), vcl_vec2);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU time: " << exec_time << std::endl;
+  std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << vcl_vec1[0] << std::endl;
+
+
+  std::cout << "------- Matrix-Vector product with symmetric_compressed_matrix (upper triangle of the matrix) ----------" << std::endl;
+  viennacl::symmetric_compressed_matrix<ScalarType> vcl_symmetric_compressed_matrix;
+  viennacl::copy(ublas_matrix, vcl_symmetric_compressed_matrix);
+  std::cout << "Stored entries: " << vcl_symmetric_compressed_matrix.nnz() << " of " << ublas_matrix.nnz() << std::endl;
+  vcl_vec1 = viennacl::linalg::prod(vcl_symmetric_compressed_matrix, vcl_vec2); //startup calculation
+
+  viennacl::backend::finish();
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    vcl_vec1 = viennacl::linalg::prod(vcl_symmetric_compressed_matrix, vcl_vec2);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU time: " << exec_time << std::endl;
+  std::cout << "GPU "; printOps(2.0 * static_cast<double>(2 * vcl_symmetric_compressed_matrix.nnz()), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << vcl_vec1[0] << std::endl;
+
+
+  std::cout << "------- Sparse matrix-matrix product with compressed_matrix ----------" << std::endl;
+  viennacl::compressed_matrix<ScalarType> vcl_compressed_matrix_C = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_compressed_matrix_1); //startup calculation
+  viennacl::backend::finish();
+
+  // two flops for each pair of nonzeros A(i,k), A(k,j):
+  double spgemm_flops = 0;
+  for (std::size_t i=0; i<ublas_matrix.nnz(); ++i)
+  {
+    std::size_t k = ublas_matrix.index2_data()[i];
+    spgemm_flops += 2.0 * static_cast<double>(ublas_matrix.index1_data()[k+1] - ublas_matrix.index1_data()[k]);
+  }
+
+  timer.start();
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    vcl_compressed_matrix_C = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_compressed_matrix_1);
+  }
+  viennacl::backend::finish();
+  exec_time = timer.get();
+  std::cout << "GPU time: " << exec_time << std::endl;
+  std::cout << "GPU "; printOps(spgemm_flops, static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  std::cout << "Nonzeros in result: " << vcl_compressed_matrix_C.nnz() << std::endl;
+
+
+  std::cout << "------- Sparse matrix times block of vectors with compressed_matrix ----------" << std::endl;
+  std::size_t block_widths[] = {1, 4, 8, 16, 32};
+  for (std::size_t w = 0; w < sizeof(block_widths) / sizeof(block_widths[0]); ++w)
+  {
+    std::size_t width = block_widths[w];
+    viennacl::matrix<ScalarType> vcl_block_rhs(ublas_matrix.size2(), width);
+    viennacl::matrix<ScalarType> vcl_block_result(ublas_matrix.size1(), width);
+    vcl_block_rhs = viennacl::scalar_matrix<ScalarType>(ublas_matrix.size2(), width, ScalarType(1.0));
+
+    vcl_block_result = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_block_rhs); //startup calculation
+    viennacl::backend::finish();
+
+    timer.start();
+    for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+    {
+      vcl_block_result = viennacl::linalg::prod(vcl_compressed_matrix_1, vcl_block_rhs);
+    }
+    viennacl::backend::finish();
+    exec_time = timer.get();
+    std::cout << "Columns: " << width << ", GPU time: " << exec_time << std::endl;
+    std::cout << "GPU "; printOps(2.0 * static_cast<double>(ublas_matrix.nnz()) * static_cast<double>(width), static_cast<double>(exec_time) / static_cast<double>(BENCHMARK_RUNS));
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -121,6 +121,41 @@ void run_amg(viennacl::linalg::cg_tag & cg_solver,
 
 }
 
+/** <h3>Run AMG preconditioner with host-based aggregation setup</h3>
+*
+*  The coarsenings VIENNACL_AMG_COARSE_AG_GREEDY and VIENNACL_AMG_COARSE_AG_MIS2 are only available for viennacl::compressed_matrix.
+*  The setup phase runs on the CSR arrays in host memory, the resulting hierarchy is then used in the memory domain of the system matrix.
+**/
+template<typename ScalarType>
+void run_amg_aggregation(viennacl::linalg::cg_tag & cg_solver,
+                         viennacl::vector<ScalarType> & vcl_vec,
+                         viennacl::vector<ScalarType> & vcl_result,
+                         viennacl::compressed_matrix<ScalarType> & vcl_compressed_matrix,
+                         std::string info,
+                         viennacl::linalg::amg_tag & amg_tag)
+{
+  boost::numeric::ublas::vector<ScalarType> avgstencil;
+
+  std::cout << "-- CG with AMG preconditioner, " << info << " --" << std::endl;
+
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<ScalarType> > vcl_amg(vcl_compressed_matrix, amg_tag);
+  std::cout << " * Setup phase (ViennaCL types)..." << std::endl;
+  vcl_amg.setup();
+
+  std::cout << " * Coarse levels: " << vcl_amg.tag().get_coarselevels() << std::endl;
+  std::cout << " * Operator complexity: " << vcl_amg.calc_complexity(avgstencil) << std::endl;
+
+  std::cout << " * CG solver (ViennaCL types)..." << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec, vcl_result, cg_solver, vcl_amg);
+
+  // If only the entries of the system matrix change, the aggregates and sparsity patterns are kept and only the values of the operators are recomputed:
+  std::cout << " * Numeric re-setup (ViennaCL types)..." << std::endl;
+  vcl_amg.resetup(vcl_compressed_matrix);
+
+  std::cout << " * CG solver (ViennaCL types)..." << std::endl;
+  run_solver(vcl_compressed_matrix, vcl_vec, vcl_result, cg_solver, vcl_amg);
+}
+
 /**
 *  <h2>Part 2: Run Solvers with AMG Preconditioners</h2>
 *
@@ -259,6 +294,25 @@ int main()
   amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
   run_amg (cg_solver, ublas_vec, ublas_result, ublas_matrix, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING, SA INTERPOLATION",amg_tag);
 
+  /**
+  * Generate the setup for smoothed aggregation with greedy aggregation computed directly on the compressed_matrix
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG_GREEDY, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
+  run_amg_aggregation(cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "GREEDY AGGREGATION, SA INTERPOLATION", amg_tag);
+
+  /**
+  * Generate the setup for smoothed aggregation with aggregates based on a distance-two maximal independent set (parallel with OpenMP)
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
+  run_amg_aggregation(cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "MIS-2 AGGREGATION, SA INTERPOLATION", amg_tag);
+
+  /**
+  * Same setup, but with Chebyshev smoothing of degree 3 instead of three Jacobi steps (other options: VIENNACL_AMG_SMOOTHER_L1_JACOBI, VIENNACL_AMG_SMOOTHER_HYBRID_GS)
+  **/
+  amg_tag = viennacl::linalg::amg_tag(VIENNACL_AMG_COARSE_AG_MIS2, VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
+  amg_tag.set_smoother(VIENNACL_AMG_SMOOTHER_CHEBYSHEV);
+  run_amg_aggregation(cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "MIS-2 AGGREGATION, SA INTERPOLATION, CHEBYSHEV SMOOTHER", amg_tag);
+
 
   /**
   *  That's it.
@@ -169,6 +169,15 @@ int main()
   viennacl::linalg::block_ilu_precond< viennacl::compressed_matrix<ScalarType>,
                                        viennacl::linalg::ilu0_tag>          vcl_block_ilu0(vcl_compressed_matrix, viennacl::linalg::ilu0_tag());
 
+  /**
+  * On many-core machines and GPUs, ILU0 can be set up by a few parallel fixed-point sweeps instead of the sequential factorization.
+  * The triangular solves in each application can likewise be replaced by a few Jacobi iterations:
+  **/
+  viennacl::linalg::ilu0_tag parallel_ilu0_tag;
+  parallel_ilu0_tag.sweeps(3);
+  parallel_ilu0_tag.jacobi_iters(2);
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<ScalarType> > vcl_parallel_ilu0(vcl_compressed_matrix, parallel_ilu0_tag);
+
   /**
   * set up Jacobi preconditioners for ViennaCL and ublas objects:
   **/
@@ -218,6 +227,7 @@ int main()
   vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::bicgstab_tag());   //without preconditioner
   vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::bicgstab_tag(1e-6, 20), vcl_ilut); //with preconditioner
   vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::bicgstab_tag(1e-6, 20), vcl_jacobi); //with preconditioner
+  vcl_result = viennacl::linalg::solve(vcl_compressed_matrix, vcl_rhs, viennacl::linalg::bicgstab_tag(1e-6, 20), vcl_parallel_ilu0); //with preconditioner
 
   /**
   * <h2>GMRES Solver</h2>
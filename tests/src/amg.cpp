@@ -0,0 +1,254 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/amg.cpp  Tests the aggregation-based AMG preconditioner for compressed_matrix.
+*   \test Tests the aggregation-based AMG preconditioner for compressed_matrix.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/amg.hpp"
+
+
+/** @brief Fills 'A' with the five-point finite difference discretization of -div(k grad u) on a points_per_dim x points_per_dim grid with Dirichlet boundary conditions.
+*
+* The coefficient k is 1 in the left half and 'coefficient_right' in the right half of the domain. Changing it only changes the values, not the sparsity pattern.
+*/
+template<typename NumericT>
+void fill_laplace_2d(std::vector<std::map<unsigned int, NumericT> > & A, unsigned int points_per_dim, NumericT coefficient_right = NumericT(1))
+{
+  A.clear();
+  A.resize(points_per_dim * points_per_dim);
+  for (unsigned int i = 0; i < points_per_dim; ++i)
+    for (unsigned int j = 0; j < points_per_dim; ++j)
+    {
+      unsigned int row = i * points_per_dim + j;
+      NumericT k = (2 * j < points_per_dim) ? NumericT(1) : coefficient_right;
+      NumericT k_left  = (j > 0 && 2 * (j - 1) >= points_per_dim) ? coefficient_right : NumericT(1);
+      NumericT k_right = (2 * (j + 1) < points_per_dim) ? NumericT(1) : coefficient_right;
+
+      // edge weights are the averages of the coefficients at both ends:
+      NumericT w_vertical = k;
+      NumericT w_left     = (k + k_left) / NumericT(2);
+      NumericT w_right    = (k + k_right) / NumericT(2);
+
+      A[row][row] = 2 * w_vertical + w_left + w_right;
+      if (i > 0)
+        A[row][row - points_per_dim] = -w_vertical;
+      if (i + 1 < points_per_dim)
+        A[row][row + points_per_dim] = -w_vertical;
+      if (j > 0)
+        A[row][row - 1] = -w_left;
+      if (j + 1 < points_per_dim)
+        A[row][row + 1] = -w_right;
+    }
+}
+
+
+/** @brief Solves with CG and the given preconditioner, checks the residual, and returns the number of iterations (0 on failure) */
+template<typename NumericT, typename PrecondT>
+unsigned int run_cg(viennacl::compressed_matrix<NumericT> const & A,
+                    viennacl::vector<NumericT> const & rhs,
+                    PrecondT const & precond,
+                    NumericT tolerance)
+{
+  viennacl::linalg::cg_tag solver(tolerance, 1000);
+  viennacl::vector<NumericT> result = viennacl::linalg::solve(A, rhs, solver, precond);
+
+  viennacl::vector<NumericT> residual = rhs;
+  residual -= viennacl::linalg::prod(A, result);
+  NumericT relative_residual = viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs);
+  std::cout << "  iterations: " << solver.iters() << ", relative residual: " << relative_residual << std::endl;
+
+  if (relative_residual > 100 * tolerance)
+    return 0;
+  return static_cast<unsigned int>(solver.iters());
+}
+
+
+/** @brief Sets up AMG with the given tag, checks CG with it against plain CG, then changes the values of the matrix and checks CG after a numeric re-setup */
+template<typename NumericT>
+int test_amg(viennacl::compressed_matrix<NumericT> const & A,
+             viennacl::compressed_matrix<NumericT> const & A2,
+             viennacl::vector<NumericT> const & rhs,
+             viennacl::linalg::amg_tag const & amg_tag,
+             unsigned int plain_iterations,
+             NumericT tolerance)
+{
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > amg(A, amg_tag);
+  amg.setup();
+
+  if (amg.tag().get_coarselevels() == 0)
+  {
+    std::cout << "# Error: No coarse levels generated" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int amg_iterations = run_cg(A, rhs, amg, tolerance);
+  if (amg_iterations == 0 || 4 * amg_iterations > plain_iterations)
+  {
+    std::cout << "# Error: CG with AMG preconditioner needs " << amg_iterations << " iterations, without preconditioner: " << plain_iterations << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // new values with the same sparsity pattern: only the numeric values of the hierarchy are recomputed
+  std::cout << "  after numeric re-setup:" << std::endl;
+  amg.resetup(A2);
+  amg_iterations = run_cg(A2, rhs, amg, tolerance);
+
+  viennacl::linalg::amg_precond<viennacl::compressed_matrix<NumericT> > amg_fresh(A2, amg_tag);
+  amg_fresh.setup();
+  std::cout << "  after fresh setup for comparison:" << std::endl;
+  unsigned int fresh_iterations = run_cg(A2, rhs, amg_fresh, tolerance);
+
+  if (amg_iterations == 0 || fresh_iterations == 0 || amg_iterations > 2 * fresh_iterations)
+  {
+    std::cout << "# Error: CG with AMG preconditioner after re-setup needs " << amg_iterations << " iterations, after fresh setup: " << fresh_iterations << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT>
+int test(NumericT tolerance)
+{
+  unsigned int points_per_dim = 80;
+
+  std::vector<std::map<unsigned int, NumericT> > std_A;
+  fill_laplace_2d(std_A, points_per_dim);
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::copy(std_A, A);
+
+  // same sparsity pattern, coefficient jump of 100 across the domain:
+  fill_laplace_2d(std_A, points_per_dim, NumericT(100));
+  viennacl::compressed_matrix<NumericT> A2;
+  viennacl::copy(std_A, A2);
+
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  std::cout << "* CG without preconditioner" << std::endl;
+  unsigned int plain_iterations = run_cg(A, rhs, viennacl::linalg::no_precond(), tolerance);
+  if (plain_iterations == 0)
+  {
+    std::cout << "# Error: CG without preconditioner did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int coarsenings[] = { VIENNACL_AMG_COARSE_AG_GREEDY, VIENNACL_AMG_COARSE_AG_MIS2 };
+  char const * coarsening_names[] = { "greedy aggregation", "MIS-2 aggregation" };
+
+  int smoothers[] = { VIENNACL_AMG_SMOOTHER_JACOBI, VIENNACL_AMG_SMOOTHER_L1_JACOBI, VIENNACL_AMG_SMOOTHER_HYBRID_GS, VIENNACL_AMG_SMOOTHER_CHEBYSHEV };
+  char const * smoother_names[] = { "Jacobi", "l1-Jacobi", "hybrid Gauss-Seidel", "Chebyshev" };
+
+  for (std::size_t i = 0; i < 2; ++i)
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      std::cout << "* CG with AMG preconditioner, " << coarsening_names[i] << ", " << smoother_names[j] << " smoother" << std::endl;
+      viennacl::linalg::amg_tag amg_tag(coarsenings[i], VIENNACL_AMG_INTERPOL_SA, 0.08, 0.67, 0.67, 3, 3, 0);
+      amg_tag.set_smoother(smoothers[j]);
+      if (test_amg(A, A2, rhs, amg_tag, plain_iterations, tolerance) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Aggregation-based AMG" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  {
+    typedef float NumericT;
+    NumericT tolerance = static_cast<NumericT>(1E-5);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT tolerance = 1E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  tolerance: " << tolerance << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(tolerance);
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+#ifdef VIENNACL_WITH_OPENCL
+  else
+    std::cout << "No double precision support, skipping test..." << std::endl;
+#endif
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
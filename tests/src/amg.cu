@@ -0,0 +1 @@
+amg.cpp
\ No newline at end of file
@@ -33,6 +33,10 @@
 
 #include "Random.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 template<typename ScalarType, typename VCLMatrixType>
 ScalarType diff(boost::numeric::ublas::matrix<ScalarType> const & mat1, VCLMatrixType  const & mat2)
 {
@@ -195,6 +199,64 @@ void init_rand(MatrixType & A)
       A(i, j) = static_cast<T>(0.1) * random<T>();
 }
 
+// small C with a long inner dimension, for which the host backend splits the inner dimension over several threads:
+template<typename T>
+int test_split_k(T epsilon)
+{
+  using viennacl::linalg::prod;
+  using viennacl::trans;
+
+  std::size_t M = 20, N = 17, K = 2085; // K exceeds four times the blocking of the inner dimension and is not a multiple of it
+
+  boost::numeric::ublas::matrix<T> A(M, K), AT(K, M), B(K, N);
+  init_rand(A);
+  init_rand(B);
+  AT = boost::numeric::ublas::trans(A);
+  boost::numeric::ublas::matrix<T> ground = boost::numeric::ublas::prod(A, B);
+  boost::numeric::ublas::matrix<T> ground2 = T(3) * ground;
+
+  viennacl::matrix<T> vcl_A(M, K), vcl_AT(K, M), vcl_C(M, N), vcl_C_unsplit(M, N);
+  viennacl::matrix<T, viennacl::column_major> vcl_B(K, N);
+  viennacl::copy(A, vcl_A);
+  viennacl::copy(AT, vcl_AT);
+  viennacl::copy(B, vcl_B);
+
+  // reference from the path without splitting:
+#ifdef VIENNACL_WITH_OPENMP
+  int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  vcl_C_unsplit = prod(vcl_A, vcl_B);
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(4);
+#endif
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "C = A.B, split inner dimension" << std::endl;
+  vcl_C = prod(vcl_A, vcl_B);
+  boost::numeric::ublas::matrix<T> unsplit(M, N);
+  viennacl::copy(vcl_C_unsplit, unsplit);
+  if (diff(ground, vcl_C) > epsilon || diff(unsplit, vcl_C) > epsilon)
+    retval = EXIT_FAILURE;
+
+  std::cout << "C = A'.B, split inner dimension" << std::endl;
+  vcl_C = prod(trans(vcl_AT), vcl_B);
+  if (diff(ground, vcl_C) > epsilon)
+    retval = EXIT_FAILURE;
+
+  std::cout << "C += 2 A.B, split inner dimension" << std::endl;
+  vcl_C += T(2) * prod(vcl_A, vcl_B);
+  if (diff(ground2, vcl_C) > epsilon)
+    retval = EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  return retval;
+}
+
 template<typename T>
 int run_test(T epsilon)
 {
@@ -304,6 +366,9 @@ int run_test(T epsilon)
 
 #undef TEST_ALL_LAYOUTS
 
+    if (test_split_k<T>(epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
     return EXIT_SUCCESS;
 }
 
@@ -49,6 +49,7 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/lu.hpp"
+#include "viennacl/linalg/cholesky.hpp"
 #include "examples/tutorial/Random.hpp"
 
 //
@@ -1047,6 +1048,77 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   //full solver with partial pivoting:
+   std::cout << "Full solver with partial pivoting" << std::endl;
+   lu_dim = 150; // more than one level of recursion
+   ublas::matrix<NumericT> pivot_matrix(lu_dim, lu_dim);
+   ublas::vector<NumericT> pivot_rhs(lu_dim);
+   ublas::permutation_matrix<std::size_t> ublas_pivots(lu_dim);
+   viennacl::matrix<NumericT, F> vcl_pivot_matrix(lu_dim, lu_dim);
+   viennacl::vector<NumericT> vcl_pivot_rhs(lu_dim);
+   std::vector<viennacl::vcl_size_t> vcl_pivots;
+
+   // small diagonal entries, large entries on a cyclically shifted diagonal, so that pivoting is required:
+   for (std::size_t i=0; i<lu_dim; ++i)
+   {
+     for (std::size_t j=0; j<lu_dim; ++j)
+       pivot_matrix(i,j) = -static_cast<NumericT>(0.5) * random<NumericT>();
+     pivot_matrix(i, (i + 7) % lu_dim) = static_cast<NumericT>(30.0) + random<NumericT>();
+     pivot_rhs(i) = random<NumericT>();
+   }
+
+   viennacl::copy(pivot_matrix, vcl_pivot_matrix);
+   viennacl::copy(pivot_rhs, vcl_pivot_rhs);
+
+   ublas::lu_factorize(pivot_matrix, ublas_pivots);
+   ublas::lu_substitute(pivot_matrix, ublas_pivots, pivot_rhs);
+
+   viennacl::linalg::lu_factorize(vcl_pivot_matrix, vcl_pivots);
+   viennacl::linalg::lu_substitute(vcl_pivot_matrix, vcl_pivots, vcl_pivot_rhs);
+
+   if ( std::fabs(diff(pivot_rhs, vcl_pivot_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(pivot_rhs, vcl_pivot_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   //Cholesky solver:
+   std::cout << "Cholesky solver" << std::endl;
+   ublas::matrix<NumericT> spd_matrix(lu_dim, lu_dim);
+   ublas::vector<NumericT> spd_rhs(lu_dim);
+   ublas::permutation_matrix<std::size_t> spd_pivots(lu_dim);
+   viennacl::matrix<NumericT, F> vcl_spd_matrix(lu_dim, lu_dim);
+   viennacl::vector<NumericT> vcl_spd_rhs(lu_dim);
+
+   // symmetric, diagonally dominant:
+   for (std::size_t i=0; i<lu_dim; ++i)
+   {
+     for (std::size_t j=0; j<i; ++j)
+     {
+       spd_matrix(i,j) = random<NumericT>();
+       spd_matrix(j,i) = spd_matrix(i,j);
+     }
+     spd_matrix(i,i) = static_cast<NumericT>(lu_dim);
+     spd_rhs(i) = random<NumericT>();
+   }
+
+   viennacl::copy(spd_matrix, vcl_spd_matrix);
+   viennacl::copy(spd_rhs, vcl_spd_rhs);
+
+   ublas::lu_factorize(spd_matrix, spd_pivots);
+   ublas::lu_substitute(spd_matrix, spd_pivots, spd_rhs);
+
+   viennacl::linalg::cholesky_factorize(vcl_spd_matrix);
+   viennacl::linalg::cholesky_substitute(vcl_spd_matrix, vcl_spd_rhs);
+
+   if ( std::fabs(diff(spd_rhs, vcl_spd_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: Cholesky solver" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(spd_rhs, vcl_spd_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
@@ -0,0 +1,394 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/qr.cpp  Tests the Householder QR factorization and the tall-skinny QR factorization of dense matrices.
+*   \test  Tests the Householder QR factorization and the tall-skinny QR factorization of dense matrices.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// We don't need debug mode in UBLAS:
+#ifndef NDEBUG
+  #define BOOST_UBLAS_NDEBUG
+#endif
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+//
+// *** ViennaCL
+//
+#define VIENNACL_WITH_UBLAS 1
+#include "viennacl/scalar.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/qr.hpp"
+#include "examples/tutorial/Random.hpp"
+
+//
+// -------------------------------------------------------------
+//
+using namespace boost::numeric;
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Largest deviation of the entries of mat2 from mat1, relative to the largest entry of mat1 */
+template<typename NumericT>
+NumericT diff(ublas::matrix<NumericT> const & mat1, ublas::matrix<NumericT> const & mat2)
+{
+  NumericT max_entry = 0;
+  NumericT max_diff  = 0;
+  for (std::size_t i = 0; i < mat1.size1(); ++i)
+    for (std::size_t j = 0; j < mat1.size2(); ++j)
+    {
+      max_entry = std::max(max_entry, std::fabs(mat1(i, j)));
+      max_diff  = std::max(max_diff,  std::fabs(mat1(i, j) - mat2(i, j)));
+    }
+  return (max_entry > 0) ? max_diff / max_entry : max_diff;
+}
+
+/** @brief Returns the upper triangular factor R stored in the factored matrix A */
+template<typename NumericT>
+ublas::matrix<NumericT> extract_R(ublas::matrix<NumericT> const & A)
+{
+  ublas::matrix<NumericT> R(A.size1(), A.size2());
+  for (std::size_t i = 0; i < A.size1(); ++i)
+    for (std::size_t j = 0; j < A.size2(); ++j)
+      R(i, j) = (j >= i) ? A(i, j) : NumericT(0);
+  return R;
+}
+
+template<typename NumericT>
+ublas::matrix<NumericT> random_matrix(std::size_t rows, std::size_t cols)
+{
+  ublas::matrix<NumericT> A(rows, cols);
+  for (std::size_t i = 0; i < rows; ++i)
+    for (std::size_t j = 0; j < cols; ++j)
+      A(i, j) = random<NumericT>() - NumericT(0.5);
+  return A;
+}
+
+
+//
+// Blocked QR in compact WY form
+//
+
+template<typename NumericT, typename F, typename Epsilon>
+int test_qr_compact_wy(std::size_t rows, std::size_t cols, std::size_t block_size, Epsilon const & epsilon)
+{
+  typedef viennacl::matrix<NumericT, F>   MatrixType;
+
+  int retval = EXIT_SUCCESS;
+
+  ublas::matrix<NumericT> A = random_matrix<NumericT>(rows, cols);
+
+  MatrixType vcl_A(rows, cols);
+  viennacl::copy(A, vcl_A);
+  std::vector<NumericT> betas = viennacl::linalg::inplace_qr(vcl_A, block_size);
+
+  ublas::matrix<NumericT> A_factored(rows, cols);
+  viennacl::copy(vcl_A, A_factored);
+  ublas::matrix<NumericT> R = extract_R(A_factored);
+
+  // Q^T A = R:
+  MatrixType vcl_B(rows, cols);
+  viennacl::copy(A, vcl_B);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_B, block_size);
+
+  ublas::matrix<NumericT> QT_A(rows, cols);
+  viennacl::copy(vcl_B, QT_A);
+  NumericT act_diff = diff(R, QT_A);
+  if (act_diff > epsilon)
+  {
+    std::cout << "# Error at operation: Q^T A = R" << std::endl;
+    std::cout << "  diff: " << act_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // Q^T applied to the columns of A one at a time:
+  for (std::size_t j = 0; j < cols; ++j)
+  {
+    std::vector<NumericT> a_j(rows);
+    for (std::size_t i = 0; i < rows; ++i)
+      a_j[i] = A(i, j);
+    viennacl::vector<NumericT> vcl_a_j(rows);
+    viennacl::copy(a_j, vcl_a_j);
+    viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_a_j, block_size);
+    viennacl::copy(vcl_a_j, a_j);
+
+    for (std::size_t i = 0; i < rows; ++i)
+      QT_A(i, j) = a_j[i];
+  }
+  act_diff = diff(R, QT_A);
+  if (act_diff > epsilon)
+  {
+    std::cout << "# Error at operation: Q^T a_j = r_j" << std::endl;
+    std::cout << "  diff: " << act_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // Q is orthogonal: Q^T (Q^T)^T = I
+  ublas::matrix<NumericT> identity = ublas::identity_matrix<NumericT>(rows);
+  MatrixType vcl_QT(rows, rows);
+  viennacl::copy(identity, vcl_QT);
+  viennacl::linalg::inplace_qr_apply_trans_Q(vcl_A, betas, vcl_QT, block_size);
+
+  MatrixType vcl_QT_Q(rows, rows);
+  vcl_QT_Q = viennacl::linalg::prod(vcl_QT, trans(vcl_QT));
+  ublas::matrix<NumericT> QT_Q(rows, rows);
+  viennacl::copy(vcl_QT_Q, QT_Q);
+  act_diff = diff(identity, QT_Q);
+  if (act_diff > epsilon)
+  {
+    std::cout << "# Error at operation: Q^T Q = I" << std::endl;
+    std::cout << "  diff: " << act_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  if (retval != EXIT_SUCCESS)
+    std::cout << "  rows: " << rows << ", cols: " << cols << ", block size: " << block_size << std::endl;
+
+  return retval;
+}
+
+
+//
+// Tall-skinny QR
+//
+
+/** @brief Factors a random matrix with inplace_tsqr(). Depending on 'proxy', the matrix is stored in a plain matrix (0), a matrix_range (1), or a matrix_slice (2) of a larger matrix. */
+template<typename NumericT, typename F, typename Epsilon>
+int test_tsqr(std::size_t rows, std::size_t cols, std::size_t num_blocks, int proxy, Epsilon const & epsilon)
+{
+  typedef viennacl::matrix<NumericT, F>   MatrixType;
+
+  int retval = EXIT_SUCCESS;
+
+  ublas::matrix<NumericT> A = random_matrix<NumericT>(rows, cols);
+
+  // reference R from the blocked Householder QR:
+  MatrixType vcl_A_ref(rows, cols);
+  viennacl::copy(A, vcl_A_ref);
+  viennacl::linalg::inplace_qr(vcl_A_ref);
+  ublas::matrix<NumericT> A_ref(rows, cols);
+  viennacl::copy(vcl_A_ref, A_ref);
+  ublas::matrix<NumericT> R_ref = extract_R(A_ref);
+
+  // matrix to be factored, possibly embedded in a larger matrix:
+  MatrixType vcl_A(rows, cols);
+  viennacl::copy(A, vcl_A);
+  MatrixType vcl_big(2 * rows + 3, 2 * cols + 3);
+  vcl_big = viennacl::scalar_matrix<NumericT>(vcl_big.size1(), vcl_big.size2(), NumericT(42));
+  viennacl::matrix_range<MatrixType> A_range(vcl_big, viennacl::range(2, 2 + rows), viennacl::range(1, 1 + cols));
+  viennacl::matrix_slice<MatrixType> A_slice(vcl_big, viennacl::slice(1, 2, rows), viennacl::slice(3, 2, cols));
+
+  viennacl::matrix_base<NumericT> * A_proxy = &vcl_A;
+  if (proxy == 1)
+  {
+    A_range = vcl_A;
+    A_proxy = &A_range;
+  }
+  else if (proxy == 2)
+  {
+    A_slice = vcl_A;
+    A_proxy = &A_slice;
+  }
+
+  viennacl::linalg::tsqr_factors<NumericT> factors = viennacl::linalg::inplace_tsqr(*A_proxy, num_blocks);
+
+  MatrixType vcl_A_factored(rows, cols);
+  vcl_A_factored = *A_proxy;
+  ublas::matrix<NumericT> A_factored(rows, cols);
+  viennacl::copy(vcl_A_factored, A_factored);
+  ublas::matrix<NumericT> R = extract_R(A_factored);
+
+  // R agrees with the reference up to the signs of its rows:
+  for (std::size_t i = 0; i < cols; ++i)
+    if ((R(i, i) < 0) != (R_ref(i, i) < 0))
+      for (std::size_t j = i; j < cols; ++j)
+        R(i, j) = -R(i, j);
+  NumericT act_diff = diff(R_ref, R);
+  if (act_diff > epsilon)
+  {
+    std::cout << "# Error at operation: R of TSQR" << std::endl;
+    std::cout << "  diff: " << act_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  R = extract_R(A_factored);
+
+  // Q^T A = R:
+  MatrixType vcl_B(rows, cols);
+  viennacl::copy(A, vcl_B);
+  viennacl::linalg::tsqr_apply_trans_Q(*A_proxy, factors, vcl_B);
+  ublas::matrix<NumericT> QT_A(rows, cols);
+  viennacl::copy(vcl_B, QT_A);
+  act_diff = diff(R, QT_A);
+  if (act_diff > epsilon)
+  {
+    std::cout << "# Error at operation: Q^T A = R with TSQR" << std::endl;
+    std::cout << "  diff: " << act_diff << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // b = A x is in the range of A, thus Q (Q^T b) = b even if all but the first 'cols' entries of Q^T b are dropped:
+  std::vector<NumericT> b(rows, NumericT(0));
+  for (std::size_t j = 0; j < cols; ++j)
+  {
+    NumericT x_j = random<NumericT>();
+    for (std::size_t i = 0; i < rows; ++i)
+      b[i] += A(i, j) * x_j;
+  }
+  viennacl::vector<NumericT> vcl_b(rows);
+  viennacl::copy(b, vcl_b);
+  viennacl::linalg::tsqr_apply_trans_Q(*A_proxy, factors, vcl_b);
+  viennacl::project(vcl_b, viennacl::range(cols, rows)) = viennacl::zero_vector<NumericT>(rows - cols);
+  viennacl::linalg::tsqr_apply_Q(*A_proxy, factors, vcl_b);
+
+  std::vector<NumericT> Q_QT_b(rows);
+  viennacl::copy(vcl_b, Q_QT_b);
+  NumericT max_b = 0;
+  NumericT max_diff = 0;
+  for (std::size_t i = 0; i < rows; ++i)
+  {
+    max_b    = std::max(max_b, std::fabs(b[i]));
+    max_diff = std::max(max_diff, std::fabs(b[i] - Q_QT_b[i]));
+  }
+  if (max_diff > epsilon * max_b)
+  {
+    std::cout << "# Error at operation: Q (Q^T b) = b with TSQR" << std::endl;
+    std::cout << "  diff: " << max_diff / max_b << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  if (retval != EXIT_SUCCESS)
+    std::cout << "  rows: " << rows << ", cols: " << cols << ", blocks: " << num_blocks << ", proxy: " << proxy << std::endl;
+
+  return retval;
+}
+
+
+template<typename NumericT, typename F, typename Epsilon>
+int test_layout(Epsilon const & epsilon)
+{
+  std::size_t sizes[][2]     = { {47, 31}, {31, 47}, {40, 40}, {1, 9}, {9, 1} };
+  std::size_t block_sizes[]  = { 1, 5, 8, 32, 64 };
+
+  for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    for (std::size_t k = 0; k < sizeof(block_sizes) / sizeof(block_sizes[0]); ++k)
+      if (test_qr_compact_wy<NumericT, F>(sizes[i][0], sizes[i][1], block_sizes[k], epsilon) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+  std::size_t tsqr_cols[]   = { 1, 7, 12 };
+  std::size_t num_blocks[]  = { 0, 1, 2, 3, 5, 8 };
+
+  for (std::size_t i = 0; i < sizeof(tsqr_cols) / sizeof(tsqr_cols[0]); ++i)
+    for (std::size_t k = 0; k < sizeof(num_blocks) / sizeof(num_blocks[0]); ++k)
+      for (int proxy = 0; proxy < 3; ++proxy)
+        if (test_tsqr<NumericT, F>(301, tsqr_cols[i], num_blocks[k], proxy, epsilon) != EXIT_SUCCESS)
+          return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT, typename Epsilon>
+int test(Epsilon const & epsilon)
+{
+  std::cout << "Testing blocked QR and TSQR, row-major" << std::endl;
+  if (test_layout<NumericT, viennacl::row_major>(epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing blocked QR and TSQR, column-major" << std::endl;
+  if (test_layout<NumericT, viennacl::column_major>(epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "## Test :: QR factorization" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+
+   int retval = EXIT_SUCCESS;
+
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+   {
+      typedef float NumericT;
+      NumericT epsilon = NumericT(1.0E-4);
+      std::cout << "# Testing setup:" << std::endl;
+      std::cout << "  eps:     " << epsilon << std::endl;
+      std::cout << "  numeric: float" << std::endl;
+      retval = test<NumericT>(epsilon);
+      if ( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+      else
+        return retval;
+   }
+   std::cout << std::endl;
+   std::cout << "----------------------------------------------" << std::endl;
+   std::cout << std::endl;
+#ifdef VIENNACL_WITH_OPENCL
+   if ( viennacl::ocl::current_device().double_support() )
+#endif
+   {
+      {
+        typedef double NumericT;
+        NumericT epsilon = 1.0E-12;
+        std::cout << "# Testing setup:" << std::endl;
+        std::cout << "  eps:     " << epsilon << std::endl;
+        std::cout << "  numeric: double" << std::endl;
+        retval = test<NumericT>(epsilon);
+        if ( retval == EXIT_SUCCESS )
+          std::cout << "# Test passed" << std::endl;
+        else
+          return retval;
+      }
+      std::cout << std::endl;
+      std::cout << "----------------------------------------------" << std::endl;
+      std::cout << std::endl;
+   }
+
+   std::cout << std::endl;
+   std::cout << "------- Test completed --------" << std::endl;
+   std::cout << std::endl;
+
+
+   return retval;
+}
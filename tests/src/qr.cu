@@ -0,0 +1 @@
+qr.cpp
\ No newline at end of file
@@ -29,6 +29,8 @@
 // *** System
 //
 #include <iostream>
+#include <fstream>
+#include <cstdio>
 
 //
 // *** Boost
@@ -55,13 +57,23 @@
 #include "viennacl/ell_matrix.hpp"
 #include "viennacl/sliced_ell_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
+#include "viennacl/bsr_matrix.hpp"
+#include "viennacl/compact_compressed_matrix.hpp"
+#include "viennacl/symmetric_compressed_matrix.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/io/matrix_market.hpp"
+#include "viennacl/io/binary_format.hpp"
+#include "viennacl/tools/sparse_format.hpp"
 #include "examples/tutorial/Random.hpp"
 #include "examples/tutorial/vector-io.hpp"
 
@@ -223,6 +235,1125 @@ int strided_matrix_vector_product_test(Epsilon epsilon,
     return retval;
 }
 
+// matrix where a few rows hold most of the nonzeros, so that rows get split across threads:
+template<typename NumericT, typename Epsilon>
+int unbalanced_matrix_vector_product_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t N = 3000;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      rhs(i) = NumericT(1) + random<NumericT>();
+      if (i == 0 || i == N / 2 || i == N / 2 + 1 || i == N - 1) // dense rows
+      {
+        for (std::size_t j = 0; j < N; ++j)
+          ublas_matrix(i, j) = random<NumericT>();
+      }
+      else if (i % 3 != 0) // short rows, every third row is empty
+      {
+        ublas_matrix(i, i) = NumericT(2);
+        ublas_matrix(i, (7 * i) % N) = NumericT(-1);
+      }
+    }
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::copy(rhs, vcl_rhs);
+    viennacl::vector<NumericT> vcl_result = viennacl::scalar_vector<NumericT>(N, NumericT(1));
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with unbalanced compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // second product reuses the partition cached in the matrix:
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: repeated matrix-vector product with unbalanced compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // a new sparsity pattern needs to invalidate the cached partition:
+    ublas_matrix(N / 4, 0) = NumericT(3);
+    result = ublas::prod(ublas_matrix, rhs);
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with modified unbalanced compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // sliced_ell_matrix with various block sizes C and sorting windows sigma (zero: defaults):
+    std::size_t block_sizes[]     = { 0, 8, 24, 32 };
+    std::size_t sorting_windows[] = { 0, 1, 40, 64 };
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+      viennacl::sliced_ell_matrix<NumericT> vcl_sliced_ell_matrix(N, N, block_sizes[k], sorting_windows[k]);
+      viennacl::copy(ublas_matrix, vcl_sliced_ell_matrix);
+      vcl_result = viennacl::linalg::prod(vcl_sliced_ell_matrix, vcl_rhs);
+      if ( std::fabs(diff(result, vcl_result)) > epsilon )
+      {
+        std::cout << "# Error at operation: matrix-vector product with unbalanced sliced_ell_matrix, C = " << block_sizes[k] << ", sigma = " << sorting_windows[k] << std::endl;
+        std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    return retval;
+}
+
+
+// sparse matrix-matrix products, using both the dense and the hashed row accumulation on the host:
+template<typename NumericT, typename Epsilon>
+int sparse_matrix_product_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t N = 300, K = 200, M = 5000;
+    ublas::compressed_matrix<NumericT> ublas_A(N, K), ublas_B(K, M), ublas_K(K, K);
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        ublas_A(i, (i * 17 + j * 59) % K) = NumericT(1) + random<NumericT>();
+    for (std::size_t i = 0; i < K; ++i)
+    {
+      for (std::size_t j = 0; j < 4; ++j)
+        ublas_B(i, (i * 101 + j * 1237) % M) = NumericT(1) + random<NumericT>();
+      ublas_K(i, i) = NumericT(2);
+      for (std::size_t j = 1; j < 4; ++j)
+        ublas_K(i, (i * 7 + j * 31) % K) = NumericT(1) + random<NumericT>();
+    }
+
+    viennacl::compressed_matrix<NumericT> vcl_A, vcl_B, vcl_K;
+    viennacl::copy(ublas_A, vcl_A);
+    viennacl::copy(ublas_B, vcl_B);
+    viennacl::copy(ublas_K, vcl_K);
+
+    ublas::compressed_matrix<NumericT> ublas_C = ublas::sparse_prod<ublas::compressed_matrix<NumericT> >(ublas_A, ublas_B);
+    viennacl::compressed_matrix<NumericT> vcl_C = viennacl::linalg::prod(vcl_A, vcl_B);
+    if ( vcl_C.nnz() != ublas_C.nnz() || std::fabs(diff(ublas_C, vcl_C)) > epsilon )
+    {
+      std::cout << "# Error at operation: sparse matrix-matrix product with compressed_matrix" << std::endl;
+      std::cout << "  nonzeros: " << vcl_C.nnz() << " vs. " << ublas_C.nnz() << ", diff: " << std::fabs(diff(ublas_C, vcl_C)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    ublas_C = ublas::sparse_prod<ublas::compressed_matrix<NumericT> >(ublas_A, ublas_K);
+    vcl_C = viennacl::linalg::prod(vcl_A, vcl_K);
+    if ( vcl_C.nnz() != ublas_C.nnz() || std::fabs(diff(ublas_C, vcl_C)) > epsilon )
+    {
+      std::cout << "# Error at operation: sparse matrix-matrix product with compressed_matrix, assignment" << std::endl;
+      std::cout << "  nonzeros: " << vcl_C.nnz() << " vs. " << ublas_C.nnz() << ", diff: " << std::fabs(diff(ublas_C, vcl_C)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    ublas_C = ublas::sparse_prod<ublas::compressed_matrix<NumericT> >(ublas_K, ublas_K);
+    vcl_K = viennacl::linalg::prod(vcl_K, vcl_K);
+    if ( vcl_K.nnz() != ublas_C.nnz() || std::fabs(diff(ublas_C, vcl_K)) > epsilon )
+    {
+      std::cout << "# Error at operation: sparse matrix-matrix product with compressed_matrix, aliased factors" << std::endl;
+      std::cout << "  nonzeros: " << vcl_K.nnz() << " vs. " << ublas_C.nnz() << ", diff: " << std::fabs(diff(ublas_C, vcl_K)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // enough rows for the product to run multi-threaded on the host, with a few long rows for the dense accumulation:
+    std::size_t L = 6000;
+    ublas::compressed_matrix<NumericT> ublas_L(L, L);
+    for (std::size_t i = 0; i < L; ++i)
+    {
+      ublas_L(i, i) = NumericT(2);
+      ublas_L(i, (i * 13 + 7) % L) = NumericT(1) + random<NumericT>();
+      ublas_L(i, (i * 101 + 1) % L) = NumericT(1) + random<NumericT>();
+      if (i % 1000 == 0)
+        for (std::size_t j = 1; j < 250; ++j)
+          ublas_L(i, (i + j * 23) % L) = random<NumericT>();
+    }
+    viennacl::compressed_matrix<NumericT> vcl_L;
+    viennacl::copy(ublas_L, vcl_L);
+
+    ublas_C = ublas::sparse_prod<ublas::compressed_matrix<NumericT> >(ublas_L, ublas_L);
+    vcl_C = viennacl::linalg::prod(vcl_L, vcl_L);
+    if ( vcl_C.nnz() != ublas_C.nnz() || std::fabs(diff(ublas_C, vcl_C)) > epsilon )
+    {
+      std::cout << "# Error at operation: sparse matrix-matrix product with compressed_matrix, many rows" << std::endl;
+      std::cout << "  nonzeros: " << vcl_C.nnz() << " vs. " << ublas_C.nnz() << ", diff: " << std::fabs(diff(ublas_C, vcl_C)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+
+// conversion from compressed_matrix to another sparse matrix type and back:
+template<typename SparseMatrixT, typename NumericT, typename Epsilon>
+int sparse_format_conversion_test(ublas::compressed_matrix<NumericT> & ublas_matrix,
+                                  viennacl::compressed_matrix<NumericT> const & vcl_matrix,
+                                  viennacl::vector<NumericT> const & vcl_rhs,
+                                  ublas::vector<NumericT> & result,
+                                  std::string const & name,
+                                  Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    SparseMatrixT vcl_converted;
+    viennacl::tools::convert_sparse_matrix(vcl_matrix, vcl_converted);
+
+    viennacl::vector<NumericT> vcl_result(vcl_rhs.size());
+    vcl_result = viennacl::linalg::prod(vcl_converted, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: conversion from compressed_matrix to " << name << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    viennacl::compressed_matrix<NumericT> vcl_back;
+    viennacl::tools::convert_sparse_matrix(vcl_converted, vcl_back);
+    if ( vcl_back.nnz() != ublas_matrix.nnz() || std::fabs(diff(ublas_matrix, vcl_back)) > epsilon )
+    {
+      std::cout << "# Error at operation: conversion from " << name << " to compressed_matrix" << std::endl;
+      std::cout << "  nonzeros: " << vcl_back.nnz() << " vs. " << ublas_matrix.nnz() << ", diff: " << std::fabs(diff(ublas_matrix, vcl_back)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+
+// conversions between all sparse matrix types and selection of the format based on the row statistics:
+template<typename NumericT, typename Epsilon>
+int sparse_format_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t N = 1000;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N), ublas_banded(N, N);
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      rhs(i) = NumericT(1) + random<NumericT>();
+      if (i == 1 || i == N / 2 || i == N / 2 + 1 || i == N - 2) // dense rows
+      {
+        for (std::size_t j = 0; j < N; ++j)
+          ublas_matrix(i, j) = NumericT(1) + random<NumericT>();
+      }
+      else if (i % 3 != 0) // short rows, every third row is empty
+      {
+        ublas_matrix(i, i) = NumericT(2);
+        ublas_matrix(i, (7 * i) % N) = NumericT(-1);
+      }
+
+      ublas_banded(i, i) = NumericT(2);
+      ublas_banded(i, (i + 1) % N) = NumericT(-1);
+      ublas_banded(i, (i + N - 1) % N) = NumericT(-1);
+    }
+    ublas_matrix.complete_index1_data(); // the last row is empty
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix, vcl_banded;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::copy(ublas_banded, vcl_banded);
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::copy(rhs, vcl_rhs);
+
+    retval |= sparse_format_conversion_test<viennacl::compressed_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "compressed_matrix", epsilon);
+    retval |= sparse_format_conversion_test<viennacl::compressed_compressed_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "compressed_compressed_matrix", epsilon);
+    retval |= sparse_format_conversion_test<viennacl::coordinate_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "coordinate_matrix", epsilon);
+    retval |= sparse_format_conversion_test<viennacl::ell_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "ell_matrix", epsilon);
+    retval |= sparse_format_conversion_test<viennacl::sliced_ell_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "sliced_ell_matrix", epsilon);
+    retval |= sparse_format_conversion_test<viennacl::hyb_matrix<NumericT> >(ublas_matrix, vcl_matrix, vcl_rhs, result, "hyb_matrix", epsilon);
+
+    // statistics:
+    viennacl::tools::sparse_row_statistics stats = viennacl::tools::row_statistics(vcl_matrix);
+    if (stats.rows != N || stats.nnz != ublas_matrix.nnz() || stats.max != N || stats.histogram.size() != 11 || stats.histogram[0] != (N - 1) / 3 || stats.histogram[10] != 4)
+    {
+      std::cout << "# Error at operation: row statistics" << std::endl;
+      std::cout << "  rows: " << stats.rows << ", nonzeros: " << stats.nnz << ", max: " << stats.max << ", buckets: " << stats.histogram.size() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // a few very long rows are best handled by hyb_matrix on GPUs, while equal row lengths favor ell_matrix:
+    if (   viennacl::tools::recommend_sparse_format(stats, viennacl::OPENCL_MEMORY) != viennacl::tools::SPARSE_FORMAT_HYB
+        || viennacl::tools::recommend_sparse_format(viennacl::tools::row_statistics(vcl_banded), viennacl::OPENCL_MEMORY) != viennacl::tools::SPARSE_FORMAT_ELL)
+    {
+      std::cout << "# Error at operation: recommendation of sparse matrix format" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // the timed selection needs to be cached:
+    viennacl::tools::sparse_format fastest_format = viennacl::tools::benchmark_sparse_format(vcl_matrix, 2);
+    if (viennacl::tools::benchmark_sparse_format(vcl_matrix, 2) != fastest_format)
+    {
+      std::cout << "# Error at operation: benchmark of sparse matrix formats" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+// block-structured system with three unknowns per grid point, as obtained from vector-valued PDEs:
+template<typename NumericT, typename Epsilon>
+int bsr_matrix_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t points = 200;
+    std::size_t N = 3 * points;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t p = 0; p < points; ++p)
+    {
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        rhs(3 * p + i) = NumericT(1) + random<NumericT>();
+        for (std::size_t j = 0; j < 3; ++j) // strongly coupled unknowns within each point
+          ublas_matrix(3 * p + i, 3 * p + j) = (i == j) ? NumericT(6) : NumericT(1.5);
+        if (p > 0)
+          ublas_matrix(3 * p + i, 3 * (p - 1) + i) = NumericT(-1);
+        if (p + 1 < points)
+          ublas_matrix(3 * p + i, 3 * (p + 1) + i) = NumericT(-1);
+      }
+    }
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::vector<NumericT> vcl_result(N);
+    viennacl::copy(rhs, vcl_rhs);
+
+    // copy from uBLAS and from compressed_matrix:
+    viennacl::bsr_matrix<NumericT, 3> vcl_matrix, vcl_matrix2;
+    viennacl::compressed_matrix<NumericT> vcl_compressed_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::copy(ublas_matrix, vcl_compressed_matrix);
+    viennacl::copy(vcl_compressed_matrix, vcl_matrix2);
+
+    if (vcl_matrix.nonzero_blocks() != 3 * points - 2 || vcl_matrix2.nonzero_blocks() != vcl_matrix.nonzero_blocks())
+    {
+      std::cout << "# Error at operation: copy to bsr_matrix" << std::endl;
+      std::cout << "  blocks: " << vcl_matrix.nonzero_blocks() << " and " << vcl_matrix2.nonzero_blocks() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix2, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with bsr_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // strided vectors:
+    viennacl::vector<NumericT> vcl_rhs_strided(2 * N);
+    viennacl::vector<NumericT> vcl_result_strided(3 * N);
+    viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, N)) = vcl_rhs;
+    viennacl::project(vcl_result_strided, viennacl::slice(2, 3, N)) = viennacl::linalg::prod(vcl_matrix, viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, N)));
+    vcl_result = viennacl::project(vcl_result_strided, viennacl::slice(2, 3, N));
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with bsr_matrix and strided vectors" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // copy back to the host:
+    ublas::compressed_matrix<NumericT> ublas_matrix2(N, N);
+    viennacl::copy(vcl_matrix, ublas_matrix2);
+    if ( ublas_matrix2.nnz() != ublas_matrix.nnz() || std::fabs(diff(ublas_matrix2, vcl_compressed_matrix)) > epsilon )
+    {
+      std::cout << "# Error at operation: copy from bsr_matrix to ublas::compressed_matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // iterative solvers with (block-)Jacobi preconditioners:
+    NumericT solver_tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+    viennacl::linalg::jacobi_precond< viennacl::bsr_matrix<NumericT, 3> >       vcl_jacobi(vcl_matrix, viennacl::linalg::jacobi_tag());
+    viennacl::linalg::block_jacobi_precond< viennacl::bsr_matrix<NumericT, 3> > vcl_block_jacobi(vcl_matrix, viennacl::linalg::block_jacobi_tag());
+    NumericT norm_rhs = viennacl::linalg::norm_2(vcl_rhs);
+
+    viennacl::linalg::cg_tag cg_tag_jacobi(solver_tolerance, 400);
+    viennacl::linalg::cg_tag cg_tag_block_jacobi(solver_tolerance, 400);
+    viennacl::vector<NumericT> vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, cg_tag_jacobi, vcl_jacobi);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_x);
+    vcl_result -= vcl_rhs;
+    if ( viennacl::linalg::norm_2(vcl_result) > 10 * solver_tolerance * norm_rhs )
+    {
+      std::cout << "# Error at operation: CG with Jacobi preconditioner for bsr_matrix" << std::endl;
+      std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, cg_tag_block_jacobi, vcl_block_jacobi);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_x);
+    vcl_result -= vcl_rhs;
+    if ( viennacl::linalg::norm_2(vcl_result) > 10 * solver_tolerance * norm_rhs || cg_tag_block_jacobi.iters() > cg_tag_jacobi.iters() )
+    {
+      std::cout << "# Error at operation: CG with block Jacobi preconditioner for bsr_matrix" << std::endl;
+      std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << ", iterations: " << cg_tag_block_jacobi.iters() << " vs. " << cg_tag_jacobi.iters() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, viennacl::linalg::bicgstab_tag(solver_tolerance, 400), vcl_block_jacobi);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_x);
+    vcl_result -= vcl_rhs;
+    if ( viennacl::linalg::norm_2(vcl_result) > 10 * solver_tolerance * norm_rhs )
+    {
+      std::cout << "# Error at operation: BiCGStab with block Jacobi preconditioner for bsr_matrix" << std::endl;
+      std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // GMRES monitors the preconditioned residual, which does not reach the same tolerance in single precision:
+    NumericT gmres_tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-8) : NumericT(1e-4);
+    vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, viennacl::linalg::gmres_tag(gmres_tolerance, 400, 30), vcl_block_jacobi);
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_x);
+    vcl_result -= vcl_rhs;
+    if ( viennacl::linalg::norm_2(vcl_result) > 100 * gmres_tolerance * norm_rhs )
+    {
+      std::cout << "# Error at operation: GMRES with block Jacobi preconditioner for bsr_matrix" << std::endl;
+      std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // clear:
+    vcl_matrix.clear();
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( viennacl::linalg::norm_2(vcl_result) > 0 )
+    {
+      std::cout << "# Error at operation: matrix-vector product with bsr_matrix after clear()" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // preconditioner for an empty matrix:
+    viennacl::bsr_matrix<NumericT, 3> vcl_empty_matrix;
+    vcl_block_jacobi.init(vcl_empty_matrix);
+    viennacl::linalg::block_jacobi_precond< viennacl::bsr_matrix<NumericT, 3> > vcl_empty_block_jacobi(vcl_empty_matrix, viennacl::linalg::block_jacobi_tag());
+
+    return retval;
+}
+
+// nonsymmetric five-point stencil, incomplete LU factorizations by fixed-point sweeps:
+template<typename NumericT, typename Epsilon>
+int ilu0_sweeps_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t points = 40; // enough entries for the multi-threaded setup
+    std::size_t N = points * points;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t i = 0; i < points; ++i)
+    {
+      for (std::size_t j = 0; j < points; ++j)
+      {
+        std::size_t row = i * points + j;
+        rhs(row) = NumericT(1) + random<NumericT>();
+        ublas_matrix(row, row) = NumericT(4.2);
+        if (i > 0)          ublas_matrix(row, row - points) = NumericT(-1);
+        if (i + 1 < points) ublas_matrix(row, row + points) = NumericT(-1);
+        if (j > 0)          ublas_matrix(row, row - 1)      = NumericT(-1.1);
+        if (j + 1 < points) ublas_matrix(row, row + 1)      = NumericT(-0.9);
+      }
+    }
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::copy(rhs, vcl_rhs);
+
+    // the sweeps converge to the sequential factors:
+    for (std::size_t fill_level = 0; fill_level < 3; ++fill_level)
+    {
+      viennacl::linalg::ilu0_tag sequential_tag;
+      sequential_tag.fill_level(fill_level);
+      viennacl::linalg::ilu0_tag sweeps_tag;
+      sweeps_tag.fill_level(fill_level);
+      sweeps_tag.sweeps(80);
+
+      viennacl::compressed_matrix<NumericT> LU_sequential(viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::compressed_matrix<NumericT> LU_sweeps(viennacl::context(viennacl::MAIN_MEMORY));
+      LU_sequential = vcl_matrix;
+      LU_sweeps = vcl_matrix;
+      viennacl::linalg::detail::ilu0_factorize(LU_sequential, sequential_tag, viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::detail::ilu0_factorize(LU_sweeps,     sweeps_tag,     viennacl::traits::context(vcl_matrix));
+
+      std::vector<NumericT> entries_sequential(LU_sequential.nnz());
+      std::vector<NumericT> entries_sweeps(LU_sweeps.nnz());
+      viennacl::backend::memory_read(LU_sequential.handle(), 0, sizeof(NumericT) * entries_sequential.size(), &(entries_sequential[0]));
+      viennacl::backend::memory_read(LU_sweeps.handle(),     0, sizeof(NumericT) * entries_sweeps.size(),     &(entries_sweeps[0]));
+
+      NumericT max_diff = 0;
+      for (std::size_t i = 0; i < std::min(entries_sequential.size(), entries_sweeps.size()); ++i)
+        max_diff = std::max<NumericT>(max_diff, std::fabs(entries_sequential[i] - entries_sweeps[i]));
+      if (entries_sequential.size() != entries_sweeps.size() || max_diff > epsilon
+          || (fill_level == 0 && LU_sweeps.nnz() != vcl_matrix.nnz()) || (fill_level > 0 && LU_sweeps.nnz() <= vcl_matrix.nnz()))
+      {
+        std::cout << "# Error at operation: ILU(" << fill_level << ") by fixed-point sweeps" << std::endl;
+        std::cout << "  nonzeros: " << entries_sequential.size() << " vs. " << entries_sweeps.size() << ", diff: " << max_diff << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    // preconditioners with few sweeps and approximate triangular solves:
+    NumericT solver_tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+    NumericT norm_rhs = viennacl::linalg::norm_2(vcl_rhs);
+    for (std::size_t jacobi_iters = 0; jacobi_iters <= 3; jacobi_iters += 3)
+    {
+      viennacl::linalg::ilu0_tag ilu_tag;
+      ilu_tag.sweeps(3);
+      ilu_tag.jacobi_iters(jacobi_iters);
+      ilu_tag.fill_level(1);
+      viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > vcl_ilu(vcl_matrix, ilu_tag);
+
+      viennacl::linalg::bicgstab_tag solver_tag(solver_tolerance, 100);
+      viennacl::vector<NumericT> vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, solver_tag, vcl_ilu);
+      viennacl::vector<NumericT> vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_x);
+      vcl_result -= vcl_rhs;
+      if ( viennacl::linalg::norm_2(vcl_result) > 10 * solver_tolerance * norm_rhs || solver_tag.iters() > 20 )
+      {
+        std::cout << "# Error at operation: BiCGStab with ILU(1) by fixed-point sweeps, Jacobi iterations: " << jacobi_iters << std::endl;
+        std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << ", iterations: " << solver_tag.iters() << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    return retval;
+}
+
+// nonsymmetric five-point stencil with equal off-diagonal entries in natural and in red-black ordering, row-parallel ILUT setup versus serial ILUT:
+template<typename NumericT>
+int ilut_row_parallel_test(bool red_black)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t points = 60;
+    std::size_t N = points * points;
+
+    // index of grid point (i, j). Red-black ordering numbers all points with even i+j first:
+    std::vector<std::size_t> index(N);
+    std::size_t num_red = 0;
+    for (std::size_t p = 0; p < N; ++p)
+      if ((p / points + p % points) % 2 == 0)
+        ++num_red;
+    for (std::size_t p = 0, red = 0, black = num_red; p < N; ++p)
+    {
+      if (!red_black)
+        index[p] = p;
+      else
+        index[p] = ((p / points + p % points) % 2 == 0) ? red++ : black++;
+    }
+
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    for (std::size_t i = 0; i < points; ++i)
+    {
+      for (std::size_t j = 0; j < points; ++j)
+      {
+        std::size_t p = i * points + j;
+        std::size_t row = index[p];
+        ublas_matrix(row, row) = NumericT(4.2) + NumericT(p % 7) / NumericT(10);
+        if (i > 0)          ublas_matrix(row, index[p - points]) = NumericT(-1);
+        if (i + 1 < points) ublas_matrix(row, index[p + points]) = NumericT(-1);
+        if (j > 0)          ublas_matrix(row, index[p - 1])      = NumericT(-1);
+        if (j + 1 < points) ublas_matrix(row, index[p + 1])      = NumericT(-0.9);
+      }
+    }
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::copy(ublas_matrix, vcl_matrix);
+
+    std::size_t entries_per_row[] = {3, 5, 20};
+    double      drop_tolerance[]  = {1e-2, 1e-3, 1e-5};
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      viennacl::linalg::ilut_tag ilut_tag(static_cast<unsigned int>(entries_per_row[k]), drop_tolerance[k]);
+
+      std::vector< std::map<unsigned int, NumericT> > LU_map(N);
+      viennacl::linalg::precondition(vcl_matrix, LU_map, ilut_tag);
+      viennacl::compressed_matrix<NumericT> LU_serial(viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::copy(LU_map, LU_serial);
+
+      viennacl::compressed_matrix<NumericT> LU_parallel(viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::detail::ilut_row_parallel(vcl_matrix, LU_parallel, ilut_tag);
+
+      // factors must be identical:
+      bool identical = (LU_serial.nnz() == LU_parallel.nnz());
+      if (identical)
+      {
+        unsigned int const * row_serial   = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_serial.handle1());
+        unsigned int const * row_parallel = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_parallel.handle1());
+        unsigned int const * col_serial   = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_serial.handle2());
+        unsigned int const * col_parallel = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_parallel.handle2());
+        NumericT     const * val_serial   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU_serial.handle());
+        NumericT     const * val_parallel = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU_parallel.handle());
+
+        for (std::size_t i = 0; i <= N; ++i)
+          identical = identical && (row_serial[i] == row_parallel[i]);
+        for (std::size_t i = 0; i < LU_serial.nnz(); ++i)
+          identical = identical && (col_serial[i] == col_parallel[i]) && !(val_serial[i] < val_parallel[i]) && !(val_serial[i] > val_parallel[i]);
+      }
+
+      if (!identical || LU_parallel.nnz() <= ublas_matrix.nnz() / 2)
+      {
+        std::cout << "# Error at operation: row-parallel ILUT, red-black ordering: " << red_black << ", entries per row: " << entries_per_row[k] << ", drop tolerance: " << drop_tolerance[k] << std::endl;
+        std::cout << "  nonzeros: " << LU_serial.nnz() << " vs. " << LU_parallel.nnz() << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    return retval;
+}
+
+// wide matrix with column distances beyond the range of 16-bit column offsets:
+template<typename NumericT, typename ValueT, typename IndexT, typename Epsilon>
+int compact_compressed_matrix_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t rows = 60;
+    std::size_t cols = 150000;
+    ublas::compressed_matrix<NumericT> ublas_matrix(rows, cols);
+    ublas::vector<NumericT> rhs(cols);
+    for (std::size_t j = 0; j < cols; ++j)
+      rhs(j) = NumericT(1) + random<NumericT>();
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+      if (i % 10 == 5) // empty rows
+        continue;
+      ublas_matrix(i, i) = NumericT(1) + random<NumericT>();
+      ublas_matrix(i, 7 * i + 100) = NumericT(1) + random<NumericT>();
+      ublas_matrix(i, 70000 + i) = NumericT(1) + random<NumericT>();
+      if (i % 2)
+        ublas_matrix(i, cols - 1 - i) = NumericT(1) + random<NumericT>();
+    }
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::vector<NumericT> vcl_rhs(cols);
+    viennacl::vector<NumericT> vcl_result(rows);
+    viennacl::copy(rhs, vcl_rhs);
+
+    // copy from uBLAS and from compressed_matrix:
+    viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> vcl_matrix, vcl_matrix2;
+    viennacl::compressed_matrix<NumericT> vcl_compressed_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::copy(ublas_matrix, vcl_compressed_matrix);
+    viennacl::copy(vcl_compressed_matrix, vcl_matrix2);
+
+    // explicit zeros are only needed if the column offsets are 16 bits wide:
+    bool needs_padding = (sizeof(IndexT) < 4);
+    if ( (vcl_matrix.nnz() > ublas_matrix.nnz()) != needs_padding || vcl_matrix2.nnz() != vcl_matrix.nnz() )
+    {
+      std::cout << "# Error at operation: copy to compact_compressed_matrix" << std::endl;
+      std::cout << "  nonzeros: " << vcl_matrix.nnz() << " and " << vcl_matrix2.nnz() << " vs. " << ublas_matrix.nnz() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix2, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with compact_compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // strided vectors:
+    viennacl::vector<NumericT> vcl_rhs_strided(2 * cols);
+    viennacl::vector<NumericT> vcl_result_strided(3 * rows);
+    viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, cols)) = vcl_rhs;
+    viennacl::project(vcl_result_strided, viennacl::slice(2, 3, rows)) = viennacl::linalg::prod(vcl_matrix, viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, cols)));
+    vcl_result = viennacl::project(vcl_result_strided, viennacl::slice(2, 3, rows));
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with compact_compressed_matrix and strided vectors" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // copy back to the host:
+    ublas::compressed_matrix<NumericT> ublas_matrix2(rows, cols);
+    viennacl::copy(vcl_matrix, ublas_matrix2);
+    if ( ublas_matrix2.nnz() != ublas_matrix.nnz() || std::fabs(diff(ublas_matrix2, vcl_compressed_matrix)) > epsilon )
+    {
+      std::cout << "# Error at operation: copy from compact_compressed_matrix to ublas::compressed_matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // clear:
+    vcl_matrix.clear();
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( viennacl::linalg::norm_2(vcl_result) > 0 )
+    {
+      std::cout << "# Error at operation: matrix-vector product with compact_compressed_matrix after clear()" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+// parallel MatrixMarket reader and writer for CSR arrays and compressed_matrix:
+template<typename NumericT, typename Epsilon>
+int matrix_market_test(ublas::compressed_matrix<NumericT> & ublas_matrix, Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    if (viennacl::io::read_matrix_market_file(vcl_matrix, "../examples/testdata/mat65k.mtx") == 0 || std::fabs(diff(ublas_matrix, vcl_matrix)) > epsilon)
+    {
+      std::cout << "# Error at operation: reading MatrixMarket file into compressed_matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // write and read back with the line-by-line reader:
+    viennacl::io::write_matrix_market_file(vcl_matrix, "sparse-test-io.mtx");
+    ublas::compressed_matrix<NumericT> ublas_matrix2;
+    viennacl::io::read_matrix_market_file(ublas_matrix2, "sparse-test-io.mtx");
+    if ( ublas_matrix2.nnz() != ublas_matrix.nnz() || std::fabs(diff(ublas_matrix2, vcl_matrix)) > 0 )
+    {
+      std::cout << "# Error at operation: writing MatrixMarket file from compressed_matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.mtx");
+
+    std::vector<unsigned int> row_buffer, col_buffer;
+    std::vector<NumericT> elements;
+    viennacl::vcl_size_t rows = 0, cols = 0;
+
+    // symmetric header, comments, blank lines, unsorted and duplicate entries:
+    {
+      std::ofstream writer("sparse-test-io.mtx");
+      writer << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n\n4 4 5\n3 1 -2.5e-1\n1 1 4\n4 4 1E+1\n 2 2   3.0\n3 1 7";
+    }
+    unsigned int symmetric_rows[] = { 0, 2, 3, 4, 5 };
+    unsigned int symmetric_cols[] = { 0, 2, 1, 0, 3 };
+    NumericT     symmetric_values[] = { 4, 7, 3, 7, 10 };
+    if (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") == 0
+        || rows != 4 || cols != 4 || elements.size() != 5
+        || !std::equal(row_buffer.begin(), row_buffer.end(), symmetric_rows)
+        || !std::equal(col_buffer.begin(), col_buffer.end(), symmetric_cols)
+        || !std::equal(elements.begin(), elements.end(), symmetric_values))
+    {
+      std::cout << "# Error at operation: reading symmetric MatrixMarket file" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // pattern header and empty rows:
+    {
+      std::ofstream writer("sparse-test-io.mtx");
+      writer << "%%MatrixMarket matrix coordinate pattern general\n3 5 3\n1 5\n3 2\n1 1\n";
+    }
+    unsigned int pattern_rows[] = { 0, 2, 2, 3 };
+    unsigned int pattern_cols[] = { 0, 4, 1 };
+    if (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") == 0
+        || rows != 3 || cols != 5 || elements.size() != 3
+        || !std::equal(row_buffer.begin(), row_buffer.end(), pattern_rows)
+        || !std::equal(col_buffer.begin(), col_buffer.end(), pattern_cols)
+        || std::count(elements.begin(), elements.end(), NumericT(1)) != 3)
+    {
+      std::cout << "# Error at operation: reading pattern MatrixMarket file" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // long unsorted rows with duplicates, the last duplicate in the file is kept:
+    {
+      std::ofstream writer("sparse-test-io.mtx");
+      writer << "%%MatrixMarket matrix coordinate real general\n2 100 300\n";
+      for (std::size_t k = 0; k < 100; ++k)
+        writer << "2 " << (k * 37) % 100 + 1 << " -1\n" << "1 " << 100 - k << " 1\n";
+      for (std::size_t k = 0; k < 100; ++k)
+        writer << "2 " << (k * 37) % 100 + 1 << " " << (k * 37) % 100 << ".5\n";
+    }
+    bool long_rows_ok = (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") != 0
+                         && rows == 2 && cols == 100 && elements.size() == 200 && row_buffer[1] == 100);
+    for (std::size_t i = 0; long_rows_ok && i < 200; ++i)
+      long_rows_ok = (col_buffer[i] == i % 100)
+                  && (i < 100 ? elements[i] == NumericT(1) : elements[i] == NumericT(0.5) + NumericT(i - 100));
+    if (!long_rows_ok)
+    {
+      std::cout << "# Error at operation: reading MatrixMarket file with long unsorted rows" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // indices out of bounds are rejected:
+    {
+      std::ofstream writer("sparse-test-io.mtx");
+      writer << "%%MatrixMarket matrix coordinate real general\n3 3 1\n4 1 1.0\n";
+    }
+    std::cout << "Expecting an error message for an index out of bounds:" << std::endl;
+    if (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") != 0)
+    {
+      std::cout << "# Error at operation: reading MatrixMarket file with index out of bounds" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.mtx");
+
+    // banner tokens are case-insensitive:
+    {
+      std::ofstream writer("sparse-test-io.mtx");
+      writer << "%%MatrixMarket MATRIX Coordinate Real Skew-Symmetric\n2 2 1\n2 1 3.0\n";
+    }
+    if (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") == 0
+        || elements.size() != 2 || elements[0] < NumericT(-3) || elements[0] > NumericT(-3))
+    {
+      std::cout << "# Error at operation: reading MatrixMarket file with upper case banner" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.mtx");
+
+    // a file which cannot be opened is reported as a failure:
+    std::cout << "Expecting an error message for a missing file:" << std::endl;
+    if (viennacl::io::read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, "sparse-test-io.mtx") != 0)
+    {
+      std::cout << "# Error at operation: reading missing MatrixMarket file" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+// binary file format for sparse and dense matrices:
+template<typename NumericT, typename VCL_MatrixT, typename Epsilon>
+int binary_format_product_test(ublas::compressed_matrix<NumericT> & ublas_matrix, viennacl::context ctx, Epsilon epsilon, std::string const & name)
+{
+    ublas::vector<NumericT> rhs(ublas_matrix.size2());
+    for (std::size_t i=0; i<rhs.size(); ++i)
+      rhs[i] = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::vector<NumericT> vcl_rhs(rhs.size(), ctx);
+    viennacl::vector<NumericT> vcl_result(result.size(), ctx);
+    viennacl::copy(rhs, vcl_rhs);
+
+    VCL_MatrixT vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    if (!viennacl::io::write_binary_file(vcl_matrix, std::string("sparse-test-io.bin")))
+    {
+      std::cout << "# Error at operation: writing binary file from " << name << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    VCL_MatrixT vcl_matrix2(ctx);
+    if (!viennacl::io::read_binary_file(vcl_matrix2, "sparse-test-io.bin"))
+    {
+      std::cout << "# Error at operation: reading binary file into " << name << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.bin");
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix2, vcl_rhs);
+    if (vcl_matrix2.size1() != ublas_matrix.size1() || vcl_matrix2.size2() != ublas_matrix.size2() || std::fabs(diff(result, vcl_result)) > epsilon)
+    {
+      std::cout << "# Error at operation: matrix-vector product with " << name << " read from binary file" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/** @brief Writes a sliced_ell_matrix with rows sorted within windows (sigma > 1, only set up in main memory) and reads it into the provided memory context. */
+template<typename NumericT, typename Epsilon>
+int binary_format_sliced_ell_sigma_test(viennacl::context ctx, Epsilon epsilon)
+{
+    // rows of strongly varying length (including empty rows), so that sorting permutes them:
+    std::size_t rows = 1000;
+    std::size_t cols = 300;
+    ublas::compressed_matrix<NumericT> ublas_matrix(rows, cols);
+    for (std::size_t i=0; i<rows; ++i)
+      for (std::size_t k=0; k<(i * 37) % 23; ++k)
+        ublas_matrix(i, (i * 13 + k * 7) % cols) = NumericT(1) + random<NumericT>();
+
+    ublas::vector<NumericT> rhs(cols);
+    for (std::size_t i=0; i<rhs.size(); ++i)
+      rhs[i] = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::sliced_ell_matrix<NumericT> vcl_matrix(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    if (vcl_matrix.sigma() <= 1 || !viennacl::io::write_binary_file(vcl_matrix, std::string("sparse-test-io.bin")))
+    {
+      std::cout << "# Error at operation: writing binary file from sliced_ell_matrix with sorted rows" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    viennacl::sliced_ell_matrix<NumericT> vcl_matrix2(ctx);
+    if (!viennacl::io::read_binary_file(vcl_matrix2, "sparse-test-io.bin"))
+    {
+      std::cout << "# Error at operation: reading binary file into sliced_ell_matrix with sorted rows" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.bin");
+
+    viennacl::vector<NumericT> vcl_rhs(rhs.size(), ctx);
+    viennacl::vector<NumericT> vcl_result(result.size(), ctx);
+    viennacl::copy(rhs, vcl_rhs);
+    vcl_result = viennacl::linalg::prod(vcl_matrix2, vcl_rhs);
+    if (vcl_matrix2.size1() != rows || vcl_matrix2.size2() != cols
+        || (ctx.memory_type() != viennacl::MAIN_MEMORY && vcl_matrix2.sigma() != 1)
+        || std::fabs(diff(result, vcl_result)) > epsilon)
+    {
+      std::cout << "# Error at operation: matrix-vector product with sliced_ell_matrix with sorted rows read from binary file" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+template<typename NumericT, typename Epsilon>
+int binary_format_test(ublas::compressed_matrix<NumericT> & ublas_matrix, Epsilon epsilon)
+{
+    // arrays are used from the memory mapping in main memory, and copied into buffers otherwise:
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::context default_ctx;
+
+    int retval = EXIT_SUCCESS;
+    if (   binary_format_product_test<NumericT, viennacl::compressed_matrix<NumericT> >(ublas_matrix, host_ctx,    epsilon, "compressed_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::compressed_matrix<NumericT> >(ublas_matrix, default_ctx, epsilon, "compressed_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::ell_matrix<NumericT> >(ublas_matrix, host_ctx,    epsilon, "ell_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::ell_matrix<NumericT> >(ublas_matrix, default_ctx, epsilon, "ell_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::sliced_ell_matrix<NumericT> >(ublas_matrix, host_ctx,    epsilon, "sliced_ell_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::sliced_ell_matrix<NumericT> >(ublas_matrix, default_ctx, epsilon, "sliced_ell_matrix") != EXIT_SUCCESS
+        || binary_format_sliced_ell_sigma_test<NumericT>(host_ctx,    epsilon) != EXIT_SUCCESS
+        || binary_format_sliced_ell_sigma_test<NumericT>(default_ctx, epsilon) != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::hyb_matrix<NumericT> >(ublas_matrix, host_ctx,    epsilon, "hyb_matrix") != EXIT_SUCCESS
+        || binary_format_product_test<NumericT, viennacl::hyb_matrix<NumericT> >(ublas_matrix, default_ctx, epsilon, "hyb_matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // dense matrix including padding:
+    ublas::matrix<NumericT> ublas_dense(13, 7);
+    for (std::size_t i=0; i<ublas_dense.size1(); ++i)
+      for (std::size_t j=0; j<ublas_dense.size2(); ++j)
+        ublas_dense(i, j) = random<NumericT>();
+
+    viennacl::matrix<NumericT, viennacl::column_major> vcl_dense(ublas_dense.size1(), ublas_dense.size2());
+    viennacl::copy(ublas_dense, vcl_dense);
+    viennacl::io::write_binary_file(vcl_dense, "sparse-test-io.bin");
+
+    viennacl::matrix<NumericT, viennacl::column_major> vcl_dense2(1, 1, host_ctx);
+    ublas::matrix<NumericT> ublas_dense2(ublas_dense.size1(), ublas_dense.size2());
+    if (!viennacl::io::read_binary_file(vcl_dense2, "sparse-test-io.bin")
+        || vcl_dense2.size1() != ublas_dense.size1() || vcl_dense2.size2() != ublas_dense.size2()
+        || vcl_dense2.internal_size1() != vcl_dense.internal_size1() || vcl_dense2.internal_size2() != vcl_dense.internal_size2())
+    {
+      std::cout << "# Error at operation: reading binary file into dense matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    else
+    {
+      vcl_dense2 *= NumericT(2);  // modifies the private copy of the mapped pages only
+      viennacl::copy(vcl_dense2, ublas_dense2);
+      if (ublas::norm_inf(ublas_dense2 - NumericT(2) * ublas_dense) > 0)
+      {
+        std::cout << "# Error at operation: scaling of dense matrix read from binary file" << std::endl;
+        retval = EXIT_FAILURE;
+      }
+    }
+
+    // the file is not affected by changes to the matrix, and a different storage layout is rejected:
+    viennacl::matrix<NumericT, viennacl::column_major> vcl_dense3;
+    viennacl::matrix<NumericT, viennacl::row_major>    vcl_dense4;
+    std::cout << "Expecting an error message for a different storage layout:" << std::endl;
+    if (!viennacl::io::read_binary_file(vcl_dense3, "sparse-test-io.bin") || viennacl::io::read_binary_file(vcl_dense4, "sparse-test-io.bin"))
+    {
+      std::cout << "# Error at operation: reading binary file into dense matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    viennacl::copy(vcl_dense3, ublas_dense2);
+    if (ublas::norm_inf(ublas_dense2 - ublas_dense) > 0)
+    {
+      std::cout << "# Error at operation: modification of dense matrix read from binary file" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // object types are checked:
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    std::cout << "Expecting an error message for a different type of object:" << std::endl;
+    if (viennacl::io::read_binary_file(vcl_matrix, "sparse-test-io.bin"))
+    {
+      std::cout << "# Error at operation: reading binary file holding a different object" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+    std::remove("sparse-test-io.bin");
+
+    return retval;
+}
+
+// rectangular matrix for products with the transposed matrix:
+template<typename NumericT, typename Epsilon>
+int transposed_matrix_vector_product_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t rows = 700;
+    std::size_t cols = 300;
+    ublas::compressed_matrix<NumericT> ublas_matrix(rows, cols);
+    ublas::compressed_matrix<NumericT> ublas_matrix_trans(cols, rows);
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+      for (std::size_t j = (7 * i) % 11; j < cols; j += 1 + (i % 23))
+      {
+        NumericT value = NumericT(1) + random<NumericT>();
+        ublas_matrix(i, j) = value;
+        ublas_matrix_trans(j, i) = value;
+      }
+    }
+    ublas::vector<NumericT> rhs(rows);
+    for (std::size_t i = 0; i < rows; ++i)
+      rhs(i) = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix_trans, rhs);
+
+    viennacl::compressed_matrix<NumericT> vcl_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::vector<NumericT> vcl_rhs(rows);
+    viennacl::vector<NumericT> vcl_result(cols);
+    viennacl::copy(rhs, vcl_rhs);
+
+    vcl_result = viennacl::linalg::prod(trans(vcl_matrix), vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with transposed rectangular compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // strided vectors and accumulation:
+    viennacl::vector<NumericT> vcl_rhs_strided(2 * rows);
+    viennacl::vector<NumericT> vcl_result_strided(3 * cols);
+    viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, rows)) = vcl_rhs;
+    viennacl::project(vcl_result_strided, viennacl::slice(2, 3, cols)) = viennacl::linalg::prod(trans(vcl_matrix), viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, rows)));
+    vcl_result = viennacl::project(vcl_result_strided, viennacl::slice(2, 3, cols));
+    vcl_result += viennacl::linalg::prod(trans(vcl_matrix), vcl_rhs);
+    result *= NumericT(2);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with transposed compressed_matrix and strided vectors" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
+
+// symmetric positive definite matrix from a five-point stencil with random weights:
+template<typename NumericT, typename Epsilon>
+int symmetric_compressed_matrix_test(Epsilon epsilon)
+{
+    int retval = EXIT_SUCCESS;
+
+    std::size_t points_per_dim = 50;
+    std::size_t N = points_per_dim * points_per_dim;
+    ublas::compressed_matrix<NumericT> ublas_matrix(N, N);
+    for (std::size_t i = 0; i < N; ++i)   // diagonal shift keeps the entries of the product away from zero
+      ublas_matrix(i, i) = NumericT(10);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      std::size_t neighbors[2] = { i + 1, i + points_per_dim };
+      bool has_neighbor[2] = { (i + 1) % points_per_dim != 0, i + points_per_dim < N };
+      for (std::size_t k = 0; k < 2; ++k)
+      {
+        if (!has_neighbor[k])
+          continue;
+        std::size_t j = neighbors[k];
+        NumericT weight = NumericT(1) + random<NumericT>();
+        ublas_matrix(i, j) = -weight;
+        ublas_matrix(j, i) = -weight;
+        ublas_matrix(i, i) += weight;
+        ublas_matrix(j, j) += weight;
+      }
+    }
+    ublas::vector<NumericT> rhs(N);
+    for (std::size_t i = 0; i < N; ++i)
+      rhs(i) = NumericT(1) + random<NumericT>();
+    ublas::vector<NumericT> result = ublas::prod(ublas_matrix, rhs);
+
+    viennacl::vector<NumericT> vcl_rhs(N);
+    viennacl::vector<NumericT> vcl_result(N);
+    viennacl::copy(rhs, vcl_rhs);
+
+    // copy from uBLAS and from compressed_matrix keeps only the upper triangle:
+    viennacl::symmetric_compressed_matrix<NumericT> vcl_matrix, vcl_matrix2;
+    viennacl::compressed_matrix<NumericT> vcl_compressed_matrix;
+    viennacl::copy(ublas_matrix, vcl_matrix);
+    viennacl::copy(ublas_matrix, vcl_compressed_matrix);
+    viennacl::copy(vcl_compressed_matrix, vcl_matrix2);
+    if ( vcl_matrix.nnz() != (ublas_matrix.nnz() + N) / 2 || vcl_matrix2.nnz() != vcl_matrix.nnz() )
+    {
+      std::cout << "# Error at operation: copy to symmetric_compressed_matrix" << std::endl;
+      std::cout << "  nonzeros: " << vcl_matrix.nnz() << " and " << vcl_matrix2.nnz() << " vs. " << ublas_matrix.nnz() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    vcl_result = viennacl::linalg::prod(vcl_matrix2, vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // strided vectors:
+    viennacl::vector<NumericT> vcl_rhs_strided(2 * N);
+    viennacl::vector<NumericT> vcl_result_strided(3 * N);
+    viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, N)) = vcl_rhs;
+    viennacl::project(vcl_result_strided, viennacl::slice(2, 3, N)) = viennacl::linalg::prod(vcl_matrix, viennacl::project(vcl_rhs_strided, viennacl::slice(1, 2, N)));
+    vcl_result = viennacl::project(vcl_result_strided, viennacl::slice(2, 3, N));
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix and strided vectors" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // the transposed product of the full matrix must agree:
+    vcl_result = viennacl::linalg::prod(trans(vcl_compressed_matrix), vcl_rhs);
+    if ( std::fabs(diff(result, vcl_result)) > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-vector product with transposed symmetric compressed_matrix" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // copy back to the host fills both triangles:
+    ublas::compressed_matrix<NumericT> ublas_matrix2(N, N);
+    viennacl::copy(vcl_matrix, ublas_matrix2);
+    if ( ublas_matrix2.nnz() != ublas_matrix.nnz() || std::fabs(diff(ublas_matrix2, vcl_compressed_matrix)) > epsilon )
+    {
+      std::cout << "# Error at operation: copy from symmetric_compressed_matrix to ublas::compressed_matrix" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // conjugate gradients:
+    NumericT solver_tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+    NumericT norm_rhs = viennacl::linalg::norm_2(vcl_rhs);
+    viennacl::linalg::cg_tag cg_tag(solver_tolerance, 1000);
+    viennacl::vector<NumericT> vcl_x = viennacl::linalg::solve(vcl_matrix, vcl_rhs, cg_tag);
+    vcl_result = viennacl::linalg::prod(vcl_compressed_matrix, vcl_x);
+    vcl_result -= vcl_rhs;
+    if ( viennacl::linalg::norm_2(vcl_result) > 10 * solver_tolerance * norm_rhs )
+    {
+      std::cout << "# Error at operation: CG solver with symmetric_compressed_matrix" << std::endl;
+      std::cout << "  residual: " << viennacl::linalg::norm_2(vcl_result) << ", iterations: " << cg_tag.iters() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    // clear:
+    vcl_matrix.clear();
+    vcl_result = viennacl::linalg::prod(vcl_matrix, vcl_rhs);
+    if ( viennacl::linalg::norm_2(vcl_result) > 0 )
+    {
+      std::cout << "# Error at operation: matrix-vector product with symmetric_compressed_matrix after clear()" << std::endl;
+      retval = EXIT_FAILURE;
+    }
+
+    return retval;
+}
 
 template< typename NumericT, typename VCL_MATRIX, typename Epsilon >
 int resize_test(Epsilon const& epsilon)
@@ -417,6 +1548,16 @@ int test(Epsilon const& epsilon)
   //unsigned int cg_mat_size = cg_mat.size();
   std::cout << "done reading matrix" << std::endl;
 
+  std::cout << "Testing parallel MatrixMarket reader and writer" << std::endl;
+  retval = matrix_market_test<NumericT>(ublas_matrix, epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing binary file format: sparse and dense matrices" << std::endl;
+  retval = binary_format_test<NumericT>(ublas_matrix, epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
 
   rhs.resize(ublas_matrix.size2());
   for (std::size_t i=0; i<rhs.size(); ++i)
@@ -477,6 +1618,21 @@ int test(Epsilon const& epsilon)
   if (retval != EXIT_SUCCESS)
     return retval;
 
+  std::cout << "Testing products: compressed_matrix, unbalanced rows" << std::endl;
+  retval = unbalanced_matrix_vector_product_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing sparse matrix-matrix products: compressed_matrix" << std::endl;
+  retval = sparse_matrix_product_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing conversions and format selection: all sparse matrix types" << std::endl;
+  retval = sparse_format_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
   //
   // Triangular solvers for A \ b:
   //
@@ -496,6 +1652,22 @@ int test(Epsilon const& epsilon)
   }
 
 
+  std::cout << "Testing products: transposed compressed_matrix" << std::endl;
+  result = ublas::prod(ublas_matrix_trans, rhs);
+  vcl_result = viennacl::linalg::prod(trans(vcl_compressed_matrix), vcl_rhs);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with transposed compressed_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  retval = transposed_matrix_vector_product_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+
   std::cout << "Testing unit upper triangular solve: compressed_matrix" << std::endl;
   result = rhs;
   viennacl::copy(result, vcl_result);
@@ -800,6 +1972,80 @@ int test(Epsilon const& epsilon)
     return retval;
 
 
+  std::cout << "Testing products: bsr_matrix" << std::endl;
+  viennacl::bsr_matrix<NumericT, 3> vcl_bsr_matrix;
+  viennacl::copy(ublas_matrix, vcl_bsr_matrix);
+  result     = viennacl::linalg::prod(ublas_matrix, rhs);
+  vcl_result.clear();
+  vcl_result = viennacl::linalg::prod(vcl_bsr_matrix, vcl_rhs);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with bsr_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing copies and solvers: bsr_matrix" << std::endl;
+  retval = bsr_matrix_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing incomplete LU factorizations by fixed-point sweeps" << std::endl;
+  retval = ilu0_sweeps_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing row-parallel ILUT setup" << std::endl;
+  retval = ilut_row_parallel_test<NumericT>(false);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = ilut_row_parallel_test<NumericT>(true);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+
+  std::cout << "Testing products: compact_compressed_matrix" << std::endl;
+  viennacl::compact_compressed_matrix<NumericT> vcl_compact_compressed_matrix;
+  viennacl::copy(ublas_matrix, vcl_compact_compressed_matrix);
+  vcl_result.clear();
+  vcl_result = viennacl::linalg::prod(vcl_compact_compressed_matrix, vcl_rhs);
+
+  if ( std::fabs(diff(result, vcl_result)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product with compact_compressed_matrix" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  std::cout << "Testing products: compact_compressed_matrix, strided vectors" << std::endl;
+  retval = strided_matrix_vector_product_test<NumericT, viennacl::compact_compressed_matrix<NumericT> >(epsilon, result, rhs, vcl_result, vcl_rhs);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  // values stored in single precision are accurate to about 1e-7 relative to the vector entries:
+  Epsilon compact_epsilon = (sizeof(NumericT) > 4) ? Epsilon(1e-5) : epsilon;
+
+  std::cout << "Testing copies: compact_compressed_matrix" << std::endl;
+  retval = compact_compressed_matrix_test<NumericT, NumericT, unsigned short>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = compact_compressed_matrix_test<NumericT, NumericT, unsigned int>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = compact_compressed_matrix_test<NumericT, float, unsigned short>(compact_epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+  retval = compact_compressed_matrix_test<NumericT, float, unsigned int>(compact_epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+  std::cout << "Testing products, copies, and CG: symmetric_compressed_matrix" << std::endl;
+  retval = symmetric_compressed_matrix_test<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return retval;
+
+
   // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
   NumericT alpha = static_cast<NumericT>(2.786);
@@ -850,6 +2096,26 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  vcl_result2.clear();
+  vcl_result2 = alpha * viennacl::linalg::prod(vcl_bsr_matrix, vcl_rhs) + beta * vcl_result;
+
+  if ( std::fabs(diff(result, vcl_result2)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product (bsr_matrix) with scaled additions" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  vcl_result2.clear();
+  vcl_result2 = alpha * viennacl::linalg::prod(vcl_compact_compressed_matrix, vcl_rhs) + beta * vcl_result;
+
+  if ( std::fabs(diff(result, vcl_result2)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-vector product (compact_compressed_matrix) with scaled additions" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(result, vcl_result2)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
   ////////////// Test of .clear() ////////////////
   ublas_matrix.clear();
 
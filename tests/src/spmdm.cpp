@@ -56,6 +56,7 @@
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/coordinate_matrix.hpp"
 #include "viennacl/ell_matrix.hpp"
+#include "viennacl/bsr_matrix.hpp"
 #include "viennacl/hyb_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"       //generic matrix-vector product
 #include "viennacl/linalg/norm_2.hpp"     //generic l2-norm for vectors
@@ -91,6 +92,65 @@ int check_matrices(const ublas::matrix< ScalarType >& ref_mat, const ublas::matr
   return EXIT_SUCCESS;
 }
 
+// blocks of vectors as used by block Krylov methods. 29 = 16 + 8 + 4 + 1 columns cover all register tile widths of the host implementation:
+template<typename NumericT, typename ResultLayoutT, typename FactorLayoutT>
+int multi_vector_test(ublas::compressed_matrix<NumericT> const & ublas_lhs,
+                      viennacl::compressed_matrix<NumericT> const & compressed_lhs,
+                      NumericT epsilon)
+{
+  int retVal = EXIT_SUCCESS;
+
+  std::size_t widths[] = {5, 29};
+  for (std::size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w)
+  {
+    std::size_t cols_rhs = widths[w];
+
+    ublas::matrix<NumericT> ublas_rhs1(ublas_lhs.size2(), cols_rhs);
+    for (unsigned int i = 0; i < ublas_rhs1.size1(); i++)
+      for (unsigned int j = 0; j < ublas_rhs1.size2(); j++)
+        ublas_rhs1(i,j) = NumericT(0.5) + NumericT(0.1) * random<NumericT>();
+    ublas::matrix<NumericT> ublas_rhs2 = ublas::trans(ublas_rhs1);
+    ublas::matrix<NumericT> ublas_result = ublas::zero_matrix<NumericT>(ublas_lhs.size1(), cols_rhs);
+    for (typename ublas::compressed_matrix<NumericT>::const_iterator1 row_it = ublas_lhs.begin1(); row_it != ublas_lhs.end1(); ++row_it)
+      for (typename ublas::compressed_matrix<NumericT>::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+        for (std::size_t j = 0; j < cols_rhs; ++j)
+          ublas_result(col_it.index1(), j) += *col_it * ublas_rhs1(col_it.index2(), j);
+
+    viennacl::matrix<NumericT, FactorLayoutT> rhs1(ublas_lhs.size2(), cols_rhs);
+    viennacl::matrix<NumericT, FactorLayoutT> rhs2(cols_rhs, ublas_lhs.size2());
+    viennacl::copy(ublas_rhs1, rhs1);
+    viennacl::copy(ublas_rhs2, rhs2);
+
+    viennacl::matrix<NumericT, ResultLayoutT> result(ublas_lhs.size1(), cols_rhs);
+    ublas::matrix<NumericT> temp(ublas_lhs.size1(), cols_rhs);
+
+    std::cout << "Testing compressed(CSR) lhs * dense rhs with " << cols_rhs << " columns" << std::endl;
+    result = viennacl::linalg::prod(compressed_lhs, rhs1);
+    viennacl::copy(result, temp);
+    retVal |= check_matrices(ublas_result, temp, epsilon);
+
+    std::cout << "Testing compressed(CSR) lhs * transposed dense rhs with " << cols_rhs << " columns" << std::endl;
+    result.clear();
+    result = viennacl::linalg::prod(compressed_lhs, viennacl::trans(rhs2));
+    viennacl::copy(result, temp);
+    retVal |= check_matrices(ublas_result, temp, epsilon);
+
+    // every other column of a wider matrix:
+    std::cout << "Testing compressed(CSR) lhs * strided dense rhs with " << cols_rhs << " columns" << std::endl;
+    viennacl::matrix<NumericT, FactorLayoutT> rhs_wide(ublas_lhs.size2(), 2 * cols_rhs);
+    viennacl::matrix<NumericT, ResultLayoutT> result_wide(ublas_lhs.size1(), 2 * cols_rhs);
+    viennacl::matrix_slice<viennacl::matrix<NumericT, FactorLayoutT> >  rhs_slice(rhs_wide, viennacl::slice(0, 1, ublas_lhs.size2()), viennacl::slice(1, 2, cols_rhs));
+    viennacl::matrix_slice<viennacl::matrix<NumericT, ResultLayoutT> > result_slice(result_wide, viennacl::slice(0, 1, ublas_lhs.size1()), viennacl::slice(0, 2, cols_rhs));
+    rhs_slice = rhs1;
+    result_slice = viennacl::linalg::prod(compressed_lhs, rhs_slice);
+    result = result_slice;
+    viennacl::copy(result, temp);
+    retVal |= check_matrices(ublas_result, temp, epsilon);
+  }
+
+  return retVal;
+}
+
 template<typename NumericT, typename ResultLayoutT, typename FactorLayoutT>
 int test(NumericT epsilon)
 {
@@ -114,6 +174,7 @@ int test(NumericT epsilon)
   viennacl::ell_matrix<NumericT>        ell_lhs;
   viennacl::coordinate_matrix<NumericT> coo_lhs;
   viennacl::hyb_matrix<NumericT>     hyb_lhs;
+  viennacl::bsr_matrix<NumericT, 3>  bsr_lhs;
 
   ublas::matrix<NumericT> ublas_result;
   viennacl::matrix<NumericT, ResultLayoutT> result;
@@ -122,6 +183,7 @@ int test(NumericT epsilon)
   viennacl::copy( ublas_lhs, ell_lhs);
   viennacl::copy( ublas_lhs, coo_lhs);
   viennacl::copy( ublas_lhs, hyb_lhs);
+  viennacl::copy( ublas_lhs, bsr_lhs);
 
   ublas::matrix<NumericT> ublas_rhs1(ublas_lhs.size2(), cols_rhs);
   viennacl::matrix<NumericT, FactorLayoutT> rhs1(ublas_lhs.size2(), cols_rhs);
@@ -181,6 +243,16 @@ int test(NumericT epsilon)
 
   /******************************************************************/
 
+  std::cout << "Testing compressed(BSR) lhs * dense rhs" << std::endl;
+  result.clear();
+  result = viennacl::linalg::prod( bsr_lhs, rhs1);
+
+  temp.clear();
+  viennacl::copy( result, temp);
+  retVal |= check_matrices(ublas_result, temp, epsilon);
+
+  /******************************************************************/
+
   /* gold result */
   ublas_result = ublas::prod( ublas_lhs, ublas::trans(ublas_rhs2));
 
@@ -221,6 +293,19 @@ int test(NumericT epsilon)
   viennacl::copy( result, temp);
   check_matrices(ublas_result, temp, epsilon);
 
+  /******************************************************************/
+
+  std::cout << "Testing compressed(BSR) lhs * transposed dense rhs" << std::endl;
+  result.clear();
+  result = viennacl::linalg::prod( bsr_lhs, viennacl::trans(rhs2));
+
+  temp.clear();
+  viennacl::copy( result, temp);
+  retVal |= check_matrices(ublas_result, temp, epsilon);
+
+  /******************************************************************/
+  retVal |= multi_vector_test<NumericT, ResultLayoutT, FactorLayoutT>(ublas_lhs, compressed_lhs, epsilon);
+
   /******************************************************************/
   if (retVal == EXIT_SUCCESS) {
     std::cout << "Tests passed successfully" << std::endl;
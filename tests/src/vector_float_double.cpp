@@ -26,6 +26,8 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 //
 // *** ViennaCL
@@ -2034,12 +2036,162 @@ int test(Epsilon const& epsilon,
 }
 
 
+/** @brief Tests the vectorized BLAS level 1 kernels of the host backend.
+*
+* Sizes are chosen such that entries remain after the last full SIMD vector, strides other than one run the plain loops,
+* and the l^2-norm is also computed for entries whose squares overflow or underflow.
+*/
+template< typename NumericT, typename Epsilon >
+int test_host_blas1(Epsilon const& epsilon)
+{
+  std::size_t sizes[] = {1, 2, 3, 5, 7, 9, 15, 17, 31, 33, 63, 65, 127, 129, 10007};
+  std::size_t strides[] = {1, 2, 3};
+  NumericT scalings[] = { NumericT(1),
+                          std::ldexp(NumericT(1), std::numeric_limits<NumericT>::max_exponent / 2 + 4),   // squares overflow
+                          std::ldexp(NumericT(1), std::numeric_limits<NumericT>::min_exponent / 2 - 4) }; // squares underflow
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  NumericT alpha = NumericT(3.1415);
+  NumericT beta  = NumericT(2.7182);
+
+  for (std::size_t i=0; i<sizeof(sizes) / sizeof(sizes[0]); ++i)
+    for (std::size_t j=0; j<sizeof(strides) / sizeof(strides[0]); ++j)
+    {
+      std::size_t size   = sizes[i];
+      std::size_t stride = strides[j];
+
+      // entries start at index 1, so the first entry of a unit-stride vector is not aligned:
+      std::vector<NumericT> std_full_vec(1 + size * stride);
+      std::vector<NumericT> std_full_vec2(1 + size * stride);
+      for (std::size_t k=0; k<std_full_vec.size(); ++k)
+      {
+        std_full_vec[k]  = (k % 2) ? NumericT(0.5) + random<NumericT>() : NumericT(-0.5) - random<NumericT>();
+        std_full_vec2[k] = NumericT(0.5) + random<NumericT>();
+      }
+      vector_proxy<NumericT> host_v1(&std_full_vec[0],  1, stride, size);
+      vector_proxy<NumericT> host_v2(&std_full_vec2[0], 1, stride, size);
+
+      viennacl::vector<NumericT> vcl_full_vec(std_full_vec.size(), host_ctx);
+      viennacl::vector<NumericT> vcl_full_vec2(std_full_vec2.size(), host_ctx);
+      viennacl::copy(std_full_vec, vcl_full_vec);
+      viennacl::copy(std_full_vec2, vcl_full_vec2);
+      viennacl::vector_slice< viennacl::vector<NumericT> > vcl_v1(vcl_full_vec,  viennacl::slice(1, stride, size));
+      viennacl::vector_slice< viennacl::vector<NumericT> > vcl_v2(vcl_full_vec2, viennacl::slice(1, stride, size));
+
+      NumericT cpu_result = 0;
+      NumericT gpu_result = 0;
+
+      // reductions:
+      for (std::size_t k=0; k<size; ++k)
+        cpu_result += host_v1[k] * host_v2[k];
+      gpu_result = viennacl::linalg::inner_prod(vcl_v1, vcl_v2);
+      if (check(cpu_result, gpu_result, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: inner_prod, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      cpu_result = 0;
+      for (std::size_t k=0; k<size; ++k)
+        cpu_result += std::fabs(host_v1[k]);
+      gpu_result = viennacl::linalg::norm_1(vcl_v1);
+      if (check(cpu_result, gpu_result, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: norm_1, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      cpu_result = 0;
+      for (std::size_t k=0; k<size; ++k)
+        cpu_result = std::max(cpu_result, std::fabs(host_v1[k]));
+      gpu_result = viennacl::linalg::norm_inf(vcl_v1);
+      if (check(cpu_result, gpu_result, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: norm_inf, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      for (std::size_t l=0; l<sizeof(scalings) / sizeof(scalings[0]); ++l)
+      {
+        // entries are scaled by a power of two, so the scaling is exact:
+        cpu_result = 0;
+        for (std::size_t k=0; k<size; ++k)
+          cpu_result += host_v1[k] * host_v1[k];
+        cpu_result = scalings[l] * std::sqrt(cpu_result);
+
+        viennacl::vector<NumericT> vcl_scaled(vcl_full_vec.size(), host_ctx);
+        vcl_scaled = scalings[l] * vcl_full_vec;
+        viennacl::vector_slice< viennacl::vector<NumericT> > vcl_scaled_slice(vcl_scaled, viennacl::slice(1, stride, size));
+        gpu_result = viennacl::linalg::norm_2(vcl_scaled_slice);
+        if (!(std::fabs(cpu_result - gpu_result) <= epsilon * cpu_result))  // check() does not catch infinite or NaN results
+        {
+          std::cout << "# Error at operation: norm_2, size " << size << ", stride " << stride << ", scaling " << scalings[l] << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      // vector updates:
+      for (std::size_t k=0; k<size; ++k)
+        host_v1[k] += alpha * host_v2[k];
+      vcl_v1 += alpha * vcl_v2;
+      if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: v1 += alpha * v2, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      for (std::size_t k=0; k<size; ++k)
+        host_v1[k] = host_v1[k] / alpha - beta * host_v2[k];
+      vcl_v1 = vcl_v1 / alpha - beta * vcl_v2;
+      if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: v1 = v1 / alpha - beta * v2, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      for (std::size_t k=0; k<size; ++k)
+        host_v1[k] *= beta;
+      vcl_v1 *= beta;
+      if (check(host_v1, vcl_v1, epsilon) != EXIT_SUCCESS)
+      {
+        std::cout << "# Error at operation: v1 *= beta, size " << size << ", stride " << stride << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // entries outside the slice must not be touched:
+      std::vector<NumericT> std_result(vcl_full_vec.size());
+      viennacl::copy(vcl_full_vec, std_result);
+      for (std::size_t k=0; k<std_result.size(); ++k)
+        if ((k == 0 || (k - 1) % stride != 0) && std_result[k] != std_full_vec[k])
+        {
+          std::cout << "# Error: entry " << k << " outside of the slice modified, size " << size << ", stride " << stride << std::endl;
+          return EXIT_FAILURE;
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
   int retval = EXIT_SUCCESS;
   std::size_t size = 24656;
 
+  std::cout << "Testing host BLAS level 1 kernels for remainders, strides and rescaled norms..." << std::endl;
+  for (int isa = viennacl::linalg::host_based::SIMD_ISA_SCALAR; isa <= viennacl::linalg::host_based::SIMD_ISA_AVX512; ++isa)
+  {
+    viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::simd_isa(isa));
+    retval = test_host_blas1<NumericT>(epsilon);
+    if (retval != EXIT_SUCCESS)
+    {
+      std::cout << "# Error with instruction set limit " << isa << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  viennacl::linalg::host_based::set_simd_isa_limit(viennacl::linalg::host_based::SIMD_ISA_AVX512);
+
   std::cout << "Running tests for vector of size " << size << std::endl;
 
   //
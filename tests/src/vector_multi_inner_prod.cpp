@@ -45,6 +45,7 @@
 #include "viennacl/linalg/norm_1.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/linalg/fused_vector_operations.hpp"
 
 #include "Random.hpp"
 
@@ -329,11 +330,92 @@ int test(Epsilon const& epsilon,
   }
 
 
+  std::cout << "Testing fused vector updates and reductions..." << std::endl;
+  NumericT alpha = NumericT(0.5);
+  NumericT beta  = NumericT(1.5);  // positive, so that no cancellation spoils the entry-wise relative error
+  ublas::vector<NumericT> ref_v3 = ublas_v3 + alpha * ublas_v1;  // the ublas vectors passed in may be identical, so work on copies
+  ublas::vector<NumericT> ref_v4 = beta * ublas_v2 + NumericT(2) * ublas_v4;
+  ref_result(0) = ublas::inner_prod(ref_v3, ref_v4);
+  ref_result(2) = ublas::norm_2(ref_v3);
+  ref_result(4) = ublas::norm_1(ref_v4);
+  ref_result(6) = ublas::norm_inf(ref_v3);
+
+  viennacl::linalg::fused_vector_operation<NumericT> fused_op;
+  fused_op.add_update(vcl_v3, alpha, vcl_v1)
+          .add_update(vcl_v4, beta,  vcl_v2, NumericT(2))
+          .add_inner_prod(vcl_v3, vcl_v4)
+          .add_norm_2(vcl_v3)
+          .add_norm_1(vcl_v4)
+          .add_norm_inf(vcl_v3);
+  viennacl::vector_slice<viennacl::vector<NumericT> > fused_result(result, viennacl::slice(0, 2, 4));
+  viennacl::linalg::fused_update_reduce(fused_op, fused_result);
+  if (check(ref_result, result, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << ref_result << std::endl;
+    std::cout << result << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (check(ref_v3, vcl_v3, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check(ref_v4, vcl_v4, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+
   // --------------------------------------------------------------------------
   return retval;
 }
 
 
+/** @brief Fused updates and reductions on vectors long enough to be split among several threads. Runs twice so that the second run reuses the scratch buffers of the first. */
+template< typename NumericT, typename Epsilon >
+int test_fused_long(Epsilon const& epsilon)
+{
+  std::size_t size = 20000;  // above the threshold for OpenMP in the host-based backend
+
+  std::cout << "Testing fused vector updates and reductions for vectors of size " << size << "..." << std::endl;
+
+  ublas::vector<NumericT> ublas_v1(size), ublas_v2(size);
+  for (std::size_t i=0; i<size; ++i)
+  {
+    ublas_v1[i] = NumericT(1.0) + random<NumericT>();
+    ublas_v2[i] = NumericT(1.0) + random<NumericT>();
+  }
+
+  viennacl::vector<NumericT> vcl_v1(size), vcl_v2(size);
+  viennacl::copy(ublas_v1, vcl_v1);
+  viennacl::copy(ublas_v2, vcl_v2);
+
+  NumericT alpha = NumericT(0.25);
+  for (std::size_t run = 0; run < 2; ++run)
+  {
+    ublas_v2 += alpha * ublas_v1;
+    ublas::vector<NumericT> ref_result(3);
+    ref_result(0) = ublas::inner_prod(ublas_v1, ublas_v2);
+    ref_result(1) = ublas::norm_1(ublas_v2);
+    ref_result(2) = ublas::norm_inf(ublas_v2);
+
+    viennacl::linalg::fused_vector_operation<NumericT> fused_op;
+    fused_op.add_update(vcl_v2, alpha, vcl_v1)
+            .add_inner_prod(vcl_v1, vcl_v2)
+            .add_norm_1(vcl_v2)
+            .add_norm_inf(vcl_v2);
+    viennacl::vector<NumericT> result(3);
+    viennacl::linalg::fused_update_reduce(fused_op, result);
+
+    if (check(ref_result, result, epsilon) != EXIT_SUCCESS)
+    {
+      std::cout << ref_result << std::endl;
+      std::cout << result << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (check(ublas_v2, vcl_v2, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
@@ -522,6 +604,10 @@ int test(Epsilon const& epsilon)
   if (retval != EXIT_SUCCESS)
     return EXIT_FAILURE;
 
+  retval = test_fused_long<NumericT>(epsilon);
+  if (retval != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
   return EXIT_SUCCESS;
 }
 
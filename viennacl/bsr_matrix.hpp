@@ -0,0 +1,502 @@
+#ifndef VIENNACL_BSR_MATRIX_HPP_
+#define VIENNACL_BSR_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/bsr_matrix.hpp
+    @brief Implementation of the bsr_matrix class for sparse matrices made of small dense blocks (block compressed sparse row format)
+*/
+
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/adapter.hpp"
+
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+/** @brief Sparse matrix class using the block compressed sparse row (BSR) format for storing the nonzeros.
+    *
+    * The matrix is partitioned into dense blocks of size BlockSize x BlockSize, and only the blocks with at least one nonzero are stored.
+    * Systems of partial differential equations with several unknowns per mesh node result in such matrices, e.g. with 3x3 blocks for linear elasticity in three dimensions.
+    * Only one column index is stored per block rather than per entry, and the products with the blocks can be carried out with the entries of the vector kept in registers.
+    * For a matrix with 2x2 blocks
+    *
+    *   (1 2 0 0)
+    *   (3 4 0 0)
+    *   (0 5 6 7)
+    *   (0 0 8 9)
+    *
+    * the block row array is (0 1 3), the block column indices are (0; 0 1), and the entries of the blocks are stored row by row as
+    *   (1 2 3 4; 0 5 0 0; 6 7 8 9)
+    *
+    * The number of rows and columns of the matrix need to be multiples of BlockSize.
+    *
+    * @tparam NumericT    The floating point type (float or double)
+    * @tparam BlockSize   The number of rows and columns of each block
+    */
+template<typename NumericT, unsigned int BlockSize /* see forwards.h for default argument */>
+class bsr_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>   value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  bsr_matrix() : rows_(0), cols_(0), nonzero_blocks_(0) {}
+
+  explicit bsr_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzero_blocks_(0)
+  {
+    init_handles(ctx);
+  }
+
+  /** @brief Construction of a BSR matrix with the supplied number of rows and columns, which need to be multiples of the block size. All entries are zero. */
+  explicit bsr_matrix(vcl_size_t rows, vcl_size_t cols, viennacl::context ctx = viennacl::context()) : rows_(rows), cols_(cols), nonzero_blocks_(0)
+  {
+    assert( (rows % BlockSize == 0) && (cols % BlockSize == 0) && bool("Error in bsr_matrix: Number of rows and columns must be multiples of the block size!"));
+    init_handles(ctx);
+    clear();
+  }
+
+  /** @brief Sets the block row array, the block column indices, and the entries of the blocks.
+  *
+  * @param row_jumper       Array of size rows/BlockSize + 1 with the offsets of the block rows in col_buffer
+  * @param col_buffer       Array of size nonzero_blocks with the block column index of each block
+  * @param elements         Array of size nonzero_blocks * BlockSize * BlockSize with the entries of each block, stored row by row
+  * @param rows             Number of rows of the matrix, must be a multiple of BlockSize
+  * @param cols             Number of columns of the matrix, must be a multiple of BlockSize
+  * @param nonzero_blocks   Number of blocks stored
+  */
+  void set(const void * row_jumper,
+           const void * col_buffer,
+           const NumericT * elements,
+           vcl_size_t rows,
+           vcl_size_t cols,
+           vcl_size_t nonzero_blocks)
+  {
+    assert( (rows > 0) && (cols > 0) && bool("Error in bsr_matrix::set(): Number of rows and columns must be larger than zero!"));
+    assert( (rows % BlockSize == 0) && (cols % BlockSize == 0) && bool("Error in bsr_matrix::set(): Number of rows and columns must be multiples of the block size!"));
+    assert( (nonzero_blocks > 0) && bool("Error in bsr_matrix::set(): Number of nonzero blocks must be larger than zero!"));
+
+    viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(row_buffer_).element_size() * (rows / BlockSize + 1), viennacl::traits::context(row_buffer_), row_jumper);
+    viennacl::backend::memory_create(col_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(col_buffer_).element_size() * nonzero_blocks,       viennacl::traits::context(col_buffer_), col_buffer);
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT) * nonzero_blocks * BlockSize * BlockSize,                                                  viennacl::traits::context(elements_),   elements);
+
+    rows_ = rows;
+    cols_ = cols;
+    nonzero_blocks_ = nonzero_blocks;
+  }
+
+  /** @brief Resets all entries in the matrix back to zero without changing the matrix size. Resets the sparsity pattern. */
+  void clear()
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> host_row_buffer(row_buffer_, block_rows() + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> host_col_buffer(col_buffer_, 1);
+    std::vector<NumericT> host_elements(BlockSize * BlockSize);
+
+    viennacl::backend::memory_create(row_buffer_, host_row_buffer.element_size() * (block_rows() + 1), viennacl::traits::context(row_buffer_), host_row_buffer.get());
+    viennacl::backend::memory_create(col_buffer_, host_col_buffer.element_size() * 1,                  viennacl::traits::context(col_buffer_), host_col_buffer.get());
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT) * host_elements.size(),             viennacl::traits::context(elements_),   &(host_elements[0]));
+
+    nonzero_blocks_ = 0;
+  }
+
+  /** @brief Returns the number of rows and columns of each block */
+  static vcl_size_t block_size() { return BlockSize; }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return rows_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return cols_; }
+
+  /** @brief Returns the number of block rows */
+  vcl_size_t block_rows() const { return rows_ / BlockSize; }
+  /** @brief Returns the number of block columns */
+  vcl_size_t block_cols() const { return cols_ / BlockSize; }
+
+  /** @brief Returns the number of blocks stored */
+  vcl_size_t nonzero_blocks() const { return nonzero_blocks_; }
+  /** @brief Returns the number of entries stored, including the zeros within the blocks */
+  vcl_size_t nnz() const { return nonzero_blocks_ * BlockSize * BlockSize; }
+
+  /** @brief Returns the OpenCL handle to the block row index array */
+  const handle_type & handle1() const { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the block column index array */
+  const handle_type & handle2() const { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the entries of the blocks */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Returns the OpenCL handle to the block row index array */
+  handle_type & handle1() { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the block column index array */
+  handle_type & handle2() { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the entries of the blocks */
+  handle_type & handle() { return elements_; }
+
+  /** @brief Switches the memory context of the matrix. */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up in main memory, OpenCL memory, or CUDA memory. */
+  viennacl::memory_types memory_context() const
+  {
+    return row_buffer_.get_active_handle_id();
+  }
+
+private:
+  void init_handles(viennacl::context ctx)
+  {
+    row_buffer_.switch_active_handle_id(ctx.memory_type());
+    col_buffer_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      row_buffer_.opencl_handle().context(ctx.opencl_context());
+      col_buffer_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+  }
+
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t nonzero_blocks_;
+
+  handle_type row_buffer_;
+  handle_type col_buffer_;
+  handle_type elements_;
+};
+
+
+//
+// host to device:
+//
+
+/** @brief Copies a sparse matrix from the host to a bsr_matrix. All blocks holding at least one entry of the host matrix are stored.
+  *
+  * There are some type requirements on the CPUMatrixT type (fulfilled by e.g. boost::numeric::ublas):
+  * - .size1() returns the number of rows
+  * - .size2() returns the number of columns
+  * - const_iterator1    is a type definition for an iterator along increasing row indices
+  * - const_iterator2    is a type definition for an iterator along increasing columns indices
+  * - The const_iterator1 type provides an iterator of type const_iterator2 via members .begin() and .end() that iterates along column indices in the current row.
+  * - The types const_iterator1 and const_iterator2 provide members functions .index1() and .index2() that return the current row and column indices respectively.
+  * - Dereferenciation of an object of type const_iterator2 returns the entry.
+  *
+  * @param cpu_matrix   A sparse matrix on the host. The number of rows and columns need to be multiples of the block size.
+  * @param gpu_matrix   A bsr_matrix from ViennaCL
+  */
+template<typename CPUMatrixT, typename NumericT, unsigned int BlockSize>
+void copy(const CPUMatrixT & cpu_matrix, bsr_matrix<NumericT, BlockSize> & gpu_matrix)
+{
+  assert( (gpu_matrix.size1() == 0 || viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+  assert( (gpu_matrix.size2() == 0 || viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
+  assert( (viennacl::traits::size1(cpu_matrix) % BlockSize == 0) && (viennacl::traits::size2(cpu_matrix) % BlockSize == 0) && bool("Number of rows and columns must be multiples of the block size") );
+
+  if (cpu_matrix.size1() > 0 && cpu_matrix.size2() > 0)
+  {
+    vcl_size_t block_rows = cpu_matrix.size1() / BlockSize;
+
+    // determine the block columns of each block row:
+    std::vector<std::vector<unsigned int> > block_columns(block_rows);
+    for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+    {
+      for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      {
+        std::vector<unsigned int> & columns = block_columns[col_it.index1() / BlockSize];
+        unsigned int block_col = static_cast<unsigned int>(col_it.index2() / BlockSize);
+        if (columns.empty() || columns.back() != block_col)
+          columns.push_back(block_col);
+      }
+    }
+
+    vcl_size_t nonzero_blocks = 0;
+    for (vcl_size_t i = 0; i < block_rows; ++i)
+    {
+      std::sort(block_columns[i].begin(), block_columns[i].end());
+      block_columns[i].erase(std::unique(block_columns[i].begin(), block_columns[i].end()), block_columns[i].end());
+      nonzero_blocks += block_columns[i].size();
+    }
+
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), block_rows + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), std::max<vcl_size_t>(nonzero_blocks, 1));
+    std::vector<NumericT> elements(std::max<vcl_size_t>(nonzero_blocks, 1) * BlockSize * BlockSize);
+
+    std::vector<vcl_size_t> row_start(block_rows + 1);
+    for (vcl_size_t i = 0; i < block_rows; ++i)
+    {
+      row_start[i + 1] = row_start[i] + block_columns[i].size();
+      row_buffer.set(i, row_start[i]);
+      for (vcl_size_t k = 0; k < block_columns[i].size(); ++k)
+        col_buffer.set(row_start[i] + k, block_columns[i][k]);
+    }
+    row_buffer.set(block_rows, nonzero_blocks);
+
+    // write the entries to the blocks:
+    for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+    {
+      for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      {
+        vcl_size_t block_row = col_it.index1() / BlockSize;
+        std::vector<unsigned int> const & columns = block_columns[block_row];
+        vcl_size_t block_index = row_start[block_row] + static_cast<vcl_size_t>(std::lower_bound(columns.begin(), columns.end(), static_cast<unsigned int>(col_it.index2() / BlockSize)) - columns.begin());
+
+        elements[(block_index * BlockSize + col_it.index1() % BlockSize) * BlockSize + col_it.index2() % BlockSize] = *col_it;
+      }
+    }
+
+    gpu_matrix.set(row_buffer.get(),
+                   col_buffer.get(),
+                   &elements[0],
+                   cpu_matrix.size1(),
+                   cpu_matrix.size2(),
+                   std::max<vcl_size_t>(nonzero_blocks, 1));
+    if (nonzero_blocks == 0)
+      gpu_matrix.clear();
+  }
+}
+
+
+/** @brief Copies a sparse matrix from the host to the compute device. The host type is the std::vector< std::map < > > format .
+  *
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  * @param gpu_matrix   The sparse bsr_matrix from ViennaCL
+  */
+template<typename IndexT, typename NumericT, unsigned int BlockSize>
+void copy(std::vector< std::map<IndexT, NumericT> > const & cpu_matrix,
+          bsr_matrix<NumericT, BlockSize> & gpu_matrix)
+{
+  vcl_size_t max_col = 0;
+  for (vcl_size_t i=0; i<cpu_matrix.size(); ++i)
+  {
+    if (cpu_matrix[i].size() > 0)
+      max_col = std::max<vcl_size_t>(max_col, (cpu_matrix[i].rbegin())->first);
+  }
+  vcl_size_t cols = std::max<vcl_size_t>(gpu_matrix.size2(), viennacl::tools::align_to_multiple<vcl_size_t>(max_col + 1, BlockSize));
+
+  tools::const_sparse_matrix_adapter<NumericT, IndexT> temp(cpu_matrix, cpu_matrix.size(), cols);
+  viennacl::copy(temp, gpu_matrix);
+}
+
+
+/** @brief Copies a compressed_matrix to a bsr_matrix in the same memory domain. The CSR arrays are passed through main memory.
+  *
+  * @param csr_matrix   The compressed_matrix. The number of rows and columns need to be multiples of the block size.
+  * @param gpu_matrix   The sparse bsr_matrix from ViennaCL
+  */
+template<typename NumericT, unsigned int AlignmentV, unsigned int BlockSize>
+void copy(compressed_matrix<NumericT, AlignmentV> const & csr_matrix,
+          bsr_matrix<NumericT, BlockSize> & gpu_matrix)
+{
+  if (csr_matrix.size1() > 0 && csr_matrix.size2() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(csr_matrix.handle1(), csr_matrix.size1() + 1);
+    viennacl::backend::memory_read(csr_matrix.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+
+    vcl_size_t nonzeros = row_buffer[csr_matrix.size1()];
+    std::vector<unsigned int> host_row_buffer(csr_matrix.size1() + 1);
+    std::vector<unsigned int> host_col_buffer(std::max<vcl_size_t>(nonzeros, 1));
+    std::vector<NumericT>     host_elements(std::max<vcl_size_t>(nonzeros, 1));
+    for (vcl_size_t i = 0; i <= csr_matrix.size1(); ++i)
+      host_row_buffer[i] = static_cast<unsigned int>(row_buffer[i]);
+
+    if (nonzeros > 0)
+    {
+      viennacl::backend::typesafe_host_array<unsigned int> col_buffer(csr_matrix.handle2(), nonzeros);
+      viennacl::backend::memory_read(csr_matrix.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+      viennacl::backend::memory_read(csr_matrix.handle(),  0, sizeof(NumericT) * nonzeros, &(host_elements[0]));
+      for (vcl_size_t k = 0; k < nonzeros; ++k)
+        host_col_buffer[k] = static_cast<unsigned int>(col_buffer[k]);
+    }
+
+    tools::const_csr_matrix_adapter<NumericT> temp(&(host_row_buffer[0]), &(host_col_buffer[0]), &(host_elements[0]), csr_matrix.size1(), csr_matrix.size2());
+    viennacl::copy(temp, gpu_matrix);
+  }
+}
+
+
+//
+// device to host:
+//
+
+/** @brief Copies a bsr_matrix to a sparse matrix on the host. Zeros within the blocks are skipped.
+  *
+  * @param gpu_matrix   The sparse bsr_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host of matching size, which needs to provide write access via operator()
+  */
+template<typename CPUMatrixT, typename NumericT, unsigned int BlockSize>
+void copy(const bsr_matrix<NumericT, BlockSize> & gpu_matrix, CPUMatrixT & cpu_matrix)
+{
+  assert( (viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+  assert( (viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
+
+  if (gpu_matrix.size1() > 0 && gpu_matrix.size2() > 0 && gpu_matrix.nonzero_blocks() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), gpu_matrix.block_rows() + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), gpu_matrix.nonzero_blocks());
+    std::vector<NumericT> elements(gpu_matrix.nnz());
+
+    viennacl::backend::memory_read(gpu_matrix.handle1(), 0, row_buffer.raw_size(),               row_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle2(), 0, col_buffer.raw_size(),               col_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle(),  0, sizeof(NumericT) * elements.size(), &(elements[0]));
+
+    for (vcl_size_t block_row = 0; block_row < gpu_matrix.block_rows(); ++block_row)
+    {
+      for (vcl_size_t k = row_buffer[block_row]; k < row_buffer[block_row + 1]; ++k)
+      {
+        vcl_size_t block_col = col_buffer[k];
+        for (vcl_size_t i = 0; i < BlockSize; ++i)
+        {
+          for (vcl_size_t j = 0; j < BlockSize; ++j)
+          {
+            NumericT val = elements[(k * BlockSize + i) * BlockSize + j];
+            if (val < 0 || val > 0) // val != 0 without compiler warnings
+              cpu_matrix(block_row * BlockSize + i, block_col * BlockSize + j) = val;
+          }
+        }
+      }
+    }
+  }
+}
+
+
+/** @brief Copies a sparse matrix from the compute device to the host. The host type is the std::vector< std::map < > > format .
+  *
+  * @param gpu_matrix   The sparse bsr_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  */
+template<typename NumericT, unsigned int BlockSize, typename IndexT>
+void copy(const bsr_matrix<NumericT, BlockSize> & gpu_matrix,
+          std::vector< std::map<IndexT, NumericT> > & cpu_matrix)
+{
+  if (cpu_matrix.size() == 0)
+    cpu_matrix.resize(gpu_matrix.size1());
+
+  assert( (cpu_matrix.size() == gpu_matrix.size1()) && bool("Size mismatch") );
+
+  tools::sparse_matrix_adapter<NumericT, IndexT> temp(cpu_matrix, gpu_matrix.size1(), gpu_matrix.size2());
+  viennacl::copy(gpu_matrix, temp);
+}
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+    }
+  };
+
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs += temp;
+    }
+  };
+
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs -= temp;
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs += temp_result;
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const bsr_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs -= temp_result;
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
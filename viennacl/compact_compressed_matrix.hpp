@@ -0,0 +1,522 @@
+#ifndef VIENNACL_COMPACT_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_COMPACT_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/compact_compressed_matrix.hpp
+    @brief Implementation of the compact_compressed_matrix class, a CSR format with delta-encoded column indices and optionally reduced precision of the stored values
+*/
+
+#include <vector>
+#include <map>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/adapter.hpp"
+
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+/** @brief Sparse matrix class using a compressed sparse row (CSR) format with narrow column indices and values, reducing the number of bytes loaded per nonzero in sparse matrix-vector products.
+    *
+    * Each row stores the column index of its first nonzero (row base). All further column indices of the row are stored as the difference to the column index of the previous nonzero,
+    * so that the column indices fit into 16 bits for IndexT = unsigned short as long as the nonzeros of a row are not too far apart.
+    * Whenever the distance of two consecutive nonzeros exceeds the largest value of IndexT, explicit zeros are inserted to bridge the gap. These are included in nnz().
+    * For the matrix
+    *
+    *   (1 0 2 0)
+    *   (0 3 0 4)
+    *   (5 0 0 6)
+    *
+    * the row array is (0 2 4 6), the row bases are (0 1 0), the column offsets are (0 2; 0 2; 0 3), and the values are (1 2; 3 4; 5 6).
+    *
+    * The values are stored as ValueT and converted to NumericT for the multiplication, hence all products are accumulated in the precision of the vectors.
+    * With NumericT = double and ValueT = float, the matrix takes half of the memory of a compressed_matrix<double>, while results are accumulated in double precision.
+    *
+    * @tparam NumericT    The floating point type of the vectors and of the accumulation (float or double)
+    * @tparam ValueT      The floating point type used for storing the nonzeros (float or double)
+    * @tparam IndexT      The type used for storing the column offsets (unsigned short or unsigned int)
+    */
+template<class NumericT, class ValueT /* see forwards.h for default argument */, class IndexT /* see forwards.h for default argument */>
+class compact_compressed_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>   value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  compact_compressed_matrix() : rows_(0), cols_(0), nonzeros_(0) {}
+
+  explicit compact_compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0)
+  {
+    init_handles(ctx);
+  }
+
+  /** @brief Construction of a compact_compressed_matrix with the supplied number of rows and columns. All entries are zero. */
+  explicit compact_compressed_matrix(vcl_size_t rows, vcl_size_t cols, viennacl::context ctx = viennacl::context()) : rows_(rows), cols_(cols), nonzeros_(0)
+  {
+    init_handles(ctx);
+    clear();
+  }
+
+  /** @brief Construction of a compact_compressed_matrix with the supplied number of rows and columns. Memory for the supplied number of stored entries is allocated, but not initialized. */
+  explicit compact_compressed_matrix(vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros, viennacl::context ctx = viennacl::context()) : rows_(rows), cols_(cols), nonzeros_(nonzeros)
+  {
+    init_handles(ctx);
+    if (nonzeros > 0)
+    {
+      viennacl::backend::memory_create(row_buffer_,  viennacl::backend::typesafe_host_array<unsigned int>().element_size() * (rows + 1), ctx);
+      viennacl::backend::memory_create(base_buffer_, viennacl::backend::typesafe_host_array<unsigned int>().element_size() * rows,       ctx);
+      viennacl::backend::memory_create(col_buffer_,  sizeof(IndexT) * nonzeros, ctx);
+      viennacl::backend::memory_create(elements_,    sizeof(ValueT) * nonzeros, ctx);
+    }
+    else
+      clear();
+  }
+
+  /** @brief Sets the row array, the row bases, the column offsets, and the values.
+  *
+  * @param row_jumper   Array of size rows + 1 with the offsets of the rows in the arrays of column offsets and values
+  * @param row_bases    Array of size rows with the column index of the first nonzero in each row (zero for empty rows)
+  * @param col_offsets  Array of size nonzeros with the difference of each column index to the previous column index in the same row (zero for the first entry)
+  * @param elements     Array of size nonzeros with the values
+  * @param rows         Number of rows of the matrix
+  * @param cols         Number of columns of the matrix
+  * @param nonzeros     Number of entries stored, including the zeros inserted to bridge large column distances
+  */
+  void set(const void * row_jumper,
+           const void * row_bases,
+           const IndexT * col_offsets,
+           const ValueT * elements,
+           vcl_size_t rows,
+           vcl_size_t cols,
+           vcl_size_t nonzeros)
+  {
+    assert( (rows > 0) && (cols > 0) && bool("Error in compact_compressed_matrix::set(): Number of rows and columns must be larger than zero!"));
+    assert( (nonzeros > 0) && bool("Error in compact_compressed_matrix::set(): Number of nonzeros must be larger than zero!"));
+
+    viennacl::backend::memory_create(row_buffer_,  viennacl::backend::typesafe_host_array<unsigned int>(row_buffer_).element_size() * (rows + 1), viennacl::traits::context(row_buffer_),  row_jumper);
+    viennacl::backend::memory_create(base_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(base_buffer_).element_size() * rows,     viennacl::traits::context(base_buffer_), row_bases);
+    viennacl::backend::memory_create(col_buffer_,  sizeof(IndexT) * nonzeros,                                                                 viennacl::traits::context(col_buffer_),  col_offsets);
+    viennacl::backend::memory_create(elements_,    sizeof(ValueT) * nonzeros,                                                                 viennacl::traits::context(elements_),    elements);
+
+    rows_ = rows;
+    cols_ = cols;
+    nonzeros_ = nonzeros;
+  }
+
+  /** @brief Resets all entries in the matrix back to zero without changing the matrix size. Resets the sparsity pattern. */
+  void clear()
+  {
+    // the row bases are allocated with rows_ + 1 entries like the row offsets, so the buffer is never empty:
+    viennacl::backend::typesafe_host_array<unsigned int> host_row_buffer(row_buffer_, rows_ + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> host_base_buffer(base_buffer_, rows_ + 1);
+    std::vector<IndexT> host_col_buffer(1);
+    std::vector<ValueT> host_elements(1);
+
+    viennacl::backend::memory_create(row_buffer_,  host_row_buffer.element_size() * (rows_ + 1),  viennacl::traits::context(row_buffer_),  host_row_buffer.get());
+    viennacl::backend::memory_create(base_buffer_, host_base_buffer.element_size() * (rows_ + 1), viennacl::traits::context(base_buffer_), host_base_buffer.get());
+    viennacl::backend::memory_create(col_buffer_,  sizeof(IndexT),              viennacl::traits::context(col_buffer_),  &(host_col_buffer[0]));
+    viennacl::backend::memory_create(elements_,    sizeof(ValueT),              viennacl::traits::context(elements_),    &(host_elements[0]));
+
+    nonzeros_ = 0;
+  }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return rows_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return cols_; }
+  /** @brief Returns the number of entries stored, including the zeros inserted to bridge large column distances */
+  vcl_size_t nnz() const { return nonzeros_; }
+
+  /** @brief Returns the OpenCL handle to the row index array */
+  const handle_type & handle1() const { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column offsets */
+  const handle_type & handle2() const { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the row bases */
+  const handle_type & handle3() const { return base_buffer_; }
+  /** @brief Returns the OpenCL handle to the values */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Returns the OpenCL handle to the row index array */
+  handle_type & handle1() { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column offsets */
+  handle_type & handle2() { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the row bases */
+  handle_type & handle3() { return base_buffer_; }
+  /** @brief Returns the OpenCL handle to the values */
+  handle_type & handle() { return elements_; }
+
+  /** @brief Switches the memory context of the matrix. */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(base_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<IndexT>(col_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<ValueT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up in main memory, OpenCL memory, or CUDA memory. */
+  viennacl::memory_types memory_context() const
+  {
+    return row_buffer_.get_active_handle_id();
+  }
+
+private:
+  void init_handles(viennacl::context ctx)
+  {
+    row_buffer_.switch_active_handle_id(ctx.memory_type());
+    base_buffer_.switch_active_handle_id(ctx.memory_type());
+    col_buffer_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      row_buffer_.opencl_handle().context(ctx.opencl_context());
+      base_buffer_.opencl_handle().context(ctx.opencl_context());
+      col_buffer_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+  }
+
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t nonzeros_;
+
+  handle_type row_buffer_;
+  handle_type base_buffer_;
+  handle_type col_buffer_;
+  handle_type elements_;
+};
+
+
+//
+// host to device:
+//
+
+/** @brief Copies a sparse matrix from the host to a compact_compressed_matrix.
+  *
+  * There are some type requirements on the CPUMatrixT type (fulfilled by e.g. boost::numeric::ublas):
+  * - .size1() returns the number of rows
+  * - .size2() returns the number of columns
+  * - const_iterator1    is a type definition for an iterator along increasing row indices
+  * - const_iterator2    is a type definition for an iterator along increasing columns indices
+  * - The const_iterator1 type provides an iterator of type const_iterator2 via members .begin() and .end() that iterates along column indices in the current row.
+  * - The types const_iterator1 and const_iterator2 provide members functions .index1() and .index2() that return the current row and column indices respectively.
+  * - Dereferenciation of an object of type const_iterator2 returns the entry.
+  *
+  * @param cpu_matrix   A sparse matrix on the host.
+  * @param gpu_matrix   A compact_compressed_matrix from ViennaCL
+  */
+template<typename CPUMatrixT, typename NumericT, typename ValueT, typename IndexT>
+void copy(const CPUMatrixT & cpu_matrix, compact_compressed_matrix<NumericT, ValueT, IndexT> & gpu_matrix)
+{
+  assert( (gpu_matrix.size1() == 0 || viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+  assert( (gpu_matrix.size2() == 0 || viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
+
+  if (cpu_matrix.size1() > 0 && cpu_matrix.size2() > 0)
+  {
+    vcl_size_t max_offset = static_cast<vcl_size_t>(std::numeric_limits<IndexT>::max());
+
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), cpu_matrix.size1() + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> base_buffer(gpu_matrix.handle3(), cpu_matrix.size1());
+    std::vector<IndexT> col_offsets;
+    std::vector<ValueT> elements;
+    col_offsets.reserve(cpu_matrix.size1());
+    elements.reserve(cpu_matrix.size1());
+
+    vcl_size_t row_index = 0;
+    for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+    {
+      // rows not visited by the iterator are empty:
+      for (; row_index <= row_it.index1(); ++row_index)
+      {
+        row_buffer.set(row_index, col_offsets.size());
+        base_buffer.set(row_index, 0);
+      }
+
+      bool first_entry = true;
+      vcl_size_t last_col = 0;
+      for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      {
+        if (first_entry)
+        {
+          base_buffer.set(row_it.index1(), col_it.index2());
+          last_col = col_it.index2();
+          first_entry = false;
+        }
+
+        // bridge large distances with explicit zeros:
+        vcl_size_t offset = col_it.index2() - last_col;
+        while (offset > max_offset)
+        {
+          col_offsets.push_back(static_cast<IndexT>(max_offset));
+          elements.push_back(ValueT(0));
+          offset -= max_offset;
+        }
+        col_offsets.push_back(static_cast<IndexT>(offset));
+        elements.push_back(static_cast<ValueT>(*col_it));
+        last_col = col_it.index2();
+      }
+    }
+    for (; row_index < cpu_matrix.size1(); ++row_index)
+    {
+      row_buffer.set(row_index, col_offsets.size());
+      base_buffer.set(row_index, 0);
+    }
+    row_buffer.set(cpu_matrix.size1(), col_offsets.size());
+
+    vcl_size_t nonzeros = col_offsets.size();
+    if (nonzeros == 0)
+    {
+      col_offsets.push_back(0);
+      elements.push_back(0);
+    }
+
+    gpu_matrix.set(row_buffer.get(),
+                   base_buffer.get(),
+                   &col_offsets[0],
+                   &elements[0],
+                   cpu_matrix.size1(),
+                   cpu_matrix.size2(),
+                   col_offsets.size());
+    if (nonzeros == 0)
+      gpu_matrix.clear();
+  }
+}
+
+
+/** @brief Copies a sparse matrix from the host to the compute device. The host type is the std::vector< std::map < > > format .
+  *
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  * @param gpu_matrix   The sparse compact_compressed_matrix from ViennaCL
+  */
+template<typename SizeT, typename NumericT, typename ValueT, typename IndexT>
+void copy(std::vector< std::map<SizeT, NumericT> > const & cpu_matrix,
+          compact_compressed_matrix<NumericT, ValueT, IndexT> & gpu_matrix)
+{
+  vcl_size_t max_col = 0;
+  for (vcl_size_t i=0; i<cpu_matrix.size(); ++i)
+  {
+    if (cpu_matrix[i].size() > 0)
+      max_col = std::max<vcl_size_t>(max_col, (cpu_matrix[i].rbegin())->first);
+  }
+
+  tools::const_sparse_matrix_adapter<NumericT, SizeT> temp(cpu_matrix, cpu_matrix.size(), std::max<vcl_size_t>(gpu_matrix.size2(), max_col + 1));
+  viennacl::copy(temp, gpu_matrix);
+}
+
+
+/** @brief Copies a compressed_matrix to a compact_compressed_matrix in the same memory domain. The CSR arrays are passed through main memory.
+  *
+  * @param csr_matrix   The compressed_matrix
+  * @param gpu_matrix   The sparse compact_compressed_matrix from ViennaCL
+  */
+template<typename NumericT, unsigned int AlignmentV, typename ValueT, typename IndexT>
+void copy(compressed_matrix<NumericT, AlignmentV> const & csr_matrix,
+          compact_compressed_matrix<NumericT, ValueT, IndexT> & gpu_matrix)
+{
+  if (csr_matrix.size1() > 0 && csr_matrix.size2() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(csr_matrix.handle1(), csr_matrix.size1() + 1);
+    viennacl::backend::memory_read(csr_matrix.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+
+    vcl_size_t nonzeros = row_buffer[csr_matrix.size1()];
+    std::vector<unsigned int> host_row_buffer(csr_matrix.size1() + 1);
+    std::vector<unsigned int> host_col_buffer(std::max<vcl_size_t>(nonzeros, 1));
+    std::vector<NumericT>     host_elements(std::max<vcl_size_t>(nonzeros, 1));
+    for (vcl_size_t i = 0; i <= csr_matrix.size1(); ++i)
+      host_row_buffer[i] = static_cast<unsigned int>(row_buffer[i]);
+
+    if (nonzeros > 0)
+    {
+      viennacl::backend::typesafe_host_array<unsigned int> col_buffer(csr_matrix.handle2(), nonzeros);
+      viennacl::backend::memory_read(csr_matrix.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+      viennacl::backend::memory_read(csr_matrix.handle(),  0, sizeof(NumericT) * nonzeros, &(host_elements[0]));
+      for (vcl_size_t k = 0; k < nonzeros; ++k)
+        host_col_buffer[k] = static_cast<unsigned int>(col_buffer[k]);
+    }
+
+    tools::const_csr_matrix_adapter<NumericT> temp(&(host_row_buffer[0]), &(host_col_buffer[0]), &(host_elements[0]), csr_matrix.size1(), csr_matrix.size2());
+    viennacl::copy(temp, gpu_matrix);
+  }
+}
+
+
+//
+// device to host:
+//
+
+/** @brief Copies a compact_compressed_matrix to a sparse matrix on the host. Zeros are skipped.
+  *
+  * @param gpu_matrix   The sparse compact_compressed_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host of matching size, which needs to provide write access via operator()
+  */
+template<typename CPUMatrixT, typename NumericT, typename ValueT, typename IndexT>
+void copy(const compact_compressed_matrix<NumericT, ValueT, IndexT> & gpu_matrix, CPUMatrixT & cpu_matrix)
+{
+  assert( (viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+  assert( (viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
+
+  if (gpu_matrix.size1() > 0 && gpu_matrix.size2() > 0 && gpu_matrix.nnz() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), gpu_matrix.size1() + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> base_buffer(gpu_matrix.handle3(), gpu_matrix.size1());
+    std::vector<IndexT> col_offsets(gpu_matrix.nnz());
+    std::vector<ValueT> elements(gpu_matrix.nnz());
+
+    viennacl::backend::memory_read(gpu_matrix.handle1(), 0, row_buffer.raw_size(),             row_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle3(), 0, base_buffer.raw_size(),            base_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle2(), 0, sizeof(IndexT) * col_offsets.size(), &(col_offsets[0]));
+    viennacl::backend::memory_read(gpu_matrix.handle(),  0, sizeof(ValueT) * elements.size(),    &(elements[0]));
+
+    for (vcl_size_t row = 0; row < gpu_matrix.size1(); ++row)
+    {
+      vcl_size_t col = base_buffer[row];
+      for (vcl_size_t k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+      {
+        col += col_offsets[k];
+        NumericT val = static_cast<NumericT>(elements[k]);
+        if (val < 0 || val > 0) // val != 0 without compiler warnings
+          cpu_matrix(row, col) = val;
+      }
+    }
+  }
+}
+
+
+/** @brief Copies a sparse matrix from the compute device to the host. The host type is the std::vector< std::map < > > format .
+  *
+  * @param gpu_matrix   The sparse compact_compressed_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  */
+template<typename NumericT, typename ValueT, typename IndexT, typename SizeT>
+void copy(const compact_compressed_matrix<NumericT, ValueT, IndexT> & gpu_matrix,
+          std::vector< std::map<SizeT, NumericT> > & cpu_matrix)
+{
+  if (cpu_matrix.size() == 0)
+    cpu_matrix.resize(gpu_matrix.size1());
+
+  assert( (cpu_matrix.size() == gpu_matrix.size1()) && bool("Size mismatch") );
+
+  tools::sparse_matrix_adapter<NumericT, SizeT> temp(cpu_matrix, gpu_matrix.size1(), gpu_matrix.size2());
+  viennacl::copy(gpu_matrix, temp);
+}
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T, typename V, typename I>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+    }
+  };
+
+  template<typename T, typename V, typename I>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs += temp;
+    }
+  };
+
+  template<typename T, typename V, typename I>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs -= temp;
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename V, typename I, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename V, typename I, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs += temp_result;
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename V, typename I, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const compact_compressed_matrix<T, V, I>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs -= temp_result;
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
@@ -39,6 +39,17 @@
 
 namespace viennacl
 {
+namespace linalg
+{
+namespace opencl
+{
+  template<typename NumericT, unsigned int AlignmentV>
+  void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                 viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                 viennacl::compressed_matrix<NumericT, AlignmentV> & C);
+}
+}
+
 namespace detail
 {
 
@@ -464,7 +475,7 @@ public:
   typedef vcl_size_t                                                                                 size_type;
 
   /** @brief Default construction of a compressed matrix. No memory is allocated */
-  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0) {}
+  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0), host_partition_num_(0) {}
 
   /** @brief Construction of a compressed matrix with the supplied number of rows and columns. If the number of nonzeros is positive, memory is allocated
       *
@@ -474,7 +485,7 @@ public:
       * @param ctx      Optional context in which the matrix is created (one out of multiple OpenCL contexts, CUDA, host)
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros = 0, viennacl::context ctx = viennacl::context())
-    : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
+    : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0), host_partition_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -508,7 +519,7 @@ public:
       * @param ctx      Context in which to create the matrix
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, viennacl::context ctx)
-    : rows_(rows), cols_(cols), nonzeros_(0), row_block_num_(0)
+    : rows_(rows), cols_(cols), nonzeros_(0), row_block_num_(0), host_partition_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -534,7 +545,7 @@ public:
     *
     * This is useful if you want to want to populate e.g. a viennacl::compressed_matrix<> on the host with copy(), but the default backend is OpenCL.
     */
-  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0)
+  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0), host_partition_num_(0)
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -565,7 +576,7 @@ public:
     */
   explicit compressed_matrix(cl_mem mem_row_buffer, cl_mem mem_col_buffer, cl_mem mem_elements,
                              vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros) :
-    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
+    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0), host_partition_num_(0)
   {
     row_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
     row_buffer_.opencl_handle() = mem_row_buffer;
@@ -604,6 +615,51 @@ public:
     viennacl::backend::typesafe_memory_copy<unsigned int>(other.row_blocks_, row_blocks_);
     viennacl::backend::typesafe_memory_copy<NumericT>(other.elements_, elements_);
 
+    generate_host_partition();
+    return *this;
+  }
+
+  /** @brief Computes the sparse matrix-matrix product C = A * B, where A, B, and C are all of type compressed_matrix. The result has sorted column indices. */
+  compressed_matrix(matrix_expression<const compressed_matrix, const compressed_matrix, op_prod> const & proxy)
+    : rows_(proxy.size1()), cols_(proxy.size2()), nonzeros_(0), row_block_num_(0), host_partition_num_(0)
+  {
+    viennacl::context ctx = viennacl::traits::context(proxy.lhs());
+
+    row_buffer_.switch_active_handle_id(ctx.memory_type());
+    col_buffer_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+    row_blocks_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      row_buffer_.opencl_handle().context(ctx.opencl_context());
+      col_buffer_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+      row_blocks_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+
+    viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), *this);
+  }
+
+  /** @brief Assigns the sparse matrix-matrix product A * B to the matrix. The sparsity pattern is replaced by the one of the product. */
+  compressed_matrix & operator=(matrix_expression<const compressed_matrix, const compressed_matrix, op_prod> const & proxy)
+  {
+    assert( (rows_ == 0 || rows_ == proxy.size1()) && bool("Size mismatch") );
+    assert( (cols_ == 0 || cols_ == proxy.size2()) && bool("Size mismatch") );
+
+    if (&proxy.lhs() == this || &proxy.rhs() == this) // the product is built in new buffers, but the factors may still be read from them
+    {
+      compressed_matrix temp(proxy);
+      *this = temp;
+      return *this;
+    }
+
+    rows_ = proxy.size1();
+    cols_ = proxy.size2();
+    nonzeros_ = 0; // buffers get reallocated for the product
+    viennacl::linalg::prod_impl(proxy.lhs(), proxy.rhs(), *this);
     return *this;
   }
 
@@ -650,8 +706,8 @@ public:
     generate_row_block_information();
   }
 
-  /** @brief Allocate memory for the supplied number of nonzeros in the matrix. Old values are preserved. */
-  void reserve(vcl_size_t new_nonzeros)
+  /** @brief Allocate memory for the supplied number of nonzeros in the matrix. Old values are preserved if 'preserve' is true. */
+  void reserve(vcl_size_t new_nonzeros, bool preserve = true)
   {
     if (new_nonzeros > nonzeros_)
     {
@@ -664,8 +720,11 @@ public:
       viennacl::backend::memory_create(col_buffer_, size_deducer.element_size() * new_nonzeros, viennacl::traits::context(col_buffer_));
       viennacl::backend::memory_create(elements_,   sizeof(NumericT) * new_nonzeros,          viennacl::traits::context(elements_));
 
-      viennacl::backend::memory_copy(col_buffer_old, col_buffer_, 0, 0, size_deducer.element_size() * nonzeros_);
-      viennacl::backend::memory_copy(elements_old,   elements_,   0, 0, sizeof(NumericT)* nonzeros_);
+      if (preserve && nonzeros_ > 0)
+      {
+        viennacl::backend::memory_copy(col_buffer_old, col_buffer_, 0, 0, size_deducer.element_size() * nonzeros_);
+        viennacl::backend::memory_copy(elements_old,   elements_,   0, 0, sizeof(NumericT)* nonzeros_);
+      }
 
       nonzeros_ = new_nonzeros;
     }
@@ -737,6 +796,7 @@ public:
     viennacl::backend::memory_create(elements_,   sizeof(NumericT) * 1,                         viennacl::traits::context(elements_), &(host_elements[0]));
 
     nonzeros_ = 0;
+    generate_host_partition();
   }
 
   /** @brief Returns a reference to the (i,j)-th entry of the sparse matrix. If (i,j) does not exist (zero), it is inserted (slow!) */
@@ -791,6 +851,11 @@ public:
   /** @brief  Returns the OpenCL handle to the matrix entry array */
   handle_type & handle() { return elements_; }
 
+  /** @brief  Returns the number of parts of the nonzero-balanced partition for products in main memory. Zero if no partition is set up. */
+  vcl_size_t host_partition_num() const { return host_partition_num_; }
+  /** @brief  Returns the handle to the nonzero-balanced partition for products in main memory. See viennacl::linalg::host_based::detail::csr_nonzero_partition() for the layout. */
+  const handle_type & host_partition_handle() const { return host_partition_; }
+
   /** @brief Switches the memory context of the matrix.
     *
     * Allows for e.g. an migration of the full matrix from OpenCL memory to host memory for e.g. computing a preconditioner.
@@ -801,6 +866,7 @@ public:
     viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
     viennacl::backend::switch_memory_context<unsigned int>(row_blocks_, new_ctx);
     viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+    generate_host_partition();
   }
 
   /** @brief Returns the current memory context to determine whether the matrix is set up for OpenMP, OpenCL, or CUDA. */
@@ -809,29 +875,17 @@ public:
     return row_buffer_.get_active_handle_id();
   }
 
-private:
+  friend struct viennacl::io::detail::binary_access;
 
-  /** @brief Helper function for accessing the element (i,j) of the matrix. */
-  vcl_size_t element_index(vcl_size_t i, vcl_size_t j)
-  {
-    //read row indices
-    viennacl::backend::typesafe_host_array<unsigned int> row_indices(row_buffer_, 2);
-    viennacl::backend::memory_read(row_buffer_, row_indices.element_size()*i, row_indices.element_size()*2, row_indices.get());
+  // writes the rows of C directly on the device, hence needs to update the derived row information afterwards:
+  template<typename NumericT2, unsigned int AlignmentV2>
+  friend void viennacl::linalg::opencl::prod_impl(viennacl::compressed_matrix<NumericT2, AlignmentV2> const & A,
+                                                  viennacl::compressed_matrix<NumericT2, AlignmentV2> const & B,
+                                                  viennacl::compressed_matrix<NumericT2, AlignmentV2> & C);
 
-    //get column indices for row i:
-    viennacl::backend::typesafe_host_array<unsigned int> col_indices(col_buffer_, row_indices[1] - row_indices[0]);
-    viennacl::backend::memory_read(col_buffer_, col_indices.element_size()*row_indices[0], row_indices.element_size()*col_indices.size(), col_indices.get());
-
-    for (vcl_size_t k=0; k<col_indices.size(); ++k)
-    {
-      if (col_indices[k] == j)
-        return row_indices[0] + k;
-    }
-
-    // if not found, return index past the end of the matrix (cf. matrix.end() in the spirit of the STL)
-    return nonzeros_;
-  }
+private:
 
+  /** @brief Updates the information derived from the row array (row blocks for CSR-adaptive, partition for products in main memory). Needs to be called whenever the row array is written to directly. */
   void generate_row_block_information()
   {
     viennacl::backend::typesafe_host_array<unsigned int> row_buffer(row_buffer_, rows_ + 1);
@@ -868,6 +922,48 @@ private:
                                        row_blocks.element_size() * (row_block_num_ + 1),
                                        viennacl::traits::context(row_buffer_), row_blocks.get());
 
+    generate_host_partition();
+  }
+
+  /** @brief Helper function for accessing the element (i,j) of the matrix. */
+  vcl_size_t element_index(vcl_size_t i, vcl_size_t j)
+  {
+    //read row indices
+    viennacl::backend::typesafe_host_array<unsigned int> row_indices(row_buffer_, 2);
+    viennacl::backend::memory_read(row_buffer_, row_indices.element_size()*i, row_indices.element_size()*2, row_indices.get());
+
+    //get column indices for row i:
+    viennacl::backend::typesafe_host_array<unsigned int> col_indices(col_buffer_, row_indices[1] - row_indices[0]);
+    viennacl::backend::memory_read(col_buffer_, col_indices.element_size()*row_indices[0], row_indices.element_size()*col_indices.size(), col_indices.get());
+
+    for (vcl_size_t k=0; k<col_indices.size(); ++k)
+    {
+      if (col_indices[k] == j)
+        return row_indices[0] + k;
+    }
+
+    // if not found, return index past the end of the matrix (cf. matrix.end() in the spirit of the STL)
+    return nonzeros_;
+  }
+
+  /** @brief Sets up the nonzero-balanced partition for products in main memory for the current number of threads.
+  *
+  * The partition is only updated together with the row array, so concurrent products with the same const matrix only read it.
+  * Products with a different number of threads compute a temporary partition instead.
+  */
+  void generate_host_partition()
+  {
+    host_partition_num_ = 0;
+    host_partition_ = handle_type();
+    if (row_buffer_.get_active_handle_id() != viennacl::MAIN_MEMORY || rows_ == 0 || row_buffer_.raw_size() < sizeof(unsigned int) * (rows_ + 1))
+      return;
+
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(row_buffer_);
+    vcl_size_t num_parts = viennacl::linalg::host_based::detail::csr_num_parts(rows_, row_buffer[rows_]);
+    std::vector<unsigned int> partition(2 * num_parts + 4);
+    viennacl::linalg::host_based::detail::csr_compute_partition(row_buffer, rows_, num_parts, &(partition[0]));
+    viennacl::backend::memory_create(host_partition_, sizeof(unsigned int) * partition.size(), viennacl::context(viennacl::MAIN_MEMORY), &(partition[0]));
+    host_partition_num_ = num_parts;
   }
 
   // /** @brief Copy constructor is by now not available. */
@@ -878,10 +974,12 @@ private:
   vcl_size_t cols_;
   vcl_size_t nonzeros_;
   vcl_size_t row_block_num_;
+  vcl_size_t host_partition_num_;
   handle_type row_buffer_;
   handle_type row_blocks_;
   handle_type col_buffer_;
   handle_type elements_;
+  handle_type host_partition_;
 };
 
 
@@ -974,6 +1072,47 @@ namespace detail
     }
   };
 
+
+  // x = trans(A) * y
+  template<typename T, unsigned int A>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = trans(A) * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+    }
+  };
+
+  template<typename T, unsigned int A>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs += temp;
+    }
+  };
+
+  template<typename T, unsigned int A>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const matrix_expression<const compressed_matrix<T, A>, const compressed_matrix<T, A>, op_trans>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs -= temp;
+    }
+  };
+
 } // namespace detail
 } // namespace linalg
   /** \endcond */
@@ -241,6 +241,7 @@ protected:
   void set_handle(viennacl::backend::mem_handle const & h);
   void switch_memory_context(viennacl::context new_ctx);
   void resize(size_type rows, size_type columns, bool preserve = true);
+  friend struct viennacl::io::detail::binary_access;
 private:
   size_type size1_;
   size_type size2_;
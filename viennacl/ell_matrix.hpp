@@ -111,6 +111,8 @@ public:
   friend void copy(const CPUMatrixT & cpu_matrix, ell_matrix<T, ALIGN> & gpu_matrix );
 #endif
 
+  friend struct viennacl::io::detail::binary_access;
+
 private:
   vcl_size_t rows_;
   vcl_size_t cols_;
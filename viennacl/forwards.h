@@ -404,6 +404,15 @@ namespace viennacl
   template<class SCALARTYPE, unsigned int ALIGNMENT = 1>
   class hyb_matrix;
 
+  template<class SCALARTYPE, unsigned int BLOCKSIZE = 3>
+  class bsr_matrix;
+
+  template<class SCALARTYPE, class VALUETYPE = SCALARTYPE, class INDEXTYPE = unsigned short>
+  class compact_compressed_matrix;
+
+  template<class SCALARTYPE>
+  class symmetric_compressed_matrix;
+
   template<class SCALARTYPE, unsigned int ALIGNMENT = 1>
   class circulant_matrix;
 
@@ -521,6 +530,27 @@ namespace viennacl
     enum { value = false };
   };
 
+  /** @brief Helper class for checking whether a matrix is a bsr_matrix (block compressed sparse row format) */
+  template<typename T>
+  struct is_bsr_matrix
+  {
+    enum { value = false };
+  };
+
+  /** @brief Helper class for checking whether a matrix is a compact_compressed_matrix (CSR format with narrow column indices and values) */
+  template<typename T>
+  struct is_compact_compressed_matrix
+  {
+    enum { value = false };
+  };
+
+  /** @brief Helper class for checking whether a matrix is a symmetric_compressed_matrix (upper triangle of a symmetric matrix in CSR format) */
+  template<typename T>
+  struct is_symmetric_compressed_matrix
+  {
+    enum { value = false };
+  };
+
   /** @brief Helper class for checking whether the provided type is one of the sparse matrix types (compressed_matrix, coordinate_matrix, etc.) */
   template<typename T>
   struct is_any_sparse_matrix
@@ -609,6 +639,15 @@ namespace viennacl
     };
   }
 
+  namespace io
+  {
+    namespace detail
+    {
+      /** @brief Grants the binary file reader and writer access to the internal sizes of the sparse and dense matrix types. See viennacl/io/binary_format.hpp */
+      struct binary_access;
+    }
+  }
+
   namespace linalg
   {
 #if !defined(_MSC_VER) || defined(__CUDACC__)
@@ -826,6 +865,9 @@ namespace viennacl
       static const char * name() { return "unit_upper"; }
     }; //unit upper triangular matrix
 
+    template<typename NumericT>
+    class fused_vector_operation;
+
     //preconditioner tags
     class ilut_tag;
 
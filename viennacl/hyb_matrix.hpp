@@ -117,6 +117,8 @@ public:
   friend void copy(const CPUMatrixT & cpu_matrix, hyb_matrix<T, ALIGN> & gpu_matrix );
 #endif
 
+  friend struct viennacl::io::detail::binary_access;
+
 private:
   NumericT  csr_threshold_;
   vcl_size_t rows_;
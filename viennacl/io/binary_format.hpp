@@ -0,0 +1,619 @@
+#ifndef VIENNACL_IO_BINARY_FORMAT_HPP
+#define VIENNACL_IO_BINARY_FORMAT_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/io/binary_format.hpp
+    @brief A versioned binary file format storing the internal arrays of sparse and dense matrices as they are held in memory.
+
+    A file consists of a fixed-size header followed by the raw contents of the memory handles of the object, each aligned to 64 bytes.
+    Files are not portable across machines with different byte order or different size of vcl_size_t, which is checked when reading.
+    When reading into an object in main memory, the arrays are used directly from a (copy-on-write) memory mapping of the file without copying.
+    For objects in OpenCL or CUDA memory, the arrays are transferred from the memory mapping in chunks.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/mem_handle.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/io/detail/mapped_file.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace io
+{
+namespace detail
+{
+  /** @brief Identifies the type of the object stored in a binary file */
+  enum binary_object_type
+  {
+    BINARY_COMPRESSED_MATRIX = 1,
+    BINARY_ELL_MATRIX,
+    BINARY_SLICED_ELL_MATRIX,
+    BINARY_HYB_MATRIX,
+    BINARY_DENSE_MATRIX
+  };
+
+  enum
+  {
+    binary_format_version = 1,
+    binary_max_arrays = 8,
+    binary_alignment = 64,          // offset alignment of the arrays in the file. Since mappings are page-aligned, this also aligns the arrays in memory
+    binary_chunk_size = 1 << 24     // number of bytes transferred at once between OpenCL or CUDA buffers and the file
+  };
+
+  /** @brief The header at the beginning of each binary file. */
+  struct binary_header
+  {
+    char         magic[8];         // "VIENNACL"
+    unsigned int version;
+    unsigned int byte_order;       // 0x01020304 written in the byte order of the writing machine
+    unsigned int size_type_bytes;  // sizeof(vcl_size_t) on the writing machine
+    unsigned int object_type;      // one out of binary_object_type
+    unsigned int numeric_bytes;    // size of the floating point type
+    unsigned int index_bytes;      // size of the entries of the index arrays
+    unsigned int layout;           // AlignmentV for sparse matrices, 1 for row-major and 0 for column-major dense matrices
+    unsigned int num_arrays;
+    vcl_size_t   sizes[binary_max_arrays];
+    double       parameter;        // csr_threshold() for hyb_matrix, unused otherwise
+    vcl_size_t   array_offsets[binary_max_arrays];
+    vcl_size_t   array_bytes[binary_max_arrays];
+  };
+
+  inline binary_header make_binary_header(binary_object_type object_type, unsigned int numeric_bytes, unsigned int index_bytes, unsigned int layout, unsigned int num_arrays)
+  {
+    binary_header header;
+    std::memset(&header, 0, sizeof(binary_header));
+    std::memcpy(header.magic, "VIENNACL", 8);
+    header.version         = binary_format_version;
+    header.byte_order      = 0x01020304;
+    header.size_type_bytes = sizeof(vcl_size_t);
+    header.object_type     = object_type;
+    header.numeric_bytes   = numeric_bytes;
+    header.index_bytes     = index_bytes;
+    header.layout          = layout;
+    header.num_arrays      = num_arrays;
+    return header;
+  }
+
+  /** @brief Writes the header followed by the arrays in the supplied handles to a file. Arrays in OpenCL or CUDA memory are read back in chunks.
+    *
+    * @param file        The filename
+    * @param header      The header, for which the array offsets and sizes are filled in here
+    * @param arrays      The memory handles of the object. The number of bytes written is given by raw_size() of each handle.
+    * @return            True on success
+    */
+  inline bool write_binary_arrays(const char * file, binary_header & header, viennacl::backend::mem_handle const * const * arrays)
+  {
+    vcl_size_t offset = viennacl::tools::align_to_multiple<vcl_size_t>(sizeof(binary_header), binary_alignment);
+    for (unsigned int i = 0; i < header.num_arrays; ++i)
+    {
+      header.array_offsets[i] = offset;
+      header.array_bytes[i]   = arrays[i]->raw_size();
+      offset = viennacl::tools::align_to_multiple<vcl_size_t>(offset + header.array_bytes[i], binary_alignment);
+    }
+
+    std::ofstream writer(file, std::ios::binary);
+    if (!writer)
+    {
+      std::cerr << "ViennaCL: Cannot open file " << file << std::endl;
+      return false;
+    }
+
+    writer.write(reinterpret_cast<const char *>(&header), sizeof(binary_header));
+
+    std::vector<char> padding(binary_alignment);
+    std::vector<char> buffer;
+    vcl_size_t position = sizeof(binary_header);
+    for (unsigned int i = 0; i < header.num_arrays; ++i)
+    {
+      writer.write(&(padding[0]), static_cast<std::streamsize>(header.array_offsets[i] - position));
+
+      vcl_size_t bytes = header.array_bytes[i];
+      if (arrays[i]->get_active_handle_id() == viennacl::MAIN_MEMORY)
+        writer.write(arrays[i]->ram_handle().get(), static_cast<std::streamsize>(bytes));
+      else
+      {
+        buffer.resize(std::min<vcl_size_t>(bytes, binary_chunk_size));
+        for (vcl_size_t chunk_start = 0; chunk_start < bytes; chunk_start += binary_chunk_size)
+        {
+          vcl_size_t chunk_bytes = std::min<vcl_size_t>(bytes - chunk_start, binary_chunk_size);
+          viennacl::backend::memory_read(*arrays[i], chunk_start, chunk_bytes, &(buffer[0]));
+          writer.write(&(buffer[0]), static_cast<std::streamsize>(chunk_bytes));
+        }
+      }
+      position = header.array_offsets[i] + bytes;
+    }
+
+    if (!writer)
+    {
+      std::cerr << "ViennaCL: Error while writing file " << file << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  /** @brief Maps a binary file into memory and checks that it holds an object of the expected type. Returns an empty pointer if the file cannot be used.
+    *
+    * @param file        The filename
+    * @param expected    Header with the object type, the sizes of the numeric and the index types, the layout, and the number of arrays expected
+    * @param header      The header read from the file
+    */
+  inline viennacl::tools::shared_ptr<mapped_file> open_binary_file(const char * file, binary_header const & expected, binary_header & header)
+  {
+    viennacl::tools::shared_ptr<mapped_file> mapped(new mapped_file(file, true));
+    if (!mapped->good())
+    {
+      std::cerr << "ViennaCL: Cannot open file " << file << std::endl;
+      return viennacl::tools::shared_ptr<mapped_file>();
+    }
+
+    if (mapped->size() < sizeof(binary_header))
+    {
+      std::cerr << "Error in file " << file << ": File is too short for a binary ViennaCL file" << std::endl;
+      return viennacl::tools::shared_ptr<mapped_file>();
+    }
+    std::memcpy(&header, mapped->data(), sizeof(binary_header));
+
+    const char * error = NULL;
+    if (std::memcmp(header.magic, expected.magic, 8) != 0)
+      error = "Not a binary ViennaCL file";
+    else if (header.version != expected.version)
+      error = "Unsupported version of the binary file format";
+    else if (header.byte_order != expected.byte_order || header.size_type_bytes != expected.size_type_bytes)
+      error = "File was written on a machine with a different byte order or word size";
+    else if (header.object_type != expected.object_type)
+      error = "File holds a different type of object";
+    else if (header.numeric_bytes != expected.numeric_bytes || header.index_bytes != expected.index_bytes)
+      error = "File holds a different numeric type or index type";
+    else if (header.layout != expected.layout && expected.object_type != BINARY_COMPRESSED_MATRIX)
+      error = "File holds an object with a different alignment or storage layout";
+    else if (header.num_arrays != expected.num_arrays)
+      error = "Unexpected number of arrays";
+
+    for (unsigned int i = 0; i < header.num_arrays && !error; ++i)
+    {
+      if (header.array_offsets[i] % binary_alignment != 0
+          || header.array_offsets[i] > mapped->size()
+          || header.array_bytes[i] > mapped->size() - header.array_offsets[i])
+        error = "File is truncated or corrupted";
+    }
+
+    if (error)
+    {
+      std::cerr << "Error in file " << file << ": " << error << std::endl;
+      return viennacl::tools::shared_ptr<mapped_file>();
+    }
+
+    return mapped;
+  }
+
+  /** @brief Deleter for memory handles pointing into a memory-mapped file. The mapping is released when the last handle referring to it is destroyed. */
+  class mapped_file_deleter
+  {
+  public:
+    mapped_file_deleter(viennacl::tools::shared_ptr<mapped_file> const & file) : file_(file) {}
+
+    void operator()(char *) const {}
+
+  private:
+    viennacl::tools::shared_ptr<mapped_file> file_;
+  };
+
+  /** @brief Replaces the handle by the respective array of a binary file. In main memory, the handle points into the memory mapping, otherwise the array is copied in chunks. */
+  inline void load_binary_array(viennacl::backend::mem_handle & handle,
+                                viennacl::tools::shared_ptr<mapped_file> const & file,
+                                binary_header const & header,
+                                unsigned int index,
+                                viennacl::context ctx)
+  {
+    vcl_size_t bytes = header.array_bytes[index];
+    char * data = file->data() + header.array_offsets[index];
+
+    handle = viennacl::backend::mem_handle();
+    handle.switch_active_handle_id(ctx.memory_type());
+    if (ctx.memory_type() == viennacl::MAIN_MEMORY)
+    {
+      if (bytes > 0)
+      {
+        handle.ram_handle() = viennacl::backend::mem_handle::ram_handle_type(data, mapped_file_deleter(file));
+        handle.raw_size(bytes);
+      }
+    }
+    else
+    {
+#ifdef VIENNACL_WITH_OPENCL
+      if (ctx.memory_type() == viennacl::OPENCL_MEMORY)
+        handle.opencl_handle().context(ctx.opencl_context());
+#endif
+      viennacl::backend::memory_create(handle, bytes, ctx);
+      for (vcl_size_t chunk_start = 0; chunk_start < bytes; chunk_start += binary_chunk_size)
+        viennacl::backend::memory_write(handle, chunk_start, std::min<vcl_size_t>(bytes - chunk_start, binary_chunk_size), data + chunk_start);
+    }
+  }
+
+  /** @brief Reads and writes the internal arrays and sizes of the sparse and dense matrix types, which declare this class a friend. */
+  struct binary_access
+  {
+    //
+    // compressed_matrix
+    //
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool write(compressed_matrix<NumericT, AlignmentV> const & A, const char * file)
+    {
+      binary_header header = make_binary_header(BINARY_COMPRESSED_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 4);
+      header.sizes[0] = A.rows_;
+      header.sizes[1] = A.cols_;
+      header.sizes[2] = A.nonzeros_;
+      header.sizes[3] = A.row_block_num_;
+
+      viennacl::backend::mem_handle const * arrays[] = { &A.row_buffer_, &A.col_buffer_, &A.elements_, &A.row_blocks_ };
+      return write_binary_arrays(file, header, arrays);
+    }
+
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool read(compressed_matrix<NumericT, AlignmentV> & A, const char * file)
+    {
+      binary_header header;
+      viennacl::tools::shared_ptr<mapped_file> mapped = open_binary_file(file, make_binary_header(BINARY_COMPRESSED_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 4), header);
+      if (!mapped.get())
+        return false;
+
+      viennacl::context ctx = viennacl::traits::context(A.row_buffer_);
+      load_binary_array(A.row_buffer_, mapped, header, 0, ctx);
+      load_binary_array(A.col_buffer_, mapped, header, 1, ctx);
+      load_binary_array(A.elements_,   mapped, header, 2, ctx);
+      load_binary_array(A.row_blocks_, mapped, header, 3, ctx);
+
+      A.rows_          = header.sizes[0];
+      A.cols_          = header.sizes[1];
+      A.nonzeros_      = header.sizes[2];
+      A.row_block_num_ = header.sizes[3];
+      A.generate_host_partition();
+      return true;
+    }
+
+    //
+    // ell_matrix
+    //
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool write(ell_matrix<NumericT, AlignmentV> const & A, const char * file)
+    {
+      binary_header header = make_binary_header(BINARY_ELL_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 2);
+      header.sizes[0] = A.rows_;
+      header.sizes[1] = A.cols_;
+      header.sizes[2] = A.maxnnz_;
+
+      viennacl::backend::mem_handle const * arrays[] = { &A.coords_, &A.elements_ };
+      return write_binary_arrays(file, header, arrays);
+    }
+
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool read(ell_matrix<NumericT, AlignmentV> & A, const char * file)
+    {
+      binary_header header;
+      viennacl::tools::shared_ptr<mapped_file> mapped = open_binary_file(file, make_binary_header(BINARY_ELL_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 2), header);
+      if (!mapped.get())
+        return false;
+
+      viennacl::context ctx = viennacl::traits::context(A.coords_);
+      load_binary_array(A.coords_,   mapped, header, 0, ctx);
+      load_binary_array(A.elements_, mapped, header, 1, ctx);
+
+      A.rows_   = header.sizes[0];
+      A.cols_   = header.sizes[1];
+      A.maxnnz_ = header.sizes[2];
+      return true;
+    }
+
+    //
+    // sliced_ell_matrix
+    //
+    template<typename ScalarT, typename IndexT>
+    static bool write(sliced_ell_matrix<ScalarT, IndexT> const & A, const char * file)
+    {
+      binary_header header = make_binary_header(BINARY_SLICED_ELL_MATRIX, sizeof(ScalarT), sizeof(IndexT), 0, 5);
+      header.sizes[0] = A.rows_;
+      header.sizes[1] = A.cols_;
+      header.sizes[2] = A.rows_per_block_;
+      header.sizes[3] = A.sigma_;
+
+      viennacl::backend::mem_handle const * arrays[] = { &A.columns_per_block_, &A.column_indices_, &A.block_start_, &A.elements_, &A.row_indices_ };
+      return write_binary_arrays(file, header, arrays);
+    }
+
+    template<typename ScalarT, typename IndexT>
+    static bool read(sliced_ell_matrix<ScalarT, IndexT> & A, const char * file)
+    {
+      binary_header header;
+      viennacl::tools::shared_ptr<mapped_file> mapped = open_binary_file(file, make_binary_header(BINARY_SLICED_ELL_MATRIX, sizeof(ScalarT), sizeof(IndexT), 0, 5), header);
+      if (!mapped.get())
+        return false;
+
+      viennacl::context ctx = viennacl::traits::context(A.columns_per_block_);
+      if (header.sizes[0] > 0 && header.sizes[3] > 1 && ctx.memory_type() != viennacl::MAIN_MEMORY)
+      {
+        // only the host kernels support the row permutation, hence rows are stored in their original order like copy() does for other memory domains:
+        load_unpermuted(A, mapped, header, ctx);
+        return true;
+      }
+
+      load_binary_array(A.columns_per_block_, mapped, header, 0, ctx);
+      load_binary_array(A.column_indices_,    mapped, header, 1, ctx);
+      load_binary_array(A.block_start_,       mapped, header, 2, ctx);
+      load_binary_array(A.elements_,          mapped, header, 3, ctx);
+      load_binary_array(A.row_indices_,       mapped, header, 4, ctx);
+
+      A.rows_           = header.sizes[0];
+      A.cols_           = header.sizes[1];
+      A.rows_per_block_ = header.sizes[2];
+      A.sigma_          = header.sizes[3];
+      return true;
+    }
+
+    /** @brief Sets up a sliced_ell_matrix with sigma = 1 from a file in which rows are permuted within windows of sigma rows. The block size is retained. */
+    template<typename ScalarT, typename IndexT>
+    static void load_unpermuted(sliced_ell_matrix<ScalarT, IndexT> & A,
+                                viennacl::tools::shared_ptr<mapped_file> const & file,
+                                binary_header const & header,
+                                viennacl::context ctx)
+    {
+      vcl_size_t rows = header.sizes[0];
+      vcl_size_t C    = header.sizes[2];
+
+      IndexT  const * file_columns_per_block = reinterpret_cast<IndexT  const *>(file->data() + header.array_offsets[0]);
+      IndexT  const * file_column_indices    = reinterpret_cast<IndexT  const *>(file->data() + header.array_offsets[1]);
+      IndexT  const * file_block_start       = reinterpret_cast<IndexT  const *>(file->data() + header.array_offsets[2]);
+      ScalarT const * file_elements          = reinterpret_cast<ScalarT const *>(file->data() + header.array_offsets[3]);
+      IndexT  const * file_row_indices       = reinterpret_cast<IndexT  const *>(file->data() + header.array_offsets[4]);
+
+      // first entry of each row in the file and its number of entries. Columns within a row are increasing, padding repeats the last column:
+      std::vector<vcl_size_t> row_offsets(rows);
+      std::vector<vcl_size_t> row_lengths(rows, 0);
+      for (vcl_size_t i = 0; i < rows; ++i)
+      {
+        vcl_size_t row    = file_row_indices[i];
+        vcl_size_t offset = file_block_start[i / C] + i % C;
+        vcl_size_t length = (file_columns_per_block[i / C] > 0) ? 1 : 0;
+        while (length < file_columns_per_block[i / C] && file_column_indices[offset + length * C] != file_column_indices[offset + (length - 1) * C])
+          ++length;
+        row_offsets[row] = offset;
+        row_lengths[row] = length;
+      }
+
+      vcl_size_t num_blocks = rows / C + 1;
+      std::vector<IndexT> columns_per_block(num_blocks, 0);
+      std::vector<IndexT> block_start((rows - 1) / C + 1);
+      vcl_size_t total_entries = 0;
+      for (vcl_size_t block = 0; block < block_start.size(); ++block)
+      {
+        vcl_size_t block_columns = 0;
+        for (vcl_size_t row = block * C; row < std::min((block + 1) * C, rows); ++row)
+          block_columns = std::max(block_columns, row_lengths[row]);
+        block_start[block]       = static_cast<IndexT>(total_entries);
+        columns_per_block[block] = static_cast<IndexT>(block_columns);
+        total_entries += block_columns * C;
+      }
+
+      std::vector<IndexT>  column_indices(std::max<vcl_size_t>(total_entries, 1), 0);
+      std::vector<ScalarT> elements(std::max<vcl_size_t>(total_entries, 1), 0);
+      for (vcl_size_t row = 0; row < rows; ++row)
+      {
+        vcl_size_t offset = block_start[row / C] + row % C;
+        IndexT last_column = 0;
+        for (vcl_size_t k = 0; k < columns_per_block[row / C]; ++k)
+        {
+          if (k < row_lengths[row])
+          {
+            last_column = file_column_indices[row_offsets[row] + k * C];
+            elements[offset + k * C] = file_elements[row_offsets[row] + k * C];
+          }
+          column_indices[offset + k * C] = last_column;
+        }
+      }
+
+      A.columns_per_block_ = viennacl::backend::mem_handle();
+      A.column_indices_    = viennacl::backend::mem_handle();
+      A.block_start_       = viennacl::backend::mem_handle();
+      A.elements_          = viennacl::backend::mem_handle();
+      A.row_indices_       = viennacl::backend::mem_handle();
+      A.columns_per_block_.switch_active_handle_id(ctx.memory_type());
+      A.column_indices_.switch_active_handle_id(ctx.memory_type());
+      A.block_start_.switch_active_handle_id(ctx.memory_type());
+      A.elements_.switch_active_handle_id(ctx.memory_type());
+      A.row_indices_.switch_active_handle_id(ctx.memory_type());
+      viennacl::backend::memory_create(A.columns_per_block_, sizeof(IndexT)  * columns_per_block.size(), ctx, &(columns_per_block[0]));
+      viennacl::backend::memory_create(A.column_indices_,    sizeof(IndexT)  * total_entries,            ctx, &(column_indices[0]));
+      viennacl::backend::memory_create(A.block_start_,       sizeof(IndexT)  * block_start.size(),       ctx, &(block_start[0]));
+      viennacl::backend::memory_create(A.elements_,          sizeof(ScalarT) * total_entries,            ctx, &(elements[0]));
+
+      A.rows_           = rows;
+      A.cols_           = header.sizes[1];
+      A.rows_per_block_ = C;
+      A.sigma_          = 1;
+    }
+
+    //
+    // hyb_matrix
+    //
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool write(hyb_matrix<NumericT, AlignmentV> const & A, const char * file)
+    {
+      binary_header header = make_binary_header(BINARY_HYB_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 5);
+      header.sizes[0] = A.rows_;
+      header.sizes[1] = A.cols_;
+      header.sizes[2] = A.ellnnz_;
+      header.sizes[3] = A.csrnnz_;
+      header.parameter = static_cast<double>(A.csr_threshold_);
+
+      viennacl::backend::mem_handle const * arrays[] = { &A.ell_coords_, &A.ell_elements_, &A.csr_rows_, &A.csr_cols_, &A.csr_elements_ };
+      return write_binary_arrays(file, header, arrays);
+    }
+
+    template<typename NumericT, unsigned int AlignmentV>
+    static bool read(hyb_matrix<NumericT, AlignmentV> & A, const char * file)
+    {
+      binary_header header;
+      viennacl::tools::shared_ptr<mapped_file> mapped = open_binary_file(file, make_binary_header(BINARY_HYB_MATRIX, sizeof(NumericT), sizeof(unsigned int), AlignmentV, 5), header);
+      if (!mapped.get())
+        return false;
+
+      viennacl::context ctx = viennacl::traits::context(A.ell_coords_);
+      load_binary_array(A.ell_coords_,   mapped, header, 0, ctx);
+      load_binary_array(A.ell_elements_, mapped, header, 1, ctx);
+      load_binary_array(A.csr_rows_,     mapped, header, 2, ctx);
+      load_binary_array(A.csr_cols_,     mapped, header, 3, ctx);
+      load_binary_array(A.csr_elements_, mapped, header, 4, ctx);
+
+      A.rows_   = header.sizes[0];
+      A.cols_   = header.sizes[1];
+      A.ellnnz_ = header.sizes[2];
+      A.csrnnz_ = header.sizes[3];
+      A.csr_threshold_ = static_cast<NumericT>(header.parameter);
+      return true;
+    }
+
+    //
+    // dense matrix
+    //
+    template<typename NumericT, typename F, unsigned int AlignmentV>
+    static bool write(matrix<NumericT, F, AlignmentV> const & A, const char * file)
+    {
+      matrix_base<NumericT> const & B = A;
+      binary_header header = make_binary_header(BINARY_DENSE_MATRIX, sizeof(NumericT), 0, B.row_major_ ? 1 : 0, 1);
+      header.sizes[0] = B.size1_;
+      header.sizes[1] = B.size2_;
+      header.sizes[2] = B.internal_size1_;
+      header.sizes[3] = B.internal_size2_;
+
+      viennacl::backend::mem_handle const * arrays[] = { &B.elements_ };
+      return write_binary_arrays(file, header, arrays);
+    }
+
+    template<typename NumericT, typename F, unsigned int AlignmentV>
+    static bool read(matrix<NumericT, F, AlignmentV> & A, const char * file)
+    {
+      matrix_base<NumericT> & B = A;
+      binary_header header;
+      viennacl::tools::shared_ptr<mapped_file> mapped = open_binary_file(file, make_binary_header(BINARY_DENSE_MATRIX, sizeof(NumericT), 0, B.row_major_ ? 1 : 0, 1), header);
+      if (!mapped.get())
+        return false;
+
+      load_binary_array(B.elements_, mapped, header, 0, viennacl::traits::context(B.elements_));
+
+      B.size1_          = header.sizes[0];
+      B.size2_          = header.sizes[1];
+      B.start1_         = 0;
+      B.start2_         = 0;
+      B.stride1_        = 1;
+      B.stride2_        = 1;
+      B.internal_size1_ = header.sizes[2];
+      B.internal_size2_ = header.sizes[3];
+      return true;
+    }
+  };
+
+} //namespace detail
+
+
+/** @brief Writes a sparse or dense matrix to a binary file, storing its internal arrays as they are held in memory.
+  *
+  * Supported are compressed_matrix, ell_matrix, sliced_ell_matrix, hyb_matrix, and matrix.
+  *
+  * @param A      The matrix. May reside in any memory domain.
+  * @param file   The filename
+  * @return       True on success. Errors are reported on std::cerr.
+  */
+template<typename NumericT, unsigned int AlignmentV>
+bool write_binary_file(compressed_matrix<NumericT, AlignmentV> const & A, const char * file) { return detail::binary_access::write(A, file); }
+
+/** @brief Writes an ell_matrix to a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, unsigned int AlignmentV>
+bool write_binary_file(ell_matrix<NumericT, AlignmentV> const & A, const char * file) { return detail::binary_access::write(A, file); }
+
+/** @brief Writes a sliced_ell_matrix to a binary file. See the compressed_matrix overload for details. */
+template<typename ScalarT, typename IndexT>
+bool write_binary_file(sliced_ell_matrix<ScalarT, IndexT> const & A, const char * file) { return detail::binary_access::write(A, file); }
+
+/** @brief Writes a hyb_matrix to a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, unsigned int AlignmentV>
+bool write_binary_file(hyb_matrix<NumericT, AlignmentV> const & A, const char * file) { return detail::binary_access::write(A, file); }
+
+/** @brief Writes a dense matrix to a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, typename F, unsigned int AlignmentV>
+bool write_binary_file(matrix<NumericT, F, AlignmentV> const & A, const char * file) { return detail::binary_access::write(A, file); }
+
+/** @brief Convenience overload taking the filename as std::string. */
+template<typename MatrixT>
+bool write_binary_file(MatrixT const & A, std::string const & file) { return write_binary_file(A, file.c_str()); }
+
+
+/** @brief Reads a sparse or dense matrix from a binary file written by write_binary_file().
+  *
+  * The matrix is set up in its current memory context (or the default memory context if none has been set up yet):
+  * In main memory, the matrix refers to a copy-on-write memory mapping of the file, so no data is copied and pages are only loaded on first access.
+  * The mapping is released with the last handle referring to it. Changes to the matrix are never written back to the file.
+  * In OpenCL or CUDA memory, the arrays are transferred to newly created buffers in chunks.
+  *
+  * The numeric type, the index type, and the alignment or storage layout of the matrix need to match the ones of the matrix written to the file.
+  *
+  * @param A      The matrix. Its previous contents are discarded.
+  * @param file   The filename
+  * @return       True on success. Errors are reported on std::cerr and leave the matrix unchanged.
+  */
+template<typename NumericT, unsigned int AlignmentV>
+bool read_binary_file(compressed_matrix<NumericT, AlignmentV> & A, const char * file) { return detail::binary_access::read(A, file); }
+
+/** @brief Reads an ell_matrix from a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, unsigned int AlignmentV>
+bool read_binary_file(ell_matrix<NumericT, AlignmentV> & A, const char * file) { return detail::binary_access::read(A, file); }
+
+/** @brief Reads a sliced_ell_matrix from a binary file. See the compressed_matrix overload for details.
+  *
+  * Rows sorted within windows of sigma > 1 rows are only supported by the host kernels.
+  * Such files are therefore rearranged to the original row order when read into OpenCL or CUDA memory.
+  */
+template<typename ScalarT, typename IndexT>
+bool read_binary_file(sliced_ell_matrix<ScalarT, IndexT> & A, const char * file) { return detail::binary_access::read(A, file); }
+
+/** @brief Reads a hyb_matrix from a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, unsigned int AlignmentV>
+bool read_binary_file(hyb_matrix<NumericT, AlignmentV> & A, const char * file) { return detail::binary_access::read(A, file); }
+
+/** @brief Reads a dense matrix from a binary file. See the compressed_matrix overload for details. */
+template<typename NumericT, typename F, unsigned int AlignmentV>
+bool read_binary_file(matrix<NumericT, F, AlignmentV> & A, const char * file) { return detail::binary_access::read(A, file); }
+
+/** @brief Convenience overload taking the filename as std::string. */
+template<typename MatrixT>
+bool read_binary_file(MatrixT & A, std::string const & file) { return read_binary_file(A, file.c_str()); }
+
+} //namespace io
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef VIENNACL_IO_DETAIL_MAPPED_FILE_HPP
+#define VIENNACL_IO_DETAIL_MAPPED_FILE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/io/detail/mapped_file.hpp
+    @brief Provides access to the contents of a file through a memory mapping, which is shared by the file readers
+*/
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace io
+{
+namespace detail
+{
+
+/** @brief View of the contents of a file. The file is memory-mapped on POSIX systems and read into a buffer otherwise.
+  *
+  * If opened with copy_on_write set, the contents may be modified through data() without the modifications being written back to the file.
+  * Otherwise, the contents must not be modified.
+  */
+class mapped_file
+{
+public:
+  explicit mapped_file(const char * filename, bool copy_on_write = false) : good_(false), data_(NULL), size_(0)
+  {
+#ifdef _WIN32
+    (void)copy_on_write;
+    std::ifstream reader(filename, std::ios::binary);
+    if (!reader)
+      return;
+    buffer_.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+    data_ = buffer_.size() > 0 ? &(buffer_[0]) : NULL;
+    size_ = buffer_.size();
+    good_ = true;
+#else
+    mapping_ = MAP_FAILED;
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat file_info;
+    if (::fstat(fd, &file_info) == 0)
+    {
+      size_ = static_cast<vcl_size_t>(file_info.st_size);
+      if (size_ > 0)
+      {
+        mapping_ = ::mmap(NULL, size_, copy_on_write ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping_ != MAP_FAILED)
+        {
+          ::madvise(mapping_, size_, MADV_WILLNEED);
+          data_ = static_cast<char *>(mapping_);
+          good_ = true;
+        }
+      }
+      else
+        good_ = true;
+    }
+    ::close(fd);
+#endif
+  }
+
+  ~mapped_file()
+  {
+#ifndef _WIN32
+    if (mapping_ != MAP_FAILED)
+      ::munmap(mapping_, size_);
+#endif
+  }
+
+  bool good() const { return good_; }
+  const char * data() const { return data_; }
+  char * data() { return data_; }
+  vcl_size_t size() const { return size_; }
+
+private:
+  mapped_file(mapped_file const &);
+  mapped_file & operator=(mapped_file const &);
+
+  bool good_;
+  char * data_;
+  vcl_size_t size_;
+#ifdef _WIN32
+  std::vector<char> buffer_;
+#else
+  void * mapping_;
+#endif
+};
+
+} //namespace detail
+} //namespace io
+} //namespace viennacl
+
+#endif
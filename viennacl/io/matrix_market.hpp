@@ -31,6 +31,17 @@
 #include <vector>
 #include <map>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/io/detail/mapped_file.hpp"
 #include "viennacl/tools/adapter.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/fill.hpp"
@@ -83,6 +94,386 @@ namespace detail
   }
 
 
+  inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+  inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+  /** @brief Parses an integer after optional blanks. On success, 'pos' points past the last digit. */
+  inline bool parse_integer(const char * & pos, const char * end, long & value)
+  {
+    while (pos < end && is_blank(*pos))
+      ++pos;
+
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+'))
+      negative = (*pos++ == '-');
+
+    if (pos == end || !is_digit(*pos))
+      return false;
+
+    long result = 0;
+    while (pos < end && is_digit(*pos))
+      result = 10 * result + (*pos++ - '0');
+
+    value = negative ? -result : result;
+    return true;
+  }
+
+  /** @brief Parses a floating point number after optional blanks. On success, 'pos' points past the number.
+  *
+  * Numbers with at most 15 significant digits and a decimal exponent of at most 22 in magnitude are converted exactly with a single multiplication or division,
+  * since both the digits and the power of ten are exactly representable in double precision. All other numbers (including inf and nan) are passed on to strtod().
+  */
+  inline bool parse_real(const char * & pos, const char * end, double & value)
+  {
+    static const double powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    while (pos < end && is_blank(*pos))
+      ++pos;
+
+    const char * token_begin = pos;
+    const char * token_end = pos;
+    while (token_end < end && !is_blank(*token_end) && *token_end != '\n')
+      ++token_end;
+    if (token_begin == token_end)
+      return false;
+
+    // fast path:
+    const char * p = token_begin;
+    bool negative = false;
+    if (*p == '-' || *p == '+')
+      negative = (*p++ == '-');
+
+    double mantissa = 0;
+    long significant_digits = 0;
+    long exponent = 0;
+    bool has_digits = false;
+    for (; p < token_end && is_digit(*p); ++p, has_digits = true)
+    {
+      if (mantissa > 0 || *p != '0')
+      {
+        mantissa = 10 * mantissa + (*p - '0');
+        ++significant_digits;
+      }
+    }
+    if (p < token_end && *p == '.')
+    {
+      for (++p; p < token_end && is_digit(*p); ++p, has_digits = true)
+      {
+        if (mantissa > 0 || *p != '0')
+        {
+          mantissa = 10 * mantissa + (*p - '0');
+          ++significant_digits;
+        }
+        --exponent;
+      }
+    }
+    if (has_digits && p < token_end && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+      long decimal_exponent = 0;
+      if (!parse_integer(p, token_end, decimal_exponent))
+        has_digits = false;
+      exponent += decimal_exponent;
+    }
+
+    if (has_digits && p == token_end && significant_digits <= 15 && exponent >= -22 && exponent <= 22)
+    {
+      value = (exponent < 0) ? mantissa / powers_of_ten[-exponent] : mantissa * powers_of_ten[exponent];
+      if (negative)
+        value = -value;
+      pos = token_end;
+      return true;
+    }
+
+    // slow path: the mapped file is not null-terminated, so the token is copied first
+    char buffer[128];
+    vcl_size_t length = static_cast<vcl_size_t>(token_end - token_begin);
+    if (length >= sizeof(buffer))
+      return false;
+    std::copy(token_begin, token_end, buffer);
+    buffer[length] = 0;
+
+    char * parse_end;
+    value = std::strtod(buffer, &parse_end);
+    if (parse_end != buffer + length)
+      return false;
+    pos = token_end;
+    return true;
+  }
+
+  /** @brief Properties of a MatrixMarket file as given by the banner and the size line */
+  struct matrix_market_header
+  {
+    matrix_market_header() : pattern(false), symmetric(false), skew_symmetric(false), rows(0), cols(0), nnz(0), lines(0), data_offset(0) {}
+
+    bool pattern;
+    bool symmetric;
+    bool skew_symmetric;
+    vcl_size_t rows;
+    vcl_size_t cols;
+    vcl_size_t nnz;
+    long lines;              // number of lines up to and including the size line
+    vcl_size_t data_offset;  // offset of the first character after the size line
+  };
+
+  /** @brief Parses the banner, the comments, and the size line of a MatrixMarket file in coordinate format. Returns false and prints an error message if the header is not supported. */
+  inline bool parse_matrix_market_header(const char * data, vcl_size_t size, const char * file, matrix_market_header & header)
+  {
+    vcl_size_t offset = 0;
+    long linenum = 0;
+    while (offset < size)
+    {
+      vcl_size_t line_end = offset;
+      while (line_end < size && data[line_end] != '\n')
+        ++line_end;
+      ++linenum;
+
+      std::string line_string(data + offset, data + line_end);
+      offset = (line_end < size) ? line_end + 1 : line_end;
+
+      if (line_string.size() >= 2 && line_string[0] == '%' && line_string[1] == '%')
+      {
+        std::stringstream line(line_string.substr(2));
+        std::string token, object, format, field, symmetry;
+        line >> token >> object >> format >> field >> symmetry;
+        detail::tolower(token);
+        detail::tolower(object);
+        detail::tolower(format);
+        detail::tolower(field);
+        detail::tolower(symmetry);
+        if (token != "matrixmarket" || object != "matrix")
+        {
+          std::cerr << "Error in file " << file << " at line " << linenum << ": Expected 'MatrixMarket matrix', got '" << token << " " << object << "'" << std::endl;
+          return false;
+        }
+        if (format != "coordinate")
+        {
+          std::cerr << "Error in file " << file << " at line " << linenum << ": Only the 'coordinate' format is supported by the parallel reader, got '" << format << "'" << std::endl;
+          return false;
+        }
+        if (field == "pattern")
+          header.pattern = true;
+        else if (field != "real" && field != "integer")
+        {
+          std::cerr << "Error in file " << file << ": The MatrixMarket reader provided with ViennaCL supports only real, integer, or pattern matrices." << std::endl;
+          return false;
+        }
+        if (symmetry == "symmetric")
+          header.symmetric = true;
+        else if (symmetry == "skew-symmetric")
+          header.skew_symmetric = true;
+        else if (symmetry != "general")
+        {
+          std::cerr << "Error in file " << file << ": The MatrixMarket reader provided with ViennaCL supports only general, symmetric, or skew-symmetric matrices." << std::endl;
+          return false;
+        }
+        continue;
+      }
+
+      const char * pos = line_string.c_str();
+      const char * pos_end = pos + line_string.size();
+      while (pos < pos_end && is_blank(*pos))
+        ++pos;
+      if (pos == pos_end || *pos == '%') // empty line or comment
+        continue;
+
+      long rows, cols, nnz;
+      if (!parse_integer(pos, pos_end, rows) || !parse_integer(pos, pos_end, cols) || !parse_integer(pos, pos_end, nnz) || rows < 0 || cols < 0 || nnz < 0)
+      {
+        std::cerr << "Error in file " << file << ": Could not get matrix dimensions in line " << linenum << std::endl;
+        return false;
+      }
+      header.rows = static_cast<vcl_size_t>(rows);
+      header.cols = static_cast<vcl_size_t>(cols);
+      header.nnz  = static_cast<vcl_size_t>(nnz);
+      header.lines = linenum;
+      header.data_offset = offset;
+      return true;
+    }
+
+    std::cerr << "Error in file " << file << ": Could not find the line with the matrix dimensions" << std::endl;
+    return false;
+  }
+
+  /** @brief Entries parsed from one chunk of the data section of a MatrixMarket file, including the mirrored entries of symmetric matrices. */
+  template<typename NumericT>
+  struct matrix_market_chunk
+  {
+    matrix_market_chunk() : file_entries(0), lines(0), error_line(0) {}
+
+    std::vector<unsigned int> rows;
+    std::vector<unsigned int> cols;
+    std::vector<NumericT>     values;
+    vcl_size_t  file_entries;
+    long        lines;
+    long        error_line;  // line within the chunk at which parsing failed, zero if successful
+    std::string error;
+  };
+
+  /** @brief Parses the lines in [begin, end), where 'begin' is at the start of a line and 'end' is one past a newline character or the end of the file. */
+  template<typename NumericT>
+  void parse_matrix_market_chunk(const char * begin, const char * end, matrix_market_header const & header, long index_base, matrix_market_chunk<NumericT> & chunk)
+  {
+    const char * pos = begin;
+    while (pos < end)
+    {
+      ++chunk.lines;
+      while (pos < end && is_blank(*pos))
+        ++pos;
+
+      if (pos < end && *pos != '\n' && *pos != '%')
+      {
+        long row, col;
+        double value = 1.0;
+        if (!parse_integer(pos, end, row) || !parse_integer(pos, end, col) || (!header.pattern && !parse_real(pos, end, value)))
+        {
+          chunk.error_line = chunk.lines;
+          chunk.error = "Parse error for matrix entry";
+          return;
+        }
+
+        row -= index_base;
+        col -= index_base;
+        if (row < 0 || row >= static_cast<long>(header.rows) || col < 0 || col >= static_cast<long>(header.cols))
+        {
+          chunk.error_line = chunk.lines;
+          chunk.error = "Index out of bounds";
+          return;
+        }
+
+        chunk.rows.push_back(static_cast<unsigned int>(row));
+        chunk.cols.push_back(static_cast<unsigned int>(col));
+        chunk.values.push_back(static_cast<NumericT>(value));
+        if ((header.symmetric || header.skew_symmetric) && row != col)
+        {
+          chunk.rows.push_back(static_cast<unsigned int>(col));
+          chunk.cols.push_back(static_cast<unsigned int>(row));
+          chunk.values.push_back(static_cast<NumericT>(header.skew_symmetric ? -value : value));
+        }
+        ++chunk.file_entries;
+      }
+
+      // skip the remainder of the line:
+      while (pos < end && *pos != '\n')
+        ++pos;
+      if (pos < end)
+        ++pos;
+    }
+  }
+
+  /** @brief Returns the number of chunks into which the data section of a file is split. Each chunk holds at least 64 KB. */
+  inline vcl_size_t matrix_market_num_chunks(vcl_size_t bytes)
+  {
+    vcl_size_t max_chunks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    max_chunks = static_cast<vcl_size_t>(4 * omp_get_max_threads());
+#endif
+    return std::max<vcl_size_t>(1, std::min<vcl_size_t>(max_chunks, bytes / 65536));
+  }
+
+  /** @brief Sorts the entries of each row by column index. If an entry occurs more than once, the last one in the file is kept. Returns the number of remaining entries. */
+  template<typename NumericT>
+  vcl_size_t sort_csr_rows(std::vector<unsigned int> & row_buffer, std::vector<unsigned int> & col_buffer, std::vector<NumericT> & elements)
+  {
+    long rows = static_cast<long>(row_buffer.size()) - 1;
+    std::vector<unsigned int> row_lengths(row_buffer.size() - 1);
+
+    // rows up to this length or already sorted are handled by insertion sort, longer rows by std::sort:
+    unsigned int const insertion_sort_max_length = 32;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (col_buffer.size() > 100000)
+#endif
+    {
+      // (column, position in file) pairs and values of long rows:
+      std::vector<std::pair<unsigned int, unsigned int> > sort_keys;
+      std::vector<NumericT> sorted_elements;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long row = 0; row < rows; ++row)
+      {
+        unsigned int row_begin = row_buffer[static_cast<vcl_size_t>(row)];
+        unsigned int row_end   = row_buffer[static_cast<vcl_size_t>(row) + 1];
+
+        bool is_sorted = true;
+        for (unsigned int i = row_begin + 1; i < row_end && is_sorted; ++i)
+          is_sorted = (col_buffer[i - 1] <= col_buffer[i]);
+
+        if (is_sorted || row_end - row_begin <= insertion_sort_max_length)
+        {
+          // stable insertion sort, linear for rows that are sorted already:
+          for (unsigned int i = row_begin + 1; i < row_end; ++i)
+          {
+            unsigned int col = col_buffer[i];
+            NumericT value = elements[i];
+            unsigned int j = i;
+            for (; j > row_begin && col_buffer[j - 1] > col; --j)
+            {
+              col_buffer[j] = col_buffer[j - 1];
+              elements[j]   = elements[j - 1];
+            }
+            col_buffer[j] = col;
+            elements[j]   = value;
+          }
+        }
+        else
+        {
+          // the position in the file breaks ties, so duplicates keep their order as with the stable insertion sort:
+          sort_keys.resize(row_end - row_begin);
+          for (unsigned int i = row_begin; i < row_end; ++i)
+            sort_keys[i - row_begin] = std::make_pair(col_buffer[i], i);
+          std::sort(sort_keys.begin(), sort_keys.end());
+
+          sorted_elements.resize(row_end - row_begin);
+          for (vcl_size_t i = 0; i < sort_keys.size(); ++i)
+            sorted_elements[i] = elements[sort_keys[i].second];
+          for (vcl_size_t i = 0; i < sort_keys.size(); ++i)
+          {
+            col_buffer[row_begin + i] = sort_keys[i].first;
+            elements[row_begin + i]   = sorted_elements[i];
+          }
+        }
+
+
+        // merge duplicates:
+        unsigned int length = 0;
+        for (unsigned int i = row_begin; i < row_end; ++i)
+        {
+          if (length > 0 && col_buffer[row_begin + length - 1] == col_buffer[i])
+            elements[row_begin + length - 1] = elements[i];
+          else
+          {
+            col_buffer[row_begin + length] = col_buffer[i];
+            elements[row_begin + length]   = elements[i];
+            ++length;
+          }
+        }
+        row_lengths[static_cast<vcl_size_t>(row)] = length;
+      }
+    }
+
+    // remove the gaps left by merged duplicates:
+    unsigned int nnz = 0;
+    for (vcl_size_t row = 0; row < row_lengths.size(); ++row)
+    {
+      unsigned int row_begin = row_buffer[row];
+      if (row_begin != nnz)
+      {
+        std::copy(col_buffer.begin() + row_begin, col_buffer.begin() + row_begin + row_lengths[row], col_buffer.begin() + nnz);
+        std::copy(elements.begin()   + row_begin, elements.begin()   + row_begin + row_lengths[row], elements.begin()   + nnz);
+      }
+      row_buffer[row] = nnz;
+      nnz += row_lengths[row];
+    }
+    row_buffer[row_lengths.size()] = nnz;
+
+    col_buffer.resize(nnz);
+    elements.resize(nnz);
+    return nnz;
+  }
 
 } //namespace
 
@@ -353,6 +744,170 @@ long read_matrix_market_file(std::vector< std::map<unsigned int, ScalarT> > & ma
 }
 
 
+/** @brief Reads a sparse matrix in coordinate format from a MatrixMarket file into compressed sparse row (CSR) arrays.
+*
+* The file is memory-mapped and split into chunks at line boundaries, which are parsed in parallel if OpenMP is enabled.
+* The CSR arrays are then built by counting the entries per row and filling in the entries in the order of the file.
+* Symmetric and skew-symmetric matrices are expanded to both triangles, pattern matrices get the value one for all entries.
+* The entries of each row are sorted by column index. Entries which occur more than once in the file are replaced by their last occurrence.
+*
+* @param row_buffer   On return, the rows+1 offsets of the rows in col_buffer and elements
+* @param col_buffer   On return, the column indices
+* @param elements     On return, the values
+* @param rows         On return, the number of rows
+* @param cols         On return, the number of columns
+* @param file         The filename
+* @param index_base   The index base, typically 1
+* @return Returns the number of lines read if the file is read correctly, zero otherwise
+*/
+template<typename NumericT>
+long read_matrix_market_file(std::vector<unsigned int> & row_buffer,
+                             std::vector<unsigned int> & col_buffer,
+                             std::vector<NumericT> & elements,
+                             vcl_size_t & rows,
+                             vcl_size_t & cols,
+                             const char * file,
+                             long index_base = 1)
+{
+  detail::mapped_file mapped(file);
+  if (!mapped.good())
+  {
+    std::cerr << "ViennaCL: Matrix Market Reader: Cannot open file " << file << std::endl;
+    return 0;
+  }
+
+  detail::matrix_market_header header;
+  if (!detail::parse_matrix_market_header(mapped.data(), mapped.size(), file, header))
+    return 0;
+
+  // split the data section at line boundaries:
+  const char * data_begin = mapped.data() + header.data_offset;
+  const char * data_end   = mapped.data() + mapped.size();
+  vcl_size_t num_chunks = detail::matrix_market_num_chunks(static_cast<vcl_size_t>(data_end - data_begin));
+  std::vector<const char *> chunk_begin(num_chunks + 1, data_end);
+  chunk_begin[0] = data_begin;
+  for (vcl_size_t i = 1; i < num_chunks; ++i)
+  {
+    const char * pos = std::max(chunk_begin[i - 1], data_begin + (static_cast<vcl_size_t>(data_end - data_begin) / num_chunks) * i);
+    while (pos < data_end && pos > data_begin && *(pos - 1) != '\n')
+      ++pos;
+    chunk_begin[i] = pos;
+  }
+
+  std::vector<detail::matrix_market_chunk<NumericT> > chunks(num_chunks);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic) if (num_chunks > 1)
+#endif
+  for (long i = 0; i < static_cast<long>(num_chunks); ++i)
+    detail::parse_matrix_market_chunk(chunk_begin[static_cast<vcl_size_t>(i)], chunk_begin[static_cast<vcl_size_t>(i) + 1], header, index_base, chunks[static_cast<vcl_size_t>(i)]);
+
+  long linenum = header.lines;
+  vcl_size_t file_entries = 0;
+  vcl_size_t nnz = 0;
+  for (vcl_size_t i = 0; i < num_chunks; ++i)
+  {
+    if (chunks[i].error_line > 0)
+    {
+      std::cerr << "Error in file " << file << " at line " << linenum + chunks[i].error_line << ": " << chunks[i].error
+                << " (matrix dim: " << header.rows << " x " << header.cols << ")" << std::endl;
+      return 0;
+    }
+    linenum += chunks[i].lines;
+    file_entries += chunks[i].file_entries;
+    nnz += chunks[i].values.size();
+  }
+  if (file_entries != header.nnz)
+  {
+    std::cerr << "Error in file " << file << ": Expected " << header.nnz << " entries, found " << file_entries << std::endl;
+    return 0;
+  }
+
+  // count entries per row, then fill in the entries in the order of the file:
+  row_buffer.assign(header.rows + 1, 0);
+  for (vcl_size_t i = 0; i < num_chunks; ++i)
+    for (vcl_size_t k = 0; k < chunks[i].rows.size(); ++k)
+      ++row_buffer[chunks[i].rows[k] + 1];
+  for (vcl_size_t row = 0; row < header.rows; ++row)
+    row_buffer[row + 1] += row_buffer[row];
+
+  std::vector<unsigned int> row_fill(row_buffer.begin(), row_buffer.end() - 1);
+  col_buffer.resize(nnz);
+  elements.resize(nnz);
+  for (vcl_size_t i = 0; i < num_chunks; ++i)
+  {
+    for (vcl_size_t k = 0; k < chunks[i].rows.size(); ++k)
+    {
+      unsigned int index = row_fill[chunks[i].rows[k]]++;
+      col_buffer[index] = chunks[i].cols[k];
+      elements[index]   = chunks[i].values[k];
+    }
+    std::vector<unsigned int>().swap(chunks[i].rows);
+    std::vector<unsigned int>().swap(chunks[i].cols);
+    std::vector<NumericT>().swap(chunks[i].values);
+  }
+
+  detail::sort_csr_rows(row_buffer, col_buffer, elements);
+
+  rows = header.rows;
+  cols = header.cols;
+  return linenum;
+}
+
+template<typename NumericT>
+long read_matrix_market_file(std::vector<unsigned int> & row_buffer,
+                             std::vector<unsigned int> & col_buffer,
+                             std::vector<NumericT> & elements,
+                             vcl_size_t & rows,
+                             vcl_size_t & cols,
+                             const std::string & file,
+                             long index_base = 1)
+{
+  return read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, file.c_str(), index_base);
+}
+
+/** @brief Reads a sparse matrix in coordinate format from a MatrixMarket file directly into a compressed_matrix. See the overload for CSR arrays for details.
+*
+* @param mat The matrix that is to be read. Its memory context is preserved.
+* @param file The filename
+* @param index_base The index base, typically 1
+* @return Returns the number of lines read if the file is read correctly, zero otherwise
+*/
+template<typename NumericT, unsigned int AlignmentV>
+long read_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+                             const char * file,
+                             long index_base = 1)
+{
+  std::vector<unsigned int> row_buffer;
+  std::vector<unsigned int> col_buffer;
+  std::vector<NumericT> elements;
+  vcl_size_t rows, cols;
+
+  long linenum = read_matrix_market_file(row_buffer, col_buffer, elements, rows, cols, file, index_base);
+  if (linenum == 0 || row_buffer.size() == 0 || rows == 0 || cols == 0) // error or empty matrix
+    return linenum;
+
+  vcl_size_t nnz = elements.size();
+  if (nnz == 0) // set() needs at least one entry
+  {
+    col_buffer.push_back(0);
+    elements.push_back(0);
+  }
+  mat.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), rows, cols, elements.size());
+  if (nnz == 0)
+    mat.clear();
+
+  return linenum;
+}
+
+template<typename NumericT, unsigned int AlignmentV>
+long read_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+                             const std::string & file,
+                             long index_base = 1)
+{
+  return read_matrix_market_file(mat, file.c_str(), index_base);
+}
+
+
 ////////// writer /////////////
 template<typename MatrixT>
 void write_matrix_market_file_impl(MatrixT const & mat, const char * file, long index_base)
@@ -417,6 +972,120 @@ void write_matrix_market_file(MatrixT const & mat,
 }
 
 
+/** @brief Writes a sparse matrix given by compressed sparse row (CSR) arrays to a file (MatrixMarket format).
+*
+* The lines are formatted in parallel if OpenMP is enabled, using chunks of rows with about the same number of nonzeros.
+* Values are written with enough digits to be read back without loss.
+*
+* @param row_buffer   The rows+1 offsets of the rows in col_buffer and elements
+* @param col_buffer   The column indices
+* @param elements     The values
+* @param rows         The number of rows
+* @param cols         The number of columns
+* @param file         The filename
+* @param index_base   The index base, typically 1
+*/
+template<typename NumericT>
+void write_matrix_market_file(unsigned int const * row_buffer,
+                              unsigned int const * col_buffer,
+                              NumericT const * elements,
+                              vcl_size_t rows,
+                              vcl_size_t cols,
+                              const char * file,
+                              long index_base = 1)
+{
+  std::ofstream writer(file, std::ios::binary);
+  writer << "%%MatrixMarket matrix coordinate real general" << std::endl;
+  writer << rows << " " << cols << " " << row_buffer[rows] << std::endl;
+
+  // chunks of rows holding about 2^18 entries each, formatted in parallel and written in batches:
+  vcl_size_t nnz = row_buffer[rows];
+  vcl_size_t num_chunks = std::max<vcl_size_t>(1, nnz / 262144);
+  vcl_size_t batch_size = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  batch_size = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+  int precision = std::numeric_limits<NumericT>::digits10 + 3;
+
+  std::vector<std::string> buffers(batch_size);
+  for (vcl_size_t batch_start = 0; batch_start < num_chunks; batch_start += batch_size)
+  {
+    vcl_size_t batch_end = std::min(batch_start + batch_size, num_chunks);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (batch_end - batch_start > 1)
+#endif
+    for (long i = static_cast<long>(batch_start); i < static_cast<long>(batch_end); ++i)
+    {
+      vcl_size_t chunk = static_cast<vcl_size_t>(i);
+      vcl_size_t row_begin = static_cast<vcl_size_t>(std::upper_bound(row_buffer, row_buffer + rows + 1, static_cast<unsigned int>((nnz *  chunk     ) / num_chunks)) - row_buffer) - 1;
+      vcl_size_t row_end   = static_cast<vcl_size_t>(std::upper_bound(row_buffer, row_buffer + rows + 1, static_cast<unsigned int>((nnz * (chunk + 1)) / num_chunks)) - row_buffer) - 1;
+      if (chunk + 1 == num_chunks)
+        row_end = rows;
+
+      std::string & buffer = buffers[chunk - batch_start];
+      buffer.clear();
+      char line[128];
+      for (vcl_size_t row = row_begin; row < row_end; ++row)
+      {
+        for (unsigned int k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+        {
+          int length = std::sprintf(line, "%ld %ld %.*g\n", static_cast<long>(row) + index_base, static_cast<long>(col_buffer[k]) + index_base, precision, static_cast<double>(elements[k]));
+          buffer.append(line, static_cast<vcl_size_t>(length));
+        }
+      }
+    }
+
+    for (vcl_size_t chunk = batch_start; chunk < batch_end; ++chunk)
+      writer.write(buffers[chunk - batch_start].data(), static_cast<std::streamsize>(buffers[chunk - batch_start].size()));
+  }
+
+  writer.close();
+}
+
+/** @brief Writes a compressed_matrix to a file (MatrixMarket format). The CSR arrays are passed through main memory. See the overload for CSR arrays for details.
+*
+* @param mat The matrix that is to be written
+* @param file The filename
+* @param index_base The index base, typically 1
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void write_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> const & mat,
+                              const char * file,
+                              long index_base = 1)
+{
+  std::vector<unsigned int> row_buffer(mat.size1() + 1);
+  std::vector<unsigned int> col_buffer(std::max<vcl_size_t>(mat.nnz(), 1));
+  std::vector<NumericT>     elements(std::max<vcl_size_t>(mat.nnz(), 1));
+
+  if (mat.size1() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer_host(mat.handle1(), mat.size1() + 1);
+    viennacl::backend::memory_read(mat.handle1(), 0, row_buffer_host.raw_size(), row_buffer_host.get());
+    for (vcl_size_t i = 0; i <= mat.size1(); ++i)
+      row_buffer[i] = static_cast<unsigned int>(row_buffer_host[i]);
+  }
+  if (mat.nnz() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> col_buffer_host(mat.handle2(), mat.nnz());
+    viennacl::backend::memory_read(mat.handle2(), 0, col_buffer_host.raw_size(), col_buffer_host.get());
+    viennacl::backend::memory_read(mat.handle(),  0, sizeof(NumericT) * mat.nnz(), &(elements[0]));
+    for (vcl_size_t k = 0; k < mat.nnz(); ++k)
+      col_buffer[k] = static_cast<unsigned int>(col_buffer_host[k]);
+  }
+
+  write_matrix_market_file(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), mat.size1(), mat.size2(), file, index_base);
+}
+
+template<typename NumericT, unsigned int AlignmentV>
+void write_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> const & mat,
+                              const std::string & file,
+                              long index_base = 1)
+{
+  write_matrix_market_file(mat, file.c_str(), index_base);
+}
+
+
 } //namespace io
 } //namespace viennacl
 
@@ -37,10 +37,13 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
 
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/detail/amg/amg_coarse.hpp"
 #include "viennacl/linalg/detail/amg/amg_interpol.hpp"
+#include "viennacl/linalg/detail/amg/amg_aggregation.hpp"
+#include "viennacl/linalg/detail/amg/amg_smoother.hpp"
 
 #include <map>
 
@@ -252,6 +255,45 @@ void amg_transform_gpu(InternalT1 & A, InternalT1 & P, InternalT1 & R, InternalT
   }
 }
 
+/** @brief Copies the operators of the aggregation-based setup phase (in host memory) to the memory domain used for the precondition phase.
+*
+* @param A          Operator matrices on all levels in the target memory domain
+* @param P          Prolongation/Interpolation operators on all levels in the target memory domain
+* @param R          Restriction operators on all levels in the target memory domain
+* @param A_setup    Operators matrices on all levels from setup phase
+* @param P_setup    Prolongation/Interpolation operators on all levels from setup phase
+* @param R_setup    Restriction operators on all levels from setup phase
+* @param tag        AMG preconditioner tag
+* @param ctx        Context in which the operators are created (one out of multiple OpenCL contexts, CUDA, host)
+*/
+template<typename InternalT1, typename InternalT2>
+void amg_transform_agg(InternalT1 & A, InternalT1 & P, InternalT1 & R,
+                       InternalT2 const & A_setup, InternalT2 const & P_setup, InternalT2 const & R_setup,
+                       amg_tag const & tag, viennacl::context ctx)
+{
+  // Operators from a previous setup may differ in size, hence start from empty matrices.
+  A.resize(0, false);
+  P.resize(0, false);
+  R.resize(0, false);
+
+  A.resize(tag.get_coarselevels()+1, false);
+  P.resize(tag.get_coarselevels(), false);
+  R.resize(tag.get_coarselevels(), false);
+
+  for (unsigned int i=0; i<tag.get_coarselevels()+1; ++i)
+  {
+    viennacl::switch_memory_context(A[i], ctx);
+    A[i] = A_setup[i];
+  }
+  for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
+  {
+    viennacl::switch_memory_context(P[i], ctx);
+    P[i] = P_setup[i];
+    viennacl::switch_memory_context(R[i], ctx);
+    R[i] = R_setup[i];
+  }
+}
+
 /** @brief Setup data structures for precondition phase.
 *
 * @param result      Result vector on all levels
@@ -338,6 +380,23 @@ void amg_lu(boost::numeric::ublas::compressed_matrix<NumericT> & op, boost::nume
   boost::numeric::ublas::lu_factorize(op, permutation);
 }
 
+/** @brief Pre-compute LU factorization for direct solve (ublas library) for an operator given as viennacl::compressed_matrix.
+*
+* @param op           Operator matrix for direct solve
+* @param permutation  Permutation matrix which saves the factorization result
+* @param A            Operator matrix on coarsest level
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_lu(boost::numeric::ublas::compressed_matrix<NumericT> & op, boost::numeric::ublas::permutation_matrix<> & permutation, viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+{
+  op.resize(A.size1(),A.size2(),false);
+  viennacl::copy(A, op);
+
+  // Permutation matrix has to be reinitialized with actual size. Do not clear() or resize()!
+  permutation = boost::numeric::ublas::permutation_matrix<> (op.size1());
+  boost::numeric::ublas::lu_factorize(op, permutation);
+}
+
 /** @brief AMG preconditioner class, can be supplied to solve()-routines
 */
 template<typename MatrixT>
@@ -585,64 +644,145 @@ class amg_precond< compressed_matrix<NumericT, AlignmentV> >
   boost::numeric::ublas::vector<MatrixType>       R_;
   boost::numeric::ublas::vector<PointVectorType>  pointvector_;
 
+  // operators of the aggregation-based setup phase in host memory:
+  std::vector<MatrixType> A_agg_;
+  std::vector<MatrixType> P_agg_;
+  std::vector<MatrixType> R_agg_;
+  std::vector<detail::amg::amg_agg_level<NumericT, AlignmentV> > levels_agg_;
+
   mutable boost::numeric::ublas::compressed_matrix<NumericT>  op_;
   mutable boost::numeric::ublas::permutation_matrix<>         permutation_;
 
   mutable boost::numeric::ublas::vector<VectorType> result_;
   mutable boost::numeric::ublas::vector<VectorType> rhs_;
   mutable boost::numeric::ublas::vector<VectorType> residual_;
+  mutable boost::numeric::ublas::vector<VectorType> diag_;
+  mutable boost::numeric::ublas::vector<VectorType> smoother_tmp_;
+  mutable std::vector<NumericT>                     lambda_max_;
 
   viennacl::context ctx_;
 
   mutable bool done_init_apply_;
+  unsigned int reuse_count_;
+  unsigned int requested_coarselevels_;
 
   amg_tag tag_;
 
 public:
 
-  amg_precond(): permutation_(0) {}
+  amg_precond(): permutation_(0), reuse_count_(0), requested_coarselevels_(0) {}
 
   /** @brief The constructor. Builds data structures.
   *
   * @param mat  System matrix
   * @param tag  The AMG tag
   */
-  amg_precond(compressed_matrix<NumericT, AlignmentV> const & mat, amg_tag const & tag): permutation_(0), ctx_(viennacl::traits::context(mat))
+  amg_precond(compressed_matrix<NumericT, AlignmentV> const & mat, amg_tag const & tag): permutation_(0), ctx_(viennacl::traits::context(mat)), reuse_count_(0)
   {
     tag_ = tag;
-
-    // Copy to CPU. Internal structure of sparse matrix is used for copy operation.
-    std::vector<std::map<unsigned int, NumericT> > mat2 = std::vector<std::map<unsigned int, NumericT> >(mat.size1());
-    viennacl::copy(mat, mat2);
-
-    // Initialize data structures.
-    amg_init (mat2, A_setup_, P_setup_, pointvector_, tag_);
-
-    done_init_apply_ = false;
+    requested_coarselevels_ = tag.get_coarselevels();
+    init(mat);
   }
 
   /** @brief Start setup phase for this class and copy data structures.
   */
   void setup()
   {
-    // Start setup phase.
-    amg_setup(A_setup_, P_setup_, pointvector_, tag_);
-    // Transform to GPU-Matrixtype for precondition phase.
-    amg_transform_gpu(A_, P_, R_, A_setup_, P_setup_, tag_, ctx_);
+    if (uses_aggregation())
+    {
+      detail::amg::amg_agg_setup(A_agg_, P_agg_, R_agg_, levels_agg_, tag_);
+      amg_transform_agg(A_, P_, R_, A_agg_, P_agg_, R_agg_, tag_, ctx_);
+    }
+    else
+    {
+      // Start setup phase.
+      amg_setup(A_setup_, P_setup_, pointvector_, tag_);
+      // Transform to GPU-Matrixtype for precondition phase.
+      amg_transform_gpu(A_, P_, R_, A_setup_, P_setup_, tag_, ctx_);
+    }
 
+    reuse_count_ = 0;
     done_init_apply_ = false;
   }
 
+  /** @brief Updates the preconditioner for a new system matrix with the same sparsity pattern as the matrix passed to the constructor.
+  *
+  * For the aggregation-based coarsenings (VIENNACL_AMG_COARSE_AG_GREEDY, VIENNACL_AMG_COARSE_AG_MIS2), aggregates and the sparsity patterns of all operators are kept
+  * and only the numeric values of the prolongations, restrictions, and coarse grid operators are recomputed. For all other coarsenings, a full setup is carried out.
+  *
+  * If a hierarchy reuse count n is set in the tag (cf. amg_tag::set_hierarchy_reuse()), the next n calls keep the preconditioner unchanged, the call thereafter updates it.
+  *
+  * @param mat  The new system matrix
+  */
+  void resetup(MatrixType const & mat)
+  {
+    assert( (mat.size1() == A_[0].size1()) && bool("Size mismatch of new system matrix in AMG preconditioner"));
+
+    // Reuse of hierarchy: The preconditioner for the previous matrix is kept as a whole.
+    // Replacing only the finest level would mix operators of different matrices within the cycle, which is usually worse.
+    if (reuse_count_ < tag_.get_hierarchy_reuse())
+    {
+      ++reuse_count_;
+      return;
+    }
+    reuse_count_ = 0;
+
+    if (!uses_aggregation() || mat.nnz() != A_agg_[0].nnz())
+    {
+      A_.resize(0, false);
+      P_.resize(0, false);
+      R_.resize(0, false);
+      tag_.set_coarselevels(requested_coarselevels_);
+      init(mat);
+      setup();
+      return;
+    }
+
+    // Numeric update of the hierarchy in host memory:
+    A_agg_[0] = mat;
+    detail::amg::amg_agg_resetup(A_agg_, P_agg_, R_agg_, levels_agg_, tag_);
+
+    // Transfer of the new values. The sparsity patterns are unchanged.
+    A_[0] = mat;
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+    {
+      viennacl::backend::typesafe_memory_copy<NumericT>(A_agg_[level+1].handle(), A_[level+1].handle());
+      viennacl::backend::typesafe_memory_copy<NumericT>(P_agg_[level].handle(), P_[level].handle());
+      viennacl::backend::typesafe_memory_copy<NumericT>(R_agg_[level].handle(), R_[level].handle());
+    }
+
+    if (done_init_apply_)
+      init_apply_numeric();
+  }
+
   /** @brief Prepare data structures for preconditioning:
    *  Build data structures for precondition phase.
    *  Do LU factorization on coarsest level.
   */
   void init_apply() const
   {
+    // Vectors from a previous setup may differ in size, hence start from empty containers.
+    result_.resize(0, false);
+    rhs_.resize(0, false);
+    residual_.resize(0, false);
+    diag_.resize(0, false);
+    smoother_tmp_.resize(0, false);
+
     // Setup precondition phase (Data structures).
-    amg_setup_apply(result_, rhs_, residual_, A_setup_, tag_, ctx_);
-    // Do LU factorization for direct solve.
-    amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
+    amg_setup_apply(result_, rhs_, residual_, A_, tag_, ctx_);
+
+    diag_.resize(tag_.get_coarselevels(), false);
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+      diag_[level] = VectorType(A_[level].size1(), ctx_);
+
+    if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_CHEBYSHEV)
+    {
+      smoother_tmp_.resize(tag_.get_coarselevels(), false);
+      for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+        smoother_tmp_[level] = VectorType(A_[level].size1(), ctx_);
+    }
+
+    init_apply_numeric();
 
     done_init_apply_ = true;
   }
@@ -661,16 +801,17 @@ public:
     for (unsigned int level=0; level < tag_.get_coarselevels()+1; ++level)
     {
       level_coefficients = 0;
-      for (InternalRowIterator row_iter = A_setup_[level].begin1(); row_iter != A_setup_[level].end1(); ++row_iter)
+      if (uses_aggregation())
+        level_coefficients = static_cast<unsigned int>(A_[level].nnz());
+      else
       {
-        for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
-        {
-          if (level == 0)
-            systemmat_nonzero++;
-          nonzero++;
-          level_coefficients++;
-        }
+        for (InternalRowIterator row_iter = A_setup_[level].begin1(); row_iter != A_setup_[level].end1(); ++row_iter)
+          for (InternalColIterator col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+            level_coefficients++;
       }
+      if (level == 0)
+        systemmat_nonzero = level_coefficients;
+      nonzero += level_coefficients;
       avgstencil[level] = level_coefficients/static_cast<double>(A_[level].size1());
     }
     return nonzero/static_cast<double>(systemmat_nonzero);
@@ -695,7 +836,7 @@ public:
       result_[level].clear();
 
       // Apply Smoother presmooth_ times.
-      smooth_jacobi(level, tag_.get_presmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_presmooth(), result_[level], rhs_[level], true);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After presmooth: " << std::endl;
@@ -754,7 +895,7 @@ public:
       #endif
 
       // Apply Smoother postsmooth_ times.
-      smooth_jacobi(level, tag_.get_postsmooth(), result_[level], rhs_[level]);
+      smooth(level, tag_.get_postsmooth(), result_[level], rhs_[level], false);
 
       #ifdef VIENNACL_AMG_DEBUG
       std::cout << "After postsmooth: " << std::endl;
@@ -764,7 +905,125 @@ public:
     vec = result_[0];
   }
 
-  /** @brief Jacobi Smoother (GPU version)
+  /** @brief Applies the smoother selected in the tag
+  * @param level        Coarse level to which smoother is applied to
+  * @param iterations   Number of smoother iterations (degree of the polynomial for the Chebyshev smoother)
+  * @param x            The vector smoothing is applied to
+  * @param rhs_smooth   The right hand side of the equation for the smoother
+  * @param presmoothing Whether this is presmoothing (forward sweeps) or postsmoothing (backward sweeps) for hybrid Gauss-Seidel
+  */
+  template<typename VectorT>
+  void smooth(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, bool presmoothing) const
+  {
+    switch (tag_.get_smoother())
+    {
+    case VIENNACL_AMG_SMOOTHER_L1_JACOBI:
+      smooth_l1_jacobi(level, iterations, x, rhs_smooth);
+      break;
+    case VIENNACL_AMG_SMOOTHER_HYBRID_GS:
+      if (viennacl::traits::active_handle_id(x) == viennacl::MAIN_MEMORY)
+        smooth_hybrid_gs(level, iterations, x, rhs_smooth, presmoothing);
+      else
+        smooth_l1_jacobi(level, iterations, x, rhs_smooth);
+      break;
+    case VIENNACL_AMG_SMOOTHER_CHEBYSHEV:
+      smooth_chebyshev(level, iterations, x, rhs_smooth);
+      break;
+    default:
+      smooth_jacobi(level, iterations, x, rhs_smooth);
+    }
+  }
+
+  /** @brief l1-Jacobi Smoother: x += D_l1^{-1} (rhs - A x), where D_l1 holds the l1-norms of the rows of A
+  * @param level       Coarse level to which smoother is applied to
+  * @param iterations  Number of smoother iterations
+  * @param x           The vector smoothing is applied to
+  * @param rhs_smooth  The right hand side of the equation for the smoother
+  */
+  template<typename VectorT>
+  void smooth_l1_jacobi(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth) const
+  {
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      residual_[level] = viennacl::linalg::prod(A_[level], x);
+      residual_[level] = rhs_smooth - residual_[level];
+      residual_[level] = viennacl::linalg::element_div(residual_[level], diag_[level]);
+      x += residual_[level];
+    }
+  }
+
+  /** @brief Hybrid Gauss-Seidel Smoother (host memory only): Gauss-Seidel within the rows of each thread, Jacobi across threads
+  * @param level       Coarse level to which smoother is applied to
+  * @param iterations  Number of smoother iterations
+  * @param x           The vector smoothing is applied to
+  * @param rhs_smooth  The right hand side of the equation for the smoother
+  * @param forward     Whether forward or backward sweeps are carried out
+  */
+  template<typename VectorT>
+  void smooth_hybrid_gs(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth, bool forward) const
+  {
+    for (unsigned int i=0; i<iterations; ++i)
+    {
+      residual_[level] = x;
+      detail::amg::amg_hybrid_gs_sweep(A_[level],
+                                       viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x),
+                                       viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(residual_[level]),
+                                       viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth),
+                                       forward);
+    }
+  }
+
+  /** @brief Chebyshev Smoother: Chebyshev iteration for D^{-1} A x = D^{-1} rhs targeting the upper part [0.3 lambda_max, lambda_max] of the spectrum
+  *
+  * Cf. Y. Saad, Iterative Methods for Sparse Linear Systems, Algorithm 12.1.
+  *
+  * @param level       Coarse level to which smoother is applied to
+  * @param degree      Degree of the Chebyshev polynomial
+  * @param x           The vector smoothing is applied to
+  * @param rhs_smooth  The right hand side of the equation for the smoother
+  */
+  template<typename VectorT>
+  void smooth_chebyshev(vcl_size_t level, unsigned int degree, VectorT & x, VectorT const & rhs_smooth) const
+  {
+    if (degree == 0)
+      return;
+
+    NumericT upper = lambda_max_[level];
+    NumericT lower = NumericT(0.3) * upper;
+    NumericT theta = (upper + lower) / NumericT(2);
+    NumericT delta = (upper - lower) / NumericT(2);
+    NumericT sigma = theta / delta;
+    NumericT rho   = NumericT(1) / sigma;
+
+    VectorType & r = residual_[level];
+    VectorType & d = smoother_tmp_[level];
+
+    // d = D^{-1} (rhs - A x) / theta
+    r = viennacl::linalg::prod(A_[level], x);
+    r = rhs_smooth - r;
+    r = viennacl::linalg::element_div(r, diag_[level]);
+    d = r / theta;
+
+    for (unsigned int k=0; k<degree; ++k)
+    {
+      x += d;
+      if (k + 1 == degree)
+        break;
+
+      r = viennacl::linalg::prod(A_[level], x);
+      r = rhs_smooth - r;
+      r = viennacl::linalg::element_div(r, diag_[level]);
+
+      NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+      d = (rho_new * rho) * d + (NumericT(2) * rho_new / delta) * r;
+      rho = rho_new;
+    }
+  }
+
+  /** @brief (Weighted) Jacobi Smoother
+  *
+  * Uses a dedicated kernel for OpenCL. Otherwise, x += w * D^{-1} (rhs - A x) is computed with vector operations, using the residual of the level as temporary.
+  *
   * @param level       Coarse level to which smoother is applied to
   * @param iterations  Number of smoother iterations
   * @param x           The vector smoothing is applied to
@@ -773,28 +1032,97 @@ public:
   template<typename VectorT>
   void smooth_jacobi(vcl_size_t level, unsigned int iterations, VectorT & x, VectorT const & rhs_smooth) const
   {
-    VectorType old_result = x;
+#ifdef VIENNACL_WITH_OPENCL
+    if (viennacl::traits::active_handle_id(x) == viennacl::OPENCL_MEMORY)
+    {
+      VectorType old_result = x;
 
-    viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
-    viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
-    viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "jacobi");
+      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
+      viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
+      viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "jacobi");
 
+      for (unsigned int i=0; i<iterations; ++i)
+      {
+        if (i > 0)
+          old_result = x;
+        x.clear();
+        viennacl::ocl::enqueue(k(A_[level].handle1().opencl_handle(), A_[level].handle2().opencl_handle(), A_[level].handle().opencl_handle(),
+                                static_cast<NumericT>(tag_.get_jacobiweight()),
+                                viennacl::traits::opencl_handle(old_result),
+                                viennacl::traits::opencl_handle(x),
+                                viennacl::traits::opencl_handle(rhs_smooth),
+                                static_cast<cl_uint>(rhs_smooth.size())));
+
+      }
+      return;
+    }
+#endif
+
+    NumericT weight = static_cast<NumericT>(tag_.get_jacobiweight());
     for (unsigned int i=0; i<iterations; ++i)
     {
-      if (i > 0)
-        old_result = x;
-      x.clear();
-      viennacl::ocl::enqueue(k(A_[level].handle1().opencl_handle(), A_[level].handle2().opencl_handle(), A_[level].handle().opencl_handle(),
-                              static_cast<NumericT>(tag_.get_jacobiweight()),
-                              viennacl::traits::opencl_handle(old_result),
-                              viennacl::traits::opencl_handle(x),
-                              viennacl::traits::opencl_handle(rhs_smooth),
-                              static_cast<cl_uint>(rhs_smooth.size())));
-
+      residual_[level] = viennacl::linalg::prod(A_[level], x);
+      residual_[level] = rhs_smooth - residual_[level];
+      residual_[level] = viennacl::linalg::element_div(residual_[level], diag_[level]);
+      x += weight * residual_[level];
     }
   }
 
   amg_tag & tag() { return tag_; }
+
+private:
+  /** @brief Initializes the data structures for the setup phase from the system matrix */
+  void init(MatrixType const & mat)
+  {
+    if (uses_aggregation())
+    {
+      // Aggregation-based setup works on the CSR arrays in host memory directly.
+      A_agg_.resize(1);
+      viennacl::switch_memory_context(A_agg_[0], viennacl::context(viennacl::MAIN_MEMORY));
+      A_agg_[0] = mat;
+    }
+    else
+    {
+      // Copy to CPU. Internal structure of sparse matrix is used for copy operation.
+      std::vector<std::map<unsigned int, NumericT> > mat2 = std::vector<std::map<unsigned int, NumericT> >(mat.size1());
+      viennacl::copy(mat, mat2);
+
+      // Initialize data structures.
+      A_setup_.resize(0, false);
+      P_setup_.resize(0, false);
+      pointvector_.resize(0, false);
+      amg_init (mat2, A_setup_, P_setup_, pointvector_, tag_);
+    }
+
+    done_init_apply_ = false;
+  }
+
+  /** @brief Computes the parts of the precondition phase data depending on the operator values: LU factorization on coarsest level and diagonals for the Jacobi smoother. */
+  void init_apply_numeric() const
+  {
+    // Do LU factorization for direct solve.
+    if (uses_aggregation())
+      amg_lu(op_, permutation_, A_agg_[tag_.get_coarselevels()]);
+    else
+      amg_lu(op_, permutation_, A_setup_[tag_.get_coarselevels()]);
+
+    // Diagonals for the smoothers. The l1-Jacobi smoother (also used as fallback for hybrid Gauss-Seidel outside of host memory) uses the l1-norms of the rows instead.
+    bool use_l1_diag = tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_L1_JACOBI
+                    || (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_HYBRID_GS && ctx_.memory_type() != viennacl::MAIN_MEMORY);
+    for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+      viennacl::linalg::detail::row_info(A_[level], diag_[level], use_l1_diag ? viennacl::linalg::detail::SPARSE_ROW_NORM_1 : viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+    // Upper bounds of the spectra of D^{-1} A for the Chebyshev smoother. The estimate of the power iteration is a lower bound, hence enlarged by 10 percent.
+    lambda_max_.resize(0);
+    if (tag_.get_smoother() == VIENNACL_AMG_SMOOTHER_CHEBYSHEV)
+      for (unsigned int level=0; level < tag_.get_coarselevels(); ++level)
+        lambda_max_.push_back(NumericT(1.1) * detail::amg::amg_jacobi_spectral_radius(A_[level], 20));
+  }
+
+  bool uses_aggregation() const
+  {
+    return tag_.get_coarse() == VIENNACL_AMG_COARSE_AG_GREEDY || tag_.get_coarse() == VIENNACL_AMG_COARSE_AG_MIS2;
+  }
 };
 
 }
@@ -0,0 +1,213 @@
+#ifndef VIENNACL_LINALG_CHOLESKY_HPP
+#define VIENNACL_LINALG_CHOLESKY_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cholesky.hpp
+    @brief Implementation of the Cholesky factorization A = L L^T for symmetric positive definite dense matrices.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+namespace detail
+{
+  /** @brief Unblocked Cholesky factorization of the diagonal block [start, stop) x [start, stop) of a matrix in main memory. Only the lower triangular part is referenced. */
+  template<typename NumericT, typename F>
+  void cholesky_factorize_diagonal_block(NumericT * data, vcl_size_t internal_size1, vcl_size_t internal_size2,
+                                         vcl_size_t start, vcl_size_t stop)
+  {
+    for (vcl_size_t j = start; j < stop; ++j)
+    {
+      NumericT a_jj = data[F::mem_index(j, j, internal_size1, internal_size2)];
+      if (!(a_jj > 0))
+        throw std::runtime_error("ViennaCL: Matrix is not positive definite in cholesky_factorize()");
+
+      NumericT l_jj = std::sqrt(a_jj);
+      data[F::mem_index(j, j, internal_size1, internal_size2)] = l_jj;
+
+      for (vcl_size_t i = j + 1; i < stop; ++i)
+        data[F::mem_index(i, j, internal_size1, internal_size2)] /= l_jj;
+
+      // update trailing part of the block (lower triangle only):
+      for (vcl_size_t k = j + 1; k < stop; ++k)
+      {
+        NumericT l_kj = data[F::mem_index(k, j, internal_size1, internal_size2)];
+        for (vcl_size_t i = k; i < stop; ++i)
+          data[F::mem_index(i, k, internal_size1, internal_size2)] -= data[F::mem_index(i, j, internal_size1, internal_size2)] * l_kj;
+      }
+    }
+  }
+
+  /** @brief Symmetric rank-k update C -= A A^T of the lower triangular part of C.
+  *
+  * C is split into column blocks, each of which is updated from the diagonal downwards by a matrix-matrix product.
+  * Thus, only little work is spent on the upper triangular part, while the products remain large enough for the blocked matrix-matrix multiplication.
+  */
+  template<typename MatrixT>
+  void cholesky_syrk_lower(MatrixT & A, vcl_size_t C_start, vcl_size_t C_stop, vcl_size_t A_col_start, vcl_size_t A_col_stop)
+  {
+    vcl_size_t n = C_stop - C_start;
+    vcl_size_t num_blocks = std::max<vcl_size_t>(1, std::min<vcl_size_t>(8, n / 128));
+
+    viennacl::range A_cols(A_col_start, A_col_stop);
+    for (vcl_size_t b = 0; b < num_blocks; ++b)
+    {
+      vcl_size_t block_start = C_start + (b * n) / num_blocks;
+      vcl_size_t block_stop  = C_start + ((b + 1) * n) / num_blocks;
+
+      viennacl::matrix_range<MatrixT> C_block(A, viennacl::range(block_start, C_stop), viennacl::range(block_start, block_stop));
+      viennacl::matrix_range<MatrixT> A_lower(A, viennacl::range(block_start, C_stop), A_cols);
+      viennacl::matrix_range<MatrixT> A_upper(A, viennacl::range(block_start, block_stop), A_cols);
+
+      C_block -= viennacl::linalg::prod(A_lower, trans(A_upper));
+    }
+  }
+
+  /** @brief Recursive Cholesky factorization of the trailing diagonal block [start, stop) of a matrix A in main memory.
+  *
+  * The block is split into halves. After factorizing the upper left half recursively, the lower left block is computed by a triangular solve,
+  * the lower right block is updated by a symmetric rank-k update, and then factorized recursively.
+  */
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  void cholesky_factorize_recursive(matrix<NumericT, F, AlignmentV> & A, vcl_size_t start, vcl_size_t stop)
+  {
+    typedef matrix<NumericT, F, AlignmentV>  MatrixType;
+
+    vcl_size_t n = stop - start;
+    if (n <= 32)
+    {
+      NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+      cholesky_factorize_diagonal_block<NumericT, F>(data, A.internal_size1(), A.internal_size2(), start, stop);
+      return;
+    }
+
+    vcl_size_t mid = start + n / 2;
+
+    cholesky_factorize_recursive(A, start, mid);
+
+    // L_21 = A_21 L_11^{-T}, i.e. L_11 L_21^T = A_21^T
+    viennacl::matrix_range<MatrixType> L_11(A, viennacl::range(start, mid), viennacl::range(start, mid));
+    viennacl::matrix_range<MatrixType> A_21(A, viennacl::range(mid, stop),  viennacl::range(start, mid));
+    viennacl::linalg::inplace_solve(L_11, trans(A_21), viennacl::linalg::lower_tag());
+
+    // A_22 -= L_21 L_21^T
+    cholesky_syrk_lower(A, mid, stop, start, mid);
+
+    cholesky_factorize_recursive(A, mid, stop);
+  }
+
+  /** @brief Sets the strictly upper triangular part of a square matrix in main memory to zero. */
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  void cholesky_clear_upper(matrix<NumericT, F, AlignmentV> & A)
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(A.size1()); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      for (vcl_size_t j = i + 1; j < A.size2(); ++j)
+        data[F::mem_index(i, j, A.internal_size1(), A.internal_size2())] = 0;
+    }
+  }
+}
+
+/** @brief Cholesky factorization A = L L^T of a symmetric positive definite dense matrix, equivalent to LAPACK's potrf.
+*
+* The factorization is computed on the host using a recursive algorithm, where most of the work is spent in triangular solves and multithreaded matrix-matrix products.
+* Only the lower triangular part of A is referenced. If A does not reside in main memory, the factorization is computed on a copy in main memory.
+* Throws a std::runtime_error if A is found not to be positive definite.
+*
+* @param A    The system matrix, which is overwritten by L. The strictly upper triangular part is set to zero.
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void cholesky_factorize(matrix<NumericT, F, AlignmentV> & A)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+  if (A.size1() == 0)
+    return;
+
+  if (viennacl::traits::context(A).memory_type() != viennacl::MAIN_MEMORY)
+  {
+    // factorize a copy in main memory:
+    matrix<NumericT, F, AlignmentV> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    NumericT * data_host = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A_host);
+
+    viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * A.internal_size(), data_host);
+    detail::cholesky_factorize_recursive(A_host, 0, A_host.size1());
+    detail::cholesky_clear_upper(A_host);
+    viennacl::backend::memory_write(A.handle(), 0, sizeof(NumericT) * A.internal_size(), data_host);
+  }
+  else
+  {
+    detail::cholesky_factorize_recursive(A, 0, A.size1());
+    detail::cholesky_clear_upper(A);
+  }
+}
+
+/** @brief Cholesky substitution for the system L L^T X = B.
+*
+* @param L    The Cholesky factor as computed by cholesky_factorize()
+* @param B    The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void cholesky_substitute(matrix<NumericT, F1, AlignmentV1> const & L,
+                         matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(L.size1() == L.size2() && bool("Matrix must be square"));
+  assert(L.size1() == B.size1() && bool("Size of right hand side does not match matrix size"));
+  inplace_solve(L, B, lower_tag());
+  inplace_solve(trans(L), B, upper_tag());
+}
+
+/** @brief Cholesky substitution for the system L L^T x = vec.
+*
+* @param L      The Cholesky factor as computed by cholesky_factorize()
+* @param vec    The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void cholesky_substitute(matrix<NumericT, F, MatAlignmentV> const & L,
+                         vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(L.size1() == L.size2() && bool("Matrix must be square"));
+  inplace_solve(L, vec, lower_tag());
+  inplace_solve(trans(L), vec, upper_tag());
+}
+
+}
+}
+
+#endif
@@ -82,7 +82,105 @@ void level_scheduling_substitute(vector<NumericT> & vec,
                                                   );
 }
 
+
+template<typename NumericT>
+__device__ NumericT ilu_sparse_row_dot(const unsigned int * col_buffer1, const NumericT * elements1, unsigned int begin1, unsigned int end1,
+                                       const unsigned int * col_buffer2, const NumericT * elements2, unsigned int begin2, unsigned int end2,
+                                       unsigned int bound)
+{
+  NumericT sum = 0;
+  while (begin1 < end1 && begin2 < end2)
+  {
+    unsigned int col1 = col_buffer1[begin1];
+    unsigned int col2 = col_buffer2[begin2];
+    if (col1 >= bound || col2 >= bound)
+      break;
+
+    if (col1 < col2)
+      ++begin1;
+    else if (col2 < col1)
+      ++begin2;
+    else
+      sum += elements1[begin1++] * elements2[begin2++];
+  }
+  return sum;
+}
+
+template<typename NumericT>
+__global__ void ilu_chow_patel_sweep_kernel(
+          const unsigned int * L_row_indices,
+          const unsigned int * L_column_indices,
+          NumericT * L_elements,
+          const NumericT * L_backup,
+          const NumericT * L_aij,
+          const unsigned int * U_row_indices,
+          const unsigned int * U_column_indices,
+          NumericT * U_elements,
+          const NumericT * U_backup,
+          const NumericT * U_aij,
+          unsigned int size)
+{
+  for (unsigned int i  = blockDim.x * blockIdx.x + threadIdx.x;
+                    i  < size;
+                    i += gridDim.x * blockDim.x)
+  {
+    for (unsigned int nnz_index = L_row_indices[i]; nnz_index < L_row_indices[i+1]; ++nnz_index)
+    {
+      unsigned int j = L_column_indices[nnz_index];
+      NumericT sum = ilu_sparse_row_dot(L_column_indices, L_backup, L_row_indices[i], L_row_indices[i+1],
+                                        U_column_indices, U_backup, U_row_indices[j], U_row_indices[j+1], j);
+      L_elements[nnz_index] = (L_aij[nnz_index] - sum) / U_backup[U_row_indices[j+1] - 1];
+    }
+
+    for (unsigned int nnz_index = U_row_indices[i]; nnz_index < U_row_indices[i+1]; ++nnz_index)
+    {
+      unsigned int j = U_column_indices[nnz_index];
+      NumericT sum = ilu_sparse_row_dot(L_column_indices, L_backup, L_row_indices[j], L_row_indices[j+1],
+                                        U_column_indices, U_backup, U_row_indices[i], U_row_indices[i+1], j);
+      U_elements[nnz_index] = U_aij[nnz_index] - sum;
+    }
+  }
+}
+
 } //namespace detail
+
+/** @brief Carries out one fixed-point sweep of the iterative incomplete LU factorization by Chow and Patel. All entries are updated from the previous iterate.
+*
+* @param L            Strict lower triangular factor (unit diagonal not stored) with sorted column indices
+* @param aij_L        The entries of the system matrix on the pattern of L
+* @param U_trans      Transpose of the upper triangular factor with sorted column indices. The diagonal entry is the last entry of each row.
+* @param aij_U_trans  The entries of the transposed system matrix on the pattern of U_trans
+*/
+template<typename NumericT>
+void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
+                          vector<NumericT>            const & aij_L,
+                          compressed_matrix<NumericT>       & U_trans,
+                          vector<NumericT>            const & aij_U_trans)
+{
+  // previous iterate:
+  viennacl::backend::mem_handle L_backup;
+  viennacl::backend::memory_create(L_backup, sizeof(NumericT) * L.nnz(), viennacl::traits::context(L));
+  viennacl::backend::memory_copy(L.handle(), L_backup, 0, 0, sizeof(NumericT) * L.nnz());
+
+  viennacl::backend::mem_handle U_backup;
+  viennacl::backend::memory_create(U_backup, sizeof(NumericT) * U_trans.nnz(), viennacl::traits::context(U_trans));
+  viennacl::backend::memory_copy(U_trans.handle(), U_backup, 0, 0, sizeof(NumericT) * U_trans.nnz());
+
+  detail::ilu_chow_patel_sweep_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(L.handle1().cuda_handle()),
+                                                    detail::cuda_arg<unsigned int>(L.handle2().cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(L.handle().cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(L_backup.cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(aij_L),
+                                                    detail::cuda_arg<unsigned int>(U_trans.handle1().cuda_handle()),
+                                                    detail::cuda_arg<unsigned int>(U_trans.handle2().cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(U_trans.handle().cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(U_backup.cuda_handle()),
+                                                    detail::cuda_arg<NumericT>(aij_U_trans),
+                                                    static_cast<unsigned int>(L.size1())
+                                                   );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("ilu_chow_patel_sweep_kernel");
+}
+
 } //namespace cuda
 } //namespace linalg
 } //namespace viennacl
@@ -242,6 +242,67 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   VIENNACL_CUDA_LAST_ERROR_CHECK("compressed_matrix_vec_mul_adaptive_kernel");
 }
 
+
+// Computes result = trans(A) * x within a single thread block: The rows are processed one after another, so the scatter of the entries of a row never conflicts with another row.
+template<typename NumericT>
+__global__ void compressed_matrix_trans_vec_mul_kernel(
+          const unsigned int * row_indices,
+          const unsigned int * column_indices,
+          const NumericT * elements,
+          unsigned int rows,
+          const NumericT * x,
+          unsigned int start_x,
+          unsigned int inc_x,
+          NumericT * result,
+          unsigned int start_result,
+          unsigned int inc_result,
+          unsigned int size_result)
+{
+  for (unsigned int i = threadIdx.x; i < size_result; i += blockDim.x)
+    result[i * inc_result + start_result] = 0;
+  __syncthreads();
+
+  for (unsigned int row = 0; row < rows; ++row)
+  {
+    NumericT x_row = x[row * inc_x + start_x];
+    unsigned int row_stop = row_indices[row + 1];
+    for (unsigned int i = row_indices[row] + threadIdx.x; i < row_stop; i += blockDim.x)
+      result[column_indices[i] * inc_result + start_result] += elements[i] * x_row;
+    __syncthreads();
+  }
+}
+
+
+/** @brief Carries out matrix-vector multiplication with a transposed compressed_matrix
+*
+* Implementation of the convenience expression result = prod(trans(mat), vec);
+*
+* @param mat    The transposed matrix proxy
+* @param vec    The vector
+* @param result The result vector
+*/
+template<class NumericT, unsigned int AlignmentV>
+void prod_impl(matrix_expression< const compressed_matrix<NumericT, AlignmentV>,
+                                  const compressed_matrix<NumericT, AlignmentV>,
+                                  op_trans> const & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  compressed_matrix_trans_vec_mul_kernel<<<1, 128>>>(detail::cuda_arg<unsigned int>(mat.lhs().handle1().cuda_handle()),
+                                                     detail::cuda_arg<unsigned int>(mat.lhs().handle2().cuda_handle()),
+                                                     detail::cuda_arg<NumericT>(mat.lhs().handle().cuda_handle()),
+                                                     static_cast<unsigned int>(mat.lhs().size1()),
+                                                     detail::cuda_arg<NumericT>(vec),
+                                                     static_cast<unsigned int>(vec.start()),
+                                                     static_cast<unsigned int>(vec.stride()),
+                                                     detail::cuda_arg<NumericT>(result),
+                                                     static_cast<unsigned int>(result.start()),
+                                                     static_cast<unsigned int>(result.stride()),
+                                                     static_cast<unsigned int>(result.size())
+                                                    );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("compressed_matrix_trans_vec_mul_kernel");
+}
+
 /** @brief Helper struct for accessing an element of a row- or column-major matrix.
   *
   * @param LayoutT   The layout tag: Either row_major or column_major
@@ -2550,6 +2611,453 @@ void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
 }
 
 
+//
+// Block compressed sparse row (BSR) matrix
+//
+
+namespace detail
+{
+  template<unsigned int BlockSize, typename NumericT>
+  __global__ void bsr_row_info_extractor_kernel(
+            const unsigned int * row_blocks,
+            const unsigned int * column_blocks,
+            const NumericT * elements,
+            NumericT * result,
+            unsigned int start_result,
+            unsigned int inc_result,
+            unsigned int size,
+            unsigned int option)
+  {
+    for (unsigned int row  = blockDim.x * blockIdx.x + threadIdx.x;
+                      row  < size;
+                      row += gridDim.x * blockDim.x)
+    {
+      NumericT value = 0;
+      unsigned int block_row = row / BlockSize;
+      unsigned int i = row % BlockSize;
+      unsigned int block_row_end = row_blocks[block_row+1];
+
+      for (unsigned int k = row_blocks[block_row]; k < block_row_end; ++k)
+      {
+        const NumericT * row_entries = elements + (k * BlockSize + i) * BlockSize;
+        switch (option)
+        {
+          case 0: //inf-norm
+            for (unsigned int j = 0; j < BlockSize; ++j)
+              value = max(value, fabs(row_entries[j]));
+            break;
+
+          case 1: //1-norm
+            for (unsigned int j = 0; j < BlockSize; ++j)
+              value += fabs(row_entries[j]);
+            break;
+
+          case 2: //2-norm
+            for (unsigned int j = 0; j < BlockSize; ++j)
+              value += row_entries[j] * row_entries[j];
+            break;
+
+          case 3: //diagonal entry
+            if (column_blocks[k] == block_row)
+              value = row_entries[i];
+            break;
+
+          default:
+            break;
+        }
+      }
+      if (option == 2)
+        value = sqrt(value);
+      result[row * inc_result + start_result] = value;
+    }
+  }
+
+  template<typename NumericT, unsigned int BlockSize>
+  void row_info(bsr_matrix<NumericT, BlockSize> const & mat,
+                vector_base<NumericT> & vec,
+                viennacl::linalg::detail::row_info_types info_selector)
+  {
+    bsr_row_info_extractor_kernel<BlockSize><<<128, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                           detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                           detail::cuda_arg<NumericT>(mat.handle().cuda_handle()),
+                                                           detail::cuda_arg<NumericT>(vec),
+                                                           static_cast<unsigned int>(vec.start()),
+                                                           static_cast<unsigned int>(vec.stride()),
+                                                           static_cast<unsigned int>(mat.size1()),
+                                                           static_cast<unsigned int>(info_selector)
+                                                          );
+    VIENNACL_CUDA_LAST_ERROR_CHECK("bsr_row_info_extractor_kernel");
+  }
+
+} //namespace detail
+
+
+template<unsigned int BlockSize, typename NumericT>
+__global__ void bsr_matrix_vec_mul_kernel(const unsigned int * row_blocks,
+                                          const unsigned int * column_blocks,
+                                          const NumericT * elements,
+                                          const NumericT * x,
+                                          unsigned int start_x,
+                                          unsigned int inc_x,
+                                                NumericT * result,
+                                          unsigned int start_result,
+                                          unsigned int inc_result,
+                                          unsigned int block_rows)
+{
+  for (unsigned int block_row  = blockDim.x * blockIdx.x + threadIdx.x;
+                    block_row  < block_rows;
+                    block_row += gridDim.x * blockDim.x)
+  {
+    NumericT sums[BlockSize];
+    for (unsigned int i = 0; i < BlockSize; ++i)
+      sums[i] = 0;
+
+    unsigned int block_row_end = row_blocks[block_row+1];
+    for (unsigned int k = row_blocks[block_row]; k < block_row_end; ++k)
+    {
+      const NumericT * block = elements + k * BlockSize * BlockSize;
+      unsigned int col_offset = column_blocks[k] * BlockSize;
+
+      NumericT x_block[BlockSize];
+      for (unsigned int j = 0; j < BlockSize; ++j)
+        x_block[j] = x[(col_offset + j) * inc_x + start_x];
+
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        for (unsigned int j = 0; j < BlockSize; ++j)
+          sums[i] += block[i * BlockSize + j] * x_block[j];
+    }
+
+    for (unsigned int i = 0; i < BlockSize; ++i)
+      result[(block_row * BlockSize + i) * inc_result + start_result] = sums[i];
+  }
+}
+
+
+/** @brief Carries out matrix-vector multiplication with a bsr_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  bsr_matrix_vec_mul_kernel<BlockSize><<<256, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                     detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                     detail::cuda_arg<NumericT>(mat.handle().cuda_handle()),
+                                                     detail::cuda_arg<NumericT>(vec),
+                                                     static_cast<unsigned int>(vec.start()),
+                                                     static_cast<unsigned int>(vec.stride()),
+                                                     detail::cuda_arg<NumericT>(result),
+                                                     static_cast<unsigned int>(result.start()),
+                                                     static_cast<unsigned int>(result.stride()),
+                                                     static_cast<unsigned int>(mat.block_rows())
+                                                    );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("bsr_matrix_vec_mul_kernel");
+}
+
+template<unsigned int BlockSize, bool TransposedV, typename DMatIndexT, typename ResultIndexT, typename NumericT>
+__global__ void bsr_matrix_d_mat_mul_kernel(const unsigned int * sp_mat_row_blocks,
+                                            const unsigned int * sp_mat_column_blocks,
+                                            const NumericT * sp_mat_elements,
+                                            unsigned int sp_mat_row_num,
+                                            const NumericT * d_mat,
+                                            unsigned int d_mat_row_start,
+                                            unsigned int d_mat_col_start,
+                                            unsigned int d_mat_row_inc,
+                                            unsigned int d_mat_col_inc,
+                                            unsigned int d_mat_internal_rows,
+                                            unsigned int d_mat_internal_cols,
+                                            NumericT * result,
+                                            unsigned int result_row_start,
+                                            unsigned int result_col_start,
+                                            unsigned int result_row_inc,
+                                            unsigned int result_col_inc,
+                                            unsigned int result_col_size,
+                                            unsigned int result_internal_rows,
+                                            unsigned int result_internal_cols)
+{
+  unsigned int glb_id = blockDim.x * blockIdx.x + threadIdx.x;
+  unsigned int glb_sz = gridDim.x * blockDim.x;
+
+  for (unsigned int rc = glb_id; rc < (sp_mat_row_num * result_col_size); rc += glb_sz)
+  {
+    unsigned int row = rc % sp_mat_row_num;
+    unsigned int col = rc / sp_mat_row_num;
+    unsigned int block_row = row / BlockSize;
+    unsigned int i = row % BlockSize;
+
+    NumericT r = 0;
+    unsigned int block_row_end = sp_mat_row_blocks[block_row+1];
+    for (unsigned int k = sp_mat_row_blocks[block_row]; k < block_row_end; ++k)
+    {
+      const NumericT * row_entries = sp_mat_elements + (k * BlockSize + i) * BlockSize;
+      unsigned int col_offset = sp_mat_column_blocks[k] * BlockSize;
+
+      for (unsigned int j = 0; j < BlockSize; ++j)
+      {
+        NumericT y = TransposedV ? d_mat[ DMatIndexT::apply(col, col_offset + j,
+                                                            d_mat_row_start, d_mat_row_inc,
+                                                            d_mat_col_start, d_mat_col_inc,
+                                                            d_mat_internal_rows, d_mat_internal_cols) ]
+                                 : d_mat[ DMatIndexT::apply(col_offset + j, col,
+                                                            d_mat_row_start, d_mat_row_inc,
+                                                            d_mat_col_start, d_mat_col_inc,
+                                                            d_mat_internal_rows, d_mat_internal_cols) ];
+        r += row_entries[j] * y;
+      }
+    }
+    result[ ResultIndexT::apply(row, col,
+                                result_row_start, result_row_inc,
+                                result_col_start, result_col_inc,
+                                result_internal_rows, result_internal_cols) ] = r;
+  }
+}
+
+namespace detail
+{
+  template<bool TransposedV, typename DMatIndexT, typename ResultIndexT, typename NumericT, unsigned int BlockSize>
+  void bsr_d_mat_mul(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+                     const viennacl::matrix_base<NumericT> & d_mat,
+                           viennacl::matrix_base<NumericT> & result)
+  {
+    bsr_matrix_d_mat_mul_kernel<BlockSize, TransposedV, DMatIndexT, ResultIndexT><<<128, 128>>>
+                                           (detail::cuda_arg<unsigned int>(sp_mat.handle1().cuda_handle()),
+                                            detail::cuda_arg<unsigned int>(sp_mat.handle2().cuda_handle()),
+                                            detail::cuda_arg<NumericT>(sp_mat.handle().cuda_handle()),
+                                            static_cast<unsigned int>(sp_mat.size1()),
+                                            detail::cuda_arg<NumericT>(d_mat),
+                                            static_cast<unsigned int>(viennacl::traits::start1(d_mat)),         static_cast<unsigned int>(viennacl::traits::start2(d_mat)),
+                                            static_cast<unsigned int>(viennacl::traits::stride1(d_mat)),        static_cast<unsigned int>(viennacl::traits::stride2(d_mat)),
+                                            static_cast<unsigned int>(viennacl::traits::internal_size1(d_mat)), static_cast<unsigned int>(viennacl::traits::internal_size2(d_mat)),
+
+                                            detail::cuda_arg<NumericT>(result),
+                                            static_cast<unsigned int>(viennacl::traits::start1(result)),         static_cast<unsigned int>(viennacl::traits::start2(result)),
+                                            static_cast<unsigned int>(viennacl::traits::stride1(result)),        static_cast<unsigned int>(viennacl::traits::stride2(result)),
+                                            static_cast<unsigned int>(viennacl::traits::size2(result)),
+                                            static_cast<unsigned int>(viennacl::traits::internal_size1(result)), static_cast<unsigned int>(viennacl::traits::internal_size2(result))
+                                           );
+    VIENNACL_CUDA_LAST_ERROR_CHECK("bsr_matrix_d_mat_mul_kernel");
+  }
+
+  template<bool TransposedV, typename NumericT, unsigned int BlockSize>
+  void bsr_d_mat_mul(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+                     const viennacl::matrix_base<NumericT> & d_mat,
+                           viennacl::matrix_base<NumericT> & result)
+  {
+    if (d_mat.row_major() && result.row_major())
+      bsr_d_mat_mul<TransposedV, mat_mult_matrix_index<row_major>,    mat_mult_matrix_index<row_major>    >(sp_mat, d_mat, result);
+    else if (d_mat.row_major() && !result.row_major())
+      bsr_d_mat_mul<TransposedV, mat_mult_matrix_index<row_major>,    mat_mult_matrix_index<column_major> >(sp_mat, d_mat, result);
+    else if (!d_mat.row_major() && result.row_major())
+      bsr_d_mat_mul<TransposedV, mat_mult_matrix_index<column_major>, mat_mult_matrix_index<row_major>    >(sp_mat, d_mat, result);
+    else
+      bsr_d_mat_mul<TransposedV, mat_mult_matrix_index<column_major>, mat_mult_matrix_index<column_major> >(sp_mat, d_mat, result);
+  }
+}
+
+/** @brief Carries out Sparse Matrix(BSR)-Dense Matrix multiplication
+*
+* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+* sp_mat being in BSR format
+*
+* @param sp_mat     The sparse matrix (BSR)
+* @param d_mat      The dense matrix
+* @param result     The result matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_base<NumericT> & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  detail::bsr_d_mat_mul<false>(sp_mat, d_mat, result);
+}
+
+/** @brief Carries out Sparse Matrix(BSR)-Dense Transposed Matrix multiplication
+*
+* Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+* sp_mat being in BSR format
+*
+* @param sp_mat     The sparse matrix (BSR)
+* @param d_mat      The dense transposed matrix
+* @param result     The result matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_expression< const viennacl::matrix_base<NumericT>,
+                                                  const viennacl::matrix_base<NumericT>,
+                                                  op_trans > & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  detail::bsr_d_mat_mul<true>(sp_mat, d_mat.lhs(), result);
+}
+
+
+
+//
+// Compact compressed matrix
+//
+
+template<typename NumericT, typename ValueT, typename IndexT>
+__global__ void compact_compressed_matrix_vec_mul_kernel(const unsigned int * row_indices,
+                                                         const IndexT * column_offsets,
+                                                         const unsigned int * row_bases,
+                                                         const ValueT * elements,
+                                                         const NumericT * x,
+                                                         unsigned int start_x,
+                                                         unsigned int inc_x,
+                                                               NumericT * result,
+                                                         unsigned int start_result,
+                                                         unsigned int inc_result,
+                                                         unsigned int size_result)
+{
+  for (unsigned int row  = blockDim.x * blockIdx.x + threadIdx.x;
+                    row  < size_result;
+                    row += gridDim.x * blockDim.x)
+  {
+    NumericT dot_prod = NumericT(0);
+    unsigned int col = row_bases[row];
+    unsigned int row_end = row_indices[row+1];
+    for (unsigned int i = row_indices[row]; i < row_end; ++i)
+    {
+      col += column_offsets[i];
+      dot_prod += NumericT(elements[i]) * x[col * inc_x + start_x];
+    }
+    result[row * inc_result + start_result] = dot_prod;
+  }
+}
+
+
+/** @brief Carries out matrix-vector multiplication with a compact_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, typename ValueT, typename IndexT>
+void prod_impl(const viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  compact_compressed_matrix_vec_mul_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                         detail::cuda_arg<IndexT>(mat.handle2().cuda_handle()),
+                                                         detail::cuda_arg<unsigned int>(mat.handle3().cuda_handle()),
+                                                         detail::cuda_arg<ValueT>(mat.handle().cuda_handle()),
+                                                         detail::cuda_arg<NumericT>(vec),
+                                                         static_cast<unsigned int>(vec.start()),
+                                                         static_cast<unsigned int>(vec.stride()),
+                                                         detail::cuda_arg<NumericT>(result),
+                                                         static_cast<unsigned int>(result.start()),
+                                                         static_cast<unsigned int>(result.stride()),
+                                                         static_cast<unsigned int>(result.size())
+                                                        );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("compact_compressed_matrix_vec_mul_kernel");
+}
+
+
+//
+// Symmetric compressed matrix
+//
+
+template<typename NumericT>
+__global__ void symmetric_compressed_matrix_vec_mul_kernel(const unsigned int * row_indices,
+                                                           const unsigned int * column_indices,
+                                                           const NumericT * elements,
+                                                           const NumericT * x,
+                                                           unsigned int start_x,
+                                                           unsigned int inc_x,
+                                                                 NumericT * result,
+                                                           unsigned int start_result,
+                                                           unsigned int inc_result,
+                                                           unsigned int size_result)
+{
+  for (unsigned int row  = blockDim.x * blockIdx.x + threadIdx.x;
+                    row  < size_result;
+                    row += gridDim.x * blockDim.x)
+  {
+    NumericT dot_prod = NumericT(0);
+    unsigned int row_end = row_indices[row+1];
+    for (unsigned int i = row_indices[row]; i < row_end; ++i)
+      dot_prod += elements[i] * x[column_indices[i] * inc_x + start_x];
+    result[row * inc_result + start_result] = dot_prod;
+  }
+}
+
+// Adds the contribution of the transposed strict upper triangle. Must be launched with a single thread block, which processes the rows one after another.
+template<typename NumericT>
+__global__ void symmetric_compressed_matrix_vec_mul_lower_kernel(const unsigned int * row_indices,
+                                                                 const unsigned int * column_indices,
+                                                                 const NumericT * elements,
+                                                                 const NumericT * x,
+                                                                 unsigned int start_x,
+                                                                 unsigned int inc_x,
+                                                                       NumericT * result,
+                                                                 unsigned int start_result,
+                                                                 unsigned int inc_result,
+                                                                 unsigned int size_result)
+{
+  for (unsigned int row = 0; row < size_result; ++row)
+  {
+    NumericT x_row = x[row * inc_x + start_x];
+    unsigned int row_stop = row_indices[row + 1];
+    for (unsigned int i = row_indices[row] + threadIdx.x; i < row_stop; i += blockDim.x)
+    {
+      unsigned int col = column_indices[i];
+      if (col != row)
+        result[col * inc_result + start_result] += elements[i] * x_row;
+    }
+    __syncthreads();
+  }
+}
+
+
+/** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT>
+void prod_impl(const viennacl::symmetric_compressed_matrix<NumericT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  symmetric_compressed_matrix_vec_mul_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                           detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                           detail::cuda_arg<NumericT>(mat.handle().cuda_handle()),
+                                                           detail::cuda_arg<NumericT>(vec),
+                                                           static_cast<unsigned int>(vec.start()),
+                                                           static_cast<unsigned int>(vec.stride()),
+                                                           detail::cuda_arg<NumericT>(result),
+                                                           static_cast<unsigned int>(result.start()),
+                                                           static_cast<unsigned int>(result.stride()),
+                                                           static_cast<unsigned int>(result.size())
+                                                          );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("symmetric_compressed_matrix_vec_mul_kernel");
+
+  symmetric_compressed_matrix_vec_mul_lower_kernel<<<1, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                               detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                               detail::cuda_arg<NumericT>(mat.handle().cuda_handle()),
+                                                               detail::cuda_arg<NumericT>(vec),
+                                                               static_cast<unsigned int>(vec.start()),
+                                                               static_cast<unsigned int>(vec.stride()),
+                                                               detail::cuda_arg<NumericT>(result),
+                                                               static_cast<unsigned int>(result.start()),
+                                                               static_cast<unsigned int>(result.stride()),
+                                                               static_cast<unsigned int>(result.size())
+                                                              );
+  VIENNACL_CUDA_LAST_ERROR_CHECK("symmetric_compressed_matrix_vec_mul_lower_kernel");
+}
+
+
 } // namespace cuda
 } //namespace linalg
 } //namespace viennacl
@@ -0,0 +1,699 @@
+#ifndef VIENNACL_LINALG_DETAIL_AMG_AMG_AGGREGATION_HPP
+#define VIENNACL_LINALG_DETAIL_AMG_AMG_AGGREGATION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file amg_aggregation.hpp
+    @brief Aggregation-based AMG setup phase working directly on the CSR arrays of viennacl::compressed_matrix in host memory. Experimental.
+
+    Coarsening is carried out by aggregation of strongly connected nodes, either greedily (single-threaded) or based on a distance-two maximal independent set (MIS-2, multithreaded).
+    The prolongation is the tentative piecewise constant prolongation, optionally smoothed by one damped Jacobi step (smoothed aggregation).
+    The coarse grid operators are obtained from the Galerkin product R * A * P using the sparse matrix-matrix product for compressed_matrix.
+*/
+
+#include <cmath>
+#include <cassert>
+#include <vector>
+#include <limits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/detail/amg/amg_base.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#ifndef VIENNACL_AMG_COARSE_LIMIT
+  #define VIENNACL_AMG_COARSE_LIMIT 50
+#endif
+
+#ifndef VIENNACL_AMG_MAX_LEVELS
+  #define VIENNACL_AMG_MAX_LEVELS 100
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+namespace amg
+{
+
+/** @brief Returns the aggregate index used for nodes not yet assigned to an aggregate */
+inline unsigned int amg_agg_unassigned() { return std::numeric_limits<unsigned int>::max(); }
+
+/** @brief Determines the strong connections of a matrix in host memory. Multithreaded!
+*
+* The connection (i,j) with i != j is strong if a_ij^2 >= threshold^2 * |a_ii * a_jj|. The measure is symmetric, hence so is the resulting graph for a structurally symmetric matrix.
+*
+* @param A          Operator matrix in host memory
+* @param threshold  Strength of connection threshold
+* @param strong     Holds a nonzero entry for each strong connection after the call, using the same layout as the elements of A
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_strength(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, double threshold, std::vector<char> & strong)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  long rows = static_cast<long>(A.size1());
+  std::vector<NumericT> diag(A.size1());
+  strong.resize(A.nnz());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    NumericT value = 0;
+    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+      if (col_buffer[k] == static_cast<unsigned int>(row))
+        value = elements[k];
+    diag[static_cast<vcl_size_t>(row)] = value;
+  }
+
+  NumericT threshold_squared = static_cast<NumericT>(threshold * threshold);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    NumericT diag_row = diag[static_cast<vcl_size_t>(row)];
+    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+    {
+      unsigned int col = col_buffer[k];
+      strong[k] = (col != static_cast<unsigned int>(row)) && (elements[k] * elements[k] >= threshold_squared * std::fabs(diag_row * diag[col]));
+    }
+  }
+}
+
+/** @brief Key of a node in the computation of a distance-two maximal independent set. Keys are compared lexicographically by state, pseudo-random value, and index */
+struct amg_agg_mis2_key
+{
+  unsigned int state;
+  unsigned int random;
+  unsigned int index;
+
+  bool operator<(amg_agg_mis2_key const & other) const
+  {
+    if (state != other.state)
+      return state < other.state;
+    if (random != other.random)
+      return random < other.random;
+    return index < other.index;
+  }
+};
+
+/** @brief Deterministic integer hash used as pseudo-random value for the MIS-2 computation. The result is thus independent of the number of threads. */
+inline unsigned int amg_agg_hash(unsigned int i)
+{
+  i = ((i >> 16) ^ i) * 0x45d9f3bu;
+  i = ((i >> 16) ^ i) * 0x45d9f3bu;
+  return (i >> 16) ^ i;
+}
+
+/** @brief Aggregation based on a distance-two maximal independent set (MIS-2) of the strong connection graph. Multithreaded!
+*
+* The MIS-2 is computed by repeatedly propagating the maximum key over two layers of neighbors (cf. Bell, Dalton, Olson, SIAM J. Sci. Comput. 34(4), 2012).
+* Every node of the independent set is the root of an aggregate. Neighbors of roots join their aggregates, remaining nodes join the aggregate of the neighbor they are most strongly connected to.
+*
+* @param A           Operator matrix in host memory
+* @param strong      Strong connections as computed by amg_agg_strength()
+* @param aggregates  Aggregate index of each node after the call
+* @return            Number of aggregates
+*/
+template<typename NumericT, unsigned int AlignmentV>
+unsigned int amg_agg_mis2(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, std::vector<char> const & strong, std::vector<unsigned int> & aggregates)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  const unsigned int state_out        = 0;
+  const unsigned int state_undecided  = 1;
+  const unsigned int state_in         = 2;
+
+  long rows = static_cast<long>(A.size1());
+  std::vector<amg_agg_mis2_key> keys(A.size1());
+  std::vector<amg_agg_mis2_key> keys_max1(A.size1());
+  std::vector<amg_agg_mis2_key> keys_max2(A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < rows; ++i)
+  {
+    keys[static_cast<vcl_size_t>(i)].state  = state_undecided;
+    keys[static_cast<vcl_size_t>(i)].random = amg_agg_hash(static_cast<unsigned int>(i));
+    keys[static_cast<vcl_size_t>(i)].index  = static_cast<unsigned int>(i);
+  }
+
+  //
+  // Phase 1: Compute MIS-2
+  //
+  long undecided = rows;
+  while (undecided > 0)
+  {
+    // two layers of maximum propagation:
+    for (unsigned int layer = 0; layer < 2; ++layer)
+    {
+      std::vector<amg_agg_mis2_key> const & keys_in  = (layer == 0) ? keys : keys_max1;
+      std::vector<amg_agg_mis2_key>       & keys_out = (layer == 0) ? keys_max1 : keys_max2;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long i = 0; i < rows; ++i)
+      {
+        amg_agg_mis2_key key_max = keys_in[static_cast<vcl_size_t>(i)];
+        for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+          if (strong[k] && key_max < keys_in[col_buffer[k]])
+            key_max = keys_in[col_buffer[k]];
+        keys_out[static_cast<vcl_size_t>(i)] = key_max;
+      }
+    }
+
+    // nodes which are the maximum within their distance-two neighborhood join the set, nodes with a set node in their distance-two neighborhood drop out:
+    undecided = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: undecided) if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < rows; ++i)
+    {
+      amg_agg_mis2_key & key = keys[static_cast<vcl_size_t>(i)];
+      if (key.state == state_undecided)
+      {
+        if (keys_max2[static_cast<vcl_size_t>(i)].index == key.index)
+          key.state = state_in;
+        else if (keys_max2[static_cast<vcl_size_t>(i)].state == state_in)
+          key.state = state_out;
+        else
+          ++undecided;
+      }
+    }
+  }
+
+  //
+  // Phase 2: Roots of aggregates. Numbered in increasing order of node index.
+  //
+  aggregates.resize(A.size1());
+  unsigned int num_aggregates = 0;
+  for (vcl_size_t i = 0; i < A.size1(); ++i)
+    aggregates[i] = (keys[i].state == state_in) ? num_aggregates++ : amg_agg_unassigned();
+
+  //
+  // Phase 3: Neighbors of roots join the aggregate of the root. Roots are at least three edges apart, hence there is at most one root in the neighborhood.
+  //
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < rows; ++i)
+  {
+    if (keys[static_cast<vcl_size_t>(i)].state == state_in)
+      continue;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      if (strong[k] && keys[col_buffer[k]].state == state_in)
+      {
+        aggregates[static_cast<vcl_size_t>(i)] = aggregates[col_buffer[k]];
+        break;
+      }
+  }
+
+  //
+  // Phase 4: Remaining nodes join the aggregate of the most strongly connected neighbor assigned in phase 3.
+  //
+  std::vector<unsigned int> aggregates_phase3(aggregates);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < rows; ++i)
+  {
+    if (aggregates_phase3[static_cast<vcl_size_t>(i)] != amg_agg_unassigned())
+      continue;
+    NumericT strongest = 0;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+    {
+      unsigned int agg = aggregates_phase3[col_buffer[k]];
+      if (strong[k] && agg != amg_agg_unassigned() && std::fabs(elements[k]) > strongest)
+      {
+        strongest = std::fabs(elements[k]);
+        aggregates[static_cast<vcl_size_t>(i)] = agg;
+      }
+    }
+  }
+
+  // Nodes still unassigned (only possible for a nonsymmetric strong connection graph) form aggregates on their own:
+  for (vcl_size_t i = 0; i < A.size1(); ++i)
+    if (aggregates[i] == amg_agg_unassigned())
+      aggregates[i] = num_aggregates++;
+
+  return num_aggregates;
+}
+
+/** @brief Greedy aggregation in three phases (Vanek, Mandel, Brezina, Computing 56, 1996). Single-Threaded!
+*
+* @param A           Operator matrix in host memory
+* @param strong      Strong connections as computed by amg_agg_strength()
+* @param aggregates  Aggregate index of each node after the call
+* @return            Number of aggregates
+*/
+template<typename NumericT, unsigned int AlignmentV>
+unsigned int amg_agg_greedy(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, std::vector<char> const & strong, std::vector<unsigned int> & aggregates)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  vcl_size_t rows = A.size1();
+  unsigned int num_aggregates = 0;
+  aggregates.assign(rows, amg_agg_unassigned());
+
+  // Phase 1: Nodes with a strong neighborhood not touched by any aggregate form a new aggregate together with their neighborhood.
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    if (aggregates[i] != amg_agg_unassigned())
+      continue;
+
+    bool has_neighbors = false;
+    bool neighborhood_free = true;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      if (strong[k])
+      {
+        has_neighbors = true;
+        if (aggregates[col_buffer[k]] != amg_agg_unassigned())
+        {
+          neighborhood_free = false;
+          break;
+        }
+      }
+
+    if (!has_neighbors || !neighborhood_free)
+      continue;
+
+    aggregates[i] = num_aggregates;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      if (strong[k])
+        aggregates[col_buffer[k]] = num_aggregates;
+    ++num_aggregates;
+  }
+
+  // Phase 2: Remaining nodes join the aggregate of the most strongly connected neighbor from phase 1.
+  std::vector<unsigned int> aggregates_phase1(aggregates);
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    if (aggregates_phase1[i] != amg_agg_unassigned())
+      continue;
+    NumericT strongest = 0;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+    {
+      unsigned int agg = aggregates_phase1[col_buffer[k]];
+      if (strong[k] && agg != amg_agg_unassigned() && std::fabs(elements[k]) > strongest)
+      {
+        strongest = std::fabs(elements[k]);
+        aggregates[i] = agg;
+      }
+    }
+  }
+
+  // Phase 3: Nodes still unassigned form aggregates together with their unassigned strong neighbors.
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    if (aggregates[i] != amg_agg_unassigned())
+      continue;
+    aggregates[i] = num_aggregates;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      if (strong[k] && aggregates[col_buffer[k]] == amg_agg_unassigned())
+        aggregates[col_buffer[k]] = num_aggregates;
+    ++num_aggregates;
+  }
+
+  return num_aggregates;
+}
+
+/** @brief Symbolic data of a level of the aggregation-based hierarchy, which is kept for recomputing the numeric values of the operators (cf. amg_agg_resetup()).
+*/
+template<typename NumericT, unsigned int AlignmentV>
+struct amg_agg_level
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>  MatrixType;
+
+  amg_agg_level() : num_aggregates(0), S(viennacl::context(viennacl::MAIN_MEMORY)), P_tent(viennacl::context(viennacl::MAIN_MEMORY)), AP(viennacl::context(viennacl::MAIN_MEMORY)) {}
+
+  std::vector<char>          strong;          // strong connections as computed by amg_agg_strength()
+  std::vector<unsigned int>  aggregates;      // aggregate index of each node
+  unsigned int               num_aggregates;
+  MatrixType                 S;               // Jacobi operator for smoothed aggregation, empty otherwise
+  MatrixType                 P_tent;          // tentative prolongation
+  MatrixType                 AP;              // product A * P of the Galerkin product
+};
+
+/** @brief Computes the entries of the Jacobi operator S = I - omega * D_F^{-1} * A_F used for smoothing the tentative prolongation. Multithreaded!
+*
+* The filtered matrix A_F consists of the strong connections, weak connections are lumped to the diagonal D_F.
+* Row i of S consists of the diagonal and the strong connections of row i of A, written with increasing column index.
+*
+* @param A             Operator matrix in host memory
+* @param strong        Strong connections as computed by amg_agg_strength()
+* @param omega         Damping factor
+* @param S_row_buffer  Row array of S
+* @param S_col_buffer  Column array of S (written)
+* @param S_elements    Entries of S (written)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_jacobi_entries(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                            std::vector<char> const & strong,
+                            NumericT omega,
+                            unsigned int const * S_row_buffer, unsigned int * S_col_buffer, NumericT * S_elements)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  long rows = static_cast<long>(A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    // diagonal of the filtered matrix:
+    NumericT diag = 0;
+    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+    {
+      if (col_buffer[k] == static_cast<unsigned int>(row))
+        diag += elements[k];
+      else if (!strong[k])
+        diag -= elements[k];
+    }
+    NumericT scale = (diag < 0 || diag > 0) ? omega / diag : NumericT(0);
+
+    // write entries with increasing column index, the diagonal entry is inserted at its position:
+    unsigned int index = S_row_buffer[row];
+    bool diag_written = false;
+    for (unsigned int k = row_buffer[row]; k < row_buffer[row+1]; ++k)
+    {
+      unsigned int col = col_buffer[k];
+      if (!diag_written && col >= static_cast<unsigned int>(row))
+      {
+        S_col_buffer[index] = static_cast<unsigned int>(row);
+        S_elements[index++] = NumericT(1) - scale * diag;
+        diag_written = true;
+      }
+      if (strong[k])
+      {
+        S_col_buffer[index] = col;
+        S_elements[index++] = -scale * elements[k];
+      }
+    }
+    if (!diag_written)
+    {
+      S_col_buffer[index] = static_cast<unsigned int>(row);
+      S_elements[index] = NumericT(1) - scale * diag;
+    }
+  }
+}
+
+/** @brief Recomputes the entries of the product C = A * B, where C already holds the sparsity pattern of the product. Multithreaded!
+*
+* This is the numeric stage of viennacl::linalg::host_based::prod_impl() for compressed_matrix, hence the sparsity patterns of A and B must be the same as for the computation of the pattern of C.
+*
+* @param A  The left hand side factor in host memory
+* @param B  The right hand side factor in host memory
+* @param C  The result matrix in host memory
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_prod_numeric(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                          viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                          viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+{
+  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT     const * B_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(B.handle());
+  unsigned int const * B_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(B.handle1());
+  unsigned int const * B_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(B.handle2());
+
+  NumericT           * C_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(C.handle());
+  unsigned int const * C_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(C.handle1());
+  unsigned int       * C_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(C.handle2());
+
+  long rows = static_cast<long>(A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+    viennacl::linalg::host_based::detail::spgemm_row_accumulator<NumericT> accumulator(B.size2());
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long row = 0; row < rows; ++row)
+    {
+      viennacl::linalg::host_based::detail::spgemm_accumulate_row(static_cast<vcl_size_t>(row), A_row_buffer, A_col_buffer, A_elements, B_row_buffer, B_col_buffer, B_elements, true, accumulator);
+      assert(accumulator.size() == C_row_buffer[row+1] - C_row_buffer[row] && bool("Sparsity pattern of product changed!"));
+      accumulator.extract(C_col_buffer + C_row_buffer[row], C_elements + C_row_buffer[row]);
+      accumulator.clear();
+    }
+  }
+}
+
+/** @brief Computes the prolongation operator from the aggregates.
+*
+* The tentative prolongation maps each coarse node to the constant vector on its aggregate.
+* For smoothed aggregation (VIENNACL_AMG_INTERPOL_SA) it is smoothed by one damped Jacobi step with the filtered matrix, where weak connections are lumped to the diagonal:
+* P = (I - omega * D_F^{-1} * A_F) * P_tent, where omega is the interpolation weight of the tag.
+*
+* @param A      Operator matrix in host memory
+* @param level  Symbolic data of the level. Strong connections and aggregates are read, the tentative prolongation and the Jacobi operator are written.
+* @param tag    AMG preconditioner tag
+* @param P      Prolongation operator (set up in host memory)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_prolongation(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                          amg_agg_level<NumericT, AlignmentV> & level,
+                          amg_tag const & tag,
+                          viennacl::compressed_matrix<NumericT, AlignmentV> & P)
+{
+  vcl_size_t rows = A.size1();
+
+  std::vector<unsigned int> P_tent_row_buffer(rows + 1);
+  std::vector<NumericT>     P_tent_elements(rows, NumericT(1));
+  for (vcl_size_t i = 0; i <= rows; ++i)
+    P_tent_row_buffer[i] = static_cast<unsigned int>(i);
+  level.P_tent.set(&(P_tent_row_buffer[0]), &(level.aggregates[0]), &(P_tent_elements[0]), rows, level.num_aggregates, rows);
+
+  if (tag.get_interpol() != VIENNACL_AMG_INTERPOL_SA)
+  {
+    P = level.P_tent;
+    return;
+  }
+
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+
+  // Row i of the Jacobi operator S consists of the diagonal and the strong connections of row i of A:
+  std::vector<unsigned int> S_row_buffer(rows + 1);
+  S_row_buffer[0] = 0;
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    unsigned int entries = 1;
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+      entries += level.strong[k] ? 1 : 0;
+    S_row_buffer[i+1] = S_row_buffer[i] + entries;
+  }
+
+  std::vector<unsigned int> S_col_buffer(S_row_buffer[rows]);
+  std::vector<NumericT>     S_elements(S_row_buffer[rows]);
+  amg_agg_jacobi_entries(A, level.strong, static_cast<NumericT>(tag.get_interpolweight()), &(S_row_buffer[0]), &(S_col_buffer[0]), &(S_elements[0]));
+  level.S.set(&(S_row_buffer[0]), &(S_col_buffer[0]), &(S_elements[0]), rows, rows, S_row_buffer[rows]);
+
+  viennacl::linalg::host_based::prod_impl(level.S, level.P_tent, P);
+}
+
+/** @brief Computes the transpose of a matrix in host memory. The column indices of the result are sorted.
+*
+* @param P  The matrix to be transposed
+* @param R  The transposed matrix (set up in host memory)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_transpose(viennacl::compressed_matrix<NumericT, AlignmentV> const & P, viennacl::compressed_matrix<NumericT, AlignmentV> & R)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(P.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(P.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(P.handle2());
+
+  vcl_size_t nnz = row_buffer[P.size1()];
+  std::vector<unsigned int> R_row_buffer(P.size2() + 1, 0);
+  std::vector<unsigned int> R_col_buffer(nnz);
+  std::vector<NumericT>     R_elements(nnz);
+
+  // count entries per column, then offsets:
+  for (vcl_size_t k = 0; k < nnz; ++k)
+    ++R_row_buffer[col_buffer[k] + 1];
+  for (vcl_size_t j = 0; j < P.size2(); ++j)
+    R_row_buffer[j+1] += R_row_buffer[j];
+
+  // scatter in increasing row order, which keeps the column indices of R sorted:
+  std::vector<unsigned int> R_offsets(R_row_buffer.begin(), R_row_buffer.end() - 1);
+  for (vcl_size_t i = 0; i < P.size1(); ++i)
+    for (unsigned int k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+    {
+      unsigned int index = R_offsets[col_buffer[k]]++;
+      R_col_buffer[index] = static_cast<unsigned int>(i);
+      R_elements[index]   = elements[k];
+    }
+
+  R.set(&(R_row_buffer[0]), &(R_col_buffer[0]), &(R_elements[0]), P.size2(), P.size1(), nnz);
+}
+
+/** @brief Computes the coarse grid operator A_coarse = R * A * P using two sparse matrix-matrix products in host memory.
+*
+* @param A         Operator matrix on the fine level
+* @param P         Prolongation operator
+* @param R         Restriction operator
+* @param AP        The product A * P (set up in host memory)
+* @param A_coarse  Operator matrix on the coarse level (set up in host memory)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_galerkin_prod(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                           viennacl::compressed_matrix<NumericT, AlignmentV> const & P,
+                           viennacl::compressed_matrix<NumericT, AlignmentV> const & R,
+                           viennacl::compressed_matrix<NumericT, AlignmentV> & AP,
+                           viennacl::compressed_matrix<NumericT, AlignmentV> & A_coarse)
+{
+  viennacl::linalg::host_based::prod_impl(A, P, AP);
+  viennacl::linalg::host_based::prod_impl(R, AP, A_coarse);
+}
+
+/** @brief Setup phase of aggregation-based AMG. Computes operators, prolongations, and restrictions on all levels in host memory.
+*
+* Coarsening stops once the number of unknowns is at most VIENNACL_AMG_COARSE_LIMIT, if the aggregation does not reduce the number of unknowns, or if the number of coarse levels requested by the tag is reached.
+* The number of coarse levels is written to the tag.
+*
+* @param A       Operator matrices on all levels. On entry, A[0] holds the system matrix in host memory.
+* @param P       Prolongation operators on all levels
+* @param R       Restriction operators on all levels
+* @param levels  Symbolic data on all levels, used for amg_agg_resetup()
+* @param tag     AMG preconditioner tag
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_setup(std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & A,
+                   std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & P,
+                   std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & R,
+                   std::vector<amg_agg_level<NumericT, AlignmentV> > & levels,
+                   amg_tag & tag)
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>  MatrixType;
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+  unsigned int iterations = tag.get_coarselevels();
+  if (iterations == 0)
+    iterations = VIENNACL_AMG_MAX_LEVELS;
+
+  A.resize(1);
+  P.clear();
+  R.clear();
+  levels.clear();
+
+  unsigned int level = 0;
+  for (; level < iterations; ++level)
+  {
+    if (tag.get_coarselevels() == 0 && A[level].size1() <= VIENNACL_AMG_COARSE_LIMIT)
+      break;
+
+    levels.push_back(amg_agg_level<NumericT, AlignmentV>());
+    amg_agg_level<NumericT, AlignmentV> & current = levels.back();
+
+    amg_agg_strength(A[level], tag.get_threshold(), current.strong);
+    current.num_aggregates = (tag.get_coarse() == VIENNACL_AMG_COARSE_AG_MIS2) ? amg_agg_mis2(A[level], current.strong, current.aggregates)
+                                                                              : amg_agg_greedy(A[level], current.strong, current.aggregates);
+
+    #if defined (VIENNACL_AMG_DEBUG)
+    std::cout << "Level " << level << ": " << A[level].size1() << " unknowns, " << current.num_aggregates << " aggregates" << std::endl;
+    #endif
+
+    if (current.num_aggregates == 0 || current.num_aggregates == A[level].size1())
+    {
+      levels.pop_back();
+      break;
+    }
+
+    P.push_back(MatrixType(host_ctx));
+    R.push_back(MatrixType(host_ctx));
+    A.push_back(MatrixType(host_ctx));
+
+    amg_agg_prolongation(A[level], current, tag, P[level]);
+    amg_agg_transpose(P[level], R[level]);
+    amg_agg_galerkin_prod(A[level], P[level], R[level], current.AP, A[level+1]);
+  }
+  tag.set_coarselevels(level);
+}
+
+/** @brief Recomputes the numeric values of all operators of a hierarchy set up by amg_agg_setup() for a new system matrix with the same sparsity pattern.
+*
+* Aggregates, strong connections, and the sparsity patterns of all prolongations, restrictions, and coarse grid operators are kept.
+* Only the entries of the smoothed prolongations (for VIENNACL_AMG_INTERPOL_SA), the restrictions, and the Galerkin products are recomputed.
+*
+* @param A       Operator matrices on all levels. On entry, A[0] holds the new system matrix in host memory.
+* @param P       Prolongation operators on all levels
+* @param R       Restriction operators on all levels
+* @param levels  Symbolic data on all levels as obtained from amg_agg_setup()
+* @param tag     AMG preconditioner tag
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_agg_resetup(std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & A,
+                     std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & P,
+                     std::vector<viennacl::compressed_matrix<NumericT, AlignmentV> > & R,
+                     std::vector<amg_agg_level<NumericT, AlignmentV> > & levels,
+                     amg_tag const & tag)
+{
+  for (vcl_size_t level = 0; level < levels.size(); ++level)
+  {
+    amg_agg_level<NumericT, AlignmentV> & current = levels[level];
+
+    if (tag.get_interpol() == VIENNACL_AMG_INTERPOL_SA)
+    {
+      amg_agg_jacobi_entries(A[level], current.strong, static_cast<NumericT>(tag.get_interpolweight()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(current.S.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(current.S.handle2()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(current.S.handle()));
+      amg_agg_prod_numeric(current.S, current.P_tent, P[level]);
+      amg_agg_transpose(P[level], R[level]);
+    }
+
+    amg_agg_prod_numeric(A[level], P[level], current.AP);
+    amg_agg_prod_numeric(R[level], current.AP, A[level+1]);
+  }
+}
+
+} //namespace amg
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -43,10 +43,16 @@
 #define VIENNACL_AMG_COARSE_RS0 3
 #define VIENNACL_AMG_COARSE_RS3 4
 #define VIENNACL_AMG_COARSE_AG 5
+#define VIENNACL_AMG_COARSE_AG_GREEDY 6
+#define VIENNACL_AMG_COARSE_AG_MIS2 7
 #define VIENNACL_AMG_INTERPOL_DIRECT 1
 #define VIENNACL_AMG_INTERPOL_CLASSIC 2
 #define VIENNACL_AMG_INTERPOL_AG 3
 #define VIENNACL_AMG_INTERPOL_SA 4
+#define VIENNACL_AMG_SMOOTHER_JACOBI 1
+#define VIENNACL_AMG_SMOOTHER_L1_JACOBI 2
+#define VIENNACL_AMG_SMOOTHER_HYBRID_GS 3
+#define VIENNACL_AMG_SMOOTHER_CHEBYSHEV 4
 
 namespace viennacl
 {
@@ -72,6 +78,9 @@ public:
   * @param coarselevels  Number of coarse levels that are constructed
   *      (Default: 0 = Optimize coarse levels for direct solver such that coarsest level has a maximum of COARSE_LIMIT points)
   *      (Note: Coarsening stops when number of coarse points = 0 and overwrites the parameter with actual number of coarse levels)
+  *
+  * The coarsening routines VIENNACL_AMG_COARSE_AG_GREEDY and VIENNACL_AMG_COARSE_AG_MIS2 are only available for viennacl::compressed_matrix.
+  * They compute the full hierarchy directly on the CSR arrays in host memory, where VIENNACL_AMG_INTERPOL_SA selects smoothed aggregation and any other interpolation selects the tentative (piecewise constant) prolongation.
   */
   amg_tag(unsigned int coarse = 1,
           unsigned int interpol = 1,
@@ -83,7 +92,7 @@ public:
           unsigned int coarselevels = 0)
   : coarse_(coarse), interpol_(interpol),
     threshold_(threshold), interpolweight_(interpolweight), jacobiweight_(jacobiweight),
-    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels) {}
+    presmooth_(presmooth), postsmooth_(postsmooth), coarselevels_(coarselevels), hierarchy_reuse_(0), smoother_(VIENNACL_AMG_SMOOTHER_JACOBI) {}
 
   // Getter-/Setter-Functions
   void set_coarse(unsigned int coarse) { coarse_ = coarse; }
@@ -110,10 +119,26 @@ public:
   void set_coarselevels(unsigned int coarselevels)  { coarselevels_ = coarselevels; }
   unsigned int get_coarselevels() const { return coarselevels_; }
 
+  /** @brief Sets the number of subsequent calls to amg_precond::resetup() for which the preconditioner is reused without any update (Default: 0 = Recompute the operators on every call) */
+  void set_hierarchy_reuse(unsigned int hierarchy_reuse) { hierarchy_reuse_ = hierarchy_reuse; }
+  unsigned int get_hierarchy_reuse() const { return hierarchy_reuse_; }
+
+  /** @brief Sets the smoother used on every level (Default: VIENNACL_AMG_SMOOTHER_JACOBI). Only used by the preconditioner for viennacl::compressed_matrix.
+  *
+  * VIENNACL_AMG_SMOOTHER_JACOBI:     Jacobi smoother, weighted with the Jacobi weight
+  * VIENNACL_AMG_SMOOTHER_L1_JACOBI:  Jacobi smoother with the diagonal replaced by the l1-norms of the rows, convergent without weighting for symmetric positive definite matrices
+  * VIENNACL_AMG_SMOOTHER_HYBRID_GS:  Gauss-Seidel within the block of rows of each thread, Jacobi across blocks. Forward sweeps for presmoothing, backward sweeps for postsmoothing. Falls back to l1-Jacobi if the operators are not in host memory.
+  * VIENNACL_AMG_SMOOTHER_CHEBYSHEV:  Chebyshev polynomial of the Jacobi-preconditioned operator, the degree is given by the number of pre-/postsmoothing steps
+  */
+  void set_smoother(unsigned int smoother) { smoother_ = smoother; }
+  unsigned int get_smoother() const { return smoother_; }
+
 private:
   unsigned int coarse_, interpol_;
   double threshold_, interpolweight_, jacobiweight_;
   unsigned int presmooth_, postsmooth_, coarselevels_;
+  unsigned int hierarchy_reuse_;
+  unsigned int smoother_;
 };
 
 /** @brief A class for a scalar that can be written to the sparse matrix or sparse vector datatypes.
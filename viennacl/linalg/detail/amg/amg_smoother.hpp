@@ -0,0 +1,154 @@
+#ifndef VIENNACL_LINALG_DETAIL_AMG_AMG_SMOOTHER_HPP
+#define VIENNACL_LINALG_DETAIL_AMG_AMG_SMOOTHER_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file amg_smoother.hpp
+    @brief Helper routines for the smoothers of the AMG preconditioner for viennacl::compressed_matrix (precondition phase). Experimental.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/power_iter.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+namespace amg
+{
+
+/** @brief One sweep of hybrid Gauss-Seidel in host memory. Multithreaded!
+*
+* The rows are split into one contiguous block per thread. Within a block, Gauss-Seidel is applied, values from other blocks are taken from the previous iterate (Jacobi).
+* With a single thread this is the usual Gauss-Seidel sweep.
+*
+* @param A        Operator matrix in host memory
+* @param x        Current iterate, updated in place
+* @param x_old    Copy of the current iterate, used for the coupling across blocks
+* @param rhs      Right hand side
+* @param forward  Sweep direction within each block. A forward presmoothing and a backward postsmoothing sweep result in a symmetric cycle.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void amg_hybrid_gs_sweep(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                         NumericT * x, NumericT const * x_old, NumericT const * rhs,
+                         bool forward)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  long rows = static_cast<long>(A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+    long num_blocks = 1;
+    long block_id   = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    num_blocks = omp_get_num_threads();
+    block_id   = omp_get_thread_num();
+#endif
+    long block_begin = (rows * block_id) / num_blocks;
+    long block_end   = (rows * (block_id + 1)) / num_blocks;
+
+    for (long k = 0; k < block_end - block_begin; ++k)
+    {
+      long row = forward ? block_begin + k : block_end - 1 - k;
+
+      NumericT sum  = rhs[row];
+      NumericT diag = 0;
+      for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+      {
+        long col = static_cast<long>(col_buffer[j]);
+        if (col == row)
+          diag = elements[j];
+        else
+          sum -= elements[j] * ((col >= block_begin && col < block_end) ? x[col] : x_old[col]);
+      }
+      if (diag < 0 || diag > 0)
+        x[row] = sum / diag;
+    }
+  }
+}
+
+/** @brief Estimates the largest eigenvalue of the Jacobi-preconditioned operator D^{-1} A by a few steps of the power iteration.
+*
+* The computation is carried out on a scaled copy of A in host memory.
+*
+* @param A           Operator matrix (any memory domain)
+* @param iterations  Maximum number of power iterations
+* @return            The estimate for the largest eigenvalue
+*/
+template<typename NumericT, unsigned int AlignmentV>
+NumericT amg_jacobi_spectral_radius(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t iterations)
+{
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+  viennacl::compressed_matrix<NumericT, AlignmentV> DA(host_ctx);
+  DA = A;
+
+  NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(DA.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(DA.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(DA.handle2());
+
+  long rows = static_cast<long>(DA.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    NumericT diag = 0;
+    for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+      if (static_cast<long>(col_buffer[j]) == row)
+        diag = elements[j];
+    if (diag < 0 || diag > 0)
+      for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+        elements[j] /= diag;
+  }
+
+  // 'random' starting vector as in the power iteration with default start vector:
+  std::vector<NumericT> s(DA.size1());
+  for (vcl_size_t i=0; i<s.size(); ++i)
+    s[i] = NumericT(i % 3) * NumericT(0.1234) - NumericT(0.5);
+
+  viennacl::vector<NumericT> r(DA.size1(), host_ctx);
+  viennacl::copy(s, r);
+
+  return viennacl::linalg::eig(DA, viennacl::linalg::power_iter_tag(1e-3, iterations), r);
+}
+
+} //namespace amg
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef VIENNACL_LINALG_DETAIL_ILU_CHOW_PATEL_ILU_HPP_
+#define VIENNACL_LINALG_DETAIL_ILU_CHOW_PATEL_ILU_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/ilu/chow_patel_ilu.hpp
+  @brief Fine-grained parallel incomplete LU factorization by fixed-point sweeps as proposed by Chow and Patel.
+
+  E. Chow and A. Patel, Fine-Grained Parallel Incomplete LU Factorization, SIAM J. Sci. Comput. 37(2), C169-C193, 2015.
+
+  Each sweep updates all entries of the factors independently of each other. The fixed point is the incomplete LU factorization on the given pattern.
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/misc_operations.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Counts or fills the rows of the transpose of the upper triangular part (including the diagonal) of a matrix with sorted rows.
+*
+* Each thread handles a contiguous range of columns of the matrix, i.e. rows of the transpose, and visits the rows of the matrix in ascending order.
+* Hence the column indices in each row of the transpose are sorted without any synchronization between threads.
+*
+* @param row_buffer      Row array of the matrix
+* @param col_buffer      Column array of the matrix (sorted within each row)
+* @param elements        Entries of the matrix
+* @param diagonal_index  Position of the diagonal entry within each row
+* @param rows            Number of rows (and columns) of the matrix
+* @param nnz             Number of nonzeros of the matrix
+* @param U_row_buffer    Counting: The number of entries of row i of the transpose is written to U_row_buffer[i+1]. Filling: The row array of the transpose.
+* @param U_col_buffer    Column array of the transpose (result). NULL for counting.
+* @param U_elements      Entries of the transpose (result). NULL for counting.
+* @param factor_index    Position of each entry of the matrix within the transpose (result, only for entries of the upper triangular part). NULL for counting.
+*/
+template<typename NumericT>
+void chow_patel_split_U(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, unsigned int const * diagonal_index,
+                        vcl_size_t rows, vcl_size_t nnz,
+                        unsigned int * U_row_buffer, unsigned int * U_col_buffer, NumericT * U_elements, unsigned int * factor_index)
+{
+  (void)nnz; // only used with OpenMP
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    vcl_size_t thread_id   = static_cast<vcl_size_t>(omp_get_thread_num());
+    vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+#else
+    vcl_size_t thread_id   = 0;
+    vcl_size_t num_threads = 1;
+#endif
+    unsigned int col_begin = static_cast<unsigned int>((rows * thread_id) / num_threads);
+    unsigned int col_end   = static_cast<unsigned int>((rows * (thread_id + 1)) / num_threads);
+
+    // next free position in each row of the transpose handled by this thread:
+    std::vector<unsigned int> U_offsets;
+    if (U_col_buffer)
+      U_offsets.assign(U_row_buffer + col_begin, U_row_buffer + col_end);
+
+    // only rows up to col_end have entries in the upper triangular part within [col_begin, col_end):
+    for (vcl_size_t i = 0; i < col_end; ++i)
+    {
+      unsigned int j = static_cast<unsigned int>(std::lower_bound(col_buffer + diagonal_index[i], col_buffer + row_buffer[i+1], col_begin) - col_buffer);
+      for (; j < row_buffer[i+1] && col_buffer[j] < col_end; ++j)
+      {
+        unsigned int col = col_buffer[j];
+        if (U_col_buffer)
+        {
+          unsigned int U_index = U_offsets[col - col_begin]++;
+          U_col_buffer[U_index] = static_cast<unsigned int>(i);
+          U_elements[U_index]   = elements[j];
+          factor_index[j] = U_index;
+        }
+        else
+          U_row_buffer[col+1] += 1;
+      }
+    }
+  }
+}
+
+/** @brief Computes the incomplete LU factors on the pattern of LU by a fixed number of sweeps of the Chow-Patel iteration.
+*
+* The sweeps are carried out in the memory domain given by 'ctx'. The initial guess is the strict lower part of A scaled by the diagonal for L, and the upper part of A for U.
+*
+* @param LU      On input: The system matrix in main memory with sorted column indices and the diagonal being part of the pattern (see ilu_level_of_fill_pattern()).
+*                On output: The unit lower triangular factor (diagonal not stored) and the upper triangular factor in the layout used by ILU0.
+* @param sweeps  Number of fixed-point sweeps
+* @param ctx     The context in which the sweeps are carried out
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void chow_patel_ilu(viennacl::compressed_matrix<NumericT, AlignmentV> & LU, vcl_size_t sweeps, viennacl::context ctx)
+{
+  NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
+
+  vcl_size_t rows = LU.size1();
+  if (rows == 0)
+    return;
+
+  //
+  // Step 1: Split into L and the transpose of U
+  //
+  // Rows of LU are sorted with the diagonal present, hence the strict lower part of row i precedes the diagonal and the upper part starts at the diagonal.
+  std::vector<unsigned int> diagonal_index(rows);
+  std::vector<unsigned int> L_row_buffer(rows + 1, 0);
+  std::vector<unsigned int> U_row_buffer(rows + 1, 0);
+  std::vector<NumericT>     diagonal(rows, NumericT(0));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (LU.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(rows); ++row)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+    unsigned int diag = static_cast<unsigned int>(std::lower_bound(col_buffer + row_buffer[i], col_buffer + row_buffer[i+1], static_cast<unsigned int>(i)) - col_buffer);
+    diagonal_index[i] = diag;
+    L_row_buffer[i+1] = diag - row_buffer[i];
+    diagonal[i]       = elements[diag];
+  }
+
+  chow_patel_split_U(row_buffer, col_buffer, elements, &(diagonal_index[0]), rows, LU.nnz(), &(U_row_buffer[0]),
+                     static_cast<unsigned int *>(NULL), static_cast<NumericT *>(NULL), static_cast<unsigned int *>(NULL));
+
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    L_row_buffer[i+1] += L_row_buffer[i];
+    U_row_buffer[i+1] += U_row_buffer[i];
+  }
+
+  vcl_size_t L_nnz = L_row_buffer[rows];
+  vcl_size_t U_nnz = U_row_buffer[rows];
+
+  std::vector<unsigned int> L_col_buffer(L_nnz);
+  std::vector<NumericT>     L_elements(L_nnz);
+  std::vector<NumericT>     L_aij(L_nnz);
+  std::vector<unsigned int> U_col_buffer(U_nnz);
+  std::vector<NumericT>     U_aij(U_nnz);
+  std::vector<unsigned int> factor_index(LU.nnz()); // position of each entry of LU in either L or U_trans
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (LU.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(rows); ++row)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+    unsigned int L_index = L_row_buffer[i];
+    for (unsigned int j = row_buffer[i]; j < diagonal_index[i]; ++j)
+    {
+      L_col_buffer[L_index] = col_buffer[j];
+      L_aij[L_index]        = elements[j];
+      L_elements[L_index]   = elements[j] / diagonal[col_buffer[j]];
+      factor_index[j] = L_index++;
+    }
+  }
+
+  if (U_nnz > 0)
+    chow_patel_split_U(row_buffer, col_buffer, elements, &(diagonal_index[0]), rows, LU.nnz(), &(U_row_buffer[0]),
+                       &(U_col_buffer[0]), &(U_aij[0]), &(factor_index[0]));
+  std::vector<NumericT> U_elements(U_aij);
+
+  //
+  // Step 2: Fixed-point sweeps (only needed if L is nontrivial, otherwise the initial guess is exact)
+  //
+  if (L_nnz > 0 && sweeps > 0)
+  {
+    viennacl::compressed_matrix<NumericT> L(ctx);
+    L.set(&(L_row_buffer[0]), &(L_col_buffer[0]), &(L_elements[0]), rows, rows, L_nnz);
+    viennacl::compressed_matrix<NumericT> U_trans(ctx);
+    U_trans.set(&(U_row_buffer[0]), &(U_col_buffer[0]), &(U_elements[0]), rows, rows, U_nnz);
+
+    viennacl::vector<NumericT> aij_L(L_nnz, ctx);
+    viennacl::backend::memory_write(aij_L.handle(), 0, sizeof(NumericT) * L_nnz, &(L_aij[0]));
+    viennacl::vector<NumericT> aij_U_trans(U_nnz, ctx);
+    viennacl::backend::memory_write(aij_U_trans.handle(), 0, sizeof(NumericT) * U_nnz, &(U_aij[0]));
+
+    for (vcl_size_t i = 0; i < sweeps; ++i)
+      viennacl::linalg::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+
+    viennacl::backend::memory_read(L.handle(),       0, sizeof(NumericT) * L_nnz, &(L_elements[0]));
+    viennacl::backend::memory_read(U_trans.handle(), 0, sizeof(NumericT) * U_nnz, &(U_elements[0]));
+  }
+
+  //
+  // Step 3: Write factors back to LU
+  //
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (LU.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(rows); ++row)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      elements[j] = (j < diagonal_index[i]) ? L_elements[factor_index[j]] : U_elements[factor_index[j]];
+  }
+}
+
+
+/** @brief Sets up the matrices for approximate triangular solves by Jacobi iterations from ILU factors.
+*
+* With LU = (I + L)(D + U) for strict lower and upper triangular parts L and U, the solves are x <- b - L x for the unit lower triangular factor
+* and x <- D^{-1} b - D^{-1} U x for the upper triangular factor.
+*
+* @param LU        The incomplete LU factors in main memory (unit diagonal of the lower factor not stored)
+* @param L         The strict lower triangular part of LU (result, main memory)
+* @param U         The strict upper triangular part of LU scaled by the inverse diagonal (result, main memory)
+* @param diag_inv  The inverse of the diagonal of LU (result, main memory)
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void ilu_jacobi_solve_setup(viennacl::compressed_matrix<NumericT, AlignmentV> const & LU,
+                            viennacl::compressed_matrix<NumericT> & L,
+                            viennacl::compressed_matrix<NumericT> & U,
+                            viennacl::vector<NumericT> & diag_inv)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
+
+  vcl_size_t rows = LU.size1();
+
+  std::vector<NumericT> diagonal(rows, NumericT(0));
+  for (vcl_size_t i = 0; i < rows; ++i)
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      if (col_buffer[j] == i)
+        diagonal[i] = elements[j];
+
+  std::vector<unsigned int> L_row_buffer(rows + 1, 0);
+  std::vector<unsigned int> U_row_buffer(rows + 1, 0);
+  std::vector<unsigned int> L_col_buffer, U_col_buffer;
+  std::vector<NumericT>     L_elements,   U_elements;
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+    {
+      if (col_buffer[j] < i)
+      {
+        L_col_buffer.push_back(col_buffer[j]);
+        L_elements.push_back(elements[j]);
+      }
+      else if (col_buffer[j] > i)
+      {
+        U_col_buffer.push_back(col_buffer[j]);
+        U_elements.push_back(elements[j] / diagonal[i]);
+      }
+    }
+    L_row_buffer[i+1] = static_cast<unsigned int>(L_col_buffer.size());
+    U_row_buffer[i+1] = static_cast<unsigned int>(U_col_buffer.size());
+  }
+
+  // an empty triangular part is represented by a single explicit zero:
+  if (L_col_buffer.size() == 0)
+  {
+    L_col_buffer.push_back(0); L_elements.push_back(0);
+    std::fill(L_row_buffer.begin() + 1, L_row_buffer.end(), 1);
+  }
+  if (U_col_buffer.size() == 0)
+  {
+    U_col_buffer.push_back(0); U_elements.push_back(0);
+    std::fill(U_row_buffer.begin() + 1, U_row_buffer.end(), 1);
+  }
+
+  viennacl::context host_context(viennacl::MAIN_MEMORY);
+  viennacl::switch_memory_context(L, host_context);
+  viennacl::switch_memory_context(U, host_context);
+  L.set(&(L_row_buffer[0]), &(L_col_buffer[0]), &(L_elements[0]), rows, LU.size2(), L_col_buffer.size());
+  U.set(&(U_row_buffer[0]), &(U_col_buffer[0]), &(U_elements[0]), rows, LU.size2(), U_col_buffer.size());
+
+  for (vcl_size_t i = 0; i < rows; ++i)
+    diagonal[i] = NumericT(1) / diagonal[i];
+  viennacl::switch_memory_context(diag_inv, host_context);
+  diag_inv.resize(rows, false);
+  viennacl::copy(diagonal, diag_inv);
+}
+
+} // namespace detail
+} // namespace linalg
+} // namespace viennacl
+
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <list>
@@ -43,6 +44,233 @@ namespace detail
 {
 
 
+//
+// Symbolic factorization for ILU(k):
+//
+
+/** @brief Returns true if the column indices in each row of A are strictly increasing and each row contains the diagonal, i.e. if A already has the pattern of ILU(0) as required by chow_patel_ilu().
+*
+* @param A   The system matrix in main memory
+*/
+template<typename NumericT, unsigned int AlignmentV>
+bool ilu_has_sorted_pattern_with_diagonal(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+{
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  long rows = static_cast<long>(A.size1());
+  long rows_failed = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: rows_failed) if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    unsigned int i = static_cast<unsigned int>(row);
+    bool has_diagonal = false;
+    bool is_sorted    = true;
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+    {
+      if (col_buffer[j] == i)
+        has_diagonal = true;
+      if (j > row_buffer[i] && col_buffer[j-1] >= col_buffer[j])
+        is_sorted = false;
+    }
+    if (!has_diagonal || !is_sorted)
+      rows_failed += 1;
+  }
+
+  return rows_failed == 0;
+}
+
+/** @brief Computes the pattern of ILU(0) (the pattern of A with sorted column indices and the diagonal added) in parallel. See ilu_level_of_fill_pattern() */
+template<typename NumericT, unsigned int AlignmentV>
+void ilu_zero_fill_pattern(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                           viennacl::compressed_matrix<NumericT, AlignmentV> & LU)
+{
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  vcl_size_t rows = A.size1();
+
+  std::vector<unsigned int> LU_row_buffer(rows + 1, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(rows); ++row)
+  {
+    unsigned int i = static_cast<unsigned int>(row);
+    unsigned int entries = row_buffer[i+1] - row_buffer[i] + 1;
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      if (col_buffer[j] == i)
+        entries -= 1;
+    LU_row_buffer[i+1] = entries;
+  }
+
+  for (vcl_size_t i = 0; i < rows; ++i)
+    LU_row_buffer[i+1] += LU_row_buffer[i];
+  vcl_size_t nnz = LU_row_buffer[rows];
+
+  std::vector<unsigned int> LU_col_buffer(nnz);
+  std::vector<NumericT>     LU_elements(nnz);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+    std::vector<std::pair<unsigned int, NumericT> > row_entries;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long row = 0; row < static_cast<long>(rows); ++row)
+    {
+      unsigned int i = static_cast<unsigned int>(row);
+      row_entries.clear();
+      bool has_diagonal = false;
+      for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      {
+        row_entries.push_back(std::make_pair(col_buffer[j], elements[j]));
+        has_diagonal = has_diagonal || (col_buffer[j] == i);
+      }
+      if (!has_diagonal)
+        row_entries.push_back(std::make_pair(i, NumericT(0)));
+      std::sort(row_entries.begin(), row_entries.end());
+
+      for (vcl_size_t k = 0; k < row_entries.size(); ++k)
+      {
+        LU_col_buffer[LU_row_buffer[i] + k] = row_entries[k].first;
+        LU_elements[LU_row_buffer[i] + k]   = row_entries[k].second;
+      }
+    }
+  }
+
+  viennacl::switch_memory_context(LU, viennacl::context(viennacl::MAIN_MEMORY));
+  LU.set(&(LU_row_buffer[0]), &(LU_col_buffer[0]), &(LU_elements[0]), rows, A.size2(), nnz);
+}
+
+/** @brief Computes the nonzero pattern of the incomplete LU factorization with level of fill k (ILU(k)).
+*
+* The result holds the entries of A on the extended pattern and zeros at the fill-in locations.
+* Column indices in each row are sorted and the diagonal is always part of the pattern.
+* With fill_level equal to zero, the pattern of A is kept and the rows are processed in parallel.
+* Otherwise, the rows are processed in order, since the fill-in of a row depends on the fill-in of all previous rows.
+*
+* @param A           The system matrix in main memory
+* @param fill_level  The level of fill k
+* @param LU          The resulting matrix in main memory
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void ilu_level_of_fill_pattern(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                               vcl_size_t fill_level,
+                               viennacl::compressed_matrix<NumericT, AlignmentV> & LU)
+{
+  if (fill_level == 0)
+  {
+    ilu_zero_fill_pattern(A, LU);
+    return;
+  }
+
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  vcl_size_t rows = A.size1();
+  vcl_size_t n    = std::max(rows, A.size2()); // column indices are smaller than n, n itself marks the end of the linked list below
+
+  // column indices and levels of the entries in the strict upper triangular part of each row (needed for the elimination in later rows):
+  std::vector<unsigned int> U_row_buffer(rows + 1, 0);
+  std::vector<unsigned int> U_col_buffer;
+  std::vector<vcl_size_t>   U_levels;
+
+  std::vector<unsigned int> LU_row_buffer(rows + 1);
+  std::vector<unsigned int> LU_col_buffer;
+  std::vector<NumericT>     LU_elements;
+  LU_col_buffer.reserve(A.nnz() + rows);
+  LU_elements.reserve(A.nnz() + rows);
+
+  // the current row is kept as a sorted linked list of its column indices (starting at next_col[n]) with the levels stored densely:
+  vcl_size_t const no_entry = static_cast<vcl_size_t>(-1);
+  std::vector<vcl_size_t>   row_levels(n, no_entry);
+  std::vector<unsigned int> next_col(n + 1);
+  std::vector<unsigned int> row_cols;
+
+  for (vcl_size_t i = 0; i < rows; ++i)
+  {
+    row_cols.clear();
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      if (row_levels[col_buffer[j]] == no_entry)
+      {
+        row_levels[col_buffer[j]] = 0;
+        row_cols.push_back(col_buffer[j]);
+      }
+    if (row_levels[i] == no_entry)
+    {
+      row_levels[i] = 0;
+      row_cols.push_back(static_cast<unsigned int>(i));
+    }
+    std::sort(row_cols.begin(), row_cols.end());
+
+    unsigned int tail = static_cast<unsigned int>(n);
+    for (vcl_size_t k = 0; k < row_cols.size(); ++k)
+      tail = next_col[tail] = row_cols[k];
+    next_col[tail] = static_cast<unsigned int>(n);
+
+    // eliminate with all previous rows k in ascending order. Fill-in is always inserted to the right of k, hence the iteration sees it:
+    for (unsigned int k = next_col[n]; k < i; k = next_col[k])
+    {
+      unsigned int position = k; // the columns of row k are sorted, so the insertion position only moves to the right
+      for (unsigned int l = U_row_buffer[k]; l < U_row_buffer[k+1]; ++l)
+      {
+        vcl_size_t level = row_levels[k] + U_levels[l] + 1;
+        if (level > fill_level)
+          continue;
+
+        unsigned int col = U_col_buffer[l];
+        if (row_levels[col] == no_entry)
+        {
+          while (next_col[position] < col)
+            position = next_col[position];
+          next_col[col]      = next_col[position];
+          next_col[position] = col;
+          row_levels[col]    = level;
+        }
+        else
+          row_levels[col] = std::min(row_levels[col], level);
+      }
+    }
+
+    // write pattern and reset the dense levels:
+    LU_row_buffer[i] = static_cast<unsigned int>(LU_col_buffer.size());
+    for (unsigned int col = next_col[n]; col < n; col = next_col[col])
+    {
+      LU_col_buffer.push_back(col);
+      LU_elements.push_back(NumericT(0));
+      if (col > i)
+      {
+        U_col_buffer.push_back(col);
+        U_levels.push_back(row_levels[col]);
+      }
+      row_levels[col] = no_entry;
+    }
+    U_row_buffer[i+1] = static_cast<unsigned int>(U_col_buffer.size());
+
+    // write values of A:
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+    {
+      vcl_size_t index = static_cast<vcl_size_t>(std::lower_bound(LU_col_buffer.begin() + LU_row_buffer[i], LU_col_buffer.end(), col_buffer[j]) - LU_col_buffer.begin());
+      LU_elements[index] += elements[j];
+    }
+  }
+  LU_row_buffer[rows] = static_cast<unsigned int>(LU_col_buffer.size());
+
+  viennacl::switch_memory_context(LU, viennacl::context(viennacl::MAIN_MEMORY));
+  LU.set(&(LU_row_buffer[0]), &(LU_col_buffer[0]), &(LU_elements[0]), rows, A.size2(), LU_col_buffer.size());
+}
+
+
 //
 // Level Scheduling Setup for ILU:
 //
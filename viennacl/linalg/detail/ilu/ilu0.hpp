@@ -33,6 +33,9 @@
 
  Low-level reimplementation by Karl Rupp in Nov 2012, increasing performance substantially. Also added level-scheduling.
 
+ Optionally, the factors are computed by parallel fixed-point sweeps (Chow-Patel) on the pattern of ILU(k),
+ and the triangular solves are replaced by a fixed number of Jacobi iterations.
+
 */
 
 #include <vector>
@@ -41,8 +44,10 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
+#include "viennacl/linalg/detail/ilu/chow_patel_ilu.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/prod.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
@@ -54,17 +59,42 @@ namespace linalg
 {
 
 /** @brief A tag for incomplete LU factorization with static pattern (ILU0)
+*
+* By default, the factors are computed sequentially on the host and the triangular systems are solved exactly.
+* For many-core machines and GPUs, the following options replace the sequential parts:
+*  - sweeps(): Number of fixed-point sweeps of the fine-grained parallel factorization by Chow and Patel. Zero (default) selects the sequential factorization.
+*              A few sweeps (typically up to three) are sufficient in practice.
+*  - jacobi_iters(): Number of Jacobi iterations for the approximate solution of each triangular system. Zero (default) selects exact substitution.
+*  - fill_level(): Level of fill k for ILU(k). Zero (default) keeps the pattern of the system matrix.
 */
 class ilu0_tag
 {
 public:
-  ilu0_tag(bool with_level_scheduling = false) : use_level_scheduling_(with_level_scheduling) {}
+  ilu0_tag(bool with_level_scheduling = false) : use_level_scheduling_(with_level_scheduling), sweeps_(0), jacobi_iters_(0), fill_level_(0) {}
 
   bool use_level_scheduling() const { return use_level_scheduling_; }
   void use_level_scheduling(bool b) { use_level_scheduling_ = b; }
 
+  /** @brief Returns the number of fixed-point sweeps for computing the factors. Zero means sequential factorization. */
+  vcl_size_t sweeps() const { return sweeps_; }
+  /** @brief Sets the number of fixed-point sweeps for computing the factors. Zero means sequential factorization. */
+  void sweeps(vcl_size_t num) { sweeps_ = num; }
+
+  /** @brief Returns the number of Jacobi iterations for each of the triangular solves. Zero means exact substitution. */
+  vcl_size_t jacobi_iters() const { return jacobi_iters_; }
+  /** @brief Sets the number of Jacobi iterations for each of the triangular solves. Zero means exact substitution. */
+  void jacobi_iters(vcl_size_t num) { jacobi_iters_ = num; }
+
+  /** @brief Returns the level of fill k for ILU(k) */
+  vcl_size_t fill_level() const { return fill_level_; }
+  /** @brief Sets the level of fill k for ILU(k) */
+  void fill_level(vcl_size_t k) { fill_level_ = k; }
+
 private:
   bool use_level_scheduling_;
+  vcl_size_t sweeps_;
+  vcl_size_t jacobi_iters_;
+  vcl_size_t fill_level_;
 };
 
 
@@ -126,7 +156,7 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & /*
         {
           if (col_buffer[buf_index_akj] == j)
           {
-            a_kk = elements[buf_index_akj];
+            a_kj = elements[buf_index_akj];
             break;
           }
         }
@@ -139,8 +169,36 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & /*
 
 }
 
+namespace detail
+{
+  /** @brief Computes the ILU0 or ILU(k) factors according to the options in the tag.
+  *
+  * @param LU    The system matrix in main memory. The result is directly written to LU.
+  * @param tag   The ILU0 tag
+  * @param ctx   The context in which the fixed-point sweeps are carried out (if requested by the tag)
+  */
+  template<typename NumericT>
+  void ilu0_factorize(viennacl::compressed_matrix<NumericT> & LU, ilu0_tag const & tag, viennacl::context ctx)
+  {
+    // sorted pattern with diagonal required, which is often already the case for ILU(0):
+    if (tag.fill_level() > 0 || (tag.sweeps() > 0 && !ilu_has_sorted_pattern_with_diagonal(LU)))
+    {
+      viennacl::compressed_matrix<NumericT> A(viennacl::context(viennacl::MAIN_MEMORY));
+      A = LU;
+      ilu_level_of_fill_pattern(A, tag.fill_level(), LU);
+    }
+
+    if (tag.sweeps() > 0)
+      chow_patel_ilu(LU, tag.sweeps(), ctx);
+    else
+      viennacl::linalg::precondition(LU, tag);
+  }
+}
+
 
 /** @brief ILU0 preconditioner class, can be supplied to solve()-routines
+*
+* The option jacobi_iters() of the tag is only supported by the specialization for compressed_matrix. Exact substitution is used otherwise.
 */
 template<typename MatrixT>
 class ilu0_precond
@@ -174,7 +232,7 @@ private:
     viennacl::switch_memory_context(LU_, host_context);
 
     viennacl::copy(mat, LU_);
-    viennacl::linalg::precondition(LU_, tag_);
+    detail::ilu0_factorize(LU_, tag_, host_context);
   }
 
   ilu0_tag const &                           tag_;
@@ -205,7 +263,26 @@ public:
   void apply(viennacl::vector<NumericT> & vec) const
   {
     viennacl::context host_context(viennacl::MAIN_MEMORY);
-    if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+    if (tag_.jacobi_iters() > 0)
+    {
+      // unit lower triangular solve: x <- b - L x
+      jacobi_rhs_ = vec;
+      for (vcl_size_t i = 0; i < tag_.jacobi_iters(); ++i)
+      {
+        jacobi_tmp_ = viennacl::linalg::prod(jacobi_L_, vec);
+        vec = jacobi_rhs_ - jacobi_tmp_;
+      }
+
+      // upper triangular solve: x <- D^{-1} b - D^{-1} U x
+      jacobi_rhs_ = viennacl::linalg::element_prod(vec, jacobi_diag_inv_);
+      vec = jacobi_rhs_;
+      for (vcl_size_t i = 0; i < tag_.jacobi_iters(); ++i)
+      {
+        jacobi_tmp_ = viennacl::linalg::prod(jacobi_U_, vec);
+        vec = jacobi_rhs_ - jacobi_tmp_;
+      }
+    }
+    else if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
     {
       if (tag_.use_level_scheduling())
       {
@@ -272,7 +349,20 @@ private:
     viennacl::context host_context(viennacl::MAIN_MEMORY);
     viennacl::switch_memory_context(LU_, host_context);
     LU_ = mat;
-    viennacl::linalg::precondition(LU_, tag_);
+    detail::ilu0_factorize(LU_, tag_, viennacl::traits::context(mat));
+
+    if (tag_.jacobi_iters() > 0)
+    {
+      detail::ilu_jacobi_solve_setup(LU_, jacobi_L_, jacobi_U_, jacobi_diag_inv_);
+      viennacl::switch_memory_context(jacobi_L_, viennacl::traits::context(mat));
+      viennacl::switch_memory_context(jacobi_U_, viennacl::traits::context(mat));
+      viennacl::switch_memory_context(jacobi_diag_inv_, viennacl::traits::context(mat));
+      viennacl::switch_memory_context(jacobi_rhs_, viennacl::traits::context(mat));
+      jacobi_rhs_.resize(mat.size1(), false);
+      viennacl::switch_memory_context(jacobi_tmp_, viennacl::traits::context(mat));
+      jacobi_tmp_.resize(mat.size1(), false);
+      return;
+    }
 
     if (!tag_.use_level_scheduling())
       return;
@@ -367,6 +457,11 @@ private:
   std::list<viennacl::backend::mem_handle> multifrontal_U_element_buffers_;
   std::list<vcl_size_t>                    multifrontal_U_row_elimination_num_list_;
 
+  viennacl::compressed_matrix<NumericT> jacobi_L_;
+  viennacl::compressed_matrix<NumericT> jacobi_U_;
+  viennacl::vector<NumericT>            jacobi_diag_inv_;
+  mutable viennacl::vector<NumericT>    jacobi_rhs_;
+  mutable viennacl::vector<NumericT>    jacobi_tmp_;
 };
 
 } // namespace linalg
@@ -23,7 +23,10 @@
 */
 
 #include <vector>
+#include <list>
 #include <cmath>
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
@@ -32,9 +35,18 @@
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
 
 #include <map>
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 namespace viennacl
 {
 namespace linalg
@@ -246,6 +258,477 @@ void precondition(SparseMatrixTypeT const & A,
 }
 
 
+namespace detail
+{
+  /** @brief Storage for the rows of the ILUT factors computed by one thread.
+  *
+  * Memory handed out is never moved, so other threads may read finished rows while further rows are added.
+  */
+  template<typename NumericT>
+  class ilut_row_storage
+  {
+  public:
+    ilut_row_storage() : used_(0) {}
+
+    /** @brief Provides space for 'num' entries of a row */
+    void allocate(vcl_size_t num, unsigned int * & cols, NumericT * & values)
+    {
+      if (num == 0)
+      {
+        cols = NULL;
+        values = NULL;
+        return;
+      }
+
+      if (col_chunks_.empty() || used_ + num > col_chunks_.back().size())
+      {
+        vcl_size_t chunk_size = std::max<vcl_size_t>(num, 65536);
+        col_chunks_.push_back(std::vector<unsigned int>(chunk_size));
+        value_chunks_.push_back(std::vector<NumericT>(chunk_size));
+        used_ = 0;
+      }
+
+      cols   = &(col_chunks_.back()[used_]);
+      values = &(value_chunks_.back()[used_]);
+      used_ += num;
+    }
+
+  private:
+    std::list< std::vector<unsigned int> > col_chunks_;
+    std::list< std::vector<NumericT> >     value_chunks_;
+    vcl_size_t used_;
+  };
+
+  /** @brief Orders column indices by decreasing magnitude of the respective entries in the working row.
+  *
+  * Ties are broken in favor of the larger column index, which reproduces the selection of the serial ILUT.
+  */
+  template<typename NumericT>
+  struct ilut_drop_compare
+  {
+    ilut_drop_compare(NumericT const * w) : w_(w) {}
+
+    bool operator()(unsigned int a, unsigned int b) const
+    {
+      NumericT abs_a = std::fabs(w_[a]);
+      NumericT abs_b = std::fabs(w_[b]);
+      return (abs_a > abs_b) || (!(abs_a < abs_b) && a > b);
+    }
+
+    NumericT const * w_;
+  };
+
+  /** @brief Returns true if the row was published by ilut_publish_row() */
+  inline bool ilut_row_ready(std::vector<int> const & row_done, vcl_size_t row)
+  {
+    int done;
+#if defined(VIENNACL_WITH_OPENMP) && (_OPENMP >= 201307)
+    #pragma omp atomic read seq_cst
+    done = row_done[row];
+#else
+  #ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+  #endif
+    done = row_done[row];
+#endif
+    return done != 0;
+  }
+
+  /** @brief Marks a row of the factors as finished. All writes to the row become visible to threads observing the flag. */
+  inline void ilut_publish_row(std::vector<int> & row_done, vcl_size_t row)
+  {
+#if defined(VIENNACL_WITH_OPENMP) && (_OPENMP >= 201307)
+    #pragma omp atomic write seq_cst
+    row_done[row] = 1;
+#else
+  #ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+  #endif
+    row_done[row] = 1;
+  #ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+  #endif
+#endif
+  }
+
+  /** @brief Busy-waits until a row was published by ilut_publish_row().
+  *
+  * Rows are usually published shortly after they are requested, so the thread keeps spinning, but backs off exponentially with pause instructions
+  * in order to leave the core (and the memory bus) to sibling threads which compute the row.
+  */
+  inline void ilut_wait_for_row(std::vector<int> const & row_done, vcl_size_t row)
+  {
+    unsigned int backoff = 1;
+    while (!ilut_row_ready(row_done, row))
+    {
+      for (unsigned int i = 0; i < backoff; ++i)
+      {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#endif
+      }
+      if (backoff < 1024)
+        backoff *= 2;
+    }
+  }
+
+  /** @brief Computes an order of the rows such that each row of ILUT only depends on rows earlier in the order.
+  *
+  * Whatever fill-in ILUT produces, row i is only eliminated with descendants of i in the elimination tree of the pattern of A + A^T.
+  * Rows are sorted by their height in this tree (leaves first), ties are resolved by the row index.
+  * Rows of the same height do not depend on each other.
+  *
+  *  @param row_buffer   Row offsets of A
+  *  @param col_buffer   Column indices of A
+  *  @param rows         Number of rows of A
+  *  @param order        The order of the rows (result)
+  */
+  inline void ilut_level_order(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t rows,
+                               std::vector<unsigned int> & order)
+  {
+    vcl_size_t no_parent = rows;
+
+    // entries A(k, i) with k < i, grouped by i:
+    std::vector<unsigned int> upper_offsets(rows + 1, 0);
+    for (vcl_size_t k = 0; k < rows; ++k)
+      for (unsigned int j = row_buffer[k]; j < row_buffer[k+1]; ++j)
+        if (col_buffer[j] > k && col_buffer[j] < rows)
+          ++upper_offsets[col_buffer[j] + 1];
+    for (vcl_size_t i = 0; i < rows; ++i)
+      upper_offsets[i+1] += upper_offsets[i];
+
+    std::vector<unsigned int> upper_rows(upper_offsets[rows]);
+    std::vector<unsigned int> fill_pos(upper_offsets.begin(), upper_offsets.end() - 1);
+    for (vcl_size_t k = 0; k < rows; ++k)
+      for (unsigned int j = row_buffer[k]; j < row_buffer[k+1]; ++j)
+        if (col_buffer[j] > k && col_buffer[j] < rows)
+          upper_rows[fill_pos[col_buffer[j]]++] = static_cast<unsigned int>(k);
+
+    // elimination tree of A + A^T (Liu's algorithm with path compression):
+    std::vector<vcl_size_t> parent(rows, no_parent);
+    std::vector<vcl_size_t> ancestor(rows, no_parent);
+    for (vcl_size_t i = 0; i < rows; ++i)
+    {
+      vcl_size_t num_lower = row_buffer[i+1] - row_buffer[i];
+      vcl_size_t num_upper = upper_offsets[i+1] - upper_offsets[i];
+      for (vcl_size_t l = 0; l < num_lower + num_upper; ++l)
+      {
+        vcl_size_t k = (l < num_lower) ? col_buffer[row_buffer[i] + l] : upper_rows[upper_offsets[i] + l - num_lower];
+        if (k >= i)
+          continue;
+
+        while (ancestor[k] != no_parent && ancestor[k] != i)
+        {
+          vcl_size_t next = ancestor[k];
+          ancestor[k] = i;
+          k = next;
+        }
+        if (ancestor[k] == no_parent)
+        {
+          ancestor[k] = i;
+          parent[k] = i;
+        }
+      }
+    }
+
+    // height in the tree. Children have smaller indices than their parents:
+    std::vector<unsigned int> level(rows, 0);
+    unsigned int num_levels = (rows > 0) ? 1 : 0;
+    for (vcl_size_t i = 0; i < rows; ++i)
+    {
+      if (parent[i] != no_parent)
+        level[parent[i]] = std::max(level[parent[i]], level[i] + 1);
+      num_levels = std::max(num_levels, level[i] + 1);
+    }
+
+    // counting sort by level, stable with respect to the row index:
+    std::vector<unsigned int> level_offsets(num_levels + 1, 0);
+    for (vcl_size_t i = 0; i < rows; ++i)
+      ++level_offsets[level[i] + 1];
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+      level_offsets[l+1] += level_offsets[l];
+
+    order.resize(rows);
+    for (vcl_size_t i = 0; i < rows; ++i)
+      order[level_offsets[level[i]]++] = static_cast<unsigned int>(i);
+  }
+
+
+  /** @brief Row-parallel ILUT for a compressed_matrix in main memory. Multithreaded!
+  *
+  * Rows are handed out to the threads dynamically in the order computed by ilut_level_order(), so rows of the same level are processed concurrently.
+  * Fill-in is not known in advance, hence a row still waits if a row it is eliminated with is not finished yet (e.g. for long chains in the elimination tree).
+  * All such rows come earlier in the order, so the first row in the order which is not finished never waits and there is no deadlock.
+  *
+  * The working row is kept in a dense accumulator in the thread's workspace, the pending entries of L are kept in a heap.
+  * The entries_per_row largest entries of L and U are selected with std::nth_element.
+  * Each row is computed with the same floating point operations in the same order as in the serial precondition(), so the factors are identical.
+  *
+  *  @param A     The system matrix in main memory
+  *  @param LU    The factors (result, main memory). The unit diagonal of L is not stored, columns in each row are sorted.
+  *  @param tag   The ILUT tag
+  */
+  template<typename NumericT, unsigned int AlignmentV>
+  void ilut_row_parallel(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                         viennacl::compressed_matrix<NumericT> & LU,
+                         ilut_tag const & tag)
+  {
+    assert( (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILUT") );
+    assert( (A.handle2().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILUT") );
+    assert( (A.handle().get_active_handle_id()  == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILUT") );
+
+    NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    long       rows              = static_cast<long>(A.size1());
+    vcl_size_t cols              = A.size2();
+    vcl_size_t entries_per_row   = tag.get_entries_per_row();
+    NumericT   drop_tolerance    = static_cast<NumericT>(tag.get_drop_tolerance());
+
+    // rows of the factors, published by setting row_done:
+    std::vector<unsigned int const *> LU_cols(static_cast<vcl_size_t>(rows), static_cast<unsigned int const *>(0));
+    std::vector<NumericT const *>     LU_values(static_cast<vcl_size_t>(rows), static_cast<NumericT const *>(0));
+    std::vector<unsigned int>         LU_nnz(static_cast<vcl_size_t>(rows), 0);
+    std::vector<long>                 LU_diag(static_cast<vcl_size_t>(rows), -1); // position of the diagonal in each row, -1 if not present
+    std::vector<int>                  row_done(static_cast<vcl_size_t>(rows), 0);
+
+    std::vector<unsigned int> row_order;
+    ilut_level_order(row_buffer, col_buffer, static_cast<vcl_size_t>(rows), row_order);
+
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+    std::vector< ilut_row_storage<NumericT> > storage(num_threads);
+
+    // first row which fails (same as in the serial variant):
+    long error_row = rows;
+    long error_k   = 0;
+    bool error_singular = false;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (A.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      vcl_size_t thread_id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+      thread_id = static_cast<vcl_size_t>(omp_get_thread_num());
+#endif
+
+      // dense working row w, stamps marking its nonzeros, list of its nonzeros, and heap of pending entries of L:
+      char * buffer = viennacl::linalg::host_based::detail::workspace_buffer<char>(viennacl::linalg::host_based::WORKSPACE_FACTORIZATION,
+                                                                                   cols * (sizeof(NumericT) + 3 * sizeof(unsigned int)));
+      NumericT     * w       = reinterpret_cast<NumericT *>(buffer);
+      unsigned int * w_stamp = reinterpret_cast<unsigned int *>(buffer + cols * sizeof(NumericT));
+      unsigned int * w_cols  = w_stamp + cols;
+      unsigned int * heap    = w_cols + cols;
+      std::fill(w_stamp, w_stamp + cols, 0u);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic, 1)
+#endif
+      for (long i2 = 0; i2 < rows; ++i2)
+      {
+        long i = static_cast<long>(row_order[static_cast<vcl_size_t>(i2)]);
+        unsigned int stamp = static_cast<unsigned int>(i) + 1;
+        unsigned int row   = static_cast<unsigned int>(i);
+        vcl_size_t nnz_w = 0;
+        vcl_size_t heap_size = 0;
+        bool row_failed = false;
+
+        //line 2: set up w
+        NumericT row_norm = 0;
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+        {
+          unsigned int col = col_buffer[j];
+          if (w_stamp[col] != stamp)
+          {
+            w_stamp[col] = stamp;
+            w_cols[nnz_w++] = col;
+            if (col < row)
+            {
+              heap[heap_size++] = col;
+              std::push_heap(heap, heap + heap_size, std::greater<unsigned int>());
+            }
+          }
+          NumericT entry = elements[j];
+          w[col] = entry;
+          row_norm += entry * entry;
+        }
+        NumericT tau_i = drop_tolerance * std::sqrt(row_norm);
+
+        //line 3: eliminate in ascending order of k, including fill-in
+        while (heap_size > 0)
+        {
+          std::pop_heap(heap, heap + heap_size, std::greater<unsigned int>());
+          unsigned int k = heap[--heap_size];
+
+          ilut_wait_for_row(row_done, k);
+
+          //line 4:
+          NumericT a_kk = (LU_diag[k] < 0) ? NumericT(0) : LU_values[k][LU_diag[k]];
+          if (a_kk <= 0 && a_kk >= 0) // a_kk == 0
+          {
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp critical (viennacl_ilut_error)
+#endif
+            if (i < error_row)
+            {
+              error_row = i;
+              error_k = static_cast<long>(k);
+              error_singular = false;
+            }
+            row_failed = true;
+            break;
+          }
+
+          NumericT w_k_entry = w[k] / a_kk;
+          w[k] = w_k_entry;
+
+          //line 5: (dropping rule to w_k)
+          if (std::fabs(w_k_entry) > tau_i)
+          {
+            //line 7: the entries of U in row k follow the diagonal
+            for (unsigned int l = static_cast<unsigned int>(LU_diag[k]) + 1; l < LU_nnz[k]; ++l)
+            {
+              unsigned int col = LU_cols[k][l];
+              if (w_stamp[col] != stamp)
+              {
+                w_stamp[col] = stamp;
+                w[col] = 0;
+                w_cols[nnz_w++] = col;
+                if (col < row)
+                {
+                  heap[heap_size++] = col;
+                  std::push_heap(heap, heap + heap_size, std::greater<unsigned int>());
+                }
+              }
+              w[col] -= w_k_entry * LU_values[k][l];
+            }
+          }
+        }
+
+        //Line 10: Apply a dropping rule to w. Kept entries of L are collected in 'heap' (now empty), kept entries of U are compacted in w_cols
+        vcl_size_t num_L = 0;
+        vcl_size_t num_U = 0;
+        bool has_diagonal = false;
+        for (vcl_size_t l = 0; l < nnz_w && !row_failed; ++l)
+        {
+          unsigned int col = w_cols[l];
+          NumericT abs_w_k = std::fabs(w[col]);
+          if ( (abs_w_k > tau_i) || (col == row) ) //do not drop diagonal element!
+          {
+            if (abs_w_k <= 0) // this can only happen for diagonal entry
+            {
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp critical (viennacl_ilut_error)
+#endif
+              if (i < error_row)
+              {
+                error_row = i;
+                error_singular = true;
+              }
+              row_failed = true;
+            }
+            else if (col < row)
+              heap[num_L++] = col;
+            else if (col == row)
+              has_diagonal = true;
+            else
+              w_cols[num_U++] = col;
+          }
+        }
+
+        //Lines 10-12: write the largest p values to L and U
+        if (row_failed)
+        {
+          num_L = 0;
+          num_U = 0;
+          has_diagonal = false;
+        }
+        if (num_L > entries_per_row)
+        {
+          std::nth_element(heap, heap + entries_per_row, heap + num_L, ilut_drop_compare<NumericT>(w));
+          num_L = entries_per_row;
+        }
+        if (num_U > entries_per_row)
+        {
+          std::nth_element(w_cols, w_cols + entries_per_row, w_cols + num_U, ilut_drop_compare<NumericT>(w));
+          num_U = entries_per_row;
+        }
+        std::sort(heap, heap + num_L);
+        std::sort(w_cols, w_cols + num_U);
+
+        vcl_size_t row_nnz = num_L + num_U + (has_diagonal ? 1 : 0);
+        unsigned int * row_cols;
+        NumericT     * row_values;
+        storage[thread_id].allocate(row_nnz, row_cols, row_values);
+
+        vcl_size_t index = 0;
+        for (vcl_size_t l = 0; l < num_L; ++l, ++index)
+        {
+          row_cols[index]   = heap[l];
+          row_values[index] = w[heap[l]];
+        }
+        if (has_diagonal)
+        {
+          row_cols[index]   = row;
+          row_values[index] = w[row];
+          ++index;
+        }
+        for (vcl_size_t l = 0; l < num_U; ++l, ++index)
+        {
+          row_cols[index]   = w_cols[l];
+          row_values[index] = w[w_cols[l]];
+        }
+
+        LU_cols[i]   = row_cols;
+        LU_values[i] = row_values;
+        LU_nnz[i]    = static_cast<unsigned int>(row_nnz);
+        LU_diag[i]   = has_diagonal ? static_cast<long>(num_L) : -1;
+
+        ilut_publish_row(row_done, static_cast<vcl_size_t>(i));
+      } //for i
+    }
+
+    if (error_row < rows)
+    {
+      if (error_singular)
+        throw "Triangular factor in ILUT singular!";
+
+      std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry is zero in row " << error_k
+                << " while processing line " << error_row << "!" << std::endl;
+      throw "ILUT zero diagonal!";
+    }
+
+    //
+    // Write factors to LU:
+    //
+    std::vector<unsigned int> LU_row_buffer(rows + 1, 0);
+    for (long i = 0; i < rows; ++i)
+      LU_row_buffer[i+1] = LU_row_buffer[i] + LU_nnz[i];
+
+    std::vector<unsigned int> LU_col_buffer(LU_row_buffer[rows]);
+    std::vector<NumericT>     LU_elements(LU_row_buffer[rows]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (LU_col_buffer.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i = 0; i < rows; ++i)
+    {
+      std::copy(LU_cols[i],   LU_cols[i]   + LU_nnz[i], LU_col_buffer.begin() + LU_row_buffer[i]);
+      std::copy(LU_values[i], LU_values[i] + LU_nnz[i], LU_elements.begin()   + LU_row_buffer[i]);
+    }
+
+    viennacl::switch_memory_context(LU, viennacl::context(viennacl::MAIN_MEMORY));
+    LU.set(&(LU_row_buffer[0]), &(LU_col_buffer[0]), &(LU_elements[0]), A.size1(), A.size2(), LU_col_buffer.size());
+  }
+}
+
+
 /** @brief ILUT preconditioner class, can be supplied to solve()-routines
 */
 template<typename MatrixT>
@@ -283,12 +766,7 @@ private:
 
     viennacl::copy(mat, temp);
 
-    std::vector< std::map<unsigned int, NumericType> > LU_temp(mat.size1());
-
-    viennacl::linalg::precondition(temp, LU_temp, tag_);
-
-    viennacl::switch_memory_context(LU_, host_context);
-    viennacl::copy(LU_temp, LU_);
+    detail::ilut_row_parallel(temp, LU_, tag_);
   }
 
   ilut_tag const & tag_;
@@ -362,11 +840,9 @@ private:
     viennacl::context host_context(viennacl::MAIN_MEMORY);
     viennacl::switch_memory_context(LU_, host_context);
 
-    std::vector< std::map<unsigned int, NumericT> > LU_temp(mat.size1());
-
     if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
     {
-      viennacl::linalg::precondition(mat, LU_temp, tag_);
+      detail::ilut_row_parallel(mat, LU_, tag_);
     }
     else //we need to copy to CPU
     {
@@ -375,11 +851,9 @@ private:
 
       cpu_mat = mat;
 
-      viennacl::linalg::precondition(cpu_mat, LU_temp, tag_);
+      detail::ilut_row_parallel(cpu_mat, LU_, tag_);
     }
 
-    viennacl::copy(LU_temp, LU_);
-
     if (!tag_.use_level_scheduling())
       return;
 
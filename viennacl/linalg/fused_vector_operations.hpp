@@ -0,0 +1,243 @@
+#ifndef VIENNACL_LINALG_FUSED_VECTOR_OPERATIONS_HPP_
+#define VIENNACL_LINALG_FUSED_VECTOR_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/fused_vector_operations.hpp
+    @brief A sequence of vector updates followed by inner products and norms, executed in a single pass over the vectors.
+
+    Typical use in a Krylov method:
+    \code
+      viennacl::linalg::fused_vector_operation<double> op;
+      op.add_update(x,  alpha, p);    // x += alpha * p
+      op.add_update(r, -alpha, Ap);   // r -= alpha * Ap
+      op.add_inner_prod(r, r);        // <r, r> of the updated r
+      std::vector<double> results;
+      viennacl::linalg::fused_update_reduce(op, results);
+    \endcode
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+#include "viennacl/linalg/host_based/vector_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Describes a list of vector updates y = alpha * x + beta * y, followed by a list of reductions (inner products and norms).
+*
+* The updates are applied in the order they were added. All reductions are computed from the vectors after all updates have been applied.
+* Thus, the result is the same as for executing the operations one after another, provided that the vectors are either identical or do not overlap in memory.
+* The vectors are only referenced, so they need to outlive the object.
+*/
+template<typename NumericT>
+class fused_vector_operation
+{
+public:
+  typedef NumericT                    value_type;
+  typedef vector_base<NumericT>       vector_type;
+
+  enum reduction_type
+  {
+    INNER_PROD = 0,
+    NORM_1,
+    NORM_2,
+    NORM_INF
+  };
+
+  /** @brief A linear update y = alpha * x + beta * y */
+  struct update_entry
+  {
+    vector_type       * y;
+    vector_type const * x;
+    NumericT alpha;
+    NumericT beta;
+  };
+
+  /** @brief A reduction. For norms, only x is used. */
+  struct reduction_entry
+  {
+    reduction_type      type;
+    vector_type const * x;
+    vector_type const * y;
+  };
+
+  fused_vector_operation() : size_(0) {}
+
+  /** @brief Adds the update y = alpha * x + beta * y */
+  fused_vector_operation & add_update(vector_type & y, NumericT alpha, vector_type const & x, NumericT beta = NumericT(1))
+  {
+    check_size(y);
+    check_size(x);
+    update_entry u = { &y, &x, alpha, beta };
+    updates_.push_back(u);
+    return *this;
+  }
+
+  /** @brief Adds the inner product <x, y> to the reductions */
+  fused_vector_operation & add_inner_prod(vector_type const & x, vector_type const & y) { return add_reduction(INNER_PROD, x, y); }
+
+  /** @brief Adds the l^1-norm of x to the reductions */
+  fused_vector_operation & add_norm_1(vector_type const & x)   { return add_reduction(NORM_1, x, x); }
+
+  /** @brief Adds the l^2-norm of x to the reductions */
+  fused_vector_operation & add_norm_2(vector_type const & x)   { return add_reduction(NORM_2, x, x); }
+
+  /** @brief Adds the supremum-norm of x to the reductions */
+  fused_vector_operation & add_norm_inf(vector_type const & x) { return add_reduction(NORM_INF, x, x); }
+
+  /** @brief Removes all updates and reductions */
+  void clear()
+  {
+    updates_.clear();
+    reductions_.clear();
+    size_ = 0;
+  }
+
+  vcl_size_t size() const { return size_; }
+
+  vcl_size_t update_size() const { return updates_.size(); }
+  update_entry const & update_at(vcl_size_t i) const { return updates_[i]; }
+
+  vcl_size_t reduction_size() const { return reductions_.size(); }
+  reduction_entry const & reduction_at(vcl_size_t i) const { return reductions_[i]; }
+
+  /** @brief Returns one of the vectors involved, which is used for determining the memory domain. */
+  vector_type const & some_vector() const
+  {
+    assert((updates_.size() > 0 || reductions_.size() > 0) && bool("No operations in fused_vector_operation"));
+    return updates_.size() > 0 ? *updates_[0].y : *reductions_[0].x;
+  }
+
+private:
+  fused_vector_operation & add_reduction(reduction_type type, vector_type const & x, vector_type const & y)
+  {
+    check_size(x);
+    check_size(y);
+    reduction_entry r = { type, &x, &y };
+    reductions_.push_back(r);
+    return *this;
+  }
+
+  void check_size(vector_type const & v)
+  {
+    if (updates_.size() == 0 && reductions_.size() == 0)
+      size_ = viennacl::traits::size(v);
+    assert(viennacl::traits::size(v) == size_ && bool("Size mismatch in fused_vector_operation"));
+  }
+
+  std::vector<update_entry>    updates_;
+  std::vector<reduction_entry> reductions_;
+  vcl_size_t                   size_;
+};
+
+
+namespace detail
+{
+  /** @brief Executes the operations one after another. Used for the compute backends without a fused implementation. */
+  template<typename NumericT>
+  void fused_update_reduce_sequential(fused_vector_operation<NumericT> const & op, std::vector<NumericT> & results)
+  {
+    typedef fused_vector_operation<NumericT>   OperationType;
+
+    for (vcl_size_t i = 0; i < op.update_size(); ++i)
+    {
+      typename OperationType::update_entry const & u = op.update_at(i);
+      viennacl::linalg::avbv(*u.y, *u.x, u.alpha, 1, false, false, *u.y, u.beta, 1, false, false);
+    }
+
+    viennacl::scalar<NumericT> temp(0, viennacl::traits::context(op.some_vector()));
+    for (vcl_size_t i = 0; i < op.reduction_size(); ++i)
+    {
+      typename OperationType::reduction_entry const & r = op.reduction_at(i);
+      switch (r.type)
+      {
+      case OperationType::INNER_PROD: viennacl::linalg::inner_prod_impl(*r.x, *r.y, temp); break;
+      case OperationType::NORM_1:     viennacl::linalg::norm_1_impl(*r.x, temp);           break;
+      case OperationType::NORM_2:     viennacl::linalg::norm_2_impl(*r.x, temp);           break;
+      case OperationType::NORM_INF:   viennacl::linalg::norm_inf_impl(*r.x, temp);         break;
+      }
+      results[i] = temp;
+    }
+  }
+}
+
+/** @brief Applies all updates of a fused vector operation and computes its reductions.
+*
+* In main memory, all vectors are traversed only once by a single parallel loop. Other memory domains execute the operations one after another.
+*
+* @param op       The updates and reductions
+* @param results  The results of the reductions in the order they were added to op. Resized if needed.
+*/
+template<typename NumericT>
+void fused_update_reduce(fused_vector_operation<NumericT> const & op, std::vector<NumericT> & results)
+{
+  results.resize(op.reduction_size());
+  if (op.update_size() == 0 && op.reduction_size() == 0)
+    return;
+
+  switch (viennacl::traits::handle(op.some_vector()).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::fused_update_reduce(op, results.size() > 0 ? &results[0] : NULL);
+    break;
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+    detail::fused_update_reduce_sequential(op, results);
+    break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+    detail::fused_update_reduce_sequential(op, results);
+    break;
+#endif
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Applies all updates of a fused vector operation and writes the results of its reductions to a (sub-)vector.
+*
+* @param op       The updates and reductions
+* @param result   The results of the reductions in the order they were added to op. Needs to match the number of reductions.
+*/
+template<typename NumericT>
+void fused_update_reduce(fused_vector_operation<NumericT> const & op, vector_base<NumericT> & result)
+{
+  assert(result.size() == op.reduction_size() && bool("Number of reductions does not match result size"));
+
+  std::vector<NumericT> host_results;
+  fused_update_reduce(op, host_results);
+  for (vcl_size_t i = 0; i < host_results.size(); ++i)
+    result[i] = host_results[i];
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,605 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_BLAS1_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_BLAS1_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/blas1_kernels.hpp
+    @brief Explicitly vectorized BLAS level 1 kernels (scaling, vector additions, inner products, norms) for unit-stride vectors in main memory.
+
+    Kernels are provided for SSE2, AVX2 and AVX-512 and are selected at runtime via active_simd_isa().
+    The entry points in blas1_simd return false if no kernel is available for the numeric type or the CPU, in which case the caller falls back to its plain loops.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+#include "viennacl/linalg/host_based/simd_ops.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Returns true if the square root of a sum of squares cannot be trusted because of overflow or underflow of the squares. */
+template<typename NumericT>
+bool blas1_norm_2_needs_rescaling(NumericT sum_of_squares)
+{
+  return !(sum_of_squares <= std::numeric_limits<NumericT>::max())   // also true for NaN
+      || sum_of_squares < std::numeric_limits<NumericT>::min() / std::numeric_limits<NumericT>::epsilon();
+}
+
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+
+//
+// Kernels: All vectors are unit-stride and already offset to their first entry. Entries beyond the last full SIMD vector are processed by a scalar loop.
+//          The body is the same for all instruction sets, only the target attribute and the intrinsics wrapper differ.
+//
+
+#define VIENNACL_HOST_BLAS1_KERNEL(KERNEL_NAME, TARGET_ATTRIBUTE, OPS_NAME) \
+template<typename NumericT> \
+struct KERNEL_NAME \
+{ \
+  typedef OPS_NAME<NumericT>              ops; \
+  typedef typename ops::vector_type       vector_type; \
+  static const vcl_size_t w = ops::width; \
+\
+  template<bool ReciprocalV> \
+  TARGET_ATTRIBUTE static inline vector_type scaled(vector_type v, vector_type alpha) { return ReciprocalV ? ops::div(v, alpha) : ops::mul(v, alpha); } \
+\
+  TARGET_ATTRIBUTE static inline NumericT reduce_add(vector_type v) \
+  { \
+    NumericT buffer[w]; \
+    ops::store(buffer, v); \
+    NumericT result = 0; \
+    for (vcl_size_t k = 0; k < w; ++k) \
+      result += buffer[k]; \
+    return result; \
+  } \
+\
+  TARGET_ATTRIBUTE static inline NumericT reduce_max(vector_type v) \
+  { \
+    NumericT buffer[w]; \
+    ops::store(buffer, v); \
+    NumericT result = 0; \
+    for (vcl_size_t k = 0; k < w; ++k) \
+      result = (buffer[k] > result) ? buffer[k] : result; \
+    return result; \
+  } \
+\
+  /* y = x * alpha  or  y = x / alpha */ \
+  template<bool ReciprocalV> \
+  TARGET_ATTRIBUTE static void scale(vcl_size_t n, NumericT const * x, NumericT alpha, NumericT * y) \
+  { \
+    vector_type va = ops::set1(alpha); \
+    vcl_size_t i = 0; \
+    for (; i + w <= n; i += w) \
+      ops::store(y + i, scaled<ReciprocalV>(ops::load(x + i), va)); \
+    for (; i < n; ++i) \
+      y[i] = ReciprocalV ? x[i] / alpha : x[i] * alpha; \
+  } \
+\
+  /* z = x * alpha + y * beta  or  z += x * alpha + y * beta, where each factor may also be a divisor */ \
+  template<bool ReciprocalAlphaV, bool ReciprocalBetaV, bool AccumulateV> \
+  TARGET_ATTRIBUTE static void axpby(vcl_size_t n, NumericT const * x, NumericT alpha, NumericT const * y, NumericT beta, NumericT * z) \
+  { \
+    vector_type va = ops::set1(alpha); \
+    vector_type vb = ops::set1(beta); \
+    vcl_size_t i = 0; \
+    for (; i + w <= n; i += w) \
+    { \
+      vector_type r = ops::add(scaled<ReciprocalAlphaV>(ops::load(x + i), va), scaled<ReciprocalBetaV>(ops::load(y + i), vb)); \
+      if (AccumulateV) \
+        r = ops::add(ops::load(z + i), r); \
+      ops::store(z + i, r); \
+    } \
+    for (; i < n; ++i) \
+    { \
+      NumericT r = (ReciprocalAlphaV ? x[i] / alpha : x[i] * alpha) + (ReciprocalBetaV ? y[i] / beta : y[i] * beta); \
+      z[i] = AccumulateV ? z[i] + r : r; \
+    } \
+  } \
+\
+  /* y += alpha * x */ \
+  TARGET_ATTRIBUTE static void axpy(vcl_size_t n, NumericT alpha, NumericT const * x, NumericT * y) \
+  { \
+    vector_type va = ops::set1(alpha); \
+    vcl_size_t i = 0; \
+    for (; i + w <= n; i += w) \
+      ops::store(y + i, ops::fmadd(va, ops::load(x + i), ops::load(y + i))); \
+    for (; i < n; ++i) \
+      y[i] += alpha * x[i]; \
+  } \
+\
+  /* Reductions use four independent accumulators to hide the latency of the additions */ \
+  TARGET_ATTRIBUTE static NumericT dot(vcl_size_t n, NumericT const * x, NumericT const * y) \
+  { \
+    vector_type s0 = ops::zero(), s1 = ops::zero(), s2 = ops::zero(), s3 = ops::zero(); \
+    vcl_size_t i = 0; \
+    for (; i + 4 * w <= n; i += 4 * w) \
+    { \
+      s0 = ops::fmadd(ops::load(x + i),         ops::load(y + i),         s0); \
+      s1 = ops::fmadd(ops::load(x + i + w),     ops::load(y + i + w),     s1); \
+      s2 = ops::fmadd(ops::load(x + i + 2 * w), ops::load(y + i + 2 * w), s2); \
+      s3 = ops::fmadd(ops::load(x + i + 3 * w), ops::load(y + i + 3 * w), s3); \
+    } \
+    for (; i + w <= n; i += w) \
+      s0 = ops::fmadd(ops::load(x + i), ops::load(y + i), s0); \
+    NumericT result = reduce_add(ops::add(ops::add(s0, s1), ops::add(s2, s3))); \
+    for (; i < n; ++i) \
+      result += x[i] * y[i]; \
+    return result; \
+  } \
+\
+  TARGET_ATTRIBUTE static NumericT asum(vcl_size_t n, NumericT const * x) \
+  { \
+    vector_type s0 = ops::zero(), s1 = ops::zero(), s2 = ops::zero(), s3 = ops::zero(); \
+    vcl_size_t i = 0; \
+    for (; i + 4 * w <= n; i += 4 * w) \
+    { \
+      s0 = ops::add(ops::abs(ops::load(x + i)),         s0); \
+      s1 = ops::add(ops::abs(ops::load(x + i + w)),     s1); \
+      s2 = ops::add(ops::abs(ops::load(x + i + 2 * w)), s2); \
+      s3 = ops::add(ops::abs(ops::load(x + i + 3 * w)), s3); \
+    } \
+    for (; i + w <= n; i += w) \
+      s0 = ops::add(ops::abs(ops::load(x + i)), s0); \
+    NumericT result = reduce_add(ops::add(ops::add(s0, s1), ops::add(s2, s3))); \
+    for (; i < n; ++i) \
+      result += std::fabs(x[i]); \
+    return result; \
+  } \
+\
+  /* Sum of squares of x, or of x / divisor if ScaledV is true */ \
+  template<bool ScaledV> \
+  TARGET_ATTRIBUTE static NumericT sumsq(vcl_size_t n, NumericT const * x, NumericT divisor) \
+  { \
+    vector_type vd = ops::set1(divisor); \
+    vector_type s0 = ops::zero(), s1 = ops::zero(), s2 = ops::zero(), s3 = ops::zero(); \
+    vcl_size_t i = 0; \
+    for (; i + 4 * w <= n; i += 4 * w) \
+    { \
+      vector_type x0 = ops::load(x + i),         x1 = ops::load(x + i + w); \
+      vector_type x2 = ops::load(x + i + 2 * w), x3 = ops::load(x + i + 3 * w); \
+      if (ScaledV) \
+      { \
+        x0 = ops::div(x0, vd); x1 = ops::div(x1, vd); \
+        x2 = ops::div(x2, vd); x3 = ops::div(x3, vd); \
+      } \
+      s0 = ops::fmadd(x0, x0, s0); \
+      s1 = ops::fmadd(x1, x1, s1); \
+      s2 = ops::fmadd(x2, x2, s2); \
+      s3 = ops::fmadd(x3, x3, s3); \
+    } \
+    for (; i + w <= n; i += w) \
+    { \
+      vector_type x0 = ScaledV ? ops::div(ops::load(x + i), vd) : ops::load(x + i); \
+      s0 = ops::fmadd(x0, x0, s0); \
+    } \
+    NumericT result = reduce_add(ops::add(ops::add(s0, s1), ops::add(s2, s3))); \
+    for (; i < n; ++i) \
+    { \
+      NumericT x0 = ScaledV ? x[i] / divisor : x[i]; \
+      result += x0 * x0; \
+    } \
+    return result; \
+  } \
+\
+  TARGET_ATTRIBUTE static NumericT amax(vcl_size_t n, NumericT const * x) \
+  { \
+    vector_type s0 = ops::zero(), s1 = ops::zero(); \
+    vcl_size_t i = 0; \
+    for (; i + 2 * w <= n; i += 2 * w) \
+    { \
+      s0 = ops::max(ops::abs(ops::load(x + i)),     s0); \
+      s1 = ops::max(ops::abs(ops::load(x + i + w)), s1); \
+    } \
+    for (; i + w <= n; i += w) \
+      s0 = ops::max(ops::abs(ops::load(x + i)), s0); \
+    NumericT result = reduce_max(ops::max(s0, s1)); \
+    for (; i < n; ++i) \
+      result = (std::fabs(x[i]) > result) ? std::fabs(x[i]) : result; \
+    return result; \
+  } \
+};
+
+VIENNACL_HOST_BLAS1_KERNEL(blas1_kernel_sse2,   VIENNACL_HOST_TARGET_SSE2,   sse2_ops)
+VIENNACL_HOST_BLAS1_KERNEL(blas1_kernel_avx2,   VIENNACL_HOST_TARGET_AVX2,   avx2_ops)
+VIENNACL_HOST_BLAS1_KERNEL(blas1_kernel_avx512, VIENNACL_HOST_TARGET_AVX512, avx512_ops)
+
+#undef VIENNACL_HOST_BLAS1_KERNEL
+
+#endif
+
+
+//
+// Operations: Wrap the runtime arguments of a kernel such that they can be applied to a subrange [begin, end) of the vectors with any of the kernels above.
+//
+
+/** @brief y = x * alpha or y = x / alpha */
+template<typename NumericT>
+struct blas1_scale_operation
+{
+  blas1_scale_operation(NumericT const * x, NumericT alpha, bool reciprocal_alpha, NumericT * y) : x_(x), alpha_(alpha), reciprocal_alpha_(reciprocal_alpha), y_(y) {}
+
+  template<typename KernelT>
+  void apply(vcl_size_t begin, vcl_size_t end) const
+  {
+    if (reciprocal_alpha_)
+      KernelT::template scale<true>(end - begin, x_ + begin, alpha_, y_ + begin);
+    else
+      KernelT::template scale<false>(end - begin, x_ + begin, alpha_, y_ + begin);
+  }
+
+  NumericT const * x_;
+  NumericT alpha_;
+  bool reciprocal_alpha_;
+  NumericT * y_;
+};
+
+/** @brief z = x * alpha + y * beta or z += x * alpha + y * beta, where alpha and beta may also be divisors */
+template<typename NumericT>
+struct blas1_axpby_operation
+{
+  blas1_axpby_operation(NumericT const * x, NumericT alpha, bool reciprocal_alpha,
+                        NumericT const * y, NumericT beta,  bool reciprocal_beta,
+                        NumericT * z, bool accumulate)
+    : x_(x), alpha_(alpha), reciprocal_alpha_(reciprocal_alpha), y_(y), beta_(beta), reciprocal_beta_(reciprocal_beta), z_(z), accumulate_(accumulate) {}
+
+  template<typename KernelT>
+  void apply(vcl_size_t begin, vcl_size_t end) const
+  {
+    if (accumulate_)
+      apply<KernelT, true>(begin, end);
+    else
+      apply<KernelT, false>(begin, end);
+  }
+
+  template<typename KernelT, bool AccumulateV>
+  void apply(vcl_size_t begin, vcl_size_t end) const
+  {
+    vcl_size_t n = end - begin;
+    if (reciprocal_alpha_)
+    {
+      if (reciprocal_beta_)
+        KernelT::template axpby<true, true, AccumulateV>(n, x_ + begin, alpha_, y_ + begin, beta_, z_ + begin);
+      else
+        KernelT::template axpby<true, false, AccumulateV>(n, x_ + begin, alpha_, y_ + begin, beta_, z_ + begin);
+    }
+    else
+    {
+      if (reciprocal_beta_)
+        KernelT::template axpby<false, true, AccumulateV>(n, x_ + begin, alpha_, y_ + begin, beta_, z_ + begin);
+      else
+        KernelT::template axpby<false, false, AccumulateV>(n, x_ + begin, alpha_, y_ + begin, beta_, z_ + begin);
+    }
+  }
+
+  NumericT const * x_;
+  NumericT alpha_;
+  bool reciprocal_alpha_;
+  NumericT const * y_;
+  NumericT beta_;
+  bool reciprocal_beta_;
+  NumericT * z_;
+  bool accumulate_;
+};
+
+/** @brief y += alpha * x */
+template<typename NumericT>
+struct blas1_axpy_operation
+{
+  blas1_axpy_operation(NumericT alpha, NumericT const * x, NumericT * y) : alpha_(alpha), x_(x), y_(y) {}
+
+  template<typename KernelT>
+  void apply(vcl_size_t begin, vcl_size_t end) const { KernelT::axpy(end - begin, alpha_, x_ + begin, y_ + begin); }
+
+  NumericT alpha_;
+  NumericT const * x_;
+  NumericT * y_;
+};
+
+/** @brief Inner product of x and y */
+template<typename NumericT>
+struct blas1_dot_operation
+{
+  typedef NumericT    value_type;
+  static const bool is_max = false;
+
+  blas1_dot_operation(NumericT const * x, NumericT const * y) : x_(x), y_(y) {}
+
+  template<typename KernelT>
+  NumericT apply(vcl_size_t begin, vcl_size_t end) const { return KernelT::dot(end - begin, x_ + begin, y_ + begin); }
+
+  NumericT const * x_;
+  NumericT const * y_;
+};
+
+/** @brief Sum of the absolute values of x */
+template<typename NumericT>
+struct blas1_asum_operation
+{
+  typedef NumericT    value_type;
+  static const bool is_max = false;
+
+  explicit blas1_asum_operation(NumericT const * x) : x_(x) {}
+
+  template<typename KernelT>
+  NumericT apply(vcl_size_t begin, vcl_size_t end) const { return KernelT::asum(end - begin, x_ + begin); }
+
+  NumericT const * x_;
+};
+
+/** @brief Sum of the squares of x / divisor */
+template<typename NumericT>
+struct blas1_sumsq_operation
+{
+  typedef NumericT    value_type;
+  static const bool is_max = false;
+
+  explicit blas1_sumsq_operation(NumericT const * x, NumericT divisor = NumericT(1)) : x_(x), divisor_(divisor) {}
+
+  template<typename KernelT>
+  NumericT apply(vcl_size_t begin, vcl_size_t end) const
+  {
+    if (divisor_ < NumericT(1) || divisor_ > NumericT(1))
+      return KernelT::template sumsq<true>(end - begin, x_ + begin, divisor_);
+    return KernelT::template sumsq<false>(end - begin, x_ + begin, divisor_);
+  }
+
+  NumericT const * x_;
+  NumericT divisor_;
+};
+
+/** @brief Largest absolute value of the entries of x */
+template<typename NumericT>
+struct blas1_amax_operation
+{
+  typedef NumericT    value_type;
+  static const bool is_max = true;
+
+  explicit blas1_amax_operation(NumericT const * x) : x_(x) {}
+
+  template<typename KernelT>
+  NumericT apply(vcl_size_t begin, vcl_size_t end) const { return KernelT::amax(end - begin, x_ + begin); }
+
+  NumericT const * x_;
+};
+
+
+//
+// Driver: Splits the vectors into contiguous chunks, one per thread.
+//
+
+/** @brief Computes the chunk [begin, end) of thread 'id' out of 'num_threads'. Chunk boundaries are multiples of 64 entries, hence no cache line is written by two threads. */
+inline void blas1_thread_range(vcl_size_t n, vcl_size_t id, vcl_size_t num_threads, vcl_size_t & begin, vcl_size_t & end)
+{
+  vcl_size_t num_chunks = (n + 63) / 64;
+  begin = std::min(n, 64 * ((num_chunks * id) / num_threads));
+  end   = std::min(n, 64 * ((num_chunks * (id + 1)) / num_threads));
+}
+
+template<typename KernelT, typename OperationT>
+void blas1_parallel_for(vcl_size_t n, OperationT const & op)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE && omp_get_max_threads() > 1)
+  {
+    #pragma omp parallel
+    {
+      vcl_size_t begin, end;
+      blas1_thread_range(n, static_cast<vcl_size_t>(omp_get_thread_num()), static_cast<vcl_size_t>(omp_get_num_threads()), begin, end);
+      op.template apply<KernelT>(begin, end);
+    }
+    return;
+  }
+#endif
+  op.template apply<KernelT>(0, n);
+}
+
+template<typename KernelT, typename OperationT>
+typename OperationT::value_type blas1_parallel_reduce(vcl_size_t n, OperationT const & op)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  typedef typename OperationT::value_type   value_type;
+
+  if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE && omp_get_max_threads() > 1)
+  {
+    std::vector<value_type> partial_results(static_cast<vcl_size_t>(omp_get_max_threads()));
+    vcl_size_t num_threads = 1;
+
+    #pragma omp parallel
+    {
+      vcl_size_t begin, end;
+      vcl_size_t id = static_cast<vcl_size_t>(omp_get_thread_num());
+      blas1_thread_range(n, id, static_cast<vcl_size_t>(omp_get_num_threads()), begin, end);
+      partial_results[id] = op.template apply<KernelT>(begin, end);
+      if (id == 0)
+        num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+    }
+
+    value_type result = partial_results[0];
+    for (vcl_size_t i = 1; i < num_threads; ++i)
+    {
+      if (OperationT::is_max)
+        result = (partial_results[i] > result) ? partial_results[i] : result;
+      else
+        result += partial_results[i];
+    }
+    return result;
+  }
+#endif
+  return op.template apply<KernelT>(0, n);
+}
+
+/** @brief Runs an elementwise operation with the best available kernel. Returns false if there is none. */
+template<typename NumericT, typename OperationT>
+bool blas1_for_each(vcl_size_t n, OperationT const & op)
+{
+  switch (active_simd_isa())
+  {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+  case SIMD_ISA_AVX512: blas1_parallel_for<blas1_kernel_avx512<NumericT> >(n, op); return true;
+  case SIMD_ISA_AVX2:   blas1_parallel_for<blas1_kernel_avx2<NumericT>   >(n, op); return true;
+  case SIMD_ISA_SSE2:   blas1_parallel_for<blas1_kernel_sse2<NumericT>   >(n, op); return true;
+#endif
+  default: (void)n; (void)op; return false;
+  }
+}
+
+/** @brief Runs a reduction with the best available kernel. Returns false if there is none. */
+template<typename NumericT, typename OperationT>
+bool blas1_reduce(vcl_size_t n, OperationT const & op, NumericT & result)
+{
+  switch (active_simd_isa())
+  {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+  case SIMD_ISA_AVX512: result = blas1_parallel_reduce<blas1_kernel_avx512<NumericT> >(n, op); return true;
+  case SIMD_ISA_AVX2:   result = blas1_parallel_reduce<blas1_kernel_avx2<NumericT>   >(n, op); return true;
+  case SIMD_ISA_SSE2:   result = blas1_parallel_reduce<blas1_kernel_sse2<NumericT>   >(n, op); return true;
+#endif
+  default: (void)n; (void)op; (void)result; return false;
+  }
+}
+
+
+/** @brief Entry points for the explicitly vectorized BLAS level 1 kernels. All vectors are unit-stride.
+*
+* The generic implementation provides no kernels, so each function returns false and the caller needs to fall back to a plain loop.
+*/
+template<typename NumericT>
+struct blas1_simd
+{
+  static bool scale(vcl_size_t, NumericT const *, NumericT, bool, NumericT *) { return false; }
+  static bool axpby(vcl_size_t, NumericT const *, NumericT, bool, NumericT const *, NumericT, bool, NumericT *, bool) { return false; }
+  static bool axpy(vcl_size_t, NumericT, NumericT const *, NumericT *) { return false; }
+  static bool dot(vcl_size_t, NumericT const *, NumericT const *, NumericT &) { return false; }
+  static bool asum(vcl_size_t, NumericT const *, NumericT &) { return false; }
+  static bool amax(vcl_size_t, NumericT const *, NumericT &) { return false; }
+  static bool nrm2(vcl_size_t, NumericT const *, NumericT &) { return false; }
+
+  template<typename OperationT>
+  static bool apply(vcl_size_t, vcl_size_t, OperationT const &) { return false; }
+};
+
+/** \cond */
+template<typename NumericT>
+struct blas1_floating_point_simd
+{
+  static bool scale(vcl_size_t n, NumericT const * x, NumericT alpha, bool reciprocal_alpha, NumericT * y)
+  {
+    return blas1_for_each<NumericT>(n, blas1_scale_operation<NumericT>(x, alpha, reciprocal_alpha, y));
+  }
+
+  static bool axpby(vcl_size_t n, NumericT const * x, NumericT alpha, bool reciprocal_alpha,
+                                  NumericT const * y, NumericT beta,  bool reciprocal_beta,
+                                  NumericT * z, bool accumulate)
+  {
+    return blas1_for_each<NumericT>(n, blas1_axpby_operation<NumericT>(x, alpha, reciprocal_alpha, y, beta, reciprocal_beta, z, accumulate));
+  }
+
+  /** @brief Applies an operation to the range [begin, end) with the best available kernel in the calling thread. Used by composite operations which run their own parallel loop. */
+  template<typename OperationT>
+  static bool apply(vcl_size_t begin, vcl_size_t end, OperationT const & op)
+  {
+    switch (active_simd_isa())
+    {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+    case SIMD_ISA_AVX512: op.template apply<blas1_kernel_avx512<NumericT> >(begin, end); return true;
+    case SIMD_ISA_AVX2:   op.template apply<blas1_kernel_avx2<NumericT>   >(begin, end); return true;
+    case SIMD_ISA_SSE2:   op.template apply<blas1_kernel_sse2<NumericT>   >(begin, end); return true;
+#endif
+    default: (void)begin; (void)end; (void)op; return false;
+    }
+  }
+
+  static bool axpy(vcl_size_t n, NumericT alpha, NumericT const * x, NumericT * y)
+  {
+    return blas1_for_each<NumericT>(n, blas1_axpy_operation<NumericT>(alpha, x, y));
+  }
+
+  static bool dot(vcl_size_t n, NumericT const * x, NumericT const * y, NumericT & result)
+  {
+    return blas1_reduce(n, blas1_dot_operation<NumericT>(x, y), result);
+  }
+
+  static bool asum(vcl_size_t n, NumericT const * x, NumericT & result)
+  {
+    return blas1_reduce(n, blas1_asum_operation<NumericT>(x), result);
+  }
+
+  static bool amax(vcl_size_t n, NumericT const * x, NumericT & result)
+  {
+    return blas1_reduce(n, blas1_amax_operation<NumericT>(x), result);
+  }
+
+  /** @brief Euclidean norm. The sum of squares is computed in a single pass. Only if it overflows or underflows, x is rescaled by its largest entry in modulus. */
+  static bool nrm2(vcl_size_t n, NumericT const * x, NumericT & result)
+  {
+    NumericT sum_of_squares = 0;
+    if (!blas1_reduce(n, blas1_sumsq_operation<NumericT>(x), sum_of_squares))
+      return false;
+
+    if (!blas1_norm_2_needs_rescaling(sum_of_squares))
+    {
+      result = std::sqrt(sum_of_squares);
+      return true;
+    }
+
+    NumericT max_entry = 0;
+    if (!blas1_reduce(n, blas1_amax_operation<NumericT>(x), max_entry))
+      return false;
+    if (max_entry <= 0 || max_entry > std::numeric_limits<NumericT>::max())  // zero vector or infinite entries
+    {
+      result = (sum_of_squares == sum_of_squares) ? max_entry : sum_of_squares;  // propagate NaN
+      return true;
+    }
+
+    if (!blas1_reduce(n, blas1_sumsq_operation<NumericT>(x, max_entry), sum_of_squares))
+      return false;
+    result = max_entry * std::sqrt(sum_of_squares);
+    return true;
+  }
+};
+
+template<>
+struct blas1_simd<float>  : public blas1_floating_point_simd<float> {};
+
+template<>
+struct blas1_simd<double> : public blas1_floating_point_simd<double> {};
+/** \endcond */
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -24,6 +24,10 @@
 
 #include "viennacl/traits/handle.hpp"
 
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
 namespace viennacl
 {
 namespace linalg
@@ -0,0 +1,109 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_CPU_FEATURES_HPP_
+#define VIENNACL_LINALG_HOST_BASED_CPU_FEATURES_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/cpu_features.hpp
+    @brief Runtime detection of SIMD instruction set extensions for the explicitly vectorized kernels of the host backend.
+
+    Kernels for a particular instruction set are compiled through function attributes, hence no special compiler flags are required.
+    The instruction set is then selected at runtime based on the capabilities of the executing CPU.
+    Define VIENNACL_NO_HOST_SIMD to disable all explicitly vectorized kernels.
+*/
+
+// Explicitly vectorized kernels require GCC-style function target attributes (GCC 4.9 or higher, Clang) on x86:
+#if !defined(VIENNACL_NO_HOST_SIMD) && !defined(__CUDACC__) && (defined(__x86_64__) || defined(__i386__))
+  #if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+    #define VIENNACL_WITH_HOST_SIMD_X86
+  #endif
+#endif
+
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+  #include <immintrin.h>
+  #define VIENNACL_HOST_TARGET_SSE2    __attribute__((target("sse2")))
+  #define VIENNACL_HOST_TARGET_AVX2    __attribute__((target("avx2,fma")))
+  #define VIENNACL_HOST_TARGET_AVX512  __attribute__((target("avx512f")))
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Instruction set extensions for which the host backend provides explicitly vectorized kernels. Ordered by capability. */
+enum simd_isa
+{
+  SIMD_ISA_SCALAR = 0,
+  SIMD_ISA_SSE2,
+  SIMD_ISA_AVX2,
+  SIMD_ISA_AVX512
+};
+
+namespace detail
+{
+  /** @brief Queries the best instruction set extension supported by the CPU (and the operating system). */
+  inline simd_isa detect_simd_isa()
+  {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return SIMD_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return SIMD_ISA_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+      return SIMD_ISA_SSE2;
+#endif
+    return SIMD_ISA_SCALAR;
+  }
+
+  inline simd_isa & simd_isa_limit()
+  {
+    static simd_isa limit = SIMD_ISA_AVX512;
+    return limit;
+  }
+}
+
+/** @brief Restricts the host kernels to the provided instruction set extension. Mostly useful for benchmarking and testing the fallback kernels. */
+inline void set_simd_isa_limit(simd_isa isa) { detail::simd_isa_limit() = isa; }
+
+/** @brief Returns the instruction set extension used by the host kernels: The best one supported by the CPU, capped by set_simd_isa_limit(). */
+inline simd_isa active_simd_isa()
+{
+  static const simd_isa detected = detail::detect_simd_isa();
+  return (detected < detail::simd_isa_limit()) ? detected : detail::simd_isa_limit();
+}
+
+/** @brief Returns the width of the SIMD registers used by the host kernels in bytes. Used for choosing block sizes of data structures in main memory. */
+inline unsigned int active_simd_register_bytes()
+{
+  switch (active_simd_isa())
+  {
+  case SIMD_ISA_AVX512: return 64;
+  case SIMD_ISA_AVX2:   return 32;
+  default:              return 16;
+  }
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
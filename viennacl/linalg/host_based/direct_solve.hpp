@@ -22,10 +22,18 @@
     @brief Implementations of dense direct triangular solvers are found here.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -36,34 +44,101 @@ namespace host_based
 
 namespace detail
 {
-  //
-  // Upper solve:
-  //
+  /** @brief Number of columns of the right hand side processed per thread in the triangular solvers. Chosen such that the packed block remains in cache, and such that all threads receive work. */
+  template<typename NumericT>
+  vcl_size_t trsm_chunk_size(vcl_size_t A_size, vcl_size_t B_size)
+  {
+    vcl_size_t chunk_size = (64 * 1024) / (sizeof(NumericT) * std::max<vcl_size_t>(A_size, 1));
+    chunk_size = std::max<vcl_size_t>(16, std::min<vcl_size_t>(chunk_size, 256));
+
+#ifdef VIENNACL_WITH_OPENMP
+    vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+    if (num_threads > 1)
+      chunk_size = std::min(chunk_size, std::max<vcl_size_t>(8, (B_size - 1) / num_threads + 1));
+#endif
+
+    return std::min(chunk_size, std::max<vcl_size_t>(B_size, 1));
+  }
+
+  /** @brief Blocked triangular solver for multiple right hand sides.
+  *
+  * The columns of B are split into chunks, which are processed in parallel. Each chunk is packed into a contiguous row-major buffer,
+  * so that the updates of the solution run over unit-stride rows (and are thus vectorized) irrespective of the memory layout of A and B.
+  */
   template<typename MatrixT1, typename MatrixT2>
-  void upper_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  void triangular_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool lower, bool unit_diagonal)
   {
     typedef typename MatrixT2::value_type   value_type;
 
+    if (A_size == 0 || B_size == 0)
+      return;
+
+    // dense row-major copy of the referenced triangle of A in the workspace of the calling thread, shared by all threads:
+    value_type * A_packed = workspace_buffer<value_type>(WORKSPACE_SOLVE_MATRIX, A_size * A_size);
     for (vcl_size_t i = 0; i < A_size; ++i)
     {
-      vcl_size_t current_row = A_size - i - 1;
+      vcl_size_t j_start = lower ? 0 : i;
+      vcl_size_t j_stop  = lower ? i + 1 : A_size;
+      for (vcl_size_t j = j_start; j < j_stop; ++j)
+        A_packed[i * A_size + j] = A(i, j);
+    }
 
-      for (vcl_size_t j = current_row + 1; j < A_size; ++j)
-      {
-        value_type A_element = A(current_row, j);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(current_row, k) -= A_element * B(j, k);
-      }
+    vcl_size_t chunk_size = trsm_chunk_size<value_type>(A_size, B_size);
+    long num_chunks = static_cast<long>((B_size - 1) / chunk_size + 1);
 
-      if (!unit_diagonal)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_chunks > 1 && A_size * A_size * B_size > 100000)
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      vcl_size_t col_start = static_cast<vcl_size_t>(chunk) * chunk_size;
+      vcl_size_t width     = std::min(chunk_size, B_size - col_start);
+
+      value_type * X = workspace_buffer<value_type>(WORKSPACE_SOLVE, A_size * width);
+
+      for (vcl_size_t i = 0; i < A_size; ++i)
+        for (vcl_size_t k = 0; k < width; ++k)
+          X[i * width + k] = B(i, col_start + k);
+
+      for (vcl_size_t l = 0; l < A_size; ++l)
       {
-        value_type A_diag = A(current_row, current_row);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(current_row, k) /= A_diag;
+        vcl_size_t i = lower ? l : A_size - l - 1;
+        value_type * x_i = X + i * width;
+        value_type const * A_row = A_packed + i * A_size;
+
+        vcl_size_t j_start = lower ? 0 : i + 1;
+        vcl_size_t j_stop  = lower ? i : A_size;
+        for (vcl_size_t j = j_start; j < j_stop; ++j)
+        {
+          value_type A_element = A_row[j];
+          value_type const * x_j = X + j * width;
+          for (vcl_size_t k = 0; k < width; ++k)
+            x_i[k] -= A_element * x_j[k];
+        }
+
+        if (!unit_diagonal)
+        {
+          value_type A_diag = A_row[i];
+          for (vcl_size_t k = 0; k < width; ++k)
+            x_i[k] /= A_diag;
+        }
       }
+
+      for (vcl_size_t i = 0; i < A_size; ++i)
+        for (vcl_size_t k = 0; k < width; ++k)
+          B(i, col_start + k) = X[i * width + k];
     }
   }
 
+  //
+  // Upper solve:
+  //
+  template<typename MatrixT1, typename MatrixT2>
+  void upper_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
+  {
+    triangular_inplace_solve_matrix(A, B, A_size, B_size, false, unit_diagonal);
+  }
+
   template<typename MatrixT1, typename MatrixT2>
   void inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, viennacl::linalg::unit_upper_tag)
   {
@@ -82,24 +157,7 @@ namespace detail
   template<typename MatrixT1, typename MatrixT2>
   void lower_inplace_solve_matrix(MatrixT1 & A, MatrixT2 & B, vcl_size_t A_size, vcl_size_t B_size, bool unit_diagonal)
   {
-    typedef typename MatrixT2::value_type   value_type;
-
-    for (vcl_size_t i = 0; i < A_size; ++i)
-    {
-      for (vcl_size_t j = 0; j < i; ++j)
-      {
-        value_type A_element = A(i, j);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(i, k) -= A_element * B(j, k);
-      }
-
-      if (!unit_diagonal)
-      {
-        value_type A_diag = A(i, i);
-        for (vcl_size_t k=0; k < B_size; ++k)
-          B(i, k) /= A_diag;
-      }
-    }
+    triangular_inplace_solve_matrix(A, B, A_size, B_size, true, unit_diagonal);
   }
 
   template<typename MatrixT1, typename MatrixT2>
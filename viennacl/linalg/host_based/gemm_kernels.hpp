@@ -0,0 +1,514 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_GEMM_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_GEMM_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/gemm_kernels.hpp
+    @brief Cache-blocked matrix-matrix multiplication with register-blocked micro-kernels for the host backend.
+
+    The blocking follows the scheme of GotoBLAS/BLIS: A kc x nc block of B is packed such that it stays in the L3 cache,
+    an mc x kc block of A is packed such that it stays in the L2 cache, and a kc x nr micro-panel of B is streamed from the L1 cache by the micro-kernel,
+    which keeps an mr x nr block of C in registers.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+#include "viennacl/linalg/host_based/simd_ops.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+//
+// Micro-kernels: Compute AB = A * B, where A is an mr x k micro-panel stored column by column, and B is a k x nr micro-panel stored row by row.
+//                The result AB is an mr x nr block stored in row-major order.
+//
+
+/** @brief Portable micro-kernel used for all non-floating point types and if no SIMD instruction set extension is available. */
+template<typename NumericT>
+struct gemm_kernel_scalar
+{
+  static const vcl_size_t mr = 4;
+  static const vcl_size_t nr = 4;
+  static const vcl_size_t kc = 256;
+  static const vcl_size_t mc = 128;
+  static const vcl_size_t nc = 4096;
+
+  static void apply(vcl_size_t k_size, NumericT const * A, NumericT const * B, NumericT * AB)
+  {
+    NumericT acc[mr * nr];
+    for (vcl_size_t i = 0; i < mr * nr; ++i)
+      acc[i] = NumericT(0);
+
+    for (vcl_size_t k = 0; k < k_size; ++k, A += mr, B += nr)
+      for (vcl_size_t i = 0; i < mr; ++i)
+        for (vcl_size_t j = 0; j < nr; ++j)
+          acc[i * nr + j] += A[i] * B[j];
+
+    for (vcl_size_t i = 0; i < mr * nr; ++i)
+      AB[i] = acc[i];
+  }
+};
+
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+
+/** @brief AVX2/FMA micro-kernel: 6 x (2*width) block of C in 12 registers. */
+template<typename NumericT>
+struct gemm_kernel_avx2
+{
+  typedef avx2_ops<NumericT>              ops;
+  typedef typename ops::vector_type       vector_type;
+
+  static const vcl_size_t mr = 6;
+  static const vcl_size_t nr = 2 * ops::width;
+  static const vcl_size_t kc = 256;
+  static const vcl_size_t mc = 96;
+  static const vcl_size_t nc = 4096;
+
+  VIENNACL_HOST_TARGET_AVX2 static void apply(vcl_size_t k_size, NumericT const * A, NumericT const * B, NumericT * AB)
+  {
+    vector_type c00 = ops::zero(), c01 = ops::zero();
+    vector_type c10 = ops::zero(), c11 = ops::zero();
+    vector_type c20 = ops::zero(), c21 = ops::zero();
+    vector_type c30 = ops::zero(), c31 = ops::zero();
+    vector_type c40 = ops::zero(), c41 = ops::zero();
+    vector_type c50 = ops::zero(), c51 = ops::zero();
+
+    for (vcl_size_t k = 0; k < k_size; ++k, A += mr, B += nr)
+    {
+      vector_type b0 = ops::load(B);
+      vector_type b1 = ops::load(B + ops::width);
+      vector_type a;
+
+      a = ops::broadcast(A    ); c00 = ops::fmadd(a, b0, c00); c01 = ops::fmadd(a, b1, c01);
+      a = ops::broadcast(A + 1); c10 = ops::fmadd(a, b0, c10); c11 = ops::fmadd(a, b1, c11);
+      a = ops::broadcast(A + 2); c20 = ops::fmadd(a, b0, c20); c21 = ops::fmadd(a, b1, c21);
+      a = ops::broadcast(A + 3); c30 = ops::fmadd(a, b0, c30); c31 = ops::fmadd(a, b1, c31);
+      a = ops::broadcast(A + 4); c40 = ops::fmadd(a, b0, c40); c41 = ops::fmadd(a, b1, c41);
+      a = ops::broadcast(A + 5); c50 = ops::fmadd(a, b0, c50); c51 = ops::fmadd(a, b1, c51);
+    }
+
+    ops::store(AB            , c00); ops::store(AB +          ops::width, c01);
+    ops::store(AB +     nr   , c10); ops::store(AB +     nr + ops::width, c11);
+    ops::store(AB + 2 * nr   , c20); ops::store(AB + 2 * nr + ops::width, c21);
+    ops::store(AB + 3 * nr   , c30); ops::store(AB + 3 * nr + ops::width, c31);
+    ops::store(AB + 4 * nr   , c40); ops::store(AB + 4 * nr + ops::width, c41);
+    ops::store(AB + 5 * nr   , c50); ops::store(AB + 5 * nr + ops::width, c51);
+  }
+};
+
+/** @brief AVX-512 micro-kernel: 12 x (2*width) block of C in 24 registers. */
+template<typename NumericT>
+struct gemm_kernel_avx512
+{
+  typedef avx512_ops<NumericT>            ops;
+  typedef typename ops::vector_type       vector_type;
+
+  static const vcl_size_t mr = 12;
+  static const vcl_size_t nr = 2 * ops::width;
+  static const vcl_size_t kc = 256;
+  static const vcl_size_t mc = 96;
+  static const vcl_size_t nc = 4096;
+
+  VIENNACL_HOST_TARGET_AVX512 static void apply(vcl_size_t k_size, NumericT const * A, NumericT const * B, NumericT * AB)
+  {
+    vector_type c00 = ops::zero(), c01 = ops::zero();
+    vector_type c10 = ops::zero(), c11 = ops::zero();
+    vector_type c20 = ops::zero(), c21 = ops::zero();
+    vector_type c30 = ops::zero(), c31 = ops::zero();
+    vector_type c40 = ops::zero(), c41 = ops::zero();
+    vector_type c50 = ops::zero(), c51 = ops::zero();
+    vector_type c60 = ops::zero(), c61 = ops::zero();
+    vector_type c70 = ops::zero(), c71 = ops::zero();
+    vector_type c80 = ops::zero(), c81 = ops::zero();
+    vector_type c90 = ops::zero(), c91 = ops::zero();
+    vector_type cA0 = ops::zero(), cA1 = ops::zero();
+    vector_type cB0 = ops::zero(), cB1 = ops::zero();
+
+    for (vcl_size_t k = 0; k < k_size; ++k, A += mr, B += nr)
+    {
+      vector_type b0 = ops::load(B);
+      vector_type b1 = ops::load(B + ops::width);
+      vector_type a;
+
+      a = ops::broadcast(A     ); c00 = ops::fmadd(a, b0, c00); c01 = ops::fmadd(a, b1, c01);
+      a = ops::broadcast(A +  1); c10 = ops::fmadd(a, b0, c10); c11 = ops::fmadd(a, b1, c11);
+      a = ops::broadcast(A +  2); c20 = ops::fmadd(a, b0, c20); c21 = ops::fmadd(a, b1, c21);
+      a = ops::broadcast(A +  3); c30 = ops::fmadd(a, b0, c30); c31 = ops::fmadd(a, b1, c31);
+      a = ops::broadcast(A +  4); c40 = ops::fmadd(a, b0, c40); c41 = ops::fmadd(a, b1, c41);
+      a = ops::broadcast(A +  5); c50 = ops::fmadd(a, b0, c50); c51 = ops::fmadd(a, b1, c51);
+      a = ops::broadcast(A +  6); c60 = ops::fmadd(a, b0, c60); c61 = ops::fmadd(a, b1, c61);
+      a = ops::broadcast(A +  7); c70 = ops::fmadd(a, b0, c70); c71 = ops::fmadd(a, b1, c71);
+      a = ops::broadcast(A +  8); c80 = ops::fmadd(a, b0, c80); c81 = ops::fmadd(a, b1, c81);
+      a = ops::broadcast(A +  9); c90 = ops::fmadd(a, b0, c90); c91 = ops::fmadd(a, b1, c91);
+      a = ops::broadcast(A + 10); cA0 = ops::fmadd(a, b0, cA0); cA1 = ops::fmadd(a, b1, cA1);
+      a = ops::broadcast(A + 11); cB0 = ops::fmadd(a, b0, cB0); cB1 = ops::fmadd(a, b1, cB1);
+    }
+
+    ops::store(AB             , c00); ops::store(AB +           ops::width, c01);
+    ops::store(AB +       nr  , c10); ops::store(AB +       nr + ops::width, c11);
+    ops::store(AB +  2 *  nr  , c20); ops::store(AB +  2 *  nr + ops::width, c21);
+    ops::store(AB +  3 *  nr  , c30); ops::store(AB +  3 *  nr + ops::width, c31);
+    ops::store(AB +  4 *  nr  , c40); ops::store(AB +  4 *  nr + ops::width, c41);
+    ops::store(AB +  5 *  nr  , c50); ops::store(AB +  5 *  nr + ops::width, c51);
+    ops::store(AB +  6 *  nr  , c60); ops::store(AB +  6 *  nr + ops::width, c61);
+    ops::store(AB +  7 *  nr  , c70); ops::store(AB +  7 *  nr + ops::width, c71);
+    ops::store(AB +  8 *  nr  , c80); ops::store(AB +  8 *  nr + ops::width, c81);
+    ops::store(AB +  9 *  nr  , c90); ops::store(AB +  9 *  nr + ops::width, c91);
+    ops::store(AB + 10 *  nr  , cA0); ops::store(AB + 10 *  nr + ops::width, cA1);
+    ops::store(AB + 11 *  nr  , cB0); ops::store(AB + 11 *  nr + ops::width, cB1);
+  }
+};
+
+#endif
+
+
+//
+// Packing routines
+//
+
+/** @brief Packs the block A(offset_i:offset_i+m_size, offset_k:offset_k+k_size) into micro-panels of MR rows. Rows beyond m_size are padded with zeros. */
+template<vcl_size_t MR, typename MatrixAccT, typename NumericT>
+void gemm_pack_A(MatrixAccT & A, vcl_size_t offset_i, vcl_size_t offset_k, vcl_size_t m_size, vcl_size_t k_size, NumericT * buffer)
+{
+  for (vcl_size_t panel_start = 0; panel_start < m_size; panel_start += MR)
+  {
+    vcl_size_t panel_rows = std::min(MR, m_size - panel_start);
+    for (vcl_size_t k = 0; k < k_size; ++k)
+    {
+      for (vcl_size_t i = 0; i < panel_rows; ++i)
+        buffer[i] = A(offset_i + panel_start + i, offset_k + k);
+      for (vcl_size_t i = panel_rows; i < MR; ++i)
+        buffer[i] = NumericT(0);
+      buffer += MR;
+    }
+  }
+}
+
+/** @brief Packs the block B(offset_k:offset_k+k_size, offset_j:offset_j+n_size) into micro-panels of NR columns. Columns beyond n_size are padded with zeros. */
+template<vcl_size_t NR, typename MatrixAccT, typename NumericT>
+void gemm_pack_B(MatrixAccT & B, vcl_size_t offset_k, vcl_size_t offset_j, vcl_size_t k_size, vcl_size_t n_size, NumericT * buffer)
+{
+  for (vcl_size_t k = 0; k < k_size; ++k)
+  {
+    for (vcl_size_t j = 0; j < n_size; ++j)
+      buffer[j] = B(offset_k + k, offset_j + j);
+    for (vcl_size_t j = n_size; j < NR; ++j)
+      buffer[j] = NumericT(0);
+    buffer += NR;
+  }
+}
+
+
+/** @brief Writes C(offset_i:offset_i+m_size, offset_j:offset_j+n_size) = alpha * AB + beta * C(...) for a micro-block AB computed by a micro-kernel. */
+template<vcl_size_t NR, typename MatrixAccT, typename NumericT>
+void gemm_update_C(MatrixAccT & C, vcl_size_t offset_i, vcl_size_t offset_j, vcl_size_t m_size, vcl_size_t n_size,
+                   NumericT const * AB, NumericT alpha, NumericT beta)
+{
+  if (beta > 0 || beta < 0)
+  {
+    for (vcl_size_t i = 0; i < m_size; ++i)
+      for (vcl_size_t j = 0; j < n_size; ++j)
+        C(offset_i + i, offset_j + j) = beta * C(offset_i + i, offset_j + j) + alpha * AB[i * NR + j];
+  }
+  else
+  {
+    for (vcl_size_t i = 0; i < m_size; ++i)
+      for (vcl_size_t j = 0; j < n_size; ++j)
+        C(offset_i + i, offset_j + j) =                                         alpha * AB[i * NR + j];
+  }
+}
+
+
+/** @brief Accessor to the submatrix of another accessor starting at (offset1, offset2). */
+template<typename MatrixAccT>
+class gemm_submatrix_accessor
+{
+public:
+  typedef typename MatrixAccT::value_type   value_type;
+
+  gemm_submatrix_accessor(MatrixAccT & A, vcl_size_t offset1, vcl_size_t offset2) : A_(A), offset1_(offset1), offset2_(offset2) {}
+
+  value_type & operator()(vcl_size_t i, vcl_size_t j) { return A_(i + offset1_, j + offset2_); }
+
+private:
+  MatrixAccT & A_;
+  vcl_size_t offset1_;
+  vcl_size_t offset2_;
+};
+
+
+/** @brief Computes C = alpha * A * B + beta * C using the micro-kernel KernelT.
+*
+* For each kc x nc block of B, the result C is split into two-dimensional tiles: blocks of mc rows times chunks of columns.
+* The tiles are distributed dynamically over the threads, hence also short-wide or tall-skinny products keep all threads busy.
+*
+* @param A        Accessor to the (possibly transposed) C_size1 x A_size2 matrix A
+* @param B        Accessor to the (possibly transposed) A_size2 x C_size2 matrix B
+* @param C        Accessor to the result matrix C
+*/
+template<typename KernelT, typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
+void gemm_tiled(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+                NumericT alpha, NumericT beta)
+{
+  const vcl_size_t MR = KernelT::mr;
+  const vcl_size_t NR = KernelT::nr;
+  const vcl_size_t KC = KernelT::kc;
+  const vcl_size_t MC = KernelT::mc;
+  const vcl_size_t NC = KernelT::nc;
+
+#ifdef VIENNACL_WITH_OPENMP
+  vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+  vcl_size_t num_threads = 1;
+#endif
+
+  // packed block of B, shared by all threads. Size is rounded up to full micro-panels:
+  vcl_size_t nc_max = std::min(NC, C_size2);
+  NumericT * buffer_B = workspace_buffer<NumericT>(WORKSPACE_GEMM_B, KC * ((nc_max - 1) / NR + 1) * NR);
+
+  vcl_size_t num_blocks_i = (C_size1 - 1) / MC + 1;
+
+  for (vcl_size_t offset_j = 0; offset_j < C_size2; offset_j += NC)
+  {
+    vcl_size_t nc_size = std::min(NC, C_size2 - offset_j);
+    vcl_size_t num_panels_B = (nc_size - 1) / NR + 1;
+
+    // Split the columns into chunks such that there are about four tiles per thread.
+    // Each tile repacks its block of A, so chunks are kept at least 8 micro-panels wide unless the block of B is narrower:
+    vcl_size_t num_chunks_j = std::max<vcl_size_t>(1, (4 * num_threads - 1) / num_blocks_i + 1);
+    vcl_size_t panels_per_chunk = std::max<vcl_size_t>(std::min<vcl_size_t>(8, num_panels_B), (num_panels_B - 1) / num_chunks_j + 1);
+    num_chunks_j = (num_panels_B - 1) / panels_per_chunk + 1;
+
+    vcl_size_t num_tiles = num_blocks_i * num_chunks_j;
+
+    for (vcl_size_t offset_k = 0; offset_k < A_size2; offset_k += KC)
+    {
+      vcl_size_t kc_size = std::min(KC, A_size2 - offset_k);
+      NumericT beta_block = (offset_k == 0) ? beta : NumericT(1); // accumulate into C for all but the first block of A_size2
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (num_tiles > 1)
+#endif
+      {
+        //
+        // Pack kc x nc block of B into micro-panels of NR columns:
+        //
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long panel_idx2 = 0; panel_idx2 < static_cast<long>(num_panels_B); ++panel_idx2)
+        {
+          vcl_size_t panel_idx = static_cast<vcl_size_t>(panel_idx2);
+          gemm_pack_B<NR>(B, offset_k, offset_j + panel_idx * NR, kc_size, std::min(NR, nc_size - panel_idx * NR), buffer_B + panel_idx * NR * kc_size);
+        }
+
+        //
+        // Run over all tiles of C. Each thread packs the mc x kc block of A of the tile, then multiplies with the micro-panels of B in the tile:
+        //
+        NumericT * buffer_A = workspace_buffer<NumericT>(WORKSPACE_GEMM_A, MC * KC);
+        NumericT buffer_AB[KernelT::mr * KernelT::nr];
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (long tile_idx2 = 0; tile_idx2 < static_cast<long>(num_tiles); ++tile_idx2)
+        {
+          vcl_size_t tile_idx = static_cast<vcl_size_t>(tile_idx2);
+          vcl_size_t offset_i = (tile_idx / num_chunks_j) * MC;
+          vcl_size_t mc_size  = std::min(MC, C_size1 - offset_i);
+          vcl_size_t jr_start = (tile_idx % num_chunks_j) * panels_per_chunk * NR;
+          vcl_size_t jr_stop  = std::min(nc_size, jr_start + panels_per_chunk * NR);
+
+          gemm_pack_A<MR>(A, offset_i, offset_k, mc_size, kc_size, buffer_A);
+
+          // macro-kernel: loop over micro-panels of B and A
+          for (vcl_size_t jr = jr_start; jr < jr_stop; jr += NR)
+          {
+            NumericT const * panel_B = buffer_B + (jr / NR) * NR * kc_size;
+            vcl_size_t nr_size = std::min(NR, nc_size - jr);
+
+            for (vcl_size_t ir = 0; ir < mc_size; ir += MR)
+            {
+              KernelT::apply(kc_size, buffer_A + (ir / MR) * MR * kc_size, panel_B, buffer_AB);
+              gemm_update_C<NR>(C, offset_i + ir, offset_j + jr, std::min(MR, mc_size - ir), nr_size, buffer_AB, alpha, beta_block);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+
+/** @brief Computes C = alpha * A * B + beta * C by splitting the inner dimension over the threads.
+*
+* Used if C is too small to provide enough tiles for all threads while the inner dimension is large.
+* Each thread computes the product for its range of the inner dimension into a private buffer, the buffers are then summed up.
+*/
+template<typename KernelT, typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
+void gemm_split_k(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                  vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+                  NumericT alpha, NumericT beta)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  const vcl_size_t KC = KernelT::kc;
+
+  // upper bound for the team size. The runtime may provide fewer threads (thread limit, dynamic adjustment), so the chunks are determined within the parallel region:
+  vcl_size_t max_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+  std::vector<NumericT *> partial_results(max_threads, NULL);
+
+  #pragma omp parallel num_threads(static_cast<int>(max_threads))
+  {
+    vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+    vcl_size_t thread_id   = static_cast<vcl_size_t>(omp_get_thread_num());
+    vcl_size_t k_chunk     = ((A_size2 - 1) / num_threads / KC + 1) * KC; // multiple of KC to avoid partial blocks
+    vcl_size_t k_start   = std::min(A_size2, thread_id * k_chunk);
+    vcl_size_t k_size    = std::min(A_size2, k_start + k_chunk) - k_start;
+
+    NumericT * partial = workspace_buffer<NumericT>(WORKSPACE_GEMM_C, C_size1 * C_size2);
+    partial_results[thread_id] = (k_size > 0) ? partial : NULL;
+
+    if (k_size > 0)
+    {
+      gemm_submatrix_accessor<MatrixAccT1> sub_A(A, 0, k_start);
+      gemm_submatrix_accessor<MatrixAccT2> sub_B(B, k_start, 0);
+      matrix_array_wrapper<NumericT, viennacl::row_major, false> wrapper_partial(partial, 0, 0, 1, 1, C_size1, C_size2);
+
+      gemm_tiled<KernelT>(sub_A, sub_B, wrapper_partial, C_size1, C_size2, k_size, NumericT(1), NumericT(0));
+    }
+
+    #pragma omp barrier
+
+    // reduction of the partial results:
+    #pragma omp for
+    for (long row2 = 0; row2 < static_cast<long>(C_size1); ++row2)
+    {
+      vcl_size_t row = static_cast<vcl_size_t>(row2);
+      for (vcl_size_t col = 0; col < C_size2; ++col)
+      {
+        NumericT sum = 0;
+        for (vcl_size_t t = 0; t < num_threads; ++t)
+          if (partial_results[t])
+            sum += partial_results[t][row * C_size2 + col];
+
+        if (beta > 0 || beta < 0)
+          C(row, col) = beta * C(row, col) + alpha * sum;
+        else
+          C(row, col) = alpha * sum;
+      }
+    }
+  }
+#else
+  gemm_tiled<KernelT>(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+#endif
+}
+
+
+/** @brief Computes C = alpha * A * B + beta * C using the micro-kernel KernelT. Chooses between tiling the result and splitting the inner dimension. */
+template<typename KernelT, typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
+void gemm_blocked(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                  vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+                  NumericT alpha, NumericT beta)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+  vcl_size_t num_tiles   = ((C_size1 - 1) / KernelT::mc + 1) * ((C_size2 - 1) / (8 * KernelT::nr) + 1);
+
+  // Too few tiles in C, but a long inner dimension: Split the inner dimension
+  if (num_threads > 1 && !omp_in_parallel()
+      && num_tiles < num_threads
+      && A_size2 >= num_threads * KernelT::kc
+      && A_size2 >= 4 * std::max(C_size1, C_size2))
+  {
+    gemm_split_k<KernelT>(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+    return;
+  }
+#endif
+
+  gemm_tiled<KernelT>(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+}
+
+
+/** @brief Selects the micro-kernel for C = alpha * A * B + beta * C. Non-floating point types always use the portable micro-kernel. */
+template<typename NumericT>
+struct gemm_dispatcher
+{
+  template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3>
+  static void apply(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                    vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+                    NumericT alpha, NumericT beta)
+  {
+    gemm_blocked<gemm_kernel_scalar<NumericT> >(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+  }
+};
+
+/** \cond */
+template<typename NumericT>
+struct gemm_floating_point_dispatcher
+{
+  template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3>
+  static void apply(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+                    vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+                    NumericT alpha, NumericT beta)
+  {
+    switch (active_simd_isa())
+    {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+    case SIMD_ISA_AVX512:
+      gemm_blocked<gemm_kernel_avx512<NumericT> >(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+      break;
+    case SIMD_ISA_AVX2:
+      gemm_blocked<gemm_kernel_avx2<NumericT> >(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+      break;
+#endif
+    default:
+      gemm_blocked<gemm_kernel_scalar<NumericT> >(A, B, C, C_size1, C_size2, A_size2, alpha, beta);
+    }
+  }
+};
+
+template<>
+struct gemm_dispatcher<float>  : public gemm_floating_point_dispatcher<float> {};
+
+template<>
+struct gemm_dispatcher<double> : public gemm_floating_point_dispatcher<double> {};
+/** \endcond */
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <cmath>
 #include <algorithm>  //for std::max and std::min
+#include <vector>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -33,15 +34,12 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
 
 // Minimum vector size for using OpenMP on vector operations:
-#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
-  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
 namespace linalg
@@ -75,23 +73,84 @@ namespace detail
     unsigned int const *  col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
     value_type         * data_buffer = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
+    vcl_size_t rows = A.size1();
+
+    // Same nonzero-balanced partition as for prod_impl(). Rows split across parts are completed after the parallel loop,
+    // hence their contributions to the inner products are only accumulated there.
+    vcl_size_t num_parts = (rows > 0) ? detail::csr_num_parts(rows, row_buffer[rows]) : 0;
+    std::vector<unsigned int> partition_temp;
+    unsigned int const * partition = (rows > 0) ? detail::csr_nonzero_partition(A, num_parts, partition_temp) : NULL;
+    std::vector<vcl_size_t> carry_row(num_parts);
+    std::vector<value_type> carry_value(num_parts);
+    std::vector<value_type> partial_inner_prods(3 * num_parts);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_parts > 1)
+#endif
+    for (long part2 = 0; part2 < static_cast<long>(num_parts); ++part2)
+    {
+      vcl_size_t part         = static_cast<vcl_size_t>(part2);
+      vcl_size_t row_start    = partition[2*part + 2];
+      vcl_size_t nonzero      = partition[2*part + 3];
+      vcl_size_t row_stop     = partition[2*part + 4];
+      vcl_size_t nonzero_stop = partition[2*part + 5];
+
+      value_type inner_prod_ApAp = 0;
+      value_type inner_prod_pAp = 0;
+      value_type inner_prod_Ap_r0star = 0;
+      for (vcl_size_t row = row_start; row < row_stop; ++row)
+      {
+        value_type dot_prod = 0;
+        vcl_size_t row_end = row_buffer[row+1];
+        for (; nonzero < row_end; ++nonzero)
+          dot_prod += elements[nonzero] * p_buf[col_buffer[nonzero]];
+
+        Ap_buf[row] = dot_prod;
+
+        // update contributions for the inner products (Ap, Ap) and (p, Ap), unless the row may receive a carry from the previous part:
+        if (part > 0 && row == row_start)
+          continue;
+        inner_prod_ApAp += dot_prod * dot_prod;
+        inner_prod_pAp  += p_buf[row] * dot_prod;
+        inner_prod_Ap_r0star += r0star ? dot_prod * r0star[row] : value_type(0);
+      }
+
+      value_type dot_prod = 0;
+      for (; nonzero < nonzero_stop; ++nonzero)
+        dot_prod += elements[nonzero] * p_buf[col_buffer[nonzero]];
+      carry_row[part]   = row_stop;
+      carry_value[part] = dot_prod;
+
+      partial_inner_prods[3*part]     = inner_prod_ApAp;
+      partial_inner_prods[3*part + 1] = inner_prod_pAp;
+      partial_inner_prods[3*part + 2] = inner_prod_Ap_r0star;
+    }
+
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
-    for (long row = 0; row < static_cast<long>(A.size1()); ++row)
+    for (vcl_size_t part = 0; part < num_parts; ++part)
     {
-      value_type dot_prod = 0;
-      value_type val_p_diag = p_buf[static_cast<vcl_size_t>(row)]; //likely to be loaded from cache if required again in this row
+      inner_prod_ApAp      += partial_inner_prods[3*part];
+      inner_prod_pAp       += partial_inner_prods[3*part + 1];
+      inner_prod_Ap_r0star += partial_inner_prods[3*part + 2];
+    }
 
-      vcl_size_t row_end = row_buffer[row+1];
-      for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
-        dot_prod += elements[i] * p_buf[col_buffer[i]];
+    // add carries and the inner product contributions of the rows at the boundaries of the parts:
+    for (vcl_size_t part = 0; part + 1 < num_parts; ++part)
+    {
+      vcl_size_t row = carry_row[part];
+      if (row >= rows)
+        break;
+
+      Ap_buf[row] += carry_value[part];
+      if (part + 2 < num_parts && carry_row[part + 1] == row) // row continues in the next part
+        continue;
 
-      // update contributions for the inner products (Ap, Ap) and (p, Ap)
-      Ap_buf[static_cast<vcl_size_t>(row)] = dot_prod;
+      value_type dot_prod = Ap_buf[row];
       inner_prod_ApAp += dot_prod * dot_prod;
-      inner_prod_pAp  += val_p_diag * dot_prod;
-      inner_prod_Ap_r0star += r0star ? dot_prod * r0star[static_cast<vcl_size_t>(row)] : value_type(0);
+      inner_prod_pAp  += p_buf[row] * dot_prod;
+      inner_prod_Ap_r0star += r0star ? dot_prod * r0star[row] : value_type(0);
     }
 
     data_buffer[    buffer_chunk_size] = inner_prod_ApAp;
@@ -231,43 +290,30 @@ namespace detail
     IndexT     const * columns_per_block = detail::extract_raw_pointer<IndexT>(A.handle1());
     IndexT     const * column_indices    = detail::extract_raw_pointer<IndexT>(A.handle2());
     IndexT     const * block_start       = detail::extract_raw_pointer<IndexT>(A.handle3());
+    IndexT     const * row_indices       = (A.sigma() > 1) ? detail::extract_raw_pointer<IndexT>(A.handle4()) : NULL;
     value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
-    vcl_size_t num_blocks = A.size1() / A.rows_per_block() + 1;
-    std::vector<value_type> result_values(A.rows_per_block());
+    vcl_size_t C          = A.rows_per_block();
+    vcl_size_t num_blocks = A.size1() / C + 1;
+    bool       use_simd   = detail::sliced_ell_use_simd(A, 1);
+    std::vector<value_type> result_values(C);
 
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
     for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
     {
-      vcl_size_t current_columns_per_block = columns_per_block[block_idx];
-
-      for (vcl_size_t i=0; i<result_values.size(); ++i)
-        result_values[i] = 0;
+      vcl_size_t num_columns = columns_per_block[block_idx];
+      vcl_size_t offset      = (num_columns > 0) ? block_start[block_idx] : 0;
 
-      for (IndexT column_entry_index = 0;
-                  column_entry_index < current_columns_per_block;
-                ++column_entry_index)
-      {
-        vcl_size_t stride_start = block_start[block_idx] + column_entry_index * A.rows_per_block();
-        // Note: This for-loop may be unrolled by hand for exploiting vectorization
-        //       Careful benchmarking recommended first, memory channels may be saturated already!
-        for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
-        {
-          value_type val = elements[stride_start + row_in_block];
-
-          result_values[row_in_block] += val ? p_buf[column_indices[stride_start + row_in_block]] * val : 0;
-        }
-      }
+      detail::sliced_ell_block_prod(C, num_columns, elements + offset, column_indices + offset, p_buf, 1, use_simd, &(result_values[0]));
 
-      vcl_size_t first_row_in_matrix = block_idx * A.rows_per_block();
-      for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
+      for (vcl_size_t i = 0; i < C; ++i)
       {
-        vcl_size_t row = first_row_in_matrix + row_in_block;
+        vcl_size_t row = row_indices ? row_indices[block_idx * C + i] : block_idx * C + i;
         if (row < Ap.size())
         {
-          value_type row_result = result_values[row_in_block];
+          value_type row_result = result_values[i];
 
           Ap_buf[row] = row_result;
           inner_prod_ApAp += row_result * row_result;
@@ -23,12 +23,15 @@
 */
 
 #include <list>
+#include <vector>
+#include <algorithm>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
 
 namespace viennacl
 {
@@ -70,6 +73,93 @@ namespace detail
     }
 
   }
+
+  /** @brief Returns the sparse dot product of the two rows [begin1, end1) and [begin2, end2) with sorted column indices, restricted to column indices smaller than 'bound'. */
+  template<typename NumericT>
+  NumericT ilu_sparse_row_dot(unsigned int const * col_buffer1, NumericT const * elements1, unsigned int begin1, unsigned int end1,
+                              unsigned int const * col_buffer2, NumericT const * elements2, unsigned int begin2, unsigned int end2,
+                              unsigned int bound)
+  {
+    NumericT sum = 0;
+    while (begin1 < end1 && begin2 < end2)
+    {
+      unsigned int col1 = col_buffer1[begin1];
+      unsigned int col2 = col_buffer2[begin2];
+      if (col1 >= bound || col2 >= bound)
+        break;
+
+      if (col1 < col2)
+        ++begin1;
+      else if (col2 < col1)
+        ++begin2;
+      else
+        sum += elements1[begin1++] * elements2[begin2++];
+    }
+    return sum;
+  }
+}
+
+/** @brief Carries out one fixed-point sweep of the iterative incomplete LU factorization by Chow and Patel. Multithreaded!
+*
+* All entries are updated from the previous iterate, so the result does not depend on the number of threads.
+*
+* @param L            Strict lower triangular factor (unit diagonal not stored) with sorted column indices
+* @param aij_L        The entries of the system matrix on the pattern of L
+* @param U_trans      Transpose of the upper triangular factor with sorted column indices. The diagonal entry is the last entry of each row.
+* @param aij_U_trans  The entries of the transposed system matrix on the pattern of U_trans
+*/
+template<typename NumericT>
+void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
+                          vector<NumericT>            const & aij_L,
+                          compressed_matrix<NumericT>       & U_trans,
+                          vector<NumericT>            const & aij_U_trans)
+{
+  unsigned int const * L_row_buffer = detail::extract_raw_pointer<unsigned int>(L.handle1());
+  unsigned int const * L_col_buffer = detail::extract_raw_pointer<unsigned int>(L.handle2());
+  NumericT           * L_elements   = detail::extract_raw_pointer<NumericT>(L.handle());
+  NumericT     const * L_aij        = detail::extract_raw_pointer<NumericT>(aij_L.handle());
+
+  unsigned int const * U_row_buffer = detail::extract_raw_pointer<unsigned int>(U_trans.handle1());
+  unsigned int const * U_col_buffer = detail::extract_raw_pointer<unsigned int>(U_trans.handle2());
+  NumericT           * U_elements   = detail::extract_raw_pointer<NumericT>(U_trans.handle());
+  NumericT     const * U_aij        = detail::extract_raw_pointer<NumericT>(aij_U_trans.handle());
+
+  // previous iterate, kept in the workspace so that repeated sweeps do not allocate:
+  NumericT * backup = detail::workspace_buffer<NumericT>(WORKSPACE_FACTORIZATION, L.nnz() + U_trans.nnz());
+  std::copy(L_elements, L_elements + L.nnz(), backup);
+  std::copy(U_elements, U_elements + U_trans.nnz(), backup + L.nnz());
+  NumericT const * L_old = backup;
+  NumericT const * U_old = backup + L.nnz();
+
+  long rows = static_cast<long>(L.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (L.nnz() + U_trans.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    unsigned int i = static_cast<unsigned int>(row);
+
+    // l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj
+    for (unsigned int nnz_index = L_row_buffer[i]; nnz_index < L_row_buffer[i+1]; ++nnz_index)
+    {
+      unsigned int j = L_col_buffer[nnz_index];
+      NumericT sum = detail::ilu_sparse_row_dot(L_col_buffer, L_old, L_row_buffer[i], L_row_buffer[i+1],
+                                                U_col_buffer, U_old, U_row_buffer[j], U_row_buffer[j+1],
+                                                j);
+      L_elements[nnz_index] = (L_aij[nnz_index] - sum) / U_old[U_row_buffer[j+1] - 1];
+    }
+
+    // u_ji = a_ji - sum_{k<j} l_jk u_ki  (row i of U_trans holds column i of U)
+    for (unsigned int nnz_index = U_row_buffer[i]; nnz_index < U_row_buffer[i+1]; ++nnz_index)
+    {
+      unsigned int j = U_col_buffer[nnz_index];
+      NumericT sum = detail::ilu_sparse_row_dot(L_col_buffer, L_old, L_row_buffer[j], L_row_buffer[j+1],
+                                                U_col_buffer, U_old, U_row_buffer[i], U_row_buffer[i+1],
+                                                j);
+      U_elements[nnz_index] = U_aij[nnz_index] - sum;
+    }
+  }
 }
 
 } // namespace host_based
@@ -0,0 +1,179 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SIMD_OPS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SIMD_OPS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/simd_ops.hpp
+    @brief Thin wrappers around SSE2, AVX2 and AVX-512 intrinsics such that the same explicitly vectorized kernel can be written for float and double.
+
+    All functions carry the target attribute of their instruction set, so they can be inlined into kernels compiled for the same instruction set only.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+
+/** @brief Thin wrappers around SSE2 intrinsics. SSE2 has no fused multiply-add, so fmadd() is a separate multiplication and addition. */
+template<typename NumericT>
+struct sse2_ops;
+
+template<>
+struct sse2_ops<float>
+{
+  typedef __m128 vector_type;
+  static const vcl_size_t width = 4;
+
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type zero()                                        { return _mm_setzero_ps(); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type load(float const * p)                         { return _mm_loadu_ps(p); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type broadcast(float const * p)                    { return _mm_set1_ps(*p); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type set1(float value)                             { return _mm_set1_ps(value); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type add(vector_type a, vector_type b)             { return _mm_add_ps(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type mul(vector_type a, vector_type b)             { return _mm_mul_ps(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type div(vector_type a, vector_type b)             { return _mm_div_ps(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type max(vector_type a, vector_type b)             { return _mm_max_ps(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type abs(vector_type a)                            { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  VIENNACL_HOST_TARGET_SSE2 static inline void        store(float * p, vector_type v)               { _mm_storeu_ps(p, v); }
+};
+
+template<>
+struct sse2_ops<double>
+{
+  typedef __m128d vector_type;
+  static const vcl_size_t width = 2;
+
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type zero()                                        { return _mm_setzero_pd(); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type load(double const * p)                        { return _mm_loadu_pd(p); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type broadcast(double const * p)                   { return _mm_set1_pd(*p); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type set1(double value)                            { return _mm_set1_pd(value); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type add(vector_type a, vector_type b)             { return _mm_add_pd(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type mul(vector_type a, vector_type b)             { return _mm_mul_pd(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type div(vector_type a, vector_type b)             { return _mm_div_pd(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type max(vector_type a, vector_type b)             { return _mm_max_pd(a, b); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type abs(vector_type a)                            { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  VIENNACL_HOST_TARGET_SSE2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  VIENNACL_HOST_TARGET_SSE2 static inline void        store(double * p, vector_type v)              { _mm_storeu_pd(p, v); }
+};
+
+/** @brief Thin wrappers around AVX2 intrinsics. gather() loads the entries at the provided indices, which need to be smaller than 2^31. The masked variants avoid uninitialized source registers. */
+template<typename NumericT>
+struct avx2_ops;
+
+template<>
+struct avx2_ops<float>
+{
+  typedef __m256 vector_type;
+  static const vcl_size_t width = 8;
+
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type zero()                                        { return _mm256_setzero_ps(); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type load(float const * p)                         { return _mm256_loadu_ps(p); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type broadcast(float const * p)                    { return _mm256_broadcast_ss(p); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type set1(float value)                             { return _mm256_set1_ps(value); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type add(vector_type a, vector_type b)             { return _mm256_add_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type mul(vector_type a, vector_type b)             { return _mm256_mul_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type div(vector_type a, vector_type b)             { return _mm256_div_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type max(vector_type a, vector_type b)             { return _mm256_max_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type abs(vector_type a)                            { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm256_fmadd_ps(a, b, c); }
+  VIENNACL_HOST_TARGET_AVX2 static inline void        store(float * p, vector_type v)               { _mm256_storeu_ps(p, v); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type gather(float const * base, unsigned int const * indices)  { return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(indices)), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4); }
+};
+
+template<>
+struct avx2_ops<double>
+{
+  typedef __m256d vector_type;
+  static const vcl_size_t width = 4;
+
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type zero()                                        { return _mm256_setzero_pd(); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type load(double const * p)                        { return _mm256_loadu_pd(p); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type broadcast(double const * p)                   { return _mm256_broadcast_sd(p); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type set1(double value)                            { return _mm256_set1_pd(value); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type add(vector_type a, vector_type b)             { return _mm256_add_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type mul(vector_type a, vector_type b)             { return _mm256_mul_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type div(vector_type a, vector_type b)             { return _mm256_div_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type max(vector_type a, vector_type b)             { return _mm256_max_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type abs(vector_type a)                            { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm256_fmadd_pd(a, b, c); }
+  VIENNACL_HOST_TARGET_AVX2 static inline void        store(double * p, vector_type v)              { _mm256_storeu_pd(p, v); }
+  VIENNACL_HOST_TARGET_AVX2 static inline vector_type gather(double const * base, unsigned int const * indices) { return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm_loadu_si128(reinterpret_cast<__m128i const *>(indices)), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+};
+
+/** @brief Thin wrappers around AVX-512 intrinsics. gather() loads the entries at the provided indices, which need to be smaller than 2^31. The masked variants avoid uninitialized source registers. */
+template<typename NumericT>
+struct avx512_ops;
+
+template<>
+struct avx512_ops<float>
+{
+  typedef __m512 vector_type;
+  static const vcl_size_t width = 16;
+
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type zero()                                        { return _mm512_setzero_ps(); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type load(float const * p)                         { return _mm512_loadu_ps(p); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type broadcast(float const * p)                    { return _mm512_set1_ps(*p); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type set1(float value)                             { return _mm512_set1_ps(value); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type add(vector_type a, vector_type b)             { return _mm512_add_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type mul(vector_type a, vector_type b)             { return _mm512_mul_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type div(vector_type a, vector_type b)             { return _mm512_div_ps(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type max(vector_type a, vector_type b)             { return _mm512_mask_max_ps(_mm512_setzero_ps(), 0xFFFF, a, b); }  // the unmasked intrinsic passes an undefined source operand
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type abs(vector_type a)                            { return _mm512_abs_ps(a); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm512_fmadd_ps(a, b, c); }
+  VIENNACL_HOST_TARGET_AVX512 static inline void        store(float * p, vector_type v)               { _mm512_storeu_ps(p, v); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type gather(float const * base, unsigned int const * indices)  { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, _mm512_loadu_si512(indices), base, 4); }
+};
+
+template<>
+struct avx512_ops<double>
+{
+  typedef __m512d vector_type;
+  static const vcl_size_t width = 8;
+
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type zero()                                        { return _mm512_setzero_pd(); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type load(double const * p)                        { return _mm512_loadu_pd(p); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type broadcast(double const * p)                   { return _mm512_set1_pd(*p); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type set1(double value)                            { return _mm512_set1_pd(value); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type add(vector_type a, vector_type b)             { return _mm512_add_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type mul(vector_type a, vector_type b)             { return _mm512_mul_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type div(vector_type a, vector_type b)             { return _mm512_div_pd(a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type max(vector_type a, vector_type b)             { return _mm512_mask_max_pd(_mm512_setzero_pd(), 0xFF, a, b); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type abs(vector_type a)                            { return _mm512_abs_pd(a); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm512_fmadd_pd(a, b, c); }
+  VIENNACL_HOST_TARGET_AVX512 static inline void        store(double * p, vector_type v)              { _mm512_storeu_pd(p, v); }
+  VIENNACL_HOST_TARGET_AVX512 static inline vector_type gather(double const * base, unsigned int const * indices) { return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(indices)), base, 8); }
+};
+
+#endif
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
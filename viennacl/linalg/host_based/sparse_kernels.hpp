@@ -0,0 +1,147 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SPARSE_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SPARSE_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/sparse_kernels.hpp
+    @brief Explicitly vectorized kernels for sparse matrix-vector products in main memory.
+
+    Kernels are provided for AVX2 and AVX-512, which offer gather instructions for loading the entries of the vector, and are selected at runtime via active_simd_isa().
+    The entry points return false if no kernel is available for the numeric type, the index type, or the CPU, in which case the caller falls back to its plain loops.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+#include "viennacl/linalg/host_based/simd_ops.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+
+//
+// Kernels for one slice of a matrix in the SELL-C-sigma format: Entry j of row i of the slice is located at elements[j * C + i], where C denotes the number of rows in the slice.
+//
+
+#define VIENNACL_HOST_SELL_KERNEL(KERNEL_NAME, TARGET_ATTRIBUTE, OPS_NAME) \
+template<typename NumericT> \
+struct KERNEL_NAME \
+{ \
+  typedef OPS_NAME<NumericT>              ops; \
+  typedef typename ops::vector_type       vector_type; \
+  static const vcl_size_t w = ops::width; \
+\
+  /* result[i] = sum_j elements[j * C + i] * x[column_indices[j * C + i]] for i < C. C is a multiple of the SIMD width. */ \
+  /* Two vectors of rows are processed at once in order to have two independent chains of fused multiply-adds. */ \
+  TARGET_ATTRIBUTE static void slice(vcl_size_t C, vcl_size_t num_columns, \
+                                     NumericT const * elements, unsigned int const * column_indices, \
+                                     NumericT const * x, NumericT * result) \
+  { \
+    vcl_size_t i = 0; \
+    for (; i + 2 * w <= C; i += 2 * w) \
+    { \
+      vector_type s0 = ops::zero(), s1 = ops::zero(); \
+      for (vcl_size_t j = 0; j < num_columns; ++j) \
+      { \
+        vcl_size_t offset = j * C + i; \
+        s0 = ops::fmadd(ops::load(elements + offset),     ops::gather(x, column_indices + offset),     s0); \
+        s1 = ops::fmadd(ops::load(elements + offset + w), ops::gather(x, column_indices + offset + w), s1); \
+      } \
+      ops::store(result + i,     s0); \
+      ops::store(result + i + w, s1); \
+    } \
+    for (; i < C; i += w) \
+    { \
+      vector_type s0 = ops::zero(); \
+      for (vcl_size_t j = 0; j < num_columns; ++j) \
+        s0 = ops::fmadd(ops::load(elements + j * C + i), ops::gather(x, column_indices + j * C + i), s0); \
+      ops::store(result + i, s0); \
+    } \
+  } \
+};
+
+VIENNACL_HOST_SELL_KERNEL(sell_kernel_avx2,   VIENNACL_HOST_TARGET_AVX2,   avx2_ops)
+VIENNACL_HOST_SELL_KERNEL(sell_kernel_avx512, VIENNACL_HOST_TARGET_AVX512, avx512_ops)
+
+#undef VIENNACL_HOST_SELL_KERNEL
+
+#endif
+
+
+/** @brief Entry points for the explicitly vectorized kernels for the SELL-C-sigma format.
+*
+* The generic implementation provides no kernels, so each function returns false and the caller needs to fall back to a plain loop.
+*/
+template<typename NumericT, typename IndexT>
+struct sell_simd
+{
+  static bool available(vcl_size_t) { return false; }
+  static bool slice(vcl_size_t, vcl_size_t, NumericT const *, IndexT const *, NumericT const *, NumericT *) { return false; }
+};
+
+/** \cond */
+template<typename NumericT>
+struct sell_floating_point_simd
+{
+  /** @brief Returns true if a kernel is available for slices with C rows on the executing CPU. */
+  static bool available(vcl_size_t C)
+  {
+    switch (active_simd_isa())
+    {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+    case SIMD_ISA_AVX512: return C % sell_kernel_avx512<NumericT>::w == 0;
+    case SIMD_ISA_AVX2:   return C % sell_kernel_avx2<NumericT>::w == 0;
+#endif
+    default: (void)C; return false;
+    }
+  }
+
+  /** @brief Computes the products of the C rows of a slice with the unit-stride vector x. All column indices need to be smaller than 2^31. */
+  static bool slice(vcl_size_t C, vcl_size_t num_columns, NumericT const * elements, unsigned int const * column_indices, NumericT const * x, NumericT * result)
+  {
+    switch (active_simd_isa())
+    {
+#ifdef VIENNACL_WITH_HOST_SIMD_X86
+    case SIMD_ISA_AVX512: sell_kernel_avx512<NumericT>::slice(C, num_columns, elements, column_indices, x, result); return true;
+    case SIMD_ISA_AVX2:   sell_kernel_avx2<NumericT>::slice(C, num_columns, elements, column_indices, x, result);   return true;
+#endif
+    default: (void)C; (void)num_columns; (void)elements; (void)column_indices; (void)x; (void)result; return false;
+    }
+  }
+};
+
+template<>
+struct sell_simd<float, unsigned int>  : public sell_floating_point_simd<float> {};
+
+template<>
+struct sell_simd<double, unsigned int> : public sell_floating_point_simd<double> {};
+/** \endcond */
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -23,6 +23,10 @@
 */
 
 #include <list>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -30,6 +34,12 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/sparse_kernels.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -90,6 +100,90 @@ namespace detail
       result_buf[row] = value;
     }
   }
+
+  /** @brief Returns the number of parts for a nonzero-balanced product with a compressed_matrix: One per thread, unless the matrix is too small for multithreading to pay off. */
+  inline vcl_size_t csr_num_parts(vcl_size_t rows, vcl_size_t nnz)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (rows + nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      return static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+    (void)rows; (void)nnz;
+#endif
+    return 1;
+  }
+
+  /** @brief Finds the point where a diagonal of the merge grid crosses the merge path of the row end offsets with the nonzero indices of a CSR matrix.
+  *
+  * On return, all rows before 'row' and all nonzeros before 'nonzero' are located before the diagonal, where row + nonzero == diagonal.
+  */
+  inline void csr_merge_path_search(unsigned int const * row_buffer, vcl_size_t rows, vcl_size_t nnz, vcl_size_t diagonal,
+                                    vcl_size_t & row, vcl_size_t & nonzero)
+  {
+    vcl_size_t row_min = (diagonal > nnz) ? diagonal - nnz : 0;
+    vcl_size_t row_max = std::min(diagonal, rows);
+
+    while (row_min < row_max)
+    {
+      vcl_size_t pivot = (row_min + row_max) / 2;
+      if (row_buffer[pivot + 1] <= diagonal - pivot - 1)
+        row_min = pivot + 1;
+      else
+        row_max = pivot;
+    }
+
+    row     = row_min;
+    nonzero = diagonal - row_min;
+  }
+
+  /** @brief Computes the nonzero-balanced partition of a CSR matrix into 'num_parts' parts.
+  *
+  * The list of row end offsets is merged with the list of nonzero indices (merge path) and split into parts of equal length.
+  * Thus, each part obtains about the same number of rows plus nonzeros, irrespective of how the nonzeros are distributed over the rows.
+  * Rows may be split across parts, so their partial results need to be carried over to the part completing the row.
+  *
+  * Entries 0 and 1 hold the number of rows and nonzeros the partition was computed for.
+  * Entries 2*i+2 and 2*i+3 hold the first row and the first nonzero of the i-th part, where i = 0, ..., num_parts (the last pair marks the end of the matrix).
+  *
+  * @param partition   Array of 2 * num_parts + 4 entries
+  */
+  inline void csr_compute_partition(unsigned int const * row_buffer, vcl_size_t rows, vcl_size_t num_parts, unsigned int * partition)
+  {
+    vcl_size_t nnz = row_buffer[rows];
+    partition[0] = static_cast<unsigned int>(rows);
+    partition[1] = static_cast<unsigned int>(nnz);
+    for (vcl_size_t i = 0; i <= num_parts; ++i)
+    {
+      vcl_size_t row, nonzero;
+      csr_merge_path_search(row_buffer, rows, nnz, (i * (rows + nnz)) / num_parts, row, nonzero);
+      partition[2*i + 2] = static_cast<unsigned int>(row);
+      partition[2*i + 3] = static_cast<unsigned int>(nonzero);
+    }
+  }
+
+  /** @brief Returns the nonzero-balanced partition of a compressed_matrix in main memory into 'num_parts' parts, see csr_compute_partition().
+  *
+  * The partition set up by the matrix together with its row array is used if it has the requested number of parts.
+  * Otherwise, the partition is computed into 'temp', so the matrix is never written to and concurrent products with the same matrix are safe.
+  */
+  template<typename NumericT, unsigned int AlignmentV>
+  unsigned int const * csr_nonzero_partition(compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t num_parts, std::vector<unsigned int> & temp)
+  {
+    unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+    vcl_size_t rows = A.size1();
+    vcl_size_t nnz  = row_buffer[rows];
+
+    if (A.host_partition_num() == num_parts)
+    {
+      unsigned int const * partition = detail::extract_raw_pointer<unsigned int>(A.host_partition_handle());
+      if (partition[0] == rows && partition[1] == nnz) // guards against changes to the row array bypassing compressed_matrix::set()
+        return partition;
+    }
+
+    temp.resize(2 * num_parts + 4);
+    csr_compute_partition(row_buffer, rows, num_parts, &(temp[0]));
+    return &(temp[0]);
+  }
 }
 
 
@@ -106,115 +200,349 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
                const viennacl::vector_base<NumericT> & vec,
                      viennacl::vector_base<NumericT> & result)
 {
+  if (mat.size1() == 0)
+    return;
+
   NumericT           * result_buf = detail::extract_raw_pointer<NumericT>(result.handle());
   NumericT     const * vec_buf    = detail::extract_raw_pointer<NumericT>(vec.handle());
   NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
+  vcl_size_t vec_start    = vec.start();
+  vcl_size_t vec_inc      = vec.stride();
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+
+  // Each part processes the same number of rows plus nonzeros. The partial result of a row split across parts is carried out and added afterwards.
+  vcl_size_t num_parts = detail::csr_num_parts(mat.size1(), row_buffer[mat.size1()]);
+  std::vector<unsigned int> partition_temp;
+  unsigned int const * partition = detail::csr_nonzero_partition(mat, num_parts, partition_temp);
+  std::vector<vcl_size_t> carry_row(num_parts);
+  std::vector<NumericT>   carry_value(num_parts);
+
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for if (num_parts > 1)
 #endif
-  for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
+  for (long part2 = 0; part2 < static_cast<long>(num_parts); ++part2)
   {
+    vcl_size_t part         = static_cast<vcl_size_t>(part2);
+    vcl_size_t row          = partition[2*part + 2];
+    vcl_size_t nonzero      = partition[2*part + 3];
+    vcl_size_t row_stop     = partition[2*part + 4];
+    vcl_size_t nonzero_stop = partition[2*part + 5];
+
+    for (; row < row_stop; ++row)
+    {
+      NumericT dot_prod = 0;
+      vcl_size_t row_end = row_buffer[row+1];
+      for (; nonzero < row_end; ++nonzero)
+        dot_prod += elements[nonzero] * vec_buf[col_buffer[nonzero] * vec_inc + vec_start];
+      result_buf[row * result_inc + result_start] = dot_prod;
+    }
+
+    // leading nonzeros of a row completed by one of the subsequent parts:
     NumericT dot_prod = 0;
-    vcl_size_t row_end = row_buffer[row+1];
-    for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
-      dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
-    result_buf[static_cast<vcl_size_t>(row) * result.stride() + result.start()] = dot_prod;
+    for (; nonzero < nonzero_stop; ++nonzero)
+      dot_prod += elements[nonzero] * vec_buf[col_buffer[nonzero] * vec_inc + vec_start];
+    carry_row[part]   = row_stop;
+    carry_value[part] = dot_prod;
   }
 
+  for (vcl_size_t part = 0; part + 1 < num_parts; ++part)
+    if (carry_row[part] < mat.size1())
+      result_buf[carry_row[part] * result_inc + result_start] += carry_value[part];
 }
 
-/** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
+namespace detail
+{
+  /** @brief Computes result = trans(A) * x for a CSR matrix A, or result = (A + trans(A) - diag(A)) * x if A holds the upper triangle of a symmetric matrix (SymmetricV = true), in a single pass over A.
+  *
+  * The products with trans(A) scatter into the result. Each part of the rows accumulates into a private buffer, and the buffers are summed up afterwards, so no write conflicts arise.
+  * The buffer of a part only covers the range of result entries touched by its rows, i.e. from its smallest to its largest column index (or row index for the upper triangle).
+  * The buffers are kept in the host workspace of the calling thread.
+  */
+  template<bool SymmetricV, typename NumericT>
+  void csr_scatter_prod(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t rows,
+                        NumericT const * x,      vcl_size_t x_start,      vcl_size_t x_inc,
+                        NumericT       * result, vcl_size_t result_start, vcl_size_t result_inc, vcl_size_t result_size)
+  {
+    vcl_size_t nnz = row_buffer[rows];
+    vcl_size_t num_parts = csr_num_parts(rows, nnz);
+
+    // parts of consecutive rows with about the same number of rows plus nonzeros:
+    std::vector<vcl_size_t> part_rows(num_parts + 1);
+    for (vcl_size_t i = 0; i <= num_parts; ++i)
+    {
+      vcl_size_t nonzero;
+      csr_merge_path_search(row_buffer, rows, nnz, (i * (rows + nnz)) / num_parts, part_rows[i], nonzero);
+    }
+
+    // range [part_begin, part_end) of result entries touched by each part:
+    std::vector<vcl_size_t> part_begin(num_parts, 0);
+    std::vector<vcl_size_t> part_end(num_parts, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_parts > 1)
+#endif
+    for (long part2 = 0; part2 < static_cast<long>(num_parts); ++part2)
+    {
+      vcl_size_t part = static_cast<vcl_size_t>(part2);
+      vcl_size_t col_min = result_size;
+      vcl_size_t col_max = 0;
+      for (vcl_size_t row = part_rows[part]; row < part_rows[part + 1]; ++row)
+      {
+        if (SymmetricV && row_buffer[row] < row_buffer[row + 1])
+        {
+          col_min = std::min(col_min, row);
+          col_max = std::max(col_max, row + 1);
+        }
+        for (vcl_size_t k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+        {
+          col_min = std::min<vcl_size_t>(col_min, col_buffer[k]);
+          col_max = std::max<vcl_size_t>(col_max, col_buffer[k] + 1);
+        }
+      }
+      part_begin[part] = std::min(col_min, col_max);
+      part_end[part]   = col_max;
+    }
+
+    std::vector<vcl_size_t> buffer_offsets(num_parts + 1, 0);
+    for (vcl_size_t part = 0; part < num_parts; ++part)
+      buffer_offsets[part + 1] = buffer_offsets[part] + (part_end[part] - part_begin[part]);
+
+    NumericT * buffers = workspace_buffer<NumericT>(WORKSPACE_SPARSE_PRODUCT, buffer_offsets[num_parts]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_parts > 1)
+#endif
+    for (long part2 = 0; part2 < static_cast<long>(num_parts); ++part2)
+    {
+      vcl_size_t part   = static_cast<vcl_size_t>(part2);
+      vcl_size_t offset = part_begin[part];
+      NumericT * buffer = buffers + buffer_offsets[part];
+      std::fill(buffer, buffers + buffer_offsets[part + 1], NumericT(0));
+
+      for (vcl_size_t row = part_rows[part]; row < part_rows[part + 1]; ++row)
+      {
+        NumericT x_row = x[row * x_inc + x_start];
+        NumericT dot_prod = 0;
+        for (vcl_size_t k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+        {
+          vcl_size_t col = col_buffer[k];
+          buffer[col - offset] += elements[k] * x_row;
+          if (SymmetricV && col != row)
+            dot_prod += elements[k] * x[col * x_inc + x_start];
+        }
+        if (SymmetricV && row_buffer[row] < row_buffer[row + 1])
+          buffer[row - offset] += dot_prod;
+      }
+    }
+
+    // sum up the buffers. Each chunk of the result adds the overlapping parts of all buffers:
+    vcl_size_t chunk_size = (result_size - 1) / num_parts + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_parts > 1)
+#endif
+    for (long chunk2 = 0; chunk2 < static_cast<long>(num_parts); ++chunk2)
+    {
+      vcl_size_t chunk_begin = std::min(result_size, static_cast<vcl_size_t>(chunk2) * chunk_size);
+      vcl_size_t chunk_end   = std::min(result_size, chunk_begin + chunk_size);
+
+      for (vcl_size_t i = chunk_begin; i < chunk_end; ++i)
+        result[i * result_inc + result_start] = 0;
+
+      for (vcl_size_t part = 0; part < num_parts; ++part)
+      {
+        NumericT const * buffer = buffers + buffer_offsets[part];
+        vcl_size_t offset = part_begin[part];
+        vcl_size_t i_end  = std::min(chunk_end, part_end[part]);
+        for (vcl_size_t i = std::max(chunk_begin, offset); i < i_end; ++i)
+          result[i * result_inc + result_start] += buffer[i - offset];
+      }
+    }
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a transposed compressed_matrix
 *
-* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+* Implementation of the convenience expression result = prod(trans(mat), vec);
+* The rows of the matrix are processed in parallel, each thread accumulating into a private buffer.
 *
-* @param sp_mat     The sparse matrix
-* @param d_mat      The dense matrix
-* @param result     The result matrix
+* @param mat    The transposed matrix
+* @param vec    The vector
+* @param result The result vector
 */
 template<typename NumericT, unsigned int AlignmentV>
-void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
-               const viennacl::matrix_base<NumericT> & d_mat,
-                     viennacl::matrix_base<NumericT> & result) {
-
-  NumericT     const * sp_mat_elements   = detail::extract_raw_pointer<NumericT>(sp_mat.handle());
-  unsigned int const * sp_mat_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
-  unsigned int const * sp_mat_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+void prod_impl(const viennacl::matrix_expression< const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                                  const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                                  viennacl::op_trans> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  viennacl::compressed_matrix<NumericT, AlignmentV> const & A = mat.lhs();
 
-  NumericT const * d_mat_data  = detail::extract_raw_pointer<NumericT>(d_mat);
-  NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+  if (A.size1() == 0)
+  {
+    result.clear();
+    return;
+  }
 
-  vcl_size_t d_mat_start1 = viennacl::traits::start1(d_mat);
-  vcl_size_t d_mat_start2 = viennacl::traits::start2(d_mat);
-  vcl_size_t d_mat_inc1   = viennacl::traits::stride1(d_mat);
-  vcl_size_t d_mat_inc2   = viennacl::traits::stride2(d_mat);
-  vcl_size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat);
-  vcl_size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat);
+  detail::csr_scatter_prod<false>(detail::extract_raw_pointer<unsigned int>(A.handle1()),
+                                  detail::extract_raw_pointer<unsigned int>(A.handle2()),
+                                  detail::extract_raw_pointer<NumericT>(A.handle()),
+                                  A.size1(),
+                                  detail::extract_raw_pointer<NumericT>(vec.handle()),    vec.start(),    vec.stride(),
+                                  detail::extract_raw_pointer<NumericT>(result.handle()), result.start(), result.stride(), result.size());
+}
 
-  vcl_size_t result_start1 = viennacl::traits::start1(result);
-  vcl_size_t result_start2 = viennacl::traits::start2(result);
-  vcl_size_t result_inc1   = viennacl::traits::stride1(result);
-  vcl_size_t result_inc2   = viennacl::traits::stride2(result);
-  vcl_size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-  vcl_size_t result_internal_size2  = viennacl::traits::internal_size2(result);
+namespace detail
+{
+  /** @brief Returns the offset of the first entry as well as the distances of consecutive rows and columns of a dense matrix in its buffer. Row and column distances are swapped for the transposed matrix. */
+  template<typename NumericT>
+  void dense_matrix_layout(matrix_base<NumericT> const & A, bool transposed,
+                           vcl_size_t & offset, vcl_size_t & row_inc, vcl_size_t & col_inc)
+  {
+    if (A.row_major())
+    {
+      offset  = viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+      row_inc = viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+      col_inc = viennacl::traits::stride2(A);
+    }
+    else
+    {
+      offset  = viennacl::traits::start1(A) + viennacl::traits::start2(A) * viennacl::traits::internal_size1(A);
+      row_inc = viennacl::traits::stride1(A);
+      col_inc = viennacl::traits::stride2(A) * viennacl::traits::internal_size1(A);
+    }
 
-  detail::matrix_array_wrapper<NumericT const, row_major, false>
-      d_mat_wrapper_row(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-  detail::matrix_array_wrapper<NumericT const, column_major, false>
-      d_mat_wrapper_col(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
+    if (transposed)
+      std::swap(row_inc, col_inc);
+  }
 
-  detail::matrix_array_wrapper<NumericT, row_major, false>
-      result_wrapper_row(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-  detail::matrix_array_wrapper<NumericT, column_major, false>
-      result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
+  /** @brief Computes WidthV consecutive columns of one row of the product of a CSR matrix with a dense matrix B.
+  *
+  * Each nonzero of the row is loaded once, while the WidthV partial sums are kept in registers.
+  * The loop over the columns has a compile-time trip count, so it is fully unrolled and vectorized if the columns of B are contiguous.
+  */
+  template<unsigned int WidthV, typename NumericT>
+  void csr_dense_prod_tile(NumericT const * elements, unsigned int const * col_buffer, vcl_size_t row_start, vcl_size_t row_end,
+                           NumericT const * B, vcl_size_t B_row_inc, vcl_size_t B_col_inc,
+                           NumericT       * C, vcl_size_t C_col_inc)
+  {
+    NumericT sums[WidthV];
+    for (vcl_size_t j = 0; j < WidthV; ++j)
+      sums[j] = 0;
 
-  if ( d_mat.row_major() ) {
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
-      vcl_size_t row_start = sp_mat_row_buffer[row];
-      vcl_size_t row_end = sp_mat_row_buffer[row+1];
-      for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-        NumericT temp = 0;
-        for (vcl_size_t k = row_start; k < row_end; ++k) {
-          temp += sp_mat_elements[k] * d_mat_wrapper_row(static_cast<vcl_size_t>(sp_mat_col_buffer[k]), col);
-        }
-        if (result.row_major())
-          result_wrapper_row(row, col) = temp;
-        else
-          result_wrapper_col(row, col) = temp;
+    if (B_col_inc == 1)
+    {
+      for (vcl_size_t k = row_start; k < row_end; ++k)
+      {
+        NumericT val = elements[k];
+        NumericT const * B_row = B + col_buffer[k] * B_row_inc;
+        for (vcl_size_t j = 0; j < WidthV; ++j)
+          sums[j] += val * B_row[j];
       }
     }
+    else
+    {
+      for (vcl_size_t k = row_start; k < row_end; ++k)
+      {
+        NumericT val = elements[k];
+        NumericT const * B_row = B + col_buffer[k] * B_row_inc;
+        for (vcl_size_t j = 0; j < WidthV; ++j)
+          sums[j] += val * B_row[j * B_col_inc];
+      }
+    }
+
+    for (vcl_size_t j = 0; j < WidthV; ++j)
+      C[j * C_col_inc] = sums[j];
   }
-  else {
+
+  /** @brief Computes the remaining (less than four) columns of one row of the product of a CSR matrix with a dense matrix B. */
+  template<typename NumericT>
+  void csr_dense_prod_tail(NumericT const * elements, unsigned int const * col_buffer, vcl_size_t row_start, vcl_size_t row_end,
+                           NumericT const * B, vcl_size_t B_row_inc, vcl_size_t B_col_inc,
+                           NumericT       * C, vcl_size_t C_col_inc, vcl_size_t width)
+  {
+    for (vcl_size_t j = 0; j < width; ++j)
+    {
+      NumericT sum = 0;
+      for (vcl_size_t k = row_start; k < row_end; ++k)
+        sum += elements[k] * B[col_buffer[k] * B_row_inc + j * B_col_inc];
+      C[j * C_col_inc] = sum;
+    }
+  }
+
+  /** @brief Computes C = A * B or C = A * trans(B) for a compressed_matrix A and a dense matrix B with few columns (as e.g. the block of vectors in block Krylov methods).
+  *
+  * The columns of the result are processed in tiles of 16, 8, and 4 columns, so each nonzero of A is loaded only once per tile instead of once per column.
+  */
+  template<typename NumericT, unsigned int AlignmentV>
+  void csr_dense_prod(compressed_matrix<NumericT, AlignmentV> const & A,
+                      matrix_base<NumericT> const & B, bool B_transposed,
+                      matrix_base<NumericT>       & C)
+  {
+    NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+    vcl_size_t B_offset, B_row_inc, B_col_inc;
+    vcl_size_t C_offset, C_row_inc, C_col_inc;
+    dense_matrix_layout(B, B_transposed, B_offset, B_row_inc, B_col_inc);
+    dense_matrix_layout(C, false,        C_offset, C_row_inc, C_col_inc);
+
+    NumericT const * B_data = detail::extract_raw_pointer<NumericT>(B) + B_offset;
+    NumericT       * C_data = detail::extract_raw_pointer<NumericT>(C) + C_offset;
+
+    vcl_size_t width = viennacl::traits::size2(C);
+
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for if (A.nnz() * width > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col) {
-      for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
-        vcl_size_t row_start = sp_mat_row_buffer[row];
-        vcl_size_t row_end = sp_mat_row_buffer[row+1];
-        NumericT temp = 0;
-        for (vcl_size_t k = row_start; k < row_end; ++k) {
-          temp += sp_mat_elements[k] * d_mat_wrapper_col(static_cast<vcl_size_t>(sp_mat_col_buffer[k]), static_cast<vcl_size_t>(col));
-        }
-        if (result.row_major())
-          result_wrapper_row(row, col) = temp;
-        else
-          result_wrapper_col(row, col) = temp;
-      }
+    for (long row2 = 0; row2 < static_cast<long>(A.size1()); ++row2)
+    {
+      vcl_size_t row = static_cast<vcl_size_t>(row2);
+      vcl_size_t row_start = row_buffer[row];
+      vcl_size_t row_end   = row_buffer[row+1];
+      NumericT * C_row = C_data + row * C_row_inc;
+
+      vcl_size_t col = 0;
+      for (; col + 16 <= width; col += 16)
+        csr_dense_prod_tile<16>(elements, col_buffer, row_start, row_end, B_data + col * B_col_inc, B_row_inc, B_col_inc, C_row + col * C_col_inc, C_col_inc);
+      for (; col + 8 <= width; col += 8)
+        csr_dense_prod_tile<8>(elements, col_buffer, row_start, row_end, B_data + col * B_col_inc, B_row_inc, B_col_inc, C_row + col * C_col_inc, C_col_inc);
+      for (; col + 4 <= width; col += 4)
+        csr_dense_prod_tile<4>(elements, col_buffer, row_start, row_end, B_data + col * B_col_inc, B_row_inc, B_col_inc, C_row + col * C_col_inc, C_col_inc);
+      if (col < width)
+        csr_dense_prod_tail(elements, col_buffer, row_start, row_end, B_data + col * B_col_inc, B_row_inc, B_col_inc, C_row + col * C_col_inc, C_col_inc, width - col);
     }
   }
+}
 
+/** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
+*
+* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+* The columns of the result are computed in register tiles of 16, 8, or 4 columns, reading each nonzero of sp_mat once per tile.
+*
+* @param sp_mat     The sparse matrix
+* @param d_mat      The dense matrix
+* @param result     The result matrix
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
+               const viennacl::matrix_base<NumericT> & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  detail::csr_dense_prod(sp_mat, d_mat, false, result);
 }
 
 /** @brief Carries out matrix-trans(matrix) multiplication first matrix being compressed
 *          and the second transposed
 *
 * Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+* The columns of the result are computed in register tiles of 16, 8, or 4 columns, reading each nonzero of sp_mat once per tile.
 *
 * @param sp_mat             The sparse matrix
 * @param d_mat              The transposed dense matrix
@@ -225,78 +553,236 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
                const viennacl::matrix_expression< const viennacl::matrix_base<NumericT>,
                                                   const viennacl::matrix_base<NumericT>,
                                                   viennacl::op_trans > & d_mat,
-                viennacl::matrix_base<NumericT> & result) {
+                viennacl::matrix_base<NumericT> & result)
+{
+  detail::csr_dense_prod(sp_mat, d_mat.lhs(), true, result);
+}
 
-  NumericT     const * sp_mat_elements   = detail::extract_raw_pointer<NumericT>(sp_mat.handle());
-  unsigned int const * sp_mat_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
-  unsigned int const * sp_mat_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
 
-  NumericT const *  d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat.lhs());
-  NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+//
+// Sparse matrix-matrix product with compressed_matrix
+//
+namespace detail
+{
+  /** @brief Accumulates the entries of a row of a sparse matrix-matrix product.
+  *
+  * The column indices are mapped to their position in the row either through a dense array with one entry per column of the product,
+  * or through a small hash table if the row is expected to be short compared to the number of columns (so that the dense array would mostly cause cache misses).
+  * Each thread holds its own accumulator, which is reused for all of its rows in both passes of the product.
+  * The dense array is taken from the workspace of the thread and initialized once on first use, afterwards only the positions used by a row are reset.
+  */
+  template<typename NumericT>
+  class spgemm_row_accumulator
+  {
+    static unsigned int invalid_index() { return ~0u; }
 
-  vcl_size_t d_mat_start1 = viennacl::traits::start1(d_mat.lhs());
-  vcl_size_t d_mat_start2 = viennacl::traits::start2(d_mat.lhs());
-  vcl_size_t d_mat_inc1   = viennacl::traits::stride1(d_mat.lhs());
-  vcl_size_t d_mat_inc2   = viennacl::traits::stride2(d_mat.lhs());
-  vcl_size_t d_mat_internal_size1  = viennacl::traits::internal_size1(d_mat.lhs());
-  vcl_size_t d_mat_internal_size2  = viennacl::traits::internal_size2(d_mat.lhs());
+  public:
+    explicit spgemm_row_accumulator(vcl_size_t cols) : cols_(cols), use_hash_(false), hash_mask_(0), dense_positions_(NULL) {}
 
-  vcl_size_t result_start1 = viennacl::traits::start1(result);
-  vcl_size_t result_start2 = viennacl::traits::start2(result);
-  vcl_size_t result_inc1   = viennacl::traits::stride1(result);
-  vcl_size_t result_inc2   = viennacl::traits::stride2(result);
-  vcl_size_t result_internal_size1  = viennacl::traits::internal_size1(result);
-  vcl_size_t result_internal_size2  = viennacl::traits::internal_size2(result);
+    /** @brief Prepares the accumulator for a new row with at most 'max_entries' entries. */
+    void begin_row(vcl_size_t max_entries)
+    {
+      use_hash_ = (max_entries * 32 < cols_);
+      if (use_hash_)
+      {
+        vcl_size_t hash_size = 16;
+        while (hash_size < 2 * max_entries)
+          hash_size *= 2;
+        if (hash_keys_.size() < hash_size)
+        {
+          hash_keys_.resize(hash_size, invalid_index());
+          hash_positions_.resize(hash_size);
+        }
+        hash_mask_ = hash_size - 1;
+      }
+      else if (!dense_positions_)
+      {
+        dense_positions_ = workspace_buffer<unsigned int>(WORKSPACE_SPARSE_PRODUCT, cols_);
+        std::fill(dense_positions_, dense_positions_ + cols_, invalid_index());
+      }
+    }
 
-  detail::matrix_array_wrapper<NumericT const, row_major, false>
-      d_mat_wrapper_row(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-  detail::matrix_array_wrapper<NumericT const, column_major, false>
-      d_mat_wrapper_col(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
+    /** @brief Adds 'value' to the entry in column 'col' */
+    void add(unsigned int col, NumericT value)
+    {
+      unsigned int & position = use_hash_ ? hash_position(col) : dense_positions_[col];
+      if (position == invalid_index())
+      {
+        position = static_cast<unsigned int>(entries_.size());
+        entries_.push_back(std::make_pair(col, value));
+      }
+      else
+        entries_[position].second += value;
+    }
 
-  detail::matrix_array_wrapper<NumericT, row_major, false>
-      result_wrapper_row(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
-  detail::matrix_array_wrapper<NumericT, column_major, false>
-      result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
+    /** @brief Returns the number of entries in the current row */
+    vcl_size_t size() const { return entries_.size(); }
 
-  if ( d_mat.lhs().row_major() ) {
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
-      vcl_size_t row_start = sp_mat_row_buffer[row];
-      vcl_size_t row_end = sp_mat_row_buffer[row+1];
-      for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-        NumericT temp = 0;
-        for (vcl_size_t k = row_start; k < row_end; ++k) {
-          temp += sp_mat_elements[k] * d_mat_wrapper_row(col, static_cast<vcl_size_t>(sp_mat_col_buffer[k]));
+    /** @brief Writes the entries of the current row sorted by column index to the provided arrays */
+    void extract(unsigned int * col_buffer, NumericT * elements)
+    {
+      std::sort(entries_.begin(), entries_.end(), spgemm_compare_columns);
+      for (vcl_size_t i = 0; i < entries_.size(); ++i)
+      {
+        col_buffer[i] = entries_[i].first;
+        elements[i]   = entries_[i].second;
+      }
+    }
+
+    /** @brief Removes all entries of the current row. Only the positions used by the row are reset. */
+    void clear()
+    {
+      if (use_hash_)
+      {
+        for (vcl_size_t i = 0; i < entries_.size(); ++i)
+        {
+          vcl_size_t slot = hash_slot(entries_[i].first);
+          while (hash_keys_[slot] != entries_[i].first)
+            slot = (slot + 1) & hash_mask_;
+          hash_keys_[slot] = invalid_index();
         }
-        if (result.row_major())
-          result_wrapper_row(row, col) = temp;
-        else
-          result_wrapper_col(row, col) = temp;
       }
+      else
+      {
+        for (vcl_size_t i = 0; i < entries_.size(); ++i)
+          dense_positions_[entries_[i].first] = invalid_index();
+      }
+      entries_.clear();
+    }
+
+  private:
+    static bool spgemm_compare_columns(std::pair<unsigned int, NumericT> const & a, std::pair<unsigned int, NumericT> const & b) { return a.first < b.first; }
+
+    vcl_size_t hash_slot(unsigned int col) const { return (vcl_size_t(col) * 2654435761u) & hash_mask_; }
+
+    // open addressing with linear probing. The table holds at least twice as many slots as entries, hence there is always a free slot.
+    unsigned int & hash_position(unsigned int col)
+    {
+      vcl_size_t slot = hash_slot(col);
+      while (hash_keys_[slot] != invalid_index() && hash_keys_[slot] != col)
+        slot = (slot + 1) & hash_mask_;
+
+      if (hash_keys_[slot] == invalid_index())
+      {
+        hash_keys_[slot] = col;
+        hash_positions_[slot] = invalid_index();
+      }
+      return hash_positions_[slot];
+    }
+
+    vcl_size_t cols_;
+    bool use_hash_;
+    vcl_size_t hash_mask_;
+    unsigned int * dense_positions_;
+    std::vector<unsigned int> hash_keys_;
+    std::vector<unsigned int> hash_positions_;
+    std::vector<std::pair<unsigned int, NumericT> > entries_;
+  };
+
+  /** @brief Accumulates row 'row' of the product A * B. If 'values_required' is false, only the sparsity pattern is of interest. */
+  template<typename NumericT>
+  void spgemm_accumulate_row(vcl_size_t row,
+                             unsigned int const * A_row_buffer, unsigned int const * A_col_buffer, NumericT const * A_elements,
+                             unsigned int const * B_row_buffer, unsigned int const * B_col_buffer, NumericT const * B_elements,
+                             bool values_required,
+                             spgemm_row_accumulator<NumericT> & accumulator)
+  {
+    vcl_size_t max_entries = 0;
+    for (vcl_size_t i = A_row_buffer[row]; i < A_row_buffer[row+1]; ++i)
+      max_entries += B_row_buffer[A_col_buffer[i] + 1] - B_row_buffer[A_col_buffer[i]];
+
+    accumulator.begin_row(max_entries);
+    for (vcl_size_t i = A_row_buffer[row]; i < A_row_buffer[row+1]; ++i)
+    {
+      unsigned int k = A_col_buffer[i];
+      NumericT a_ik = values_required ? A_elements[i] : NumericT(0);
+      for (vcl_size_t j = B_row_buffer[k]; j < B_row_buffer[k+1]; ++j)
+        accumulator.add(B_col_buffer[j], values_required ? a_ik * B_elements[j] : NumericT(0));
     }
   }
-  else {
+}
+
+/** @brief Carries out the sparse matrix-matrix product C = A * B with compressed_matrix.
+*
+* Uses a symbolic pass, which determines the number of nonzeros in each row of C, followed by a numeric pass which computes the entries.
+* The column indices in each row of C are sorted.
+*
+* @param A     The left hand side factor
+* @param B     The right hand side factor
+* @param C     The result matrix. The sparsity pattern is replaced by the one of the product.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+{
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT     const * B_elements   = detail::extract_raw_pointer<NumericT>(B.handle());
+  unsigned int const * B_row_buffer = detail::extract_raw_pointer<unsigned int>(B.handle1());
+  unsigned int const * B_col_buffer = detail::extract_raw_pointer<unsigned int>(B.handle2());
+
+  vcl_size_t rows = A.size1();
+  std::vector<unsigned int> C_row_buffer(rows + 1);
+  std::vector<unsigned int> C_col_buffer;
+  std::vector<NumericT>     C_elements;
+  vcl_size_t nnz = 0;
+
+  // both passes run in the same parallel region, so that each thread sets up its accumulator only once:
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col) {
-      for (vcl_size_t row = 0; row < sp_mat.size1(); ++row) {
-        vcl_size_t row_start = sp_mat_row_buffer[row];
-        vcl_size_t row_end = sp_mat_row_buffer[row+1];
-        NumericT temp = 0;
-        for (vcl_size_t k = row_start; k < row_end; ++k) {
-          temp += sp_mat_elements[k] * d_mat_wrapper_col(col, static_cast<vcl_size_t>(sp_mat_col_buffer[k]));
-        }
-        if (result.row_major())
-          result_wrapper_row(row, col) = temp;
-        else
-          result_wrapper_col(row, col) = temp;
-      }
+  {
+    detail::spgemm_row_accumulator<NumericT> accumulator(B.size2());
+
+    //
+    // Stage 1: Determine the number of nonzeros in each row
+    //
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long row = 0; row < static_cast<long>(rows); ++row)
+    {
+      detail::spgemm_accumulate_row(static_cast<vcl_size_t>(row), A_row_buffer, A_col_buffer, A_elements, B_row_buffer, B_col_buffer, B_elements, false, accumulator);
+      C_row_buffer[static_cast<vcl_size_t>(row) + 1] = static_cast<unsigned int>(accumulator.size());
+      accumulator.clear();
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp single
+#endif
+    {
+      for (vcl_size_t i = 0; i < rows; ++i)
+        C_row_buffer[i+1] += C_row_buffer[i];
+      nnz = C_row_buffer[rows];
+      C_col_buffer.resize(nnz);
+      C_elements.resize(nnz);
+    }
+
+    //
+    // Stage 2: Compute the entries
+    //
+    long numeric_rows = (nnz > 0) ? static_cast<long>(rows) : 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long row = 0; row < numeric_rows; ++row)
+    {
+      detail::spgemm_accumulate_row(static_cast<vcl_size_t>(row), A_row_buffer, A_col_buffer, A_elements, B_row_buffer, B_col_buffer, B_elements, true, accumulator);
+      accumulator.extract(&(C_col_buffer[C_row_buffer[static_cast<vcl_size_t>(row)]]), &(C_elements[C_row_buffer[static_cast<vcl_size_t>(row)]]));
+      accumulator.clear();
     }
   }
 
+  if (nnz == 0)
+  {
+    C.clear();
+    return;
+  }
+
+  C.set(&(C_row_buffer[0]), &(C_col_buffer[0]), &(C_elements[0]), rows, B.size2(), nnz);
 }
 
 
@@ -1520,6 +2006,48 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & sp_mat,
 //
 // SELL-C-\sigma Matrix
 //
+namespace detail
+{
+  /** @brief Returns true if the explicitly vectorized kernels can be used for products of a sliced_ell_matrix with a vector of the provided stride. */
+  template<typename NumericT, typename IndexT>
+  bool sliced_ell_use_simd(viennacl::sliced_ell_matrix<NumericT, IndexT> const & mat, vcl_size_t vec_stride)
+  {
+    return vec_stride == 1
+        && mat.size2() <= static_cast<vcl_size_t>(std::numeric_limits<int>::max())   // gather instructions use signed 32-bit indices
+        && sell_simd<NumericT, IndexT>::available(mat.rows_per_block());
+  }
+
+  /** @brief Computes the products of the C rows in a block of a sliced_ell_matrix with a vector. The result for the i-th row of the block is written to result_values[i].
+  *
+  * @param C               Number of rows in a block
+  * @param num_columns     Number of entries per row in the block
+  * @param elements        The entries of the block
+  * @param column_indices  The column indices of the block
+  * @param vec_buf         The vector, already offset to its first entry
+  * @param vec_stride      The stride of the vector
+  * @param use_simd        Whether the explicitly vectorized kernels may be used, see sliced_ell_use_simd()
+  * @param result_values   Buffer of size C for the results
+  */
+  template<typename NumericT, typename IndexT>
+  void sliced_ell_block_prod(vcl_size_t C, vcl_size_t num_columns,
+                             NumericT const * elements, IndexT const * column_indices,
+                             NumericT const * vec_buf, vcl_size_t vec_stride, bool use_simd,
+                             NumericT * result_values)
+  {
+    if (use_simd && num_columns > 0 && sell_simd<NumericT, IndexT>::slice(C, num_columns, elements, column_indices, vec_buf, result_values))
+      return;
+
+    // padding entries are zeros with a valid column index, so no conditionals are needed:
+    for (vcl_size_t i = 0; i < C; ++i)
+    {
+      NumericT sum = 0;
+      for (vcl_size_t j = 0; j < num_columns; ++j)
+        sum += elements[j * C + i] * vec_buf[column_indices[j * C + i] * vec_stride];
+      result_values[i] = sum;
+    }
+  }
+}
+
 /** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
 *
 * Implementation of the convenience expression result = prod(mat, vec);
@@ -1533,45 +2061,41 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
                const viennacl::vector_base<NumericT> & vec,
                      viennacl::vector_base<NumericT> & result)
 {
-  NumericT       * result_buf        = detail::extract_raw_pointer<NumericT>(result.handle());
-  NumericT const * vec_buf           = detail::extract_raw_pointer<NumericT>(vec.handle());
+  NumericT       * result_buf        = detail::extract_raw_pointer<NumericT>(result.handle()) + result.start();
+  NumericT const * vec_buf           = detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
   NumericT const * elements          = detail::extract_raw_pointer<NumericT>(mat.handle());
   IndexT   const * columns_per_block = detail::extract_raw_pointer<IndexT>(mat.handle1());
   IndexT   const * column_indices    = detail::extract_raw_pointer<IndexT>(mat.handle2());
   IndexT   const * block_start       = detail::extract_raw_pointer<IndexT>(mat.handle3());
+  IndexT   const * row_indices       = (mat.sigma() > 1) ? detail::extract_raw_pointer<IndexT>(mat.handle4()) : NULL;
 
-  vcl_size_t num_blocks = mat.size1() / mat.rows_per_block() + 1;
+  vcl_size_t C          = mat.rows_per_block();
+  vcl_size_t num_blocks = mat.size1() / C + 1;
+  bool       use_simd   = detail::sliced_ell_use_simd(mat, vec.stride());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel
 #endif
-  for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
   {
-    vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
-    vcl_size_t current_columns_per_block = columns_per_block[block_idx];
-
-    std::vector<NumericT> result_values(mat.rows_per_block());
+    std::vector<NumericT> result_values(C);
 
-    for (IndexT column_entry_index = 0;
-                column_entry_index < current_columns_per_block;
-              ++column_entry_index)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
     {
-      vcl_size_t stride_start = block_start[block_idx] + column_entry_index * mat.rows_per_block();
-      // Note: This for-loop may be unrolled by hand for exploiting vectorization
-      //       Careful benchmarking recommended first, memory channels may be saturated already!
-      for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
-      {
-        NumericT val = elements[stride_start + row_in_block];
+      vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
+      vcl_size_t num_columns = columns_per_block[block_idx];
+      vcl_size_t offset      = (num_columns > 0) ? block_start[block_idx] : 0;
 
-        result_values[row_in_block] += (val > 0 || val < 0) ? vec_buf[column_indices[stride_start + row_in_block] * vec.stride() + vec.start()] * val : 0;
-      }
-    }
+      detail::sliced_ell_block_prod(C, num_columns, elements + offset, column_indices + offset, vec_buf, vec.stride(), use_simd, &(result_values[0]));
 
-    vcl_size_t first_row_in_matrix = block_idx * mat.rows_per_block();
-    for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
-    {
-      if (first_row_in_matrix + row_in_block < result.size())
-        result_buf[(first_row_in_matrix + row_in_block) * result.stride() + result.start()] = result_values[row_in_block];
+      for (vcl_size_t i = 0; i < C; ++i)
+      {
+        vcl_size_t row = row_indices ? row_indices[block_idx * C + i] : block_idx * C + i;
+        if (row < result.size())
+          result_buf[row * result.stride()] = result_values[i];
+      }
     }
   }
 }
@@ -1828,6 +2352,315 @@ void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
 }
 
 
+
+//
+// Block compressed sparse row (BSR) matrix
+//
+
+namespace detail
+{
+  template<typename NumericT, unsigned int BlockSize>
+  void row_info(bsr_matrix<NumericT, BlockSize> const & mat,
+                vector_base<NumericT> & vec,
+                viennacl::linalg::detail::row_info_types info_selector)
+  {
+    NumericT           * result_buf = detail::extract_raw_pointer<NumericT>(vec.handle());
+    NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(mat.handle());
+    unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+    unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+    vcl_size_t result_start = vec.start();
+    vcl_size_t result_inc   = vec.stride();
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (mat.size1() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long block_row2 = 0; block_row2 < static_cast<long>(mat.block_rows()); ++block_row2)
+    {
+      vcl_size_t block_row = static_cast<vcl_size_t>(block_row2);
+      for (vcl_size_t i = 0; i < BlockSize; ++i)
+      {
+        NumericT value = 0;
+        for (vcl_size_t k = row_buffer[block_row]; k < row_buffer[block_row + 1]; ++k)
+        {
+          NumericT const * block_row_entries = elements + (k * BlockSize + i) * BlockSize;
+          switch (info_selector)
+          {
+            case viennacl::linalg::detail::SPARSE_ROW_NORM_INF: //inf-norm
+              for (vcl_size_t j = 0; j < BlockSize; ++j)
+                value = std::max<NumericT>(value, std::fabs(block_row_entries[j]));
+              break;
+
+            case viennacl::linalg::detail::SPARSE_ROW_NORM_1: //1-norm
+              for (vcl_size_t j = 0; j < BlockSize; ++j)
+                value += std::fabs(block_row_entries[j]);
+              break;
+
+            case viennacl::linalg::detail::SPARSE_ROW_NORM_2: //2-norm, square root taken below
+              for (vcl_size_t j = 0; j < BlockSize; ++j)
+                value += block_row_entries[j] * block_row_entries[j];
+              break;
+
+            case viennacl::linalg::detail::SPARSE_ROW_DIAGONAL: //diagonal entry
+              if (col_buffer[k] == block_row)
+                value = block_row_entries[i];
+              break;
+          }
+        }
+        if (info_selector == viennacl::linalg::detail::SPARSE_ROW_NORM_2)
+          value = std::sqrt(value);
+        result_buf[(block_row * BlockSize + i) * result_inc + result_start] = value;
+      }
+    }
+  }
+
+  /** @brief Computes result = A * B for a bsr_matrix A and dense matrices B and result accessed through the respective wrappers.
+  *
+  * The BlockSize entries of B multiplied with a block are loaded once and reused for all rows of the block, and the partial sums of the rows are kept in registers.
+  */
+  template<typename NumericT, unsigned int BlockSize, typename DenseWrapperT, typename ResultWrapperT>
+  void bsr_dense_prod(bsr_matrix<NumericT, BlockSize> const & A, vcl_size_t result_cols, DenseWrapperT & B, ResultWrapperT & result)
+  {
+    NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+    unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (A.nnz() * result_cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long block_row2 = 0; block_row2 < static_cast<long>(A.block_rows()); ++block_row2)
+    {
+      vcl_size_t block_row = static_cast<vcl_size_t>(block_row2);
+      for (vcl_size_t col = 0; col < result_cols; ++col)
+      {
+        NumericT sums[BlockSize];
+        for (vcl_size_t i = 0; i < BlockSize; ++i)
+          sums[i] = 0;
+
+        for (vcl_size_t k = row_buffer[block_row]; k < row_buffer[block_row + 1]; ++k)
+        {
+          NumericT const * block = elements + k * BlockSize * BlockSize;
+          vcl_size_t col_offset = col_buffer[k] * BlockSize;
+
+          NumericT x[BlockSize];
+          for (vcl_size_t j = 0; j < BlockSize; ++j)
+            x[j] = B(col_offset + j, col);
+
+          for (vcl_size_t i = 0; i < BlockSize; ++i)
+            for (vcl_size_t j = 0; j < BlockSize; ++j)
+              sums[i] += block[i * BlockSize + j] * x[j];
+        }
+
+        for (vcl_size_t i = 0; i < BlockSize; ++i)
+          result(block_row * BlockSize + i, col) = sums[i];
+      }
+    }
+  }
+
+  /** @brief Dispatches the product of a bsr_matrix with a dense matrix (transposed if TransposedV is true) to the memory layouts of the dense matrices. */
+  template<bool TransposedV, typename NumericT, unsigned int BlockSize>
+  void bsr_dense_prod(bsr_matrix<NumericT, BlockSize> const & A,
+                      matrix_base<NumericT> const & B,
+                      matrix_base<NumericT>       & result)
+  {
+    NumericT const * B_data      = detail::extract_raw_pointer<NumericT>(B);
+    NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+    detail::matrix_array_wrapper<NumericT const, row_major, TransposedV>
+        B_wrapper_row(B_data, viennacl::traits::start1(B), viennacl::traits::start2(B), viennacl::traits::stride1(B), viennacl::traits::stride2(B), viennacl::traits::internal_size1(B), viennacl::traits::internal_size2(B));
+    detail::matrix_array_wrapper<NumericT const, column_major, TransposedV>
+        B_wrapper_col(B_data, viennacl::traits::start1(B), viennacl::traits::start2(B), viennacl::traits::stride1(B), viennacl::traits::stride2(B), viennacl::traits::internal_size1(B), viennacl::traits::internal_size2(B));
+
+    detail::matrix_array_wrapper<NumericT, row_major, false>
+        result_wrapper_row(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+    detail::matrix_array_wrapper<NumericT, column_major, false>
+        result_wrapper_col(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+
+    if (B.row_major() && result.row_major())
+      bsr_dense_prod(A, result.size2(), B_wrapper_row, result_wrapper_row);
+    else if (B.row_major())
+      bsr_dense_prod(A, result.size2(), B_wrapper_row, result_wrapper_col);
+    else if (result.row_major())
+      bsr_dense_prod(A, result.size2(), B_wrapper_col, result_wrapper_row);
+    else
+      bsr_dense_prod(A, result.size2(), B_wrapper_col, result_wrapper_col);
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a bsr_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+* The entries of the vector multiplied with a block are loaded once and the partial sums of the rows of the block are kept in registers.
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  NumericT           * result_buf = detail::extract_raw_pointer<NumericT>(result.handle());
+  NumericT     const * vec_buf    = detail::extract_raw_pointer<NumericT>(vec.handle());
+  NumericT     const * elements   = detail::extract_raw_pointer<NumericT>(mat.handle());
+  unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+  unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+  vcl_size_t vec_start    = vec.start();
+  vcl_size_t vec_inc      = vec.stride();
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (mat.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long block_row2 = 0; block_row2 < static_cast<long>(mat.block_rows()); ++block_row2)
+  {
+    vcl_size_t block_row = static_cast<vcl_size_t>(block_row2);
+
+    NumericT sums[BlockSize];
+    for (vcl_size_t i = 0; i < BlockSize; ++i)
+      sums[i] = 0;
+
+    for (vcl_size_t k = row_buffer[block_row]; k < row_buffer[block_row + 1]; ++k)
+    {
+      NumericT const * block = elements + k * BlockSize * BlockSize;
+      vcl_size_t col_offset = col_buffer[k] * BlockSize;
+
+      NumericT x[BlockSize];
+      for (vcl_size_t j = 0; j < BlockSize; ++j)
+        x[j] = vec_buf[(col_offset + j) * vec_inc + vec_start];
+
+      for (vcl_size_t i = 0; i < BlockSize; ++i)
+        for (vcl_size_t j = 0; j < BlockSize; ++j)
+          sums[i] += block[i * BlockSize + j] * x[j];
+    }
+
+    for (vcl_size_t i = 0; i < BlockSize; ++i)
+      result_buf[(block_row * BlockSize + i) * result_inc + result_start] = sums[i];
+  }
+}
+
+/** @brief Carries out bsr_matrix-d_matrix multiplication
+*
+* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+*
+* @param sp_mat     The sparse matrix in BSR format
+* @param d_mat      The dense matrix
+* @param result     The result dense matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_base<NumericT> & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  detail::bsr_dense_prod<false>(sp_mat, d_mat, result);
+}
+
+/** @brief Carries out matrix-trans(matrix) multiplication first matrix being sparse BSR
+*          and the second dense transposed
+*
+* Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+*
+* @param sp_mat             The sparse matrix in BSR format
+* @param d_mat              The transposed dense matrix
+* @param result             The result matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::bsr_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_expression< const viennacl::matrix_base<NumericT>,
+                                                  const viennacl::matrix_base<NumericT>,
+                                                  viennacl::op_trans > & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  detail::bsr_dense_prod<true>(sp_mat, d_mat.lhs(), result);
+}
+
+
+//
+// Compact compressed matrix: CSR with delta-encoded column indices and reduced precision of the values
+//
+
+/** @brief Carries out matrix-vector multiplication with a compact_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+* The column indices are recovered by summing up the column offsets within each row, the values are converted to NumericT before the multiplication.
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT, typename ValueT, typename IndexT>
+void prod_impl(const viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  NumericT           * result_buf  = detail::extract_raw_pointer<NumericT>(result.handle());
+  NumericT     const * vec_buf     = detail::extract_raw_pointer<NumericT>(vec.handle());
+  ValueT       const * elements    = detail::extract_raw_pointer<ValueT>(mat.handle());
+  unsigned int const * row_buffer  = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+  IndexT       const * col_offsets = detail::extract_raw_pointer<IndexT>(mat.handle2());
+  unsigned int const * row_bases   = detail::extract_raw_pointer<unsigned int>(mat.handle3());
+
+  vcl_size_t vec_start    = vec.start();
+  vcl_size_t vec_inc      = vec.stride();
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (mat.nnz() > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long row2 = 0; row2 < static_cast<long>(mat.size1()); ++row2)
+  {
+    vcl_size_t row = static_cast<vcl_size_t>(row2);
+    vcl_size_t col = row_bases[row];
+    NumericT dot_prod = 0;
+
+    vcl_size_t row_end = row_buffer[row+1];
+    for (vcl_size_t k = row_buffer[row]; k < row_end; ++k)
+    {
+      col += col_offsets[k];
+      dot_prod += static_cast<NumericT>(elements[k]) * vec_buf[col * vec_inc + vec_start];
+    }
+
+    result_buf[row * result_inc + result_start] = dot_prod;
+  }
+}
+
+
+
+//
+// Symmetric compressed matrix: Upper triangle in CSR format
+//
+
+/** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+* Each stored entry is loaded once and multiplied with the vector for both the upper and the lower triangle.
+* The rows are processed in parallel, each thread accumulating the contributions of the lower triangle into a private buffer.
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param result The result vector
+*/
+template<typename NumericT>
+void prod_impl(const viennacl::symmetric_compressed_matrix<NumericT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+                     viennacl::vector_base<NumericT> & result)
+{
+  if (mat.size1() == 0)
+    return;
+
+  detail::csr_scatter_prod<true>(detail::extract_raw_pointer<unsigned int>(mat.handle1()),
+                                 detail::extract_raw_pointer<unsigned int>(mat.handle2()),
+                                 detail::extract_raw_pointer<NumericT>(mat.handle()),
+                                 mat.size1(),
+                                 detail::extract_raw_pointer<NumericT>(vec.handle()),    vec.start(),    vec.stride(),
+                                 detail::extract_raw_pointer<NumericT>(result.handle()), result.start(), result.stride(), result.size());
+}
+
+
 } // namespace host_based
 } //namespace linalg
 } //namespace viennacl
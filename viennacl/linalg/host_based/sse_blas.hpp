@@ -39,6 +39,8 @@
 #include <cstddef>
 #include <cmath>
 
+#include "viennacl/linalg/host_based/blas1_kernels.hpp"
+
 namespace viennacl
 {
   namespace linalg
@@ -113,32 +115,41 @@ namespace viennacl
           cx[i]=cy[i];
       }
 
-      template<class T>
-      inline T _nrm2(const T* x, vcl_size_t n)
+      namespace detail
       {
-        //based on http://www.netlib.org/blas/snrm2.f, but works with std::complex
-
-        if (n<1)
-          return T(0);
-        if (n==1)
-          return std::abs(x[0]);
-        T scale(0);
-        T scaledSquareSum(1);
-        for (vcl_size_t i=0;i<n;i++){
-          if (x[i]!=T(0)){
-            T absXi=std::abs(x[i]);
-            if (std::abs(x[i])>std::abs(scale)){
-              T temp=scale/absXi;
-              scaledSquareSum=T(1)+scaledSquareSum*temp*temp;
-              scale=absXi;
-            }
-            else{
-              T temp=absXi/scale;
-              scaledSquareSum+=temp*temp;
+        template<class T>
+        inline T nrm2_netlib(const T* x, vcl_size_t n)
+        {
+          //based on http://www.netlib.org/blas/snrm2.f, but works with std::complex
+
+          if (n<1)
+            return T(0);
+          if (n==1)
+            return std::abs(x[0]);
+          T scale(0);
+          T scaledSquareSum(1);
+          for (vcl_size_t i=0;i<n;i++){
+            if (x[i]!=T(0)){
+              T absXi=std::abs(x[i]);
+              if (std::abs(x[i])>std::abs(scale)){
+                T temp=scale/absXi;
+                scaledSquareSum=T(1)+scaledSquareSum*temp*temp;
+                scale=absXi;
+              }
+              else{
+                T temp=absXi/scale;
+                scaledSquareSum+=temp*temp;
+              }
             }
           }
+          return scale*sqrt(scaledSquareSum);
         }
-        return scale*sqrt(scaledSquareSum);
+      }
+
+      template<class T>
+      inline T _nrm2(const T* x, vcl_size_t n)
+      {
+        return detail::nrm2_netlib(x, n);
       }
 
   #if defined VIENNACL_WITH_COMPLEX
@@ -231,6 +242,66 @@ namespace viennacl
 
   #endif //defined VIENNACL_COMPLEX
 
+      //snrm2, dnrm2: explicitly vectorized, falls back to the scaled loop if no SIMD kernel is available
+      template<>
+      inline float _nrm2<float>(const float* x, vcl_size_t n)
+      {
+        float result;
+        if (viennacl::linalg::host_based::detail::blas1_simd<float>::nrm2(n, x, result))
+          return result;
+        return detail::nrm2_netlib(x, n);
+      }
+
+      template<>
+      inline double _nrm2<double>(const double* x, vcl_size_t n)
+      {
+        double result;
+        if (viennacl::linalg::host_based::detail::blas1_simd<double>::nrm2(n, x, result))
+          return result;
+        return detail::nrm2_netlib(x, n);
+      }
+
+  #if !defined VIENNACL_WITH_SSE2
+
+      //saxpy, daxpy, sdot, ddot: use the kernels with runtime instruction set dispatch unless the hand-written SSE2 versions below are enabled
+      template<>
+      inline void _axpy<float>(const float* x, float* y, vcl_size_t n, float a)
+      {
+        if (!viennacl::linalg::host_based::detail::blas1_simd<float>::axpy(n, a, x, y))
+          for (vcl_size_t i=0;i<n;i++)
+            y[i]+=a*x[i];
+      }
+
+      template<>
+      inline void _axpy<double>(const double* x, double* y, vcl_size_t n, double a)
+      {
+        if (!viennacl::linalg::host_based::detail::blas1_simd<double>::axpy(n, a, x, y))
+          for (vcl_size_t i=0;i<n;i++)
+            y[i]+=a*x[i];
+      }
+
+      template<>
+      inline float _dot<float>(vcl_size_t n, const float* x, const float* y)
+      {
+        float sum(0);
+        if (!viennacl::linalg::host_based::detail::blas1_simd<float>::dot(n, x, y, sum))
+          for (vcl_size_t i=0;i<n;i++)
+            sum+=x[i]*y[i];
+        return sum;
+      }
+
+      template<>
+      inline double _dot<double>(vcl_size_t n, const double* x, const double* y)
+      {
+        double sum(0);
+        if (!viennacl::linalg::host_based::detail::blas1_simd<double>::dot(n, x, y, sum))
+          for (vcl_size_t i=0;i<n;i++)
+            sum+=x[i]*y[i];
+        return sum;
+      }
+
+  #endif //!defined VIENNACL_WITH_SSE2
+
   #if defined VIENNACL_WITH_SSE2
 
       //saxpy
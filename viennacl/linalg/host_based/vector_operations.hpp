@@ -24,6 +24,8 @@
 
 #include <cmath>
 #include <algorithm>  //for std::max and std::min
+#include <limits>
+#include <vector>
 
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
@@ -33,15 +35,13 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/blas1_kernels.hpp"
+#include "viennacl/linalg/host_based/workspace.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
 
 // Minimum vector size for using OpenMP on vector operations:
-#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
-  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
 namespace linalg
@@ -82,6 +82,10 @@ void av(vector_base<NumericT> & vec1,
   vcl_size_t start2 = viennacl::traits::start(vec2);
   vcl_size_t inc2   = viennacl::traits::stride(vec2);
 
+  if (inc1 == 1 && inc2 == 1
+      && detail::blas1_simd<value_type>::scale(size1, data_vec2 + start2, data_alpha, reciprocal_alpha, data_vec1 + start1))
+    return;
+
   if (reciprocal_alpha)
   {
 #ifdef VIENNACL_WITH_OPENMP
@@ -130,6 +134,12 @@ void avbv(vector_base<NumericT> & vec1,
   vcl_size_t start3 = viennacl::traits::start(vec3);
   vcl_size_t inc3   = viennacl::traits::stride(vec3);
 
+  if (inc1 == 1 && inc2 == 1 && inc3 == 1
+      && detail::blas1_simd<value_type>::axpby(size1, data_vec2 + start2, data_alpha, reciprocal_alpha,
+                                                      data_vec3 + start3, data_beta,  reciprocal_beta,
+                                                      data_vec1 + start1, false))
+    return;
+
   if (reciprocal_alpha)
   {
     if (reciprocal_beta)
@@ -200,6 +210,12 @@ void avbv_v(vector_base<NumericT> & vec1,
   vcl_size_t start3 = viennacl::traits::start(vec3);
   vcl_size_t inc3   = viennacl::traits::stride(vec3);
 
+  if (inc1 == 1 && inc2 == 1 && inc3 == 1
+      && detail::blas1_simd<value_type>::axpby(size1, data_vec2 + start2, data_alpha, reciprocal_alpha,
+                                                      data_vec3 + start3, data_beta,  reciprocal_beta,
+                                                      data_vec1 + start1, true))
+    return;
+
   if (reciprocal_alpha)
   {
     if (reciprocal_beta)
@@ -488,6 +504,13 @@ void inner_prod_impl(vector_base<NumericT> const & vec1,
   vcl_size_t start2 = viennacl::traits::start(vec2);
   vcl_size_t inc2   = viennacl::traits::stride(vec2);
 
+  value_type temp;
+  if (inc1 == 1 && inc2 == 1 && detail::blas1_simd<value_type>::dot(size1, data_vec1 + start1, data_vec2 + start2, temp))
+  {
+    result = temp;
+    return;
+  }
+
   result = detail::inner_prod_impl(data_vec1, start1, inc1, size1,
                                    data_vec2, start2, inc2);  //Note: Assignment to result might be expensive, thus a temporary is introduced here
 }
@@ -634,6 +657,13 @@ void norm_1_impl(vector_base<NumericT> const & vec1,
   vcl_size_t inc1   = viennacl::traits::stride(vec1);
   vcl_size_t size1  = viennacl::traits::size(vec1);
 
+  value_type temp;
+  if (inc1 == 1 && detail::blas1_simd<value_type>::asum(size1, data_vec1 + start1, temp))
+  {
+    result = temp;
+    return;
+  }
+
   result = detail::norm_1_impl(data_vec1, start1, inc1, size1);  //Note: Assignment to result might be expensive, thus using a temporary for accumulation
 }
 
@@ -727,6 +757,50 @@ VIENNACL_NORM_2_IMPL_2(double, double)
 #undef VIENNACL_NORM_2_IMPL_1
 #undef VIENNACL_NORM_2_IMPL_2
 
+/** @brief Computes the l^2-norm from the sum of squares of the entries. Integer types: No protection against overflow. */
+template<typename NumericT, typename ScalarT>
+void norm_2_from_sum_of_squares(NumericT const *, vcl_size_t, vcl_size_t, vcl_size_t, NumericT sum_of_squares, ScalarT & result)
+{
+  result = std::sqrt(sum_of_squares);
+}
+
+/** @brief Computes the l^2-norm from the sum of squares of the entries. Floating point types: If the sum of squares has overflown or underflown, the norm is recomputed after rescaling the entries by the largest entry in modulus. */
+template<typename NumericT>
+NumericT norm_2_floating_point(NumericT const * data_vec1, vcl_size_t start1, vcl_size_t inc1, vcl_size_t size1, NumericT sum_of_squares)
+{
+  if (!blas1_norm_2_needs_rescaling(sum_of_squares))
+    return std::sqrt(sum_of_squares);
+
+  NumericT max_entry = 0;
+  for (vcl_size_t i = 0; i < size1; ++i)
+    max_entry = std::max(max_entry, std::fabs(data_vec1[i*inc1+start1]));
+  if (max_entry <= 0 || max_entry > std::numeric_limits<NumericT>::max())  // zero vector or infinite entries
+    return (sum_of_squares == sum_of_squares) ? max_entry : sum_of_squares;  // propagate NaN
+
+  NumericT temp = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: temp) if (size1 > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(size1); ++i)
+  {
+    NumericT data = data_vec1[static_cast<vcl_size_t>(i)*inc1+start1] / max_entry;
+    temp += data * data;
+  }
+  return max_entry * std::sqrt(temp);
+}
+
+template<typename ScalarT>
+void norm_2_from_sum_of_squares(float const * data_vec1, vcl_size_t start1, vcl_size_t inc1, vcl_size_t size1, float sum_of_squares, ScalarT & result)
+{
+  result = norm_2_floating_point(data_vec1, start1, inc1, size1, sum_of_squares);
+}
+
+template<typename ScalarT>
+void norm_2_from_sum_of_squares(double const * data_vec1, vcl_size_t start1, vcl_size_t inc1, vcl_size_t size1, double sum_of_squares, ScalarT & result)
+{
+  result = norm_2_floating_point(data_vec1, start1, inc1, size1, sum_of_squares);
+}
+
 }
 
 
@@ -747,7 +821,14 @@ void norm_2_impl(vector_base<NumericT> const & vec1,
   vcl_size_t inc1   = viennacl::traits::stride(vec1);
   vcl_size_t size1  = viennacl::traits::size(vec1);
 
-  result = std::sqrt(detail::norm_2_impl(data_vec1, start1, inc1, size1));  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
+  value_type temp;
+  if (inc1 == 1 && detail::blas1_simd<value_type>::nrm2(size1, data_vec1 + start1, temp))
+  {
+    result = temp;
+    return;
+  }
+
+  detail::norm_2_from_sum_of_squares(data_vec1, start1, inc1, size1, detail::norm_2_impl(data_vec1, start1, inc1, size1), result);
 }
 
 /** @brief Computes the supremum-norm of a vector
@@ -768,6 +849,11 @@ void norm_inf_impl(vector_base<NumericT> const & vec1,
   vcl_size_t size1  = viennacl::traits::size(vec1);
 
   value_type temp = 0;
+  if (inc1 == 1 && detail::blas1_simd<value_type>::amax(size1, data_vec1 + start1, temp))
+  {
+    result = temp;
+    return;
+  }
 
   // Note: No max() reduction in OpenMP yet
   for (vcl_size_t i = 0; i < size1; ++i)
@@ -909,6 +995,230 @@ void plane_rotation(vector_base<NumericT> & vec1,
   }
 }
 
+
+namespace detail
+{
+  /** @brief Raw data of an update y = alpha * x + beta * y */
+  template<typename NumericT>
+  struct fused_update
+  {
+    NumericT       * y;
+    vcl_size_t       y_start;
+    vcl_size_t       y_inc;
+    NumericT const * x;
+    vcl_size_t       x_start;
+    vcl_size_t       x_inc;
+    NumericT         alpha;
+    NumericT         beta;
+  };
+
+  /** @brief Raw data of a reduction. The type is one of the reduction types of fused_vector_operation. */
+  template<typename NumericT>
+  struct fused_reduction
+  {
+    int              type;
+    NumericT const * x;
+    vcl_size_t       x_start;
+    vcl_size_t       x_inc;
+    NumericT const * y;
+    vcl_size_t       y_start;
+    vcl_size_t       y_inc;
+  };
+
+  /** @brief Applies all updates and the partial reductions to a block of entries, which thus stays in cache for all operations. */
+  template<typename NumericT>
+  struct fused_update_reduce_block
+  {
+    typedef viennacl::linalg::fused_vector_operation<NumericT>   OperationType;
+
+    fused_update_reduce_block(fused_update<NumericT> const * updates, vcl_size_t num_updates,
+                              fused_reduction<NumericT> const * reductions, vcl_size_t num_reductions,
+                              NumericT * partial_results)
+      : updates_(updates), num_updates_(num_updates), reductions_(reductions), num_reductions_(num_reductions), partial_results_(partial_results) {}
+
+    /** @brief Explicitly vectorized version for unit-stride vectors */
+    template<typename KernelT>
+    void apply(vcl_size_t begin, vcl_size_t end) const
+    {
+      vcl_size_t n = end - begin;
+      for (vcl_size_t k = 0; k < num_updates_; ++k)
+      {
+        fused_update<NumericT> const & u = updates_[k];
+        KernelT::template axpby<false, false, false>(n, u.x + u.x_start + begin, u.alpha, u.y + u.y_start + begin, u.beta, u.y + u.y_start + begin);
+      }
+
+      for (vcl_size_t k = 0; k < num_reductions_; ++k)
+      {
+        fused_reduction<NumericT> const & r = reductions_[k];
+        NumericT const * x = r.x + r.x_start + begin;
+        switch (r.type)
+        {
+        case OperationType::INNER_PROD: partial_results_[k] += KernelT::dot(n, x, r.y + r.y_start + begin);            break;
+        case OperationType::NORM_1:     partial_results_[k] += KernelT::asum(n, x);                                     break;
+        case OperationType::NORM_2:     partial_results_[k] += KernelT::template sumsq<false>(n, x, NumericT(1));       break;
+        case OperationType::NORM_INF:   partial_results_[k]  = std::max(partial_results_[k], KernelT::amax(n, x));     break;
+        }
+      }
+    }
+
+    /** @brief Plain loops for arbitrary strides and numeric types */
+    void apply_strided(vcl_size_t begin, vcl_size_t end) const
+    {
+      for (vcl_size_t k = 0; k < num_updates_; ++k)
+      {
+        fused_update<NumericT> const & u = updates_[k];
+        for (vcl_size_t i = begin; i < end; ++i)
+          u.y[i*u.y_inc+u.y_start] = u.alpha * u.x[i*u.x_inc+u.x_start] + u.beta * u.y[i*u.y_inc+u.y_start];
+      }
+
+      for (vcl_size_t k = 0; k < num_reductions_; ++k)
+      {
+        fused_reduction<NumericT> const & r = reductions_[k];
+        NumericT temp = partial_results_[k];
+        switch (r.type)
+        {
+        case OperationType::INNER_PROD:
+          for (vcl_size_t i = begin; i < end; ++i)
+            temp += r.x[i*r.x_inc+r.x_start] * r.y[i*r.y_inc+r.y_start];
+          break;
+        case OperationType::NORM_1:
+          for (vcl_size_t i = begin; i < end; ++i)
+            temp += static_cast<NumericT>(std::fabs(static_cast<double>(r.x[i*r.x_inc+r.x_start])));  //casting to double in order to avoid problems if T is an integer type
+          break;
+        case OperationType::NORM_2:
+          for (vcl_size_t i = begin; i < end; ++i)
+            temp += r.x[i*r.x_inc+r.x_start] * r.x[i*r.x_inc+r.x_start];
+          break;
+        case OperationType::NORM_INF:
+          for (vcl_size_t i = begin; i < end; ++i)
+            temp = std::max<NumericT>(temp, static_cast<NumericT>(std::fabs(static_cast<double>(r.x[i*r.x_inc+r.x_start]))));
+          break;
+        }
+        partial_results_[k] = temp;
+      }
+    }
+
+    fused_update<NumericT> const * updates_;
+    vcl_size_t num_updates_;
+    fused_reduction<NumericT> const * reductions_;
+    vcl_size_t num_reductions_;
+    NumericT * partial_results_;
+  };
+}
+
+/** @brief Applies all updates of a fused vector operation and computes its reductions in a single parallel loop.
+*
+* Each thread processes its part of the vectors in blocks of a few thousand entries. All updates and reductions are applied to a block before moving on to the next, hence each vector is loaded from memory only once.
+* The operands and the partial results are kept in the workspace of the calling thread, the partial results of each thread start on a separate cache line.
+*
+* @param op       The updates and reductions
+* @param results  Array for the results of the reductions
+*/
+template<typename NumericT>
+void fused_update_reduce(viennacl::linalg::fused_vector_operation<NumericT> const & op, NumericT * results)
+{
+  typedef viennacl::linalg::fused_vector_operation<NumericT>   OperationType;
+
+  static const vcl_size_t block_size = 2048;
+
+  vcl_size_t size = op.size();
+  vcl_size_t num_updates    = op.update_size();
+  vcl_size_t num_reductions = op.reduction_size();
+  bool unit_stride = true;
+
+  vcl_size_t max_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  max_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+  // buffer layout: updates, reductions, partial results of each thread. Each part starts on a new cache line:
+  vcl_size_t const line = detail::workspace_alignment;
+  vcl_size_t updates_bytes    = (num_updates * sizeof(detail::fused_update<NumericT>) + line - 1) / line * line;
+  vcl_size_t reductions_bytes = (num_reductions * sizeof(detail::fused_reduction<NumericT>) + line - 1) / line * line;
+  vcl_size_t partial_stride   = (num_reductions * sizeof(NumericT) + line - 1) / line * line / sizeof(NumericT);
+
+  char * buffer = detail::workspace_buffer<char>(WORKSPACE_VECTOR, updates_bytes + reductions_bytes + max_threads * partial_stride * sizeof(NumericT));
+  detail::fused_update<NumericT>    * updates         = reinterpret_cast<detail::fused_update<NumericT> *>(buffer);
+  detail::fused_reduction<NumericT> * reductions      = reinterpret_cast<detail::fused_reduction<NumericT> *>(buffer + updates_bytes);
+  NumericT                          * partial_results = reinterpret_cast<NumericT *>(buffer + updates_bytes + reductions_bytes);
+
+  for (vcl_size_t k = 0; k < num_updates; ++k)
+  {
+    typename OperationType::update_entry const & entry = op.update_at(k);
+    detail::fused_update<NumericT> & u = updates[k];
+    u.y       = detail::extract_raw_pointer<NumericT>(*entry.y);
+    u.y_start = viennacl::traits::start(*entry.y);
+    u.y_inc   = viennacl::traits::stride(*entry.y);
+    u.x       = detail::extract_raw_pointer<NumericT>(*entry.x);
+    u.x_start = viennacl::traits::start(*entry.x);
+    u.x_inc   = viennacl::traits::stride(*entry.x);
+    u.alpha   = entry.alpha;
+    u.beta    = entry.beta;
+    unit_stride = unit_stride && (u.x_inc == 1) && (u.y_inc == 1);
+  }
+
+  for (vcl_size_t k = 0; k < num_reductions; ++k)
+  {
+    typename OperationType::reduction_entry const & entry = op.reduction_at(k);
+    detail::fused_reduction<NumericT> & r = reductions[k];
+    r.type    = entry.type;
+    r.x       = detail::extract_raw_pointer<NumericT>(*entry.x);
+    r.x_start = viennacl::traits::start(*entry.x);
+    r.x_inc   = viennacl::traits::stride(*entry.x);
+    r.y       = detail::extract_raw_pointer<NumericT>(*entry.y);
+    r.y_start = viennacl::traits::start(*entry.y);
+    r.y_inc   = viennacl::traits::stride(*entry.y);
+    unit_stride = unit_stride && (r.x_inc == 1) && (r.y_inc == 1);
+  }
+
+  vcl_size_t num_threads = 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+    vcl_size_t id   = 0;
+    vcl_size_t team = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    id   = static_cast<vcl_size_t>(omp_get_thread_num());
+    team = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+    if (id == 0)
+      num_threads = team;
+
+    vcl_size_t begin, end;
+    detail::blas1_thread_range(size, id, team, begin, end);
+
+    NumericT * thread_results = partial_results + id * partial_stride;
+    std::fill(thread_results, thread_results + num_reductions, NumericT(0));
+
+    detail::fused_update_reduce_block<NumericT> block(updates, num_updates, reductions, num_reductions, thread_results);
+    for (vcl_size_t block_start = begin; block_start < end; block_start += block_size)
+    {
+      vcl_size_t block_end = std::min(end, block_start + block_size);
+      if (!unit_stride || !detail::blas1_simd<NumericT>::apply(block_start, block_end, block))
+        block.apply_strided(block_start, block_end);
+    }
+  }
+
+  for (vcl_size_t k = 0; k < num_reductions; ++k)
+  {
+    NumericT temp = partial_results[k];
+    for (vcl_size_t i = 1; i < num_threads; ++i)
+    {
+      if (reductions[k].type == OperationType::NORM_INF)
+        temp = std::max(temp, partial_results[i * partial_stride + k]);
+      else
+        temp += partial_results[i * partial_stride + k];
+    }
+
+    if (reductions[k].type == OperationType::NORM_2)  // checks for overflow and underflow for floating point types
+      detail::norm_2_from_sum_of_squares(reductions[k].x, reductions[k].x_start, reductions[k].x_inc, size, temp, results[k]);
+    else
+      results[k] = temp;
+  }
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
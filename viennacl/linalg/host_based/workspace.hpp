@@ -0,0 +1,276 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_WORKSPACE_HPP_
+#define VIENNACL_LINALG_HOST_BASED_WORKSPACE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/workspace.hpp
+    @brief Persistent, per-thread scratch buffers for the host backend.
+
+    Kernels such as the packed matrix-matrix product require auxiliary buffers on each call.
+    Rather than allocating (and zeroing) them on each invocation, each thread keeps a set of aligned buffers which are only grown on demand.
+*/
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Identifiers of the scratch buffers held by each thread. Routines calling each other must use different slots. */
+enum workspace_slot
+{
+  WORKSPACE_GEMM_A = 0,      // packed blocks of A in matrix-matrix products
+  WORKSPACE_GEMM_B,          // packed blocks of B in matrix-matrix products
+  WORKSPACE_GEMM_C,          // partial results of matrix-matrix products with split inner dimension
+  WORKSPACE_SOLVE,           // right hand sides in triangular solvers
+  WORKSPACE_SOLVE_MATRIX,    // packed triangular matrix in triangular solvers, shared by all threads
+  WORKSPACE_FACTORIZATION,   // factorizations (LU, QR, bidiagonalization, etc.)
+  WORKSPACE_SPARSE_PRODUCT,  // partial results of sparse matrix-vector products
+  WORKSPACE_VECTOR,          // operands and partial results of fused vector operations
+  WORKSPACE_SLOT_NUM
+};
+
+/** @brief Counters for the scratch buffers of all threads. */
+struct workspace_statistics
+{
+  workspace_statistics() : current_bytes(0), high_water_mark(0), allocations(0), requests(0) {}
+
+  vcl_size_t current_bytes;     // bytes currently held by all threads
+  vcl_size_t high_water_mark;   // maximum of current_bytes since program start (or the last reset)
+  vcl_size_t allocations;       // number of (re-)allocations
+  vcl_size_t requests;          // number of buffer requests
+};
+
+namespace detail
+{
+  /** @brief Alignment of the scratch buffers in bytes. A multiple of the cache line size, so buffers of different threads never share a cache line. */
+  static const vcl_size_t workspace_alignment = 64;
+
+  /** @brief A set of scratch buffers owned by a single thread. */
+  class workspace
+  {
+    static const vcl_size_t alignment = workspace_alignment;
+
+  public:
+    workspace() : requests_(0)
+    {
+      for (vcl_size_t i = 0; i < WORKSPACE_SLOT_NUM; ++i)
+      {
+        raw_[i] = NULL;
+        aligned_[i] = NULL;
+        capacity_[i] = 0;
+      }
+    }
+
+    ~workspace()
+    {
+      for (vcl_size_t i = 0; i < WORKSPACE_SLOT_NUM; ++i)
+        std::free(raw_[i]);
+    }
+
+    /** @brief Returns an aligned buffer of at least 'bytes' bytes for the given slot. The content is not initialized. */
+    void * get(workspace_slot slot, vcl_size_t bytes);
+
+    void release();
+
+    vcl_size_t capacity() const
+    {
+      vcl_size_t total = 0;
+      for (vcl_size_t i = 0; i < WORKSPACE_SLOT_NUM; ++i)
+        total += capacity_[i];
+      return total;
+    }
+
+    vcl_size_t requests() const { return requests_; }
+
+  private:
+    workspace(workspace const &);
+    workspace & operator=(workspace const &);
+
+    char * raw_[WORKSPACE_SLOT_NUM];
+    char * aligned_[WORKSPACE_SLOT_NUM];
+    vcl_size_t capacity_[WORKSPACE_SLOT_NUM];
+    vcl_size_t requests_;
+  };
+
+  /** @brief Keeps track of the workspaces of all threads and owns them. */
+  class workspace_registry
+  {
+  public:
+    ~workspace_registry()
+    {
+      for (vcl_size_t i = 0; i < workspaces_.size(); ++i)
+        delete workspaces_[i];
+    }
+
+    workspace * create()
+    {
+      workspace * ws = new workspace();
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical (viennacl_host_workspace)
+#endif
+      workspaces_.push_back(ws);
+      return ws;
+    }
+
+    /** @brief Updates the memory counters. Called by the workspaces whenever they grow or shrink. */
+    void update(vcl_size_t bytes_freed, vcl_size_t bytes_allocated)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical (viennacl_host_workspace)
+#endif
+      {
+        stats_.current_bytes -= bytes_freed;
+        stats_.current_bytes += bytes_allocated;
+        if (bytes_allocated > 0)
+          ++stats_.allocations;
+        if (stats_.current_bytes > stats_.high_water_mark)
+          stats_.high_water_mark = stats_.current_bytes;
+      }
+    }
+
+    workspace_statistics statistics()
+    {
+      workspace_statistics result;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical (viennacl_host_workspace)
+#endif
+      {
+        result = stats_;
+        result.requests = 0;
+        for (vcl_size_t i = 0; i < workspaces_.size(); ++i)
+          result.requests += workspaces_[i]->requests();
+      }
+      return result;
+    }
+
+    void reset_high_water_mark()
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical (viennacl_host_workspace)
+#endif
+      stats_.high_water_mark = stats_.current_bytes;
+    }
+
+    void release()
+    {
+      for (vcl_size_t i = 0; i < workspaces_.size(); ++i)
+        workspaces_[i]->release();
+    }
+
+  private:
+    std::vector<workspace *> workspaces_;
+    workspace_statistics stats_;
+  };
+
+  inline workspace_registry & get_workspace_registry()
+  {
+    static workspace_registry registry;
+    return registry;
+  }
+
+  inline void * workspace::get(workspace_slot slot, vcl_size_t bytes)
+  {
+    ++requests_;
+    if (bytes > capacity_[slot])
+    {
+      vcl_size_t old_capacity = capacity_[slot];
+      std::free(raw_[slot]);
+
+      raw_[slot] = static_cast<char *>(std::malloc(bytes + alignment));
+      if (!raw_[slot])
+      {
+        aligned_[slot] = NULL;
+        capacity_[slot] = 0;
+        get_workspace_registry().update(old_capacity, 0);
+        throw std::bad_alloc();
+      }
+      aligned_[slot] = raw_[slot] + (alignment - reinterpret_cast<vcl_size_t>(raw_[slot]) % alignment);
+      capacity_[slot] = bytes;
+      get_workspace_registry().update(old_capacity, bytes);
+    }
+    return aligned_[slot];
+  }
+
+  inline void workspace::release()
+  {
+    vcl_size_t freed = capacity();
+    for (vcl_size_t i = 0; i < WORKSPACE_SLOT_NUM; ++i)
+    {
+      std::free(raw_[i]);
+      raw_[i] = NULL;
+      aligned_[i] = NULL;
+      capacity_[i] = 0;
+    }
+    if (freed > 0)
+      get_workspace_registry().update(freed, 0);
+  }
+
+  /** @brief Returns the workspace of the calling thread. Created on first use. */
+  inline workspace & thread_workspace()
+  {
+    static workspace * ws = NULL;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp threadprivate(ws)
+#endif
+    if (!ws)
+      ws = get_workspace_registry().create();
+    return *ws;
+  }
+
+  /** @brief Convenience function returning a buffer of 'num_entries' entries of type NumericT from the calling thread's workspace. */
+  template<typename NumericT>
+  NumericT * workspace_buffer(workspace_slot slot, vcl_size_t num_entries)
+  {
+    return static_cast<NumericT *>(thread_workspace().get(slot, num_entries * sizeof(NumericT)));
+  }
+
+} //namespace detail
+
+
+/** @brief Returns the counters of the scratch buffers of all threads of the host backend. */
+inline workspace_statistics host_workspace_statistics()
+{
+  return detail::get_workspace_registry().statistics();
+}
+
+/** @brief Resets the high-water mark to the amount of memory currently held. */
+inline void reset_host_workspace_high_water_mark()
+{
+  detail::get_workspace_registry().reset_high_water_mark();
+}
+
+/** @brief Frees the scratch buffers of all threads. Must not be called while host computations are running. */
+inline void release_host_workspace()
+{
+  detail::get_workspace_registry().release();
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -19,14 +19,16 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/jacobi_precond.hpp
-    @brief Implementation of a simple Jacobi preconditioner
+    @brief Implementation of a simple Jacobi preconditioner and of a point-block Jacobi preconditioner for bsr_matrix
 */
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/bsr_matrix.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
@@ -129,6 +131,147 @@ class jacobi_precond<MatrixT, true>
     viennacl::vector<NumericType> diag_A_;
 };
 
+
+/** @brief A tag for a point-block Jacobi preconditioner. The diagonal blocks of a bsr_matrix are inverted exactly.
+*/
+class block_jacobi_tag {};
+
+
+/** @brief Point-block Jacobi preconditioner class, can be supplied to solve()-routines. Only available for bsr_matrix.
+*/
+template<typename MatrixT>
+class block_jacobi_precond;
+
+
+/** @brief Point-block Jacobi preconditioner class, can be supplied to solve()-routines.
+*
+*  The inverses of the diagonal blocks are computed on the host and stored as a block-diagonal bsr_matrix, so apply() is a single sparse matrix-vector product on the device.
+*/
+template<typename NumericT, unsigned int BlockSize>
+class block_jacobi_precond< viennacl::bsr_matrix<NumericT, BlockSize> >
+{
+  typedef viennacl::bsr_matrix<NumericT, BlockSize>   MatrixType;
+
+  public:
+    block_jacobi_precond(MatrixType const & mat, block_jacobi_tag const &) : diag_A_inv_(viennacl::traits::context(mat)), temp_(mat.size1(), viennacl::traits::context(mat))
+    {
+      init(mat);
+    }
+
+    void init(MatrixType const & mat)
+    {
+      vcl_size_t block_rows = mat.block_rows();
+      vcl_size_t nonzero_blocks = mat.nonzero_blocks();
+
+      if (block_rows == 0) // empty matrix
+      {
+        diag_A_inv_ = MatrixType(viennacl::traits::context(mat));
+        temp_.resize(0, false);
+        return;
+      }
+
+      viennacl::backend::typesafe_host_array<unsigned int> row_buffer(mat.handle1(), block_rows + 1);
+      viennacl::backend::typesafe_host_array<unsigned int> col_buffer(mat.handle2(), std::max<vcl_size_t>(nonzero_blocks, 1));
+      std::vector<NumericT> elements(std::max<vcl_size_t>(nonzero_blocks, 1) * BlockSize * BlockSize);
+
+      viennacl::backend::memory_read(mat.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+      if (nonzero_blocks > 0)
+      {
+        viennacl::backend::memory_read(mat.handle2(), 0, col_buffer.raw_size(),                 col_buffer.get());
+        viennacl::backend::memory_read(mat.handle(),  0, sizeof(NumericT) * elements.size(), &(elements[0]));
+      }
+
+      viennacl::backend::typesafe_host_array<unsigned int> inv_row_buffer(mat.handle1(), block_rows + 1);
+      viennacl::backend::typesafe_host_array<unsigned int> inv_col_buffer(mat.handle2(), std::max<vcl_size_t>(block_rows, 1));
+      std::vector<NumericT> inv_elements(std::max<vcl_size_t>(block_rows, 1) * BlockSize * BlockSize);
+
+      for (vcl_size_t i = 0; i < block_rows; ++i)
+      {
+        bool diag_found = false;
+        for (vcl_size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        {
+          if (col_buffer[k] == i)
+          {
+            invert_block(&(elements[k * BlockSize * BlockSize]), &(inv_elements[i * BlockSize * BlockSize]));
+            diag_found = true;
+            break;
+          }
+        }
+        if (!diag_found)
+          throw "ViennaCL: Missing diagonal block encountered while setting up block Jacobi preconditioner!";
+
+        inv_row_buffer.set(i, i);
+        inv_col_buffer.set(i, i);
+      }
+      inv_row_buffer.set(block_rows, block_rows);
+
+      diag_A_inv_.set(inv_row_buffer.get(), inv_col_buffer.get(), &(inv_elements[0]), mat.size1(), mat.size2(), block_rows);
+      temp_.resize(mat.size1(), false);
+    }
+
+
+    template<unsigned int AlignmentV>
+    void apply(viennacl::vector<NumericT, AlignmentV> & vec) const
+    {
+      assert(diag_A_inv_.size1() == viennacl::traits::size(vec) && bool("Size mismatch"));
+      viennacl::linalg::prod_impl(diag_A_inv_, vec, temp_);
+      vec = temp_;
+    }
+
+  private:
+    /** @brief Inverts a dense block stored row-major using Gauss-Jordan elimination with partial pivoting. */
+    static void invert_block(NumericT const * block, NumericT * inverse)
+    {
+      NumericT A[BlockSize][BlockSize];
+      for (vcl_size_t i = 0; i < BlockSize; ++i)
+        for (vcl_size_t j = 0; j < BlockSize; ++j)
+        {
+          A[i][j] = block[i * BlockSize + j];
+          inverse[i * BlockSize + j] = (i == j) ? NumericT(1) : NumericT(0);
+        }
+
+      for (vcl_size_t col = 0; col < BlockSize; ++col)
+      {
+        vcl_size_t pivot = col;
+        for (vcl_size_t i = col + 1; i < BlockSize; ++i)
+          if (std::fabs(A[i][col]) > std::fabs(A[pivot][col]))
+            pivot = i;
+
+        if (A[pivot][col] <= 0 && A[pivot][col] >= 0)
+          throw "ViennaCL: Singular diagonal block encountered while setting up block Jacobi preconditioner!";
+
+        if (pivot != col)
+          for (vcl_size_t j = 0; j < BlockSize; ++j)
+          {
+            std::swap(A[pivot][j], A[col][j]);
+            std::swap(inverse[pivot * BlockSize + j], inverse[col * BlockSize + j]);
+          }
+
+        NumericT pivot_inv = NumericT(1) / A[col][col];
+        for (vcl_size_t j = 0; j < BlockSize; ++j)
+        {
+          A[col][j] *= pivot_inv;
+          inverse[col * BlockSize + j] *= pivot_inv;
+        }
+
+        for (vcl_size_t i = 0; i < BlockSize; ++i)
+        {
+          if (i == col)
+            continue;
+          NumericT factor = A[i][col];
+          for (vcl_size_t j = 0; j < BlockSize; ++j)
+          {
+            A[i][j] -= factor * A[col][j];
+            inverse[i * BlockSize + j] -= factor * inverse[col * BlockSize + j];
+          }
+        }
+      }
+    }
+
+    MatrixType diag_A_inv_;
+    mutable viennacl::vector<NumericT> temp_;
+};
+
 }
 }
 
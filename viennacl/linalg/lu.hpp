@@ -23,12 +23,16 @@
 */
 
 #include <algorithm>    //for std::min
+#include <cmath>
+#include <vector>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
 
 namespace viennacl
 {
@@ -188,6 +192,174 @@ void lu_factorize(matrix<NumericT, viennacl::column_major> & A)
 }
 
 
+namespace detail
+{
+  /** @brief Swaps the rows k and pivots[k] for k = row_start, ..., row_stop - 1 in the columns [col_start, col_stop) of a matrix in main memory. */
+  template<typename NumericT, typename F>
+  void lu_swap_rows(NumericT * data, vcl_size_t internal_size1, vcl_size_t internal_size2,
+                    std::vector<vcl_size_t> const & pivots, vcl_size_t row_start, vcl_size_t row_stop,
+                    vcl_size_t col_start, vcl_size_t col_stop)
+  {
+    if (col_start >= col_stop)
+      return;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((col_stop - col_start) * (row_stop - row_start) > 10000)
+#endif
+    for (long col2 = static_cast<long>(col_start); col2 < static_cast<long>(col_stop); ++col2)
+    {
+      vcl_size_t col = static_cast<vcl_size_t>(col2);
+      for (vcl_size_t k = row_start; k < row_stop; ++k)
+        if (pivots[k] != k)
+          std::swap(data[F::mem_index(k,         col, internal_size1, internal_size2)],
+                    data[F::mem_index(pivots[k], col, internal_size1, internal_size2)]);
+    }
+  }
+
+  /** @brief Unblocked LU factorization with partial pivoting of the columns [col_start, col_stop) of a square matrix in main memory. Row interchanges are only applied to these columns. */
+  template<typename NumericT, typename F>
+  void lu_factorize_panel(NumericT * data, vcl_size_t size, vcl_size_t internal_size1, vcl_size_t internal_size2,
+                          std::vector<vcl_size_t> & pivots, vcl_size_t col_start, vcl_size_t col_stop)
+  {
+    for (vcl_size_t k = col_start; k < col_stop; ++k)
+    {
+      // find pivot:
+      vcl_size_t pivot_row = k;
+      NumericT pivot_value = std::fabs(data[F::mem_index(k, k, internal_size1, internal_size2)]);
+      for (vcl_size_t i = k + 1; i < size; ++i)
+      {
+        NumericT value = std::fabs(data[F::mem_index(i, k, internal_size1, internal_size2)]);
+        if (value > pivot_value)
+        {
+          pivot_value = value;
+          pivot_row = i;
+        }
+      }
+      pivots[k] = pivot_row;
+
+      if (pivot_row != k)
+        for (vcl_size_t j = col_start; j < col_stop; ++j)
+          std::swap(data[F::mem_index(k,         j, internal_size1, internal_size2)],
+                    data[F::mem_index(pivot_row, j, internal_size1, internal_size2)]);
+
+      NumericT a_kk = data[F::mem_index(k, k, internal_size1, internal_size2)];
+      if (a_kk <= 0 && a_kk >= 0) // exactly singular: continue with the next column, as LAPACK does
+        continue;
+
+      // compute l_ik and update the remaining columns of the panel:
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if ((size - k) * (col_stop - k) > 20000)
+#endif
+      for (long i2 = static_cast<long>(k + 1); i2 < static_cast<long>(size); ++i2)
+      {
+        vcl_size_t i = static_cast<vcl_size_t>(i2);
+        NumericT l_ik = data[F::mem_index(i, k, internal_size1, internal_size2)] / a_kk;
+        data[F::mem_index(i, k, internal_size1, internal_size2)] = l_ik;
+        for (vcl_size_t j = k + 1; j < col_stop; ++j)
+          data[F::mem_index(i, j, internal_size1, internal_size2)] -= l_ik * data[F::mem_index(k, j, internal_size1, internal_size2)];
+      }
+    }
+  }
+
+  /** @brief Recursive LU factorization with partial pivoting of the columns [col_start, col_stop) of the square matrix A in main memory.
+  *
+  * The columns are split into a left and a right half. After factorizing the left half recursively, the right half is updated by a triangular solve and a matrix-matrix product,
+  * and the trailing part of the right half is factorized recursively. Thus, most of the work is carried out in (multithreaded) matrix-matrix products.
+  */
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  void lu_factorize_recursive(matrix<NumericT, F, AlignmentV> & A, std::vector<vcl_size_t> & pivots, vcl_size_t col_start, vcl_size_t col_stop)
+  {
+    typedef matrix<NumericT, F, AlignmentV>  MatrixType;
+
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+    vcl_size_t num_cols = col_stop - col_start;
+
+    if (num_cols <= 16)
+    {
+      lu_factorize_panel<NumericT, F>(data, A.size1(), A.internal_size1(), A.internal_size2(), pivots, col_start, col_stop);
+      return;
+    }
+
+    vcl_size_t col_mid = col_start + num_cols / 2;
+
+    // factorize left half, apply row interchanges to right half:
+    lu_factorize_recursive(A, pivots, col_start, col_mid);
+    lu_swap_rows<NumericT, F>(data, A.internal_size1(), A.internal_size2(), pivots, col_start, col_mid, col_mid, col_stop);
+
+    viennacl::range left_range(col_start, col_mid);
+    viennacl::range right_range(col_mid, col_stop);
+    viennacl::range lower_range(col_mid, A.size1());
+
+    // U_12 = L_11^{-1} A_12
+    viennacl::matrix_range<MatrixType> L_11(A, left_range, left_range);
+    viennacl::matrix_range<MatrixType> A_12(A, left_range, right_range);
+    viennacl::linalg::inplace_solve(L_11, A_12, viennacl::linalg::unit_lower_tag());
+
+    // A_22 -= L_21 * U_12
+    viennacl::matrix_range<MatrixType> L_21(A, lower_range, left_range);
+    viennacl::matrix_range<MatrixType> A_22(A, lower_range, right_range);
+    A_22 -= viennacl::linalg::prod(L_21, A_12);
+
+    // factorize right half, apply row interchanges to left half:
+    lu_factorize_recursive(A, pivots, col_mid, col_stop);
+    lu_swap_rows<NumericT, F>(data, A.internal_size1(), A.internal_size2(), pivots, col_mid, col_stop, col_start, col_mid);
+  }
+
+  /** @brief Applies the row interchanges of a pivoted LU factorization to a right hand side (vector or matrix) in main memory. */
+  template<typename NumericT>
+  void lu_apply_pivots(std::vector<vcl_size_t> const & pivots, vector_base<NumericT> & vec)
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec);
+    vcl_size_t start = viennacl::traits::start(vec);
+    vcl_size_t inc   = viennacl::traits::stride(vec);
+
+    for (vcl_size_t k = 0; k < pivots.size(); ++k)
+      if (pivots[k] != k)
+        std::swap(data[start + k * inc], data[start + pivots[k] * inc]);
+  }
+
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  void lu_apply_pivots(std::vector<vcl_size_t> const & pivots, matrix<NumericT, F, AlignmentV> & B)
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(B);
+    lu_swap_rows<NumericT, F>(data, B.internal_size1(), B.internal_size2(), pivots, 0, pivots.size(), 0, B.size2());
+  }
+}
+
+/** @brief LU factorization with partial pivoting (row interchanges) of a square dense matrix, equivalent to LAPACK's getrf.
+*
+* The factorization P A = L U is computed on the host using a recursive algorithm, where most of the work is spent in multithreaded matrix-matrix products.
+* If A does not reside in main memory, the factorization is computed on a copy in main memory.
+*
+* @param A       The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param pivots  The row interchanges: Row k was interchanged with row pivots[k] (with pivots[k] >= k), applied in the order k = 0, 1, ..., A.size1() - 1.
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void lu_factorize(matrix<NumericT, F, AlignmentV> & A, std::vector<vcl_size_t> & pivots)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+  pivots.resize(A.size1());
+  for (vcl_size_t i = 0; i < pivots.size(); ++i)
+    pivots[i] = i;
+
+  if (A.size1() == 0)
+    return;
+
+  if (viennacl::traits::context(A).memory_type() != viennacl::MAIN_MEMORY)
+  {
+    // factorize a copy in main memory:
+    matrix<NumericT, F, AlignmentV> A_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    NumericT * data_host = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A_host);
+
+    viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * A.internal_size(), data_host);
+    detail::lu_factorize_recursive(A_host, pivots, 0, A_host.size2());
+    viennacl::backend::memory_write(A.handle(), 0, sizeof(NumericT) * A.internal_size(), data_host);
+  }
+  else
+    detail::lu_factorize_recursive(A, pivots, 0, A.size2());
+}
+
 //
 // Convenience layer:
 //
@@ -221,6 +393,67 @@ void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
   inplace_solve(A, vec, upper_tag());
 }
 
+/** @brief LU substitution for the system P^T LU = rhs with the factors and row interchanges of a pivoted LU factorization.
+*
+* @param A       The LU factors as computed by lu_factorize(A, pivots)
+* @param pivots  The row interchanges as computed by lu_factorize(A, pivots)
+* @param B       The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void lu_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                   std::vector<vcl_size_t> const & pivots,
+                   matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == B.size1() && bool("Matrix must be square"));
+  assert(A.size1() == pivots.size() && bool("Size of pivot vector does not match matrix size"));
+
+  if (viennacl::traits::context(B).memory_type() != viennacl::MAIN_MEMORY)
+  {
+    matrix<NumericT, F2, AlignmentV2> B_host(B.size1(), B.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    NumericT * data_host = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(B_host);
+
+    viennacl::backend::memory_read(B.handle(), 0, sizeof(NumericT) * B.internal_size(), data_host);
+    detail::lu_apply_pivots(pivots, B_host);
+    viennacl::backend::memory_write(B.handle(), 0, sizeof(NumericT) * B.internal_size(), data_host);
+  }
+  else
+    detail::lu_apply_pivots(pivots, B);
+
+  inplace_solve(A, B, unit_lower_tag());
+  inplace_solve(A, B, upper_tag());
+}
+
+/** @brief LU substitution for the system P^T LU = rhs with the factors and row interchanges of a pivoted LU factorization.
+*
+* @param A       The LU factors as computed by lu_factorize(A, pivots)
+* @param pivots  The row interchanges as computed by lu_factorize(A, pivots)
+* @param vec     The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                   std::vector<vcl_size_t> const & pivots,
+                   vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == pivots.size() && bool("Size of pivot vector does not match matrix size"));
+
+  if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
+  {
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    viennacl::context old_ctx = viennacl::traits::context(vec);
+
+    viennacl::switch_memory_context(vec, host_ctx);
+    detail::lu_apply_pivots(pivots, vec);
+    viennacl::switch_memory_context(vec, old_ctx);
+  }
+  else
+    detail::lu_apply_pivots(pivots, vec);
+
+  inplace_solve(A, vec, unit_lower_tag());
+  inplace_solve(A, vec, upper_tag());
+}
+
 }
 }
 
@@ -87,6 +87,43 @@ namespace viennacl
     } //namespace detail
 
 
+    /** @brief Carries out one fixed-point sweep of the iterative incomplete LU factorization by Chow and Patel. All entries are updated from the previous iterate.
+    *
+    * @param L            Strict lower triangular factor (unit diagonal not stored) with sorted column indices
+    * @param aij_L        The entries of the system matrix on the pattern of L
+    * @param U_trans      Transpose of the upper triangular factor with sorted column indices. The diagonal entry is the last entry of each row.
+    * @param aij_U_trans  The entries of the transposed system matrix on the pattern of U_trans
+    */
+    template<typename NumericT>
+    void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
+                              vector<NumericT>            const & aij_L,
+                              compressed_matrix<NumericT>       & U_trans,
+                              vector<NumericT>            const & aij_U_trans)
+    {
+      switch (viennacl::traits::handle(L).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
+
   } //namespace linalg
 } //namespace viennacl
 
@@ -109,11 +109,63 @@ namespace viennacl
     "};\n";
 
 
+    namespace detail
+    {
+      /** @brief Returns the single precision matrix type used for the inner iterations. A compact_compressed_matrix keeps its narrow column offsets. */
+      template<typename MatrixT>
+      struct mixed_precision_cg_matrix
+      {
+        typedef viennacl::compressed_matrix<float> type;
+      };
+
+      template<typename NumericT, typename ValueT, typename IndexT>
+      struct mixed_precision_cg_matrix< viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> >
+      {
+        typedef viennacl::compact_compressed_matrix<float, float, IndexT> type;
+      };
+
+      /** @brief Converts an array of double precision values to single precision */
+      inline void copy_values_to_low_precision(viennacl::backend::mem_handle const & src, viennacl::backend::mem_handle & dst, vcl_size_t size,
+                                               viennacl::ocl::kernel & assign_double_to_float, double)
+      {
+        viennacl::ocl::enqueue( assign_double_to_float(dst.opencl_handle(), src.opencl_handle(), cl_uint(size)) );
+      }
+
+      /** @brief Copies an array of values which are already stored in single precision */
+      inline void copy_values_to_low_precision(viennacl::backend::mem_handle const & src, viennacl::backend::mem_handle & dst, vcl_size_t size,
+                                               viennacl::ocl::kernel &, float)
+      {
+        viennacl::backend::memory_copy(src, dst, 0, 0, sizeof(float) * size);
+      }
+
+      template<typename MatrixT>
+      void copy_to_low_precision(MatrixT const & matrix, viennacl::compressed_matrix<float> & matrix_low_precision, viennacl::ocl::kernel & assign_double_to_float)
+      {
+        viennacl::backend::memory_copy(matrix.handle1(), matrix_low_precision.handle1(), 0, 0, sizeof(cl_uint) * (matrix.size1() + 1) );
+        viennacl::backend::memory_copy(matrix.handle2(), matrix_low_precision.handle2(), 0, 0, sizeof(cl_uint) * (matrix.nnz()) );
+        copy_values_to_low_precision(matrix.handle(), matrix_low_precision.handle(), matrix.nnz(), assign_double_to_float, double());
+      }
+
+      template<typename NumericT, typename ValueT, typename IndexT>
+      void copy_to_low_precision(viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> const & matrix,
+                                 viennacl::compact_compressed_matrix<float, float, IndexT> & matrix_low_precision,
+                                 viennacl::ocl::kernel & assign_double_to_float)
+      {
+        viennacl::backend::memory_copy(matrix.handle1(), matrix_low_precision.handle1(), 0, 0, sizeof(cl_uint) * (matrix.size1() + 1) );
+        viennacl::backend::memory_copy(matrix.handle3(), matrix_low_precision.handle3(), 0, 0, sizeof(cl_uint) * (matrix.size1()) );
+        viennacl::backend::memory_copy(matrix.handle2(), matrix_low_precision.handle2(), 0, 0, sizeof(IndexT) * (matrix.nnz()) );
+        copy_values_to_low_precision(matrix.handle(), matrix_low_precision.handle(), matrix.nnz(), assign_double_to_float, ValueT());
+      }
+    }
+
     /** @brief Implementation of the conjugate gradient solver without preconditioner
     *
     * Following the algorithm in the book by Y. Saad "Iterative Methods for sparse linear systems"
     *
-    * @param matrix     The system matrix
+    * The inner iterations use a single precision copy of the system matrix. For a compact_compressed_matrix, the copy keeps the narrow column offsets,
+    * so that the inner sparse matrix-vector products load only six bytes per nonzero for IndexT = unsigned short.
+    *
+    * @param matrix     The system matrix (compressed_matrix<double> or compact_compressed_matrix<double, ValueT, IndexT>)
     * @param rhs        The load vector
     * @param tag        Solver configuration tag
     * @return The result vector
@@ -172,16 +224,8 @@ namespace viennacl
       residual_low_precision = p_low_precision;
 
       // transfer matrix to single precision:
-      viennacl::compressed_matrix<float> matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(rhs));
-      viennacl::backend::memory_copy(matrix.handle1(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle1()), 0, 0, sizeof(cl_uint) * (matrix.size1() + 1) );
-      viennacl::backend::memory_copy(matrix.handle2(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle2()), 0, 0, sizeof(cl_uint) * (matrix.nnz()) );
-
-      viennacl::ocl::enqueue( assign_double_to_float(matrix_low_precision.handle().opencl_handle(),
-                                                     matrix.handle().opencl_handle(),
-                                                     cl_uint(matrix.nnz())
-                                                    ) );
-      //std::cout << "copying matrix_low_precision..." << std::endl;
-      //assign_double_to_float(const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle()), matrix.handle(), matrix.nnz());
+      typename detail::mixed_precision_cg_matrix<MatrixType>::type matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(rhs));
+      detail::copy_to_low_precision(matrix, matrix_low_precision, assign_double_to_float);
 
       //std::cout << "Starting CG solver iterations... " << std::endl;
 
@@ -0,0 +1,254 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_BSR_MATRIX_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_BSR_MATRIX_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+#include "viennacl/linalg/opencl/common.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/bsr_matrix.hpp
+ *  @brief OpenCL kernel file for bsr_matrix operations. The block size is fixed at kernel generation time, so the loops over the entries of a block are fully unrolled. */
+namespace viennacl
+{
+namespace linalg
+{
+namespace opencl
+{
+namespace kernels
+{
+
+//////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+// Each work item computes the rows of one block row. The entries of x multiplied with a block and the partial sums of the rows are kept in registers.
+template<typename StringT>
+void generate_bsr_vec_mul(StringT & source, std::string const & numeric_string, unsigned int block_size)
+{
+  std::string B  = viennacl::tools::to_string(block_size);
+  std::string BB = viennacl::tools::to_string(block_size * block_size);
+
+  source.append("__kernel void vec_mul( \n");
+  source.append("  __global const unsigned int * row_blocks, \n");
+  source.append("  __global const unsigned int * column_blocks, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+  source.append("  uint4 layout_x, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result, \n");
+  source.append("  unsigned int block_rows) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int block_row = get_global_id(0); block_row < block_rows; block_row += get_global_size(0)) \n");
+  source.append("  { \n");
+  for (unsigned int i = 0; i < block_size; ++i)
+  {
+    source.append("    "); source.append(numeric_string); source.append(" sum_"); source.append(viennacl::tools::to_string(i)); source.append(" = 0; \n");
+  }
+  source.append("    unsigned int block_row_end = row_blocks[block_row + 1]; \n");
+  source.append("    for (unsigned int k = row_blocks[block_row]; k < block_row_end; ++k) \n");
+  source.append("    { \n");
+  source.append("      __global const "); source.append(numeric_string); source.append(" * block = elements + k * "); source.append(BB); source.append("; \n");
+  source.append("      unsigned int col_offset = column_blocks[k] * "); source.append(B); source.append("; \n");
+  for (unsigned int j = 0; j < block_size; ++j)
+  {
+    std::string js = viennacl::tools::to_string(j);
+    source.append("      "); source.append(numeric_string); source.append(" x_"); source.append(js);
+    source.append(" = x[(col_offset + "); source.append(js); source.append(") * layout_x.y + layout_x.x]; \n");
+  }
+  for (unsigned int i = 0; i < block_size; ++i)
+  {
+    std::string is = viennacl::tools::to_string(i);
+    for (unsigned int j = 0; j < block_size; ++j)
+    {
+      std::string js = viennacl::tools::to_string(j);
+      source.append("      sum_"); source.append(is); source.append(" += block["); source.append(viennacl::tools::to_string(i * block_size + j)); source.append("] * x_"); source.append(js); source.append("; \n");
+    }
+  }
+  source.append("    } \n");
+  for (unsigned int i = 0; i < block_size; ++i)
+  {
+    std::string is = viennacl::tools::to_string(i);
+    source.append("    result[(block_row * "); source.append(B); source.append(" + "); source.append(is); source.append(") * layout_result.y + layout_result.x] = sum_"); source.append(is); source.append("; \n");
+  }
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+template<typename StringT>
+void generate_bsr_row_info_extractor(StringT & source, std::string const & numeric_string, unsigned int block_size)
+{
+  std::string B = viennacl::tools::to_string(block_size);
+
+  source.append("__kernel void row_info_extractor( \n");
+  source.append("  __global const unsigned int * row_blocks, \n");
+  source.append("  __global const unsigned int * column_blocks, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result, \n");
+  source.append("  unsigned int size, \n");
+  source.append("  unsigned int option \n");
+  source.append("  ) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = get_global_id(0); row < size; row += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    "); source.append(numeric_string); source.append(" value = 0; \n");
+  source.append("    unsigned int block_row = row / "); source.append(B); source.append("; \n");
+  source.append("    unsigned int i = row % "); source.append(B); source.append("; \n");
+  source.append("    unsigned int block_row_end = row_blocks[block_row + 1]; \n");
+  source.append("    for (unsigned int k = row_blocks[block_row]; k < block_row_end; ++k) \n");
+  source.append("    { \n");
+  source.append("      __global const "); source.append(numeric_string); source.append(" * row_entries = elements + (k * "); source.append(B); source.append(" + i) * "); source.append(B); source.append("; \n");
+  source.append("      switch (option) \n");
+  source.append("      { \n");
+  source.append("        case 0: \n"); //inf-norm
+  source.append("          for (unsigned int j = 0; j < "); source.append(B); source.append("; ++j) \n");
+  source.append("            value = max(value, fabs(row_entries[j])); \n");
+  source.append("          break; \n");
+  source.append("        case 1: \n"); //1-norm
+  source.append("          for (unsigned int j = 0; j < "); source.append(B); source.append("; ++j) \n");
+  source.append("            value += fabs(row_entries[j]); \n");
+  source.append("          break; \n");
+  source.append("        case 2: \n"); //2-norm
+  source.append("          for (unsigned int j = 0; j < "); source.append(B); source.append("; ++j) \n");
+  source.append("            value += row_entries[j] * row_entries[j]; \n");
+  source.append("          break; \n");
+  source.append("        case 3: \n"); //diagonal entry
+  source.append("          if (column_blocks[k] == block_row) \n");
+  source.append("            value = row_entries[i]; \n");
+  source.append("          break; \n");
+  source.append("        default: \n");
+  source.append("          break; \n");
+  source.append("      } \n");
+  source.append("    } \n");
+  source.append("    if (option == 2) \n");
+  source.append("      value = sqrt(value); \n");
+  source.append("    result[row * layout_result.y + layout_result.x] = value; \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+namespace detail
+{
+  // Each work item computes one entry of the result.
+  template<typename StringT>
+  void generate_bsr_matrix_dense_matrix_mul(StringT & source, std::string const & numeric_string, unsigned int block_size,
+                                            bool B_transposed, bool B_row_major, bool C_row_major)
+  {
+    std::string B = viennacl::tools::to_string(block_size);
+
+    source.append("__kernel void ");
+    source.append(viennacl::linalg::opencl::detail::sparse_dense_matmult_kernel_name(B_transposed, B_row_major, C_row_major));
+    source.append("( \n");
+    source.append("    __global const unsigned int * sp_mat_row_blocks, \n");
+    source.append("    __global const unsigned int * sp_mat_column_blocks, \n");
+    source.append("    __global const "); source.append(numeric_string); source.append(" * sp_mat_elements, \n");
+    source.append("    unsigned int sp_mat_row_num, \n");
+    source.append("    __global const "); source.append(numeric_string); source.append("* d_mat, \n");
+    source.append("    unsigned int d_mat_row_start, \n");
+    source.append("    unsigned int d_mat_col_start, \n");
+    source.append("    unsigned int d_mat_row_inc, \n");
+    source.append("    unsigned int d_mat_col_inc, \n");
+    source.append("    unsigned int d_mat_row_size, \n");
+    source.append("    unsigned int d_mat_col_size, \n");
+    source.append("    unsigned int d_mat_internal_rows, \n");
+    source.append("    unsigned int d_mat_internal_cols, \n");
+    source.append("    __global "); source.append(numeric_string); source.append(" * result, \n");
+    source.append("    unsigned int result_row_start, \n");
+    source.append("    unsigned int result_col_start, \n");
+    source.append("    unsigned int result_row_inc, \n");
+    source.append("    unsigned int result_col_inc, \n");
+    source.append("    unsigned int result_row_size, \n");
+    source.append("    unsigned int result_col_size, \n");
+    source.append("    unsigned int result_internal_rows, \n");
+    source.append("    unsigned int result_internal_cols) { \n");
+
+    source.append("  for (uint rc = get_global_id(0); rc < sp_mat_row_num * result_col_size; rc += get_global_size(0)) { \n");
+    source.append("    uint row = rc % sp_mat_row_num; \n");
+    source.append("    uint col = rc / sp_mat_row_num; \n");
+    source.append("    uint block_row = row / "); source.append(B); source.append("; \n");
+    source.append("    uint i = row % "); source.append(B); source.append("; \n");
+    source.append("    "); source.append(numeric_string); source.append(" r = 0; \n");
+
+    source.append("    uint block_row_end = sp_mat_row_blocks[block_row + 1]; \n");
+    source.append("    for (uint k = sp_mat_row_blocks[block_row]; k < block_row_end; ++k) { \n");
+    source.append("      __global const "); source.append(numeric_string); source.append(" * row_entries = sp_mat_elements + (k * "); source.append(B); source.append(" + i) * "); source.append(B); source.append("; \n");
+    source.append("      uint col_offset = sp_mat_column_blocks[k] * "); source.append(B); source.append("; \n");
+    source.append("      for (uint j = 0; j < "); source.append(B); source.append("; ++j) \n");
+    if (B_transposed && B_row_major)
+      source.append("        r += row_entries[j] * d_mat[ (d_mat_row_start + col * d_mat_row_inc) * d_mat_internal_cols + d_mat_col_start + (col_offset + j) * d_mat_col_inc ]; \n");
+    else if (B_transposed && !B_row_major)
+      source.append("        r += row_entries[j] * d_mat[ (d_mat_row_start + col * d_mat_row_inc)                       + (d_mat_col_start + (col_offset + j) * d_mat_col_inc) * d_mat_internal_rows ]; \n");
+    else if (!B_transposed && B_row_major)
+      source.append("        r += row_entries[j] * d_mat[ (d_mat_row_start + (col_offset + j) * d_mat_row_inc) * d_mat_internal_cols + d_mat_col_start + col * d_mat_col_inc ]; \n");
+    else
+      source.append("        r += row_entries[j] * d_mat[ (d_mat_row_start + (col_offset + j) * d_mat_row_inc)                       + (d_mat_col_start + col * d_mat_col_inc) * d_mat_internal_rows ]; \n");
+    source.append("    } \n");
+
+    if (C_row_major)
+      source.append("    result[ (result_row_start + row * result_row_inc) * result_internal_cols + result_col_start + col * result_col_inc ] = r; \n");
+    else
+      source.append("    result[ (result_row_start + row * result_row_inc)                        + (result_col_start + col * result_col_inc) * result_internal_rows ] = r; \n");
+    source.append("  } \n");
+    source.append("} \n");
+  }
+}
+
+template<typename StringT>
+void generate_bsr_matrix_dense_matrix_multiplication(StringT & source, std::string const & numeric_string, unsigned int block_size)
+{
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, false, false, false);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, false, false,  true);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, false,  true, false);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, false,  true,  true);
+
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, true, false, false);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, true, false,  true);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, true,  true, false);
+  detail::generate_bsr_matrix_dense_matrix_mul(source, numeric_string, block_size, true,  true,  true);
+}
+
+//////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+// main kernel class
+/** @brief Main kernel class for generating OpenCL kernels for bsr_matrix. One program is generated for each block size. */
+template<typename NumericT, unsigned int BlockSize>
+struct bsr_matrix
+{
+  static std::string program_name()
+  {
+    return viennacl::ocl::type_to_string<NumericT>::apply() + "_bsr_matrix_" + viennacl::tools::to_string(BlockSize);
+  }
+
+  static void init(viennacl::ocl::context & ctx)
+  {
+    static std::map<cl_context, bool> init_done;
+    if (!init_done[ctx.handle().get()])
+    {
+      viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+      std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+      std::string source;
+      source.reserve(4096);
+
+      viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+      // fully parametrized kernels:
+      generate_bsr_vec_mul(source, numeric_string, BlockSize);
+      generate_bsr_row_info_extractor(source, numeric_string, BlockSize);
+      generate_bsr_matrix_dense_matrix_multiplication(source, numeric_string, BlockSize);
+
+      std::string prog_name = program_name();
+      #ifdef VIENNACL_BUILD_INFO
+      std::cout << "Creating program " << prog_name << std::endl;
+      #endif
+      ctx.add_program(source, prog_name);
+      init_done[ctx.handle().get()] = true;
+    } //if
+  } //init
+};
+
+}  // namespace kernels
+}  // namespace opencl
+}  // namespace linalg
+}  // namespace viennacl
+#endif
@@ -0,0 +1,101 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_COMPACT_COMPRESSED_MATRIX_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_COMPACT_COMPRESSED_MATRIX_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+#include "viennacl/linalg/opencl/common.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/compact_compressed_matrix.hpp
+ *  @brief OpenCL kernel file for compact_compressed_matrix operations. One program is generated for each combination of vector type, value type, and index type. */
+namespace viennacl
+{
+namespace linalg
+{
+namespace opencl
+{
+namespace kernels
+{
+
+//////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+// Each work item processes one row, since the column indices are recovered by summing up the column offsets within the row.
+template<typename StringT>
+void generate_compact_compressed_matrix_vec_mul(StringT & source, std::string const & numeric_string, std::string const & value_string, std::string const & index_string)
+{
+  source.append("__kernel void vec_mul( \n");
+  source.append("  __global const unsigned int * row_indices, \n");
+  source.append("  __global const "); source.append(index_string); source.append(" * column_offsets, \n");
+  source.append("  __global const unsigned int * row_bases, \n");
+  source.append("  __global const "); source.append(value_string); source.append(" * elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+  source.append("  uint4 layout_x, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = get_global_id(0); row < layout_result.z; row += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    "); source.append(numeric_string); source.append(" dot_prod = 0; \n");
+  source.append("    unsigned int col = row_bases[row]; \n");
+  source.append("    unsigned int row_end = row_indices[row+1]; \n");
+  source.append("    for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+  source.append("    { \n");
+  source.append("      col += column_offsets[i]; \n");
+  source.append("      dot_prod += ("); source.append(numeric_string); source.append(")(elements[i]) * x[col * layout_x.y + layout_x.x]; \n");
+  source.append("    } \n");
+  source.append("    result[row * layout_result.y + layout_result.x] = dot_prod; \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+//////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+// main kernel class
+/** @brief Main kernel class for generating OpenCL kernels for compact_compressed_matrix. */
+template<typename NumericT, typename ValueT, typename IndexT>
+struct compact_compressed_matrix
+{
+  static std::string program_name()
+  {
+    return viennacl::ocl::type_to_string<NumericT>::apply() + "_" + viennacl::ocl::type_to_string<ValueT>::apply() + "_"
+         + viennacl::ocl::type_to_string<IndexT>::apply() + "_compact_compressed_matrix";
+  }
+
+  static void init(viennacl::ocl::context & ctx)
+  {
+    static std::map<cl_context, bool> init_done;
+    if (!init_done[ctx.handle().get()])
+    {
+      viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+      viennacl::ocl::DOUBLE_PRECISION_CHECKER<ValueT>::apply(ctx);
+      std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+      std::string value_string   = viennacl::ocl::type_to_string<ValueT>::apply();
+      std::string index_string   = viennacl::ocl::type_to_string<IndexT>::apply();
+
+      std::string source;
+      source.reserve(1024);
+
+      if (numeric_string == "double")
+        viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+      else
+        viennacl::ocl::append_double_precision_pragma<ValueT>(ctx, source);
+
+      generate_compact_compressed_matrix_vec_mul(source, numeric_string, value_string, index_string);
+
+      std::string prog_name = program_name();
+      #ifdef VIENNACL_BUILD_INFO
+      std::cout << "Creating program " << prog_name << std::endl;
+      #endif
+      ctx.add_program(source, prog_name);
+      init_done[ctx.handle().get()] = true;
+    } //if
+  } //init
+};
+
+}  // namespace kernels
+}  // namespace opencl
+}  // namespace linalg
+}  // namespace viennacl
+#endif
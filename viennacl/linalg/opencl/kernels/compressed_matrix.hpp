@@ -425,6 +425,105 @@ void generate_compressed_matrix_row_info_extractor(StringT & source, std::string
 
 }
 
+// Sparse matrix-matrix product C = A * B. Each work item merges the rows of B referenced by a row of A, which requires sorted column indices in B.
+// The current position in each of these rows of B is kept in 'B_row_positions', which holds one entry per nonzero of A.
+template<typename StringT>
+void generate_compressed_matrix_spgemm(StringT & source, std::string const & numeric_string)
+{
+  // Stage 1: number of nonzeros in each row of C
+  source.append("__kernel void spgemm_row_lengths( \n");
+  source.append("  __global const unsigned int * A_row_indices, \n");
+  source.append("  __global const unsigned int * A_col_indices, \n");
+  source.append("  unsigned int A_size1, \n");
+  source.append("  __global const unsigned int * B_row_indices, \n");
+  source.append("  __global const unsigned int * B_col_indices, \n");
+  source.append("  __global unsigned int * B_row_positions, \n");
+  source.append("  __global unsigned int * C_row_lengths) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = get_global_id(0); row < A_size1; row += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    unsigned int A_row_start = A_row_indices[row]; \n");
+  source.append("    unsigned int A_row_stop  = A_row_indices[row+1]; \n");
+  source.append("    for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      B_row_positions[i] = B_row_indices[A_col_indices[i]]; \n");
+
+  source.append("    unsigned int num_entries = 0; \n");
+  source.append("    while (1) \n");
+  source.append("    { \n");
+  source.append("      unsigned int min_col = 0xFFFFFFFF; \n");
+  source.append("      for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      { \n");
+  source.append("        unsigned int pos = B_row_positions[i]; \n");
+  source.append("        if (pos < B_row_indices[A_col_indices[i] + 1]) \n");
+  source.append("          min_col = min(min_col, B_col_indices[pos]); \n");
+  source.append("      } \n");
+  source.append("      if (min_col == 0xFFFFFFFF) \n");
+  source.append("        break; \n");
+
+  source.append("      for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      { \n");
+  source.append("        unsigned int pos = B_row_positions[i]; \n");
+  source.append("        if (pos < B_row_indices[A_col_indices[i] + 1] && B_col_indices[pos] == min_col) \n");
+  source.append("          B_row_positions[i] = pos + 1; \n");
+  source.append("      } \n");
+  source.append("      ++num_entries; \n");
+  source.append("    } \n");
+  source.append("    C_row_lengths[row] = num_entries; \n");
+  source.append("  } \n");
+  source.append("} \n");
+
+  // Stage 2: column indices and entries of C
+  source.append("__kernel void spgemm_entries( \n");
+  source.append("  __global const unsigned int * A_row_indices, \n");
+  source.append("  __global const unsigned int * A_col_indices, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * A_elements, \n");
+  source.append("  unsigned int A_size1, \n");
+  source.append("  __global const unsigned int * B_row_indices, \n");
+  source.append("  __global const unsigned int * B_col_indices, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * B_elements, \n");
+  source.append("  __global unsigned int * B_row_positions, \n");
+  source.append("  __global const unsigned int * C_row_indices, \n");
+  source.append("  __global unsigned int * C_col_indices, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * C_elements) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = get_global_id(0); row < A_size1; row += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    unsigned int A_row_start = A_row_indices[row]; \n");
+  source.append("    unsigned int A_row_stop  = A_row_indices[row+1]; \n");
+  source.append("    for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      B_row_positions[i] = B_row_indices[A_col_indices[i]]; \n");
+
+  source.append("    unsigned int C_index = C_row_indices[row]; \n");
+  source.append("    while (1) \n");
+  source.append("    { \n");
+  source.append("      unsigned int min_col = 0xFFFFFFFF; \n");
+  source.append("      for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      { \n");
+  source.append("        unsigned int pos = B_row_positions[i]; \n");
+  source.append("        if (pos < B_row_indices[A_col_indices[i] + 1]) \n");
+  source.append("          min_col = min(min_col, B_col_indices[pos]); \n");
+  source.append("      } \n");
+  source.append("      if (min_col == 0xFFFFFFFF) \n");
+  source.append("        break; \n");
+
+  source.append("      "); source.append(numeric_string); source.append(" value = 0; \n");
+  source.append("      for (unsigned int i = A_row_start; i < A_row_stop; ++i) \n");
+  source.append("      { \n");
+  source.append("        unsigned int pos = B_row_positions[i]; \n");
+  source.append("        if (pos < B_row_indices[A_col_indices[i] + 1] && B_col_indices[pos] == min_col) \n");
+  source.append("        { \n");
+  source.append("          value += A_elements[i] * B_elements[pos]; \n");
+  source.append("          B_row_positions[i] = pos + 1; \n");
+  source.append("        } \n");
+  source.append("      } \n");
+  source.append("      C_col_indices[C_index] = min_col; \n");
+  source.append("      C_elements[C_index]    = value; \n");
+  source.append("      ++C_index; \n");
+  source.append("    } \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
 template<typename StringT>
 void generate_compressed_matrix_trans_lu_backward(StringT & source, std::string const & numeric_string)
 {
@@ -739,6 +838,35 @@ void generate_compressed_matrix_trans_unit_lu_forward_slow(StringT & source, std
 
 }
 
+// Computes y = trans(A) * x within a single work group: The rows are processed one after another, so the scatter of the entries of a row never conflicts with another row.
+template<typename StringT>
+void generate_compressed_matrix_trans_vec_mul(StringT & source, std::string const & numeric_string)
+{
+  source.append("__kernel void trans_vec_mul( \n");
+  source.append("  __global const unsigned int * row_indices, \n");
+  source.append("  __global const unsigned int * column_indices, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+  source.append("  unsigned int rows, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+  source.append("  uint4 layout_x, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int i = get_local_id(0); i < layout_result.z; i += get_local_size(0)) \n");
+  source.append("    result[i * layout_result.y + layout_result.x] = 0; \n");
+  source.append("  barrier(CLK_GLOBAL_MEM_FENCE); \n");
+
+  source.append("  for (unsigned int row = 0; row < rows; ++row) \n");
+  source.append("  { \n");
+  source.append("    "); source.append(numeric_string); source.append(" x_row = x[row * layout_x.y + layout_x.x]; \n");
+  source.append("    unsigned int row_stop = row_indices[row + 1]; \n");
+  source.append("    for (unsigned int i = row_indices[row] + get_local_id(0); i < row_stop; i += get_local_size(0)) \n");
+  source.append("      result[column_indices[i] * layout_result.y + layout_result.x] += elements[i] * x_row; \n");
+  source.append("    barrier(CLK_GLOBAL_MEM_FENCE); \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
 template<typename StringT>
 void generate_compressed_matrix_unit_lu_backward(StringT & source, std::string const & numeric_string)
 {
@@ -1144,6 +1272,8 @@ struct compressed_matrix
       }
       generate_compressed_matrix_dense_matrix_multiplication(source, numeric_string);
       generate_compressed_matrix_row_info_extractor(source, numeric_string);
+      generate_compressed_matrix_spgemm(source, numeric_string);
+      generate_compressed_matrix_trans_vec_mul(source, numeric_string);
       generate_compressed_matrix_vec_mul(source, numeric_string);
       generate_compressed_matrix_vec_mul4(source, numeric_string);
       generate_compressed_matrix_vec_mul8(source, numeric_string);
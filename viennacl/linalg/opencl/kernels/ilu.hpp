@@ -7,7 +7,7 @@
 #include "viennacl/ocl/utils.hpp"
 
 /** @file viennacl/linalg/opencl/kernels/ilu.hpp
- *  @brief OpenCL kernel file for nonnegative matrix factorization */
+ *  @brief OpenCL kernel file for incomplete LU factorization preconditioners */
 namespace viennacl
 {
 namespace linalg
@@ -43,6 +43,68 @@ void generate_ilu_level_scheduling_substitute(StringT & source, std::string cons
   source.append("} \n");
 }
 
+template<typename StringT>
+void generate_ilu_chow_patel_sweep(StringT & source, std::string const & numeric_string)
+{
+  // sparse dot product of two rows with sorted column indices, restricted to columns smaller than 'bound':
+  source.append(numeric_string); source.append(" ilu_sparse_row_dot( \n");
+  source.append("  __global const unsigned int * col_buffer1, __global const "); source.append(numeric_string); source.append(" * elements1, unsigned int begin1, unsigned int end1, \n");
+  source.append("  __global const unsigned int * col_buffer2, __global const "); source.append(numeric_string); source.append(" * elements2, unsigned int begin2, unsigned int end2, \n");
+  source.append("  unsigned int bound) \n");
+  source.append("{ \n");
+  source.append("  "); source.append(numeric_string); source.append(" sum = 0; \n");
+  source.append("  while (begin1 < end1 && begin2 < end2) \n");
+  source.append("  { \n");
+  source.append("    unsigned int col1 = col_buffer1[begin1]; \n");
+  source.append("    unsigned int col2 = col_buffer2[begin2]; \n");
+  source.append("    if (col1 >= bound || col2 >= bound) \n");
+  source.append("      break; \n");
+  source.append("    if (col1 < col2) \n");
+  source.append("      ++begin1; \n");
+  source.append("    else if (col2 < col1) \n");
+  source.append("      ++begin2; \n");
+  source.append("    else \n");
+  source.append("      sum += elements1[begin1++] * elements2[begin2++]; \n");
+  source.append("  } \n");
+  source.append("  return sum; \n");
+  source.append("} \n");
+
+  source.append("__kernel void ilu_chow_patel_sweep( \n");
+  source.append("  __global const unsigned int * L_row_indices, \n");
+  source.append("  __global const unsigned int * L_column_indices, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * L_elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * L_backup, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * L_aij, \n");
+  source.append("  __global const unsigned int * U_row_indices, \n");
+  source.append("  __global const unsigned int * U_column_indices, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * U_elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * U_backup, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * U_aij, \n");
+  source.append("  unsigned int size) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int i  = get_global_id(0); \n");
+  source.append("                    i  < size; \n");
+  source.append("                    i += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    for (unsigned int nnz_index = L_row_indices[i]; nnz_index < L_row_indices[i+1]; ++nnz_index) \n");
+  source.append("    { \n");
+  source.append("      unsigned int j = L_column_indices[nnz_index]; \n");
+  source.append("      "); source.append(numeric_string); source.append(" sum = ilu_sparse_row_dot(L_column_indices, L_backup, L_row_indices[i], L_row_indices[i+1], \n");
+  source.append("                                                   U_column_indices, U_backup, U_row_indices[j], U_row_indices[j+1], j); \n");
+  source.append("      L_elements[nnz_index] = (L_aij[nnz_index] - sum) / U_backup[U_row_indices[j+1] - 1]; \n");
+  source.append("    } \n");
+
+  source.append("    for (unsigned int nnz_index = U_row_indices[i]; nnz_index < U_row_indices[i+1]; ++nnz_index) \n");
+  source.append("    { \n");
+  source.append("      unsigned int j = U_column_indices[nnz_index]; \n");
+  source.append("      "); source.append(numeric_string); source.append(" sum = ilu_sparse_row_dot(L_column_indices, L_backup, L_row_indices[j], L_row_indices[j+1], \n");
+  source.append("                                                   U_column_indices, U_backup, U_row_indices[i], U_row_indices[i+1], j); \n");
+  source.append("      U_elements[nnz_index] = U_aij[nnz_index] - sum; \n");
+  source.append("    } \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
 // main kernel class
 /** @brief Main kernel class for generating OpenCL kernels for incomplete LU factorization preconditioners. */
 template<class NumericT>
@@ -62,7 +124,7 @@ struct ilu
       std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
 
       std::string source;
-      source.reserve(1024);
+      source.reserve(4096);
 
       viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
 
@@ -70,6 +132,7 @@ struct ilu
       if (numeric_string == "float" || numeric_string == "double")
       {
         generate_ilu_level_scheduling_substitute(source, numeric_string);
+        generate_ilu_chow_patel_sweep(source, numeric_string);
       }
 
       std::string prog_name = program_name();
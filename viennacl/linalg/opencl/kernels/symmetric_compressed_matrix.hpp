@@ -0,0 +1,119 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_SYMMETRIC_COMPRESSED_MATRIX_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_SYMMETRIC_COMPRESSED_MATRIX_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+#include "viennacl/linalg/opencl/common.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/symmetric_compressed_matrix.hpp
+ *  @brief OpenCL kernel file for symmetric_compressed_matrix operations */
+namespace viennacl
+{
+namespace linalg
+{
+namespace opencl
+{
+namespace kernels
+{
+
+//////////////////////////// Part 1: Kernel generation routines ////////////////////////////////////
+
+// Each work item computes the product of one row of the stored upper triangle (including the diagonal) with x.
+template<typename StringT>
+void generate_symmetric_compressed_matrix_vec_mul(StringT & source, std::string const & numeric_string)
+{
+  source.append("__kernel void vec_mul( \n");
+  source.append("  __global const unsigned int * row_indices, \n");
+  source.append("  __global const unsigned int * column_indices, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+  source.append("  uint4 layout_x, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = get_global_id(0); row < layout_result.z; row += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    "); source.append(numeric_string); source.append(" dot_prod = 0; \n");
+  source.append("    unsigned int row_end = row_indices[row+1]; \n");
+  source.append("    for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+  source.append("      dot_prod += elements[i] * x[column_indices[i] * layout_x.y + layout_x.x]; \n");
+  source.append("    result[row * layout_result.y + layout_result.x] = dot_prod; \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+// Adds the contribution of the strict lower triangle, i.e. the transposed strict upper triangle, to the result.
+// Must be run with a single work group: The rows are processed one after another, so the scatter of the entries of a row never conflicts with another row.
+template<typename StringT>
+void generate_symmetric_compressed_matrix_vec_mul_lower(StringT & source, std::string const & numeric_string)
+{
+  source.append("__kernel void vec_mul_lower( \n");
+  source.append("  __global const unsigned int * row_indices, \n");
+  source.append("  __global const unsigned int * column_indices, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * elements, \n");
+  source.append("  __global const "); source.append(numeric_string); source.append(" * x, \n");
+  source.append("  uint4 layout_x, \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * result, \n");
+  source.append("  uint4 layout_result) \n");
+  source.append("{ \n");
+  source.append("  for (unsigned int row = 0; row < layout_result.z; ++row) \n");
+  source.append("  { \n");
+  source.append("    "); source.append(numeric_string); source.append(" x_row = x[row * layout_x.y + layout_x.x]; \n");
+  source.append("    unsigned int row_stop = row_indices[row + 1]; \n");
+  source.append("    for (unsigned int i = row_indices[row] + get_local_id(0); i < row_stop; i += get_local_size(0)) \n");
+  source.append("    { \n");
+  source.append("      unsigned int col = column_indices[i]; \n");
+  source.append("      if (col != row) \n");
+  source.append("        result[col * layout_result.y + layout_result.x] += elements[i] * x_row; \n");
+  source.append("    } \n");
+  source.append("    barrier(CLK_GLOBAL_MEM_FENCE); \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+//////////////////////////// Part 2: Main kernel class ////////////////////////////////////
+
+// main kernel class
+/** @brief Main kernel class for generating OpenCL kernels for symmetric_compressed_matrix. */
+template<typename NumericT>
+struct symmetric_compressed_matrix
+{
+  static std::string program_name()
+  {
+    return viennacl::ocl::type_to_string<NumericT>::apply() + "_symmetric_compressed_matrix";
+  }
+
+  static void init(viennacl::ocl::context & ctx)
+  {
+    static std::map<cl_context, bool> init_done;
+    if (!init_done[ctx.handle().get()])
+    {
+      viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+      std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+      std::string source;
+      source.reserve(1024);
+
+      viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+      generate_symmetric_compressed_matrix_vec_mul(source, numeric_string);
+      generate_symmetric_compressed_matrix_vec_mul_lower(source, numeric_string);
+
+      std::string prog_name = program_name();
+      #ifdef VIENNACL_BUILD_INFO
+      std::cout << "Creating program " << prog_name << std::endl;
+      #endif
+      ctx.add_program(source, prog_name);
+      init_done[ctx.handle().get()] = true;
+    } //if
+  } //init
+};
+
+}  // namespace kernels
+}  // namespace opencl
+}  // namespace linalg
+}  // namespace viennacl
+#endif
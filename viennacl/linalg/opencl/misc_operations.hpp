@@ -61,6 +61,39 @@ void level_scheduling_substitute(vector<NumericT> & x,
 }
 
 } //namespace detail
+
+/** @brief Carries out one fixed-point sweep of the iterative incomplete LU factorization by Chow and Patel. All entries are updated from the previous iterate.
+*
+* @param L            Strict lower triangular factor (unit diagonal not stored) with sorted column indices
+* @param aij_L        The entries of the system matrix on the pattern of L
+* @param U_trans      Transpose of the upper triangular factor with sorted column indices. The diagonal entry is the last entry of each row.
+* @param aij_U_trans  The entries of the transposed system matrix on the pattern of U_trans
+*/
+template<typename NumericT>
+void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
+                          vector<NumericT>            const & aij_L,
+                          compressed_matrix<NumericT>       & U_trans,
+                          vector<NumericT>            const & aij_U_trans)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(L).context());
+
+  // previous iterate:
+  viennacl::backend::mem_handle L_backup;
+  viennacl::backend::memory_create(L_backup, sizeof(NumericT) * L.nnz(), viennacl::traits::context(L));
+  viennacl::backend::memory_copy(L.handle(), L_backup, 0, 0, sizeof(NumericT) * L.nnz());
+
+  viennacl::backend::mem_handle U_backup;
+  viennacl::backend::memory_create(U_backup, sizeof(NumericT) * U_trans.nnz(), viennacl::traits::context(U_trans));
+  viennacl::backend::memory_copy(U_trans.handle(), U_backup, 0, 0, sizeof(NumericT) * U_trans.nnz());
+
+  viennacl::linalg::opencl::kernels::ilu<NumericT>::init(ctx);
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::ilu<NumericT>::program_name(), "ilu_chow_patel_sweep");
+
+  viennacl::ocl::enqueue(k(L.handle1().opencl_handle(), L.handle2().opencl_handle(), L.handle().opencl_handle(), L_backup.opencl_handle(), aij_L,
+                           U_trans.handle1().opencl_handle(), U_trans.handle2().opencl_handle(), U_trans.handle().opencl_handle(), U_backup.opencl_handle(), aij_U_trans,
+                           static_cast<cl_uint>(L.size1())));
+}
+
 } // namespace opencl
 } //namespace linalg
 } //namespace viennacl
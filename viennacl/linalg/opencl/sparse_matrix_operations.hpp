@@ -35,6 +35,9 @@
 #include "viennacl/linalg/opencl/kernels/sliced_ell_matrix.hpp"
 #include "viennacl/linalg/opencl/kernels/hyb_matrix.hpp"
 #include "viennacl/linalg/opencl/kernels/compressed_compressed_matrix.hpp"
+#include "viennacl/linalg/opencl/kernels/bsr_matrix.hpp"
+#include "viennacl/linalg/opencl/kernels/compact_compressed_matrix.hpp"
+#include "viennacl/linalg/opencl/kernels/symmetric_compressed_matrix.hpp"
 #include "viennacl/linalg/opencl/common.hpp"
 
 namespace viennacl
@@ -126,6 +129,48 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & A,
 }
 
 
+/** @brief Carries out matrix-vector multiplication with a transposed compressed_matrix
+*
+* Implementation of the convenience expression y = prod(trans(A), x);
+* A single work group processes the rows one after another and scatters the entries of each row to y.
+*
+* @param proxy_A  The transposed matrix proxy
+* @param x        The vector
+* @param y        The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(matrix_expression< const compressed_matrix<NumericT, AlignmentV>,
+                                  const compressed_matrix<NumericT, AlignmentV>,
+                                  op_trans> const & proxy_A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT>       & y)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(proxy_A.lhs()).context());
+  viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "trans_vec_mul");
+
+  viennacl::ocl::packed_cl_uint layout_x;
+  layout_x.start  = cl_uint(viennacl::traits::start(x));
+  layout_x.stride = cl_uint(viennacl::traits::stride(x));
+  layout_x.size   = cl_uint(viennacl::traits::size(x));
+  layout_x.internal_size   = cl_uint(viennacl::traits::internal_size(x));
+
+  viennacl::ocl::packed_cl_uint layout_y;
+  layout_y.start  = cl_uint(viennacl::traits::start(y));
+  layout_y.stride = cl_uint(viennacl::traits::stride(y));
+  layout_y.size   = cl_uint(viennacl::traits::size(y));
+  layout_y.internal_size   = cl_uint(viennacl::traits::internal_size(y));
+
+  k.local_work_size(0, 128);
+  k.global_work_size(0, k.local_work_size());
+  viennacl::ocl::enqueue(k(proxy_A.lhs().handle1().opencl_handle(), proxy_A.lhs().handle2().opencl_handle(), proxy_A.lhs().handle().opencl_handle(),
+                           cl_uint(proxy_A.lhs().size1()),
+                           x, layout_x,
+                           y, layout_y
+                          ));
+}
+
+
 /** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
 *
 * Implementation of the convenience expression y = prod(sp_A, d_A);
@@ -192,6 +237,74 @@ void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & sp_A,
 }
 
 
+/** @brief Carries out the sparse matrix-matrix product C = A * B with compressed_matrix
+*
+* The number of nonzeros in each row of C is determined in a first pass, which allows for allocating C before its entries are computed in a second pass.
+* The column indices in each row of B are required to be sorted, as it is the case for all matrices set up by ViennaCL. The column indices of C are sorted.
+*
+* @param A     The left hand side factor
+* @param B     The right hand side factor
+* @param C     The result matrix. The sparsity pattern is replaced by the one of the product.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+  viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::init(ctx);
+
+  viennacl::backend::mem_handle B_row_positions;
+  viennacl::backend::mem_handle C_row_lengths;
+  viennacl::backend::memory_create(B_row_positions, sizeof(cl_uint) * std::max<vcl_size_t>(A.nnz(), 1), viennacl::traits::context(A));
+  viennacl::backend::memory_create(C_row_lengths,   sizeof(cl_uint) * (A.size1() + 1),                 viennacl::traits::context(A));
+
+  //
+  // Stage 1: Determine the number of nonzeros in each row of C and compute the row array
+  //
+  viennacl::ocl::kernel & k_lengths = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "spgemm_row_lengths");
+  viennacl::ocl::enqueue(k_lengths(A.handle1().opencl_handle(), A.handle2().opencl_handle(), cl_uint(A.size1()),
+                                   B.handle1().opencl_handle(), B.handle2().opencl_handle(),
+                                   B_row_positions.opencl_handle(),
+                                   C_row_lengths.opencl_handle()
+                                  )
+                        );
+
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(C_row_lengths, A.size1() + 1);
+  viennacl::backend::memory_read(C_row_lengths, 0, row_buffer.raw_size(), row_buffer.get());
+
+  vcl_size_t nnz = 0;
+  for (vcl_size_t i = 0; i < A.size1(); ++i)
+  {
+    vcl_size_t row_length = row_buffer[i];
+    row_buffer.set(i, nnz);
+    nnz += row_length;
+  }
+  row_buffer.set(A.size1(), nnz);
+
+  if (nnz == 0)
+  {
+    C.clear();
+    return;
+  }
+
+  viennacl::backend::memory_create(C.handle1(), row_buffer.raw_size(), viennacl::traits::context(A), row_buffer.get());
+  C.reserve(nnz, false);
+
+  //
+  // Stage 2: Compute the column indices and the entries of C
+  //
+  viennacl::ocl::kernel & k_entries = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<NumericT>::program_name(), "spgemm_entries");
+  viennacl::ocl::enqueue(k_entries(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(), cl_uint(A.size1()),
+                                   B.handle1().opencl_handle(), B.handle2().opencl_handle(), B.handle().opencl_handle(),
+                                   B_row_positions.opencl_handle(),
+                                   C.handle1().opencl_handle(), C.handle2().opencl_handle(), C.handle().opencl_handle()
+                                  )
+                        );
+
+  C.generate_row_block_information();
+}
+
 
 // triangular solvers
 
@@ -980,6 +1093,257 @@ void prod_impl(viennacl::hyb_matrix<NumericT, AlignmentV> const & A,
 }
 
 
+
+//
+// Block compressed sparse row (BSR) matrix
+//
+
+namespace detail
+{
+  template<typename NumericT, unsigned int BlockSize>
+  void row_info(bsr_matrix<NumericT, BlockSize> const & A,
+                vector_base<NumericT> & x,
+                viennacl::linalg::detail::row_info_types info_selector)
+  {
+    viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+    viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::init(ctx);
+    viennacl::ocl::kernel & row_info_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::program_name(), "row_info_extractor");
+
+    viennacl::ocl::packed_cl_uint layout_x;
+    layout_x.start  = cl_uint(viennacl::traits::start(x));
+    layout_x.stride = cl_uint(viennacl::traits::stride(x));
+    layout_x.size   = cl_uint(viennacl::traits::size(x));
+    layout_x.internal_size   = cl_uint(viennacl::traits::internal_size(x));
+
+    viennacl::ocl::enqueue(row_info_kernel(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(),
+                                           viennacl::traits::opencl_handle(x),
+                                           layout_x,
+                                           cl_uint(A.size1()),
+                                           cl_uint(info_selector)
+                                          )
+                          );
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a bsr_matrix
+*
+* Implementation of the convenience expression y = prod(A, x);
+* Each work item processes one block row.
+*
+* @param A    The matrix
+* @param x    The vector
+* @param y    The result vector
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(viennacl::bsr_matrix<NumericT, BlockSize> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT>       & y)
+{
+  assert(A.size1() == y.size());
+  assert(A.size2() == x.size());
+
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+  viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::init(ctx);
+
+  viennacl::ocl::packed_cl_uint layout_x;
+  layout_x.start  = cl_uint(viennacl::traits::start(x));
+  layout_x.stride = cl_uint(viennacl::traits::stride(x));
+  layout_x.size   = cl_uint(viennacl::traits::size(x));
+  layout_x.internal_size   = cl_uint(viennacl::traits::internal_size(x));
+
+  viennacl::ocl::packed_cl_uint layout_y;
+  layout_y.start  = cl_uint(viennacl::traits::start(y));
+  layout_y.stride = cl_uint(viennacl::traits::stride(y));
+  layout_y.size   = cl_uint(viennacl::traits::size(y));
+  layout_y.internal_size   = cl_uint(viennacl::traits::internal_size(y));
+
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::program_name(), "vec_mul");
+
+  viennacl::ocl::enqueue(k(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(),
+                           viennacl::traits::opencl_handle(x),
+                           layout_x,
+                           viennacl::traits::opencl_handle(y),
+                           layout_y,
+                           cl_uint(A.block_rows())
+                          )
+                        );
+}
+
+/** @brief Carries out Sparse Matrix(BSR)-Dense Matrix multiplication
+*
+* Implementation of the convenience expression y = prod(sp_A, d_A);
+* sp_mat being in BSR format
+*
+* @param sp_A     The sparse matrix (BSR)
+* @param d_A      The dense matrix
+* @param y        The y matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(viennacl::bsr_matrix<NumericT, BlockSize> const & sp_A,
+               viennacl::matrix_base<NumericT> const & d_A,
+               viennacl::matrix_base<NumericT>       & y)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(sp_A).context());
+  viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::init(ctx);
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::program_name(),
+                                             detail::sparse_dense_matmult_kernel_name(false, d_A.row_major(), y.row_major()));
+
+  viennacl::ocl::enqueue(k(sp_A.handle1().opencl_handle(), sp_A.handle2().opencl_handle(), sp_A.handle().opencl_handle(),
+                           cl_uint(sp_A.size1()),
+                           viennacl::traits::opencl_handle(d_A),
+                           cl_uint(viennacl::traits::start1(d_A)),          cl_uint(viennacl::traits::start2(d_A)),
+                           cl_uint(viennacl::traits::stride1(d_A)),         cl_uint(viennacl::traits::stride2(d_A)),
+                           cl_uint(viennacl::traits::size1(d_A)),           cl_uint(viennacl::traits::size2(d_A)),
+                           cl_uint(viennacl::traits::internal_size1(d_A)),  cl_uint(viennacl::traits::internal_size2(d_A)),
+                           viennacl::traits::opencl_handle(y),
+                           cl_uint(viennacl::traits::start1(y)),         cl_uint(viennacl::traits::start2(y)),
+                           cl_uint(viennacl::traits::stride1(y)),        cl_uint(viennacl::traits::stride2(y)),
+                           cl_uint(viennacl::traits::size1(y)),          cl_uint(viennacl::traits::size2(y)),
+                           cl_uint(viennacl::traits::internal_size1(y)), cl_uint(viennacl::traits::internal_size2(y))
+                          )
+                        );
+}
+
+/** @brief Carries out Sparse Matrix(BSR)-Dense Transposed Matrix multiplication
+*
+* Implementation of the convenience expression y = prod(sp_A, trans(d_A));
+* sp_mat being in BSR format
+*
+* @param sp_A     The sparse matrix (BSR)
+* @param d_A      The dense transposed matrix
+* @param y        The y matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(viennacl::bsr_matrix<NumericT, BlockSize> const & sp_A,
+               viennacl::matrix_expression< const viennacl::matrix_base<NumericT>,
+                                            const viennacl::matrix_base<NumericT>,
+                                            viennacl::op_trans > const & d_A,
+               viennacl::matrix_base<NumericT> & y)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(sp_A).context());
+  viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::init(ctx);
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::bsr_matrix<NumericT, BlockSize>::program_name(),
+                                             detail::sparse_dense_matmult_kernel_name(true, d_A.lhs().row_major(), y.row_major()));
+
+  viennacl::ocl::enqueue(k(sp_A.handle1().opencl_handle(), sp_A.handle2().opencl_handle(), sp_A.handle().opencl_handle(),
+                           cl_uint(sp_A.size1()),
+                           viennacl::traits::opencl_handle(d_A.lhs()),
+                           cl_uint(viennacl::traits::start1(d_A.lhs())),          cl_uint(viennacl::traits::start2(d_A.lhs())),
+                           cl_uint(viennacl::traits::stride1(d_A.lhs())),         cl_uint(viennacl::traits::stride2(d_A.lhs())),
+                           cl_uint(viennacl::traits::size1(d_A.lhs())),           cl_uint(viennacl::traits::size2(d_A.lhs())),
+                           cl_uint(viennacl::traits::internal_size1(d_A.lhs())),  cl_uint(viennacl::traits::internal_size2(d_A.lhs())),
+                           viennacl::traits::opencl_handle(y),
+                           cl_uint(viennacl::traits::start1(y)),         cl_uint(viennacl::traits::start2(y)),
+                           cl_uint(viennacl::traits::stride1(y)),        cl_uint(viennacl::traits::stride2(y)),
+                           cl_uint(viennacl::traits::size1(y)),          cl_uint(viennacl::traits::size2(y)),
+                           cl_uint(viennacl::traits::internal_size1(y)), cl_uint(viennacl::traits::internal_size2(y))
+                          )
+                        );
+}
+
+
+
+//
+// Compact compressed matrix
+//
+
+/** @brief Carries out matrix-vector multiplication with a compact_compressed_matrix
+*
+* Implementation of the convenience expression y = prod(A, x);
+* Each work item processes one row. The values are converted to the precision of the vectors before multiplication.
+*
+* @param A    The matrix
+* @param x    The vector
+* @param y    The result vector
+*/
+template<typename NumericT, typename ValueT, typename IndexT>
+void prod_impl(viennacl::compact_compressed_matrix<NumericT, ValueT, IndexT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT>       & y)
+{
+  assert(A.size1() == y.size());
+  assert(A.size2() == x.size());
+
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+  viennacl::linalg::opencl::kernels::compact_compressed_matrix<NumericT, ValueT, IndexT>::init(ctx);
+
+  viennacl::ocl::packed_cl_uint layout_x;
+  layout_x.start  = cl_uint(viennacl::traits::start(x));
+  layout_x.stride = cl_uint(viennacl::traits::stride(x));
+  layout_x.size   = cl_uint(viennacl::traits::size(x));
+  layout_x.internal_size   = cl_uint(viennacl::traits::internal_size(x));
+
+  viennacl::ocl::packed_cl_uint layout_y;
+  layout_y.start  = cl_uint(viennacl::traits::start(y));
+  layout_y.stride = cl_uint(viennacl::traits::stride(y));
+  layout_y.size   = cl_uint(viennacl::traits::size(y));
+  layout_y.internal_size   = cl_uint(viennacl::traits::internal_size(y));
+
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compact_compressed_matrix<NumericT, ValueT, IndexT>::program_name(), "vec_mul");
+
+  viennacl::ocl::enqueue(k(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle3().opencl_handle(), A.handle().opencl_handle(),
+                           viennacl::traits::opencl_handle(x),
+                           layout_x,
+                           viennacl::traits::opencl_handle(y),
+                           layout_y
+                          )
+                        );
+}
+
+
+//
+// Symmetric compressed matrix
+//
+
+/** @brief Carries out matrix-vector multiplication with a symmetric_compressed_matrix
+*
+* Implementation of the convenience expression y = prod(A, x);
+* The first kernel computes the products of the stored upper triangle with one work item per row.
+* The second kernel adds the contributions of the strict upper triangle transposed using a single work group processing the rows one after another.
+*
+* @param A    The matrix
+* @param x    The vector
+* @param y    The result vector
+*/
+template<typename NumericT>
+void prod_impl(viennacl::symmetric_compressed_matrix<NumericT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT>       & y)
+{
+  assert(A.size1() == y.size());
+  assert(A.size2() == x.size());
+
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+  viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<NumericT>::init(ctx);
+
+  viennacl::ocl::packed_cl_uint layout_x;
+  layout_x.start  = cl_uint(viennacl::traits::start(x));
+  layout_x.stride = cl_uint(viennacl::traits::stride(x));
+  layout_x.size   = cl_uint(viennacl::traits::size(x));
+  layout_x.internal_size   = cl_uint(viennacl::traits::internal_size(x));
+
+  viennacl::ocl::packed_cl_uint layout_y;
+  layout_y.start  = cl_uint(viennacl::traits::start(y));
+  layout_y.stride = cl_uint(viennacl::traits::stride(y));
+  layout_y.size   = cl_uint(viennacl::traits::size(y));
+  layout_y.internal_size   = cl_uint(viennacl::traits::internal_size(y));
+
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<NumericT>::program_name(), "vec_mul");
+  viennacl::ocl::enqueue(k(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(),
+                           x, layout_x,
+                           y, layout_y
+                          ));
+
+  viennacl::ocl::kernel & k_trans = ctx.get_kernel(viennacl::linalg::opencl::kernels::symmetric_compressed_matrix<NumericT>::program_name(), "vec_mul_lower");
+  k_trans.local_work_size(0, 128);
+  k_trans.global_work_size(0, k_trans.local_work_size());
+  viennacl::ocl::enqueue(k_trans(A.handle1().opencl_handle(), A.handle2().opencl_handle(), A.handle().opencl_handle(),
+                                 x, layout_x,
+                                 y, layout_y
+                                ));
+}
+
+
 } // namespace opencl
 } //namespace linalg
 } //namespace viennacl
@@ -62,33 +62,25 @@ namespace viennacl
     };
 
    /**
-    *   @brief Implementation of the calculation of eigenvalues using poweriteration
+    *   @brief Implementation of the calculation of eigenvalues using poweriteration with a user-supplied start vector
+    *
+    *   The start vector also determines where the computation takes place, e.g. for a matrix in a memory domain other than the default one.
     *
     *   @param matrix        The system matrix
     *   @param tag           Tag with termination factor
+    *   @param r             Start vector (must not be zero). Holds the last iterate on return.
     *   @return              Returns the largest eigenvalue computed by the power iteration method
     */
-    template< typename MatrixT >
+    template<typename MatrixT, typename VectorT>
     typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type
-    eig(MatrixT const& matrix, power_iter_tag const & tag)
+    eig(MatrixT const& matrix, power_iter_tag const & tag, VectorT & r)
     {
 
       typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
       typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
-      typedef typename viennacl::result_of::vector_for_matrix<MatrixT>::type    VectorT;
 
       CPU_ScalarType eigenvalue;
-      vcl_size_t matrix_size = matrix.size1();
-      VectorT r(matrix_size);
-      VectorT r2(matrix_size);
-      std::vector<CPU_ScalarType> s(matrix_size);
-
-      for (vcl_size_t i=0; i<s.size(); ++i)
-        s[i] = CPU_ScalarType(i % 3) * CPU_ScalarType(0.1234) - CPU_ScalarType(0.5);   //'random' starting vector
-
-      detail::copy_vec_to_vec(s,r);
-
-      //std::cout << s << std::endl;
+      VectorT r2(r);
 
       double epsilon = tag.factor();
       CPU_ScalarType norm = norm_2(r);
@@ -112,6 +104,36 @@ namespace viennacl
       return eigenvalue;
     }
 
+   /**
+    *   @brief Implementation of the calculation of eigenvalues using poweriteration
+    *
+    *   @param matrix        The system matrix
+    *   @param tag           Tag with termination factor
+    *   @return              Returns the largest eigenvalue computed by the power iteration method
+    */
+    template< typename MatrixT >
+    typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type
+    eig(MatrixT const& matrix, power_iter_tag const & tag)
+    {
+
+      typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
+      typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
+      typedef typename viennacl::result_of::vector_for_matrix<MatrixT>::type    VectorT;
+
+      vcl_size_t matrix_size = matrix.size1();
+      VectorT r(matrix_size);
+      std::vector<CPU_ScalarType> s(matrix_size);
+
+      for (vcl_size_t i=0; i<s.size(); ++i)
+        s[i] = CPU_ScalarType(i % 3) * CPU_ScalarType(0.1234) - CPU_ScalarType(0.5);   //'random' starting vector
+
+      detail::copy_vec_to_vec(s,r);
+
+      //std::cout << s << std::endl;
+
+      return eig(matrix, tag, r);
+    }
+
 
   } // end namespace linalg
 } // end namespace viennacl
@@ -266,6 +266,21 @@ namespace viennacl
                                op_prod >(mat, vec);
     }
 
+    // transposed sparse matrix-vector product
+    template<typename SparseMatrixType, class SCALARTYPE>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value,
+                                  vector_expression<const matrix_expression<const SparseMatrixType, const SparseMatrixType, op_trans>,
+                                                    const vector_base<SCALARTYPE>,
+                                                    op_prod >
+                                 >::type
+    prod(const matrix_expression<const SparseMatrixType, const SparseMatrixType, op_trans> & mat,
+         const vector_base<SCALARTYPE> & vec)
+    {
+      return vector_expression<const matrix_expression<const SparseMatrixType, const SparseMatrixType, op_trans>,
+                               const vector_base<SCALARTYPE>,
+                               op_prod >(mat, vec);
+    }
+
     template< typename SparseMatrixType, typename SCALARTYPE>
     typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value,
                                   viennacl::matrix_expression<const SparseMatrixType,
@@ -301,6 +316,19 @@ namespace viennacl
                                           viennacl::op_prod >(A, B);
     }
 
+    // sparse matrix-matrix product
+    template<typename NumericT, unsigned int AlignmentV>
+    viennacl::matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
+                                const compressed_matrix<NumericT, AlignmentV>,
+                                op_prod >
+    prod(compressed_matrix<NumericT, AlignmentV> const & A,
+         compressed_matrix<NumericT, AlignmentV> const & B)
+    {
+      return viennacl::matrix_expression<const compressed_matrix<NumericT, AlignmentV>,
+                                         const compressed_matrix<NumericT, AlignmentV>,
+                                         op_prod >(A, B);
+    }
+
     template<typename StructuredMatrixType, class SCALARTYPE>
     typename viennacl::enable_if< viennacl::is_any_dense_structured_matrix<StructuredMatrixType>::value,
                                   vector_expression<const StructuredMatrixType,
@@ -42,6 +42,10 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/range.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -554,6 +558,221 @@ namespace viennacl
 
 
 
+
+      /** @brief Copies a panel of a ViennaCL matrix to a column-major buffer on the host.
+      *
+      * The panel is first assigned to a contiguous temporary on the device, so that a single transfer suffices for all backends.
+      */
+      template<typename NumericT, typename F, unsigned int AlignmentV>
+      void qr_read_panel(viennacl::matrix_range<viennacl::matrix<NumericT, F, AlignmentV> > const & A_panel,
+                         viennacl::matrix<NumericT, F, AlignmentV> & temp,
+                         std::vector<NumericT> & panel)
+      {
+        temp = A_panel;
+
+        std::vector<NumericT> buffer(temp.internal_size());
+        viennacl::backend::memory_read(temp.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+
+        panel.resize(temp.size1() * temp.size2());
+        for (vcl_size_t j = 0; j < temp.size2(); ++j)
+          for (vcl_size_t i = 0; i < temp.size1(); ++i)
+            panel[i + j * temp.size1()] = buffer[F::mem_index(i, j, temp.internal_size1(), temp.internal_size2())];
+      }
+
+      /** @brief Copies a column-major buffer on the host to a ViennaCL matrix of the same size. */
+      template<typename NumericT, typename F, unsigned int AlignmentV>
+      void qr_write_panel(std::vector<NumericT> const & panel, viennacl::matrix<NumericT, F, AlignmentV> & dest)
+      {
+        std::vector<NumericT> buffer(dest.internal_size());
+        for (vcl_size_t j = 0; j < dest.size2(); ++j)
+          for (vcl_size_t i = 0; i < dest.size1(); ++i)
+            buffer[F::mem_index(i, j, dest.internal_size1(), dest.internal_size2())] = panel[i + j * dest.size1()];
+
+        viennacl::backend::memory_write(dest.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+      }
+
+      /** @brief Unblocked Householder QR of a column-major panel with 'rows' rows and 'cols' columns on the host.
+      *
+      * The reflectors (I - beta_k v_k v_k^T) are normalized to v_k[k] = 1 and stored below the diagonal, exactly as in the column-by-column implementations above.
+      */
+      template<typename NumericT>
+      void qr_factor_panel(std::vector<NumericT> & panel, vcl_size_t rows, vcl_size_t cols, NumericT * betas)
+      {
+        for (vcl_size_t k = 0; k < std::min(rows, cols); ++k)
+        {
+          NumericT * v = &(panel[k * rows]);
+
+          NumericT sigma = 0;
+          for (vcl_size_t i = k+1; i < rows; ++i)
+            sigma += v[i] * v[i];
+
+          if (sigma <= 0)
+          {
+            betas[k] = 0;
+            continue;
+          }
+
+          NumericT A_kk = v[k];
+          NumericT mu = std::sqrt(sigma + A_kk * A_kk);
+          NumericT v1 = (A_kk <= 0) ? (A_kk - mu) : (-sigma / (A_kk + mu));
+          NumericT beta = static_cast<NumericT>(2) * v1 * v1 / (sigma + v1 * v1);
+
+          for (vcl_size_t i = k+1; i < rows; ++i)
+            v[i] /= v1;
+          v[k] = mu;
+          betas[k] = beta;
+
+          // apply reflector to the remaining columns of the panel:
+          for (vcl_size_t l = k+1; l < cols; ++l)
+          {
+            NumericT * a = &(panel[l * rows]);
+            NumericT v_in_col = a[k];
+            for (vcl_size_t i = k+1; i < rows; ++i)
+              v_in_col += v[i] * a[i];
+
+            v_in_col *= beta;
+            a[k] -= v_in_col;
+            for (vcl_size_t i = k+1; i < rows; ++i)
+              a[i] -= v_in_col * v[i];
+          }
+        }
+      }
+
+      /** @brief Sets up the compact WY representation H_0 H_1 ... H_{k-1} = I - V T V^T of the reflectors stored in a factored panel.
+      *
+      * @param panel   Column-major panel as returned by qr_factor_panel()
+      * @param rows    Number of rows of the panel
+      * @param cols    Number of reflectors in the panel
+      * @param betas   The scalars beta_k of the reflectors
+      * @param V       Column-major buffer of size rows x cols receiving the unit lower trapezoidal matrix of reflectors
+      * @param T       Column-major buffer of size cols x cols receiving the upper triangular factor
+      */
+      template<typename NumericT>
+      void qr_setup_compact_wy(std::vector<NumericT> const & panel, vcl_size_t rows, vcl_size_t cols, NumericT const * betas,
+                               std::vector<NumericT> & V, std::vector<NumericT> & T)
+      {
+        V.assign(rows * cols, NumericT(0));
+        T.assign(cols * cols, NumericT(0));
+
+        for (vcl_size_t k = 0; k < cols; ++k)
+        {
+          V[k + k * rows] = NumericT(1);
+          for (vcl_size_t i = k+1; i < rows; ++i)
+            V[i + k * rows] = panel[i + k * rows];
+        }
+
+        // T(0:k, k) = -beta_k * T(0:k, 0:k) * V(:, 0:k)^T v_k
+        std::vector<NumericT> z(cols);
+        for (vcl_size_t k = 0; k < cols; ++k)
+        {
+          NumericT const * v_k = &(V[k * rows]);
+          for (vcl_size_t l = 0; l < k; ++l)
+          {
+            NumericT const * v_l = &(V[l * rows]);
+            NumericT temp = 0;
+            for (vcl_size_t i = k; i < rows; ++i)
+              temp += v_l[i] * v_k[i];
+            z[l] = temp;
+          }
+
+          for (vcl_size_t l = 0; l < k; ++l)
+          {
+            NumericT temp = 0;
+            for (vcl_size_t r = l; r < k; ++r)
+              temp += T[l + r * cols] * z[r];
+            T[l + k * cols] = -betas[k] * temp;
+          }
+          T[k + k * cols] = betas[k];
+        }
+      }
+
+      /** @brief Computes V and T of the compact WY representation for the reflectors stored in A(j:end, j:j+cols) and transfers them to the device of A. */
+      template<typename NumericT, typename F, unsigned int AlignmentV, typename VectorType>
+      void qr_compact_wy_from_A(viennacl::matrix<NumericT, F, AlignmentV> const & A, VectorType const & betas, vcl_size_t j, vcl_size_t cols,
+                                viennacl::matrix<NumericT, F, AlignmentV> & vclV, viennacl::matrix<NumericT, F, AlignmentV> & vclT)
+      {
+        vcl_size_t rows = A.size1() - j;
+
+        std::vector<NumericT> panel;
+        viennacl::matrix_range<viennacl::matrix<NumericT, F, AlignmentV> > A_panel(A, viennacl::range(j, A.size1()), viennacl::range(j, j + cols));
+        qr_read_panel(A_panel, vclV, panel);
+
+        std::vector<NumericT> panel_betas(cols);
+        for (vcl_size_t k = 0; k < cols; ++k)
+          panel_betas[k] = betas[j + k];
+
+        std::vector<NumericT> V, T;
+        qr_setup_compact_wy(panel, rows, cols, &(panel_betas[0]), V, T);
+
+        qr_write_panel(V, vclV);
+        vclT.resize(cols, cols, false);
+        qr_write_panel(T, vclT);
+      }
+
+
+      /** @brief Implementation of a blocked QR factorization using the compact WY representation (I - V T V^T) of the reflectors in each panel.
+      *
+      * Each panel is factored on the host, while the update of the trailing matrix is carried out by three matrix-matrix products on the device of A.
+      * Prefer the use of the convenience interface inplace_qr()
+      *
+      * @param A            A dense ViennaCL matrix to be factored
+      * @param block_size   The number of columns per panel
+      */
+      template<typename NumericT, typename F, unsigned int AlignmentV>
+      std::vector<NumericT> inplace_qr_compact_wy(viennacl::matrix<NumericT, F, AlignmentV> & A, vcl_size_t block_size = 32)
+      {
+        typedef viennacl::matrix<NumericT, F, AlignmentV>   MatrixType;
+        typedef viennacl::matrix_range<MatrixType>          MatrixRange;
+
+        std::vector<NumericT> betas(A.size2());
+        vcl_size_t min_size = std::min(A.size1(), A.size2());
+        if (min_size == 0)
+          return betas;
+
+        block_size = std::max<vcl_size_t>(block_size, 1);
+
+        viennacl::context ctx = viennacl::traits::context(A);
+        MatrixType vclP(0, 0, ctx);
+        MatrixType vclT(0, 0, ctx);
+        MatrixType VT_A(0, 0, ctx);
+        MatrixType T_VT_A(0, 0, ctx);
+
+        std::vector<NumericT> panel, V, T;
+
+        for (vcl_size_t j = 0; j < min_size; j += block_size)
+        {
+          vcl_size_t rows = A.size1() - j;
+          vcl_size_t cols = std::min(min_size, j + block_size) - j;
+
+          // factor panel on the host:
+          MatrixRange A_panel(A, viennacl::range(j, A.size1()), viennacl::range(j, j + cols));
+          vclP.resize(rows, cols, false);
+          qr_read_panel(A_panel, vclP, panel);
+          qr_factor_panel(panel, rows, cols, &(betas[j]));
+          qr_write_panel(panel, vclP);
+          A_panel = vclP;
+
+          if (A.size2() <= j + cols)
+            continue;
+
+          // apply Q^T = I - V T^T V^T to the trailing matrix:
+          qr_setup_compact_wy(panel, rows, cols, &(betas[j]), V, T);
+          qr_write_panel(V, vclP);
+          vclT.resize(cols, cols, false);
+          qr_write_panel(T, vclT);
+
+          MatrixRange A_trailing(A, viennacl::range(j, A.size1()), viennacl::range(j + cols, A.size2()));
+          VT_A.resize(cols, A_trailing.size2(), false);
+          T_VT_A.resize(cols, A_trailing.size2(), false);
+
+          VT_A   = viennacl::linalg::prod(trans(vclP), A_trailing);
+          T_VT_A = viennacl::linalg::prod(trans(vclT), VT_A);
+          A_trailing -= viennacl::linalg::prod(vclP, T_VT_A);
+        }
+
+        return betas;
+      }
+
     } //namespace detail
 
 
@@ -624,29 +843,97 @@ namespace viennacl
       }
     }
 
+    /** @brief Computes Q^T b for a ViennaCL matrix A factored by inplace_qr(). The reflectors are applied block-wise in compact WY form on the device of A.
+     *
+     *  @param A            A matrix holding the Householder reflectors in the lower triangular part.
+     *  @param betas        The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param b            The vector b to which the result Q^T b is directly written to
+     *  @param block_size   The number of reflectors applied at once
+     */
     template<typename T, typename F, unsigned int ALIGNMENT, typename VectorType1, unsigned int A2>
-    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b)
+    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b, vcl_size_t block_size = 32)
+    {
+      typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+      vcl_size_t min_size = std::min(A.size1(), A.size2());
+      block_size = std::max<vcl_size_t>(block_size, 1);
+
+      viennacl::context ctx = viennacl::traits::context(A);
+      MatrixType vclV(0, 0, ctx);
+      MatrixType vclT(0, 0, ctx);
+      viennacl::vector<T> VT_b(block_size, ctx);
+      viennacl::vector<T> T_VT_b(block_size, ctx);
+
+      for (vcl_size_t j = 0; j < min_size; j += block_size)
+      {
+        vcl_size_t cols = std::min(min_size, j + block_size) - j;
+
+        vclV.resize(A.size1() - j, cols, false);
+        detail::qr_compact_wy_from_A(A, betas, j, cols, vclV, vclT);
+
+        // b(j:end) -= V T^T V^T b(j:end)
+        viennacl::vector_range<viennacl::vector<T, A2> > b_part(b, viennacl::range(j, A.size1()));
+        VT_b.resize(cols, false);
+        T_VT_b.resize(cols, false);
+
+        VT_b   = viennacl::linalg::prod(trans(vclV), b_part);
+        T_VT_b = viennacl::linalg::prod(trans(vclT), VT_b);
+        b_part -= viennacl::linalg::prod(vclV, T_VT_b);
+      }
+    }
+
+    /** @brief Computes Q^T B for a ViennaCL matrix A factored by inplace_qr(), where B holds multiple right hand sides. The reflectors are applied block-wise in compact WY form.
+     *
+     *  @param A            A matrix holding the Householder reflectors in the lower triangular part.
+     *  @param betas        The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param B            The matrix B to which the result Q^T B is directly written to
+     *  @param block_size   The number of reflectors applied at once
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT, typename VectorType1>
+    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::matrix<T, F, ALIGNMENT> & B, vcl_size_t block_size = 32)
     {
-      boost::numeric::ublas::matrix<T> ublas_A(A.size1(), A.size2());
-      viennacl::copy(A, ublas_A);
+      typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+      assert(A.size1() == B.size1() && bool("Size mismatch of A and B in inplace_qr_apply_trans_Q()"));
+
+      vcl_size_t min_size = std::min(A.size1(), A.size2());
+      block_size = std::max<vcl_size_t>(block_size, 1);
 
-      std::vector<T> stl_b(b.size());
-      viennacl::copy(b, stl_b);
+      viennacl::context ctx = viennacl::traits::context(A);
+      MatrixType vclV(0, 0, ctx);
+      MatrixType vclT(0, 0, ctx);
+      MatrixType VT_B(0, 0, ctx);
+      MatrixType T_VT_B(0, 0, ctx);
 
-      inplace_qr_apply_trans_Q(ublas_A, betas, stl_b);
+      for (vcl_size_t j = 0; j < min_size; j += block_size)
+      {
+        vcl_size_t cols = std::min(min_size, j + block_size) - j;
+
+        vclV.resize(A.size1() - j, cols, false);
+        detail::qr_compact_wy_from_A(A, betas, j, cols, vclV, vclT);
 
-      viennacl::copy(stl_b, b);
+        // B(j:end, :) -= V T^T V^T B(j:end, :)
+        viennacl::matrix_range<MatrixType> B_part(B, viennacl::range(j, B.size1()), viennacl::range(0, B.size2()));
+        VT_B.resize(cols, B.size2(), false);
+        T_VT_B.resize(cols, B.size2(), false);
+
+        VT_B   = viennacl::linalg::prod(trans(vclV), B_part);
+        T_VT_B = viennacl::linalg::prod(trans(vclT), VT_B);
+        B_part -= viennacl::linalg::prod(vclV, T_VT_B);
+      }
     }
 
     /** @brief Overload of inplace-QR factorization of a ViennaCL matrix A
+     *
+     * Panels of 'block_size' columns are factored on the host, the trailing matrix is updated with the compact WY representation via matrix-matrix products.
      *
      * @param A            A dense ViennaCL matrix to be factored
      * @param block_size   The block size to be used.
      */
     template<typename T, typename F, unsigned int ALIGNMENT>
-    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size = 16)
+    std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size = 32)
     {
-      return detail::inplace_qr_hybrid(A, block_size);
+      return detail::inplace_qr_compact_wy(A, block_size);
     }
 
     /** @brief Overload of inplace-QR factorization for a general Boost.uBLAS compatible matrix A
@@ -661,6 +948,420 @@ namespace viennacl
     }
 
 
+    //
+    // Tall-skinny QR (TSQR)
+    //
+
+    /** @brief Implicit representation of the orthogonal factor Q of a tall-skinny QR factorization computed by inplace_tsqr().
+    *
+    * The reflectors of each row block are stored in the strictly lower triangular part of the respective block of the factored matrix.
+    * The reflectors combining the triangular factors of two blocks along the binary reduction tree are stored in the nodes.
+    */
+    template<typename NumericT>
+    struct tsqr_factors
+    {
+      /** @brief A node of the reduction tree, combining the triangular factors of the row blocks 'upper' and 'lower'. */
+      struct tree_node
+      {
+        tree_node(vcl_size_t upper_block, vcl_size_t lower_block) : upper(upper_block), lower(lower_block) {}
+
+        vcl_size_t upper;
+        vcl_size_t lower;
+        std::vector<NumericT> reflectors;  // column-major, (2*cols) x cols
+        std::vector<NumericT> betas;
+      };
+
+      tsqr_factors() : rows(0), cols(0) {}
+
+      vcl_size_t num_blocks() const { return block_starts.size() - 1; }
+
+      vcl_size_t rows;
+      vcl_size_t cols;
+      std::vector<vcl_size_t> block_starts;   // first row of each block, with the number of rows as the last entry
+      std::vector<NumericT>   block_betas;    // 'cols' betas per block
+      std::vector<tree_node>  nodes;          // nodes of the reduction tree, ordered by level
+      std::vector<vcl_size_t> level_starts;   // index of the first node of each level, with the number of nodes as the last entry
+    };
+
+    namespace detail
+    {
+      /** @brief Access to the entries of a matrix_base or vector_base residing in a host buffer, irrespective of the memory layout. Vectors are treated as a single column. */
+      template<typename NumericT>
+      class tsqr_host_accessor
+      {
+      public:
+        tsqr_host_accessor(NumericT * data, matrix_base<NumericT> const & A)
+          : data_(data), start1_(A.start1()), start2_(A.start2()), inc1_(A.stride1()), inc2_(A.stride2()),
+            internal_size1_(A.internal_size1()), internal_size2_(A.internal_size2()), row_major_(A.row_major()) {}
+
+        tsqr_host_accessor(NumericT * data, vector_base<NumericT> const & v)
+          : data_(data), start1_(v.start()), start2_(0), inc1_(v.stride()), inc2_(0),
+            internal_size1_(v.internal_size()), internal_size2_(1), row_major_(true) {}
+
+        NumericT & operator()(vcl_size_t i, vcl_size_t j) const
+        {
+          return row_major_ ? data_[(start1_ + i * inc1_) * internal_size2_ + start2_ + j * inc2_]
+                            : data_[ start1_ + i * inc1_ + (start2_ + j * inc2_) * internal_size1_];
+        }
+
+      private:
+        NumericT * data_;
+        vcl_size_t start1_;
+        vcl_size_t start2_;
+        vcl_size_t inc1_;
+        vcl_size_t inc2_;
+        vcl_size_t internal_size1_;
+        vcl_size_t internal_size2_;
+        bool row_major_;
+      };
+
+      /** @brief Provides the content of a memory handle in host memory. Handles outside of main memory are copied to a temporary, which is written back by sync(). */
+      template<typename NumericT>
+      class tsqr_host_buffer
+      {
+      public:
+        explicit tsqr_host_buffer(viennacl::backend::mem_handle & handle) : handle_(handle), data_(NULL)
+        {
+          if (handle.get_active_handle_id() == viennacl::MAIN_MEMORY)
+            data_ = reinterpret_cast<NumericT *>(handle.ram_handle().get());
+          else if (handle.raw_size() > 0)
+          {
+            temp_.resize(handle.raw_size() / sizeof(NumericT));
+            viennacl::backend::memory_read(handle, 0, handle.raw_size(), &(temp_[0]));
+            data_ = &(temp_[0]);
+          }
+        }
+
+        NumericT * get() { return data_; }
+
+        void sync()
+        {
+          if (temp_.size() > 0)
+            viennacl::backend::memory_write(handle_, 0, handle_.raw_size(), &(temp_[0]));
+        }
+
+      private:
+        viennacl::backend::mem_handle & handle_;
+        NumericT * data_;
+        std::vector<NumericT> temp_;
+      };
+
+      /** @brief Applies the reflectors (I - beta_k v_k v_k^T) stored in the strictly lower part of the column-major matrix V (with implicit unit diagonal) to x.
+      *
+      * If 'transposed' is true, the reflectors are applied in the order k = 0, 1, ..., thus computing Q^T x. Otherwise, Q x is computed.
+      */
+      template<typename NumericT>
+      void tsqr_apply_reflectors(NumericT const * V, vcl_size_t rows, vcl_size_t num_reflectors, NumericT const * betas, NumericT * x, bool transposed)
+      {
+        for (vcl_size_t l = 0; l < num_reflectors; ++l)
+        {
+          vcl_size_t k = transposed ? l : num_reflectors - l - 1;
+          NumericT beta = betas[k];
+          if (!(beta > 0 || beta < 0))
+            continue;
+
+          NumericT const * v = V + k * rows;
+          NumericT v_in_x = x[k];
+          for (vcl_size_t i = k+1; i < rows; ++i)
+            v_in_x += v[i] * x[i];
+
+          v_in_x *= beta;
+          x[k] -= v_in_x;
+          for (vcl_size_t i = k+1; i < rows; ++i)
+            x[i] -= v_in_x * v[i];
+        }
+      }
+
+      /** @brief Applies the reflectors of the row block 'block' stored in A to all columns of B */
+      template<typename NumericT>
+      void tsqr_apply_block(tsqr_host_accessor<NumericT> const & A, tsqr_factors<NumericT> const & factors, vcl_size_t block,
+                            tsqr_host_accessor<NumericT> const & B, vcl_size_t B_cols, bool transposed)
+      {
+        vcl_size_t row_start = factors.block_starts[block];
+        vcl_size_t rows = factors.block_starts[block + 1] - row_start;
+        vcl_size_t num_reflectors = std::min(rows, factors.cols);
+
+        std::vector<NumericT> V(rows * num_reflectors);
+        for (vcl_size_t j = 0; j < num_reflectors; ++j)
+          for (vcl_size_t i = j+1; i < rows; ++i)
+            V[i + j * rows] = A(row_start + i, j);
+
+        std::vector<NumericT> x(rows);
+        for (vcl_size_t j = 0; j < B_cols; ++j)
+        {
+          for (vcl_size_t i = 0; i < rows; ++i)
+            x[i] = B(row_start + i, j);
+          tsqr_apply_reflectors(&(V[0]), rows, num_reflectors, &(factors.block_betas[block * factors.cols]), &(x[0]), transposed);
+          for (vcl_size_t i = 0; i < rows; ++i)
+            B(row_start + i, j) = x[i];
+        }
+      }
+
+      /** @brief Applies the reflectors of a node of the reduction tree to the leading rows of the two row blocks of B */
+      template<typename NumericT>
+      void tsqr_apply_node(typename tsqr_factors<NumericT>::tree_node const & node, tsqr_factors<NumericT> const & factors,
+                           tsqr_host_accessor<NumericT> const & B, vcl_size_t B_cols, bool transposed)
+      {
+        vcl_size_t n = factors.cols;
+        vcl_size_t upper_start = factors.block_starts[node.upper];
+        vcl_size_t lower_start = factors.block_starts[node.lower];
+
+        std::vector<NumericT> x(2 * n);
+        for (vcl_size_t j = 0; j < B_cols; ++j)
+        {
+          for (vcl_size_t i = 0; i < n; ++i)
+          {
+            x[i]     = B(upper_start + i, j);
+            x[n + i] = B(lower_start + i, j);
+          }
+          tsqr_apply_reflectors(&(node.reflectors[0]), 2 * n, n, &(node.betas[0]), &(x[0]), transposed);
+          for (vcl_size_t i = 0; i < n; ++i)
+          {
+            B(upper_start + i, j) = x[i];
+            B(lower_start + i, j) = x[n + i];
+          }
+        }
+      }
+
+      /** @brief Applies Q^T (transposed == true) or Q of a TSQR factorization to the host data of B */
+      template<typename NumericT>
+      void tsqr_apply(tsqr_host_accessor<NumericT> const & A, tsqr_factors<NumericT> const & factors,
+                      tsqr_host_accessor<NumericT> const & B, vcl_size_t B_cols, bool transposed)
+      {
+        long num_blocks = static_cast<long>(factors.num_blocks());
+        long num_levels = static_cast<long>(factors.level_starts.size()) - 1;
+
+        if (transposed)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long b = 0; b < num_blocks; ++b)
+            tsqr_apply_block(A, factors, static_cast<vcl_size_t>(b), B, B_cols, true);
+        }
+
+        for (long l = 0; l < num_levels; ++l)
+        {
+          vcl_size_t level = transposed ? static_cast<vcl_size_t>(l) : static_cast<vcl_size_t>(num_levels - l - 1);
+          long node_start = static_cast<long>(factors.level_starts[level]);
+          long node_stop  = static_cast<long>(factors.level_starts[level + 1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long i = node_start; i < node_stop; ++i)
+            tsqr_apply_node(factors.nodes[static_cast<vcl_size_t>(i)], factors, B, B_cols, transposed);
+        }
+
+        if (!transposed)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long b = 0; b < num_blocks; ++b)
+            tsqr_apply_block(A, factors, static_cast<vcl_size_t>(b), B, B_cols, false);
+        }
+      }
+    } //namespace detail
+
+
+    /** @brief Computes a communication-avoiding QR factorization (TSQR) of a tall and skinny matrix A.
+    *
+    * The rows of A are split into blocks, which are factored independently (one per thread). The resulting triangular factors are then combined in a binary reduction tree.
+    * On return, the upper triangular part of the first A.size2() rows of A holds R, while the remaining entries of A hold the reflectors of the row blocks.
+    * Q is only available implicitly through tsqr_apply_trans_Q() and tsqr_apply_Q().
+    *
+    * The factorization is computed on the host. Objects residing in other memory domains are transferred.
+    *
+    * @param A            The matrix to be factored. Also accepts matrix_range and matrix_slice.
+    * @param num_blocks   The number of row blocks. If zero, at least one block per thread is used, with blocks of at most about 256 KB. Each block holds at least A.size2() rows.
+    * @return             The reflectors of the reduction tree and the layout of the row blocks
+    */
+    template<typename NumericT>
+    tsqr_factors<NumericT> inplace_tsqr(matrix_base<NumericT> & A, vcl_size_t num_blocks = 0)
+    {
+      typedef typename tsqr_factors<NumericT>::tree_node   NodeType;
+
+      vcl_size_t m = A.size1();
+      vcl_size_t n = A.size2();
+
+      if (num_blocks == 0)
+      {
+        // at least one block per thread, and blocks small enough to stay in cache during their factorization:
+#ifdef VIENNACL_WITH_OPENMP
+        num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+        num_blocks = 1;
+#endif
+        num_blocks = std::max<vcl_size_t>(num_blocks, (m * n * sizeof(NumericT)) / (256 * 1024));
+      }
+      if (n > 0)
+        num_blocks = std::min(num_blocks, m / n);
+      num_blocks = std::max<vcl_size_t>(num_blocks, 1);
+
+      tsqr_factors<NumericT> factors;
+      factors.rows = m;
+      factors.cols = n;
+      factors.block_starts.resize(num_blocks + 1);
+      for (vcl_size_t b = 0; b <= num_blocks; ++b)
+        factors.block_starts[b] = (b * m) / num_blocks;
+      factors.block_betas.resize(num_blocks * n);
+      factors.level_starts.push_back(0);
+
+      if (m == 0 || n == 0)
+        return factors;
+
+      detail::tsqr_host_buffer<NumericT> A_buffer(A.handle());
+      detail::tsqr_host_accessor<NumericT> A_host(A_buffer.get(), A);
+
+      // triangular factors (column-major, n x n) of the row blocks:
+      std::vector<std::vector<NumericT> > R(num_blocks);
+
+      //
+      // Stage 1: Factor row blocks independently
+      //
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long b2 = 0; b2 < static_cast<long>(num_blocks); ++b2)
+      {
+        vcl_size_t b = static_cast<vcl_size_t>(b2);
+        vcl_size_t row_start = factors.block_starts[b];
+        vcl_size_t rows = factors.block_starts[b + 1] - row_start;
+
+        std::vector<NumericT> panel(rows * n);
+        for (vcl_size_t j = 0; j < n; ++j)
+          for (vcl_size_t i = 0; i < rows; ++i)
+            panel[i + j * rows] = A_host(row_start + i, j);
+
+        detail::qr_factor_panel(panel, rows, n, &(factors.block_betas[b * n]));
+
+        for (vcl_size_t j = 0; j < n; ++j)
+          for (vcl_size_t i = 0; i < rows; ++i)
+            A_host(row_start + i, j) = panel[i + j * rows];
+
+        R[b].resize(n * n);
+        for (vcl_size_t j = 0; j < n; ++j)
+          for (vcl_size_t i = 0; i < std::min(rows, j + 1); ++i)
+            R[b][i + j * n] = panel[i + j * rows];
+      }
+
+      //
+      // Stage 2: Combine pairs of triangular factors in a binary tree
+      //
+      for (vcl_size_t stride = 1; stride < num_blocks; stride *= 2)
+      {
+        vcl_size_t level_start = factors.nodes.size();
+        for (vcl_size_t b = 0; b + stride < num_blocks; b += 2 * stride)
+          factors.nodes.push_back(NodeType(b, b + stride));
+        factors.level_starts.push_back(factors.nodes.size());
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long i = static_cast<long>(level_start); i < static_cast<long>(factors.nodes.size()); ++i)
+        {
+          NodeType & node = factors.nodes[static_cast<vcl_size_t>(i)];
+          std::vector<NumericT> & R_upper = R[node.upper];
+          std::vector<NumericT> const & R_lower = R[node.lower];
+
+          node.reflectors.resize(2 * n * n);
+          node.betas.resize(n);
+          for (vcl_size_t j = 0; j < n; ++j)
+            for (vcl_size_t k = 0; k < n; ++k)
+            {
+              node.reflectors[k     + j * 2 * n] = R_upper[k + j * n];
+              node.reflectors[n + k + j * 2 * n] = R_lower[k + j * n];
+            }
+
+          detail::qr_factor_panel(node.reflectors, 2 * n, n, &(node.betas[0]));
+
+          for (vcl_size_t j = 0; j < n; ++j)
+            for (vcl_size_t k = 0; k <= j; ++k)
+              R_upper[k + j * n] = node.reflectors[k + j * 2 * n];
+        }
+      }
+
+      // write final R to A:
+      if (num_blocks > 1)
+      {
+        for (vcl_size_t j = 0; j < n; ++j)
+          for (vcl_size_t i = 0; i <= j; ++i)
+            A_host(i, j) = R[0][i + j * n];
+      }
+
+      A_buffer.sync();
+      return factors;
+    }
+
+    /** @brief Computes Q^T B, where Q is the implicit orthogonal factor of a TSQR factorization obtained from inplace_tsqr().
+    *
+    * The first A.size2() rows of the result hold the coefficients with respect to the columns of A, which is what is needed for a least squares solve with R.
+    *
+    * @param A         The matrix factored by inplace_tsqr()
+    * @param factors   The factors returned by inplace_tsqr()
+    * @param B         The matrix to which Q^T is applied in-place. Must have A.size1() rows.
+    */
+    template<typename NumericT>
+    void tsqr_apply_trans_Q(matrix_base<NumericT> const & A, tsqr_factors<NumericT> const & factors, matrix_base<NumericT> & B)
+    {
+      assert(B.size1() == factors.rows && bool("Size mismatch in tsqr_apply_trans_Q()"));
+
+      detail::tsqr_host_buffer<NumericT> A_buffer(const_cast<viennacl::backend::mem_handle &>(A.handle()));
+      detail::tsqr_host_buffer<NumericT> B_buffer(B.handle());
+      detail::tsqr_apply(detail::tsqr_host_accessor<NumericT>(A_buffer.get(), A), factors,
+                         detail::tsqr_host_accessor<NumericT>(B_buffer.get(), B), B.size2(), true);
+      B_buffer.sync();
+    }
+
+    /** @brief Computes Q^T b, where Q is the implicit orthogonal factor of a TSQR factorization obtained from inplace_tsqr(). */
+    template<typename NumericT>
+    void tsqr_apply_trans_Q(matrix_base<NumericT> const & A, tsqr_factors<NumericT> const & factors, vector_base<NumericT> & b)
+    {
+      assert(b.size() == factors.rows && bool("Size mismatch in tsqr_apply_trans_Q()"));
+
+      detail::tsqr_host_buffer<NumericT> A_buffer(const_cast<viennacl::backend::mem_handle &>(A.handle()));
+      detail::tsqr_host_buffer<NumericT> b_buffer(b.handle());
+      detail::tsqr_apply(detail::tsqr_host_accessor<NumericT>(A_buffer.get(), A), factors,
+                         detail::tsqr_host_accessor<NumericT>(b_buffer.get(), b), 1, true);
+      b_buffer.sync();
+    }
+
+    /** @brief Computes Q B, where Q is the implicit orthogonal factor of a TSQR factorization obtained from inplace_tsqr().
+    *
+    * For example, the explicit thin factor Q is obtained by applying Q to the first A.size2() columns of the identity matrix.
+    *
+    * @param A         The matrix factored by inplace_tsqr()
+    * @param factors   The factors returned by inplace_tsqr()
+    * @param B         The matrix to which Q is applied in-place. Must have A.size1() rows.
+    */
+    template<typename NumericT>
+    void tsqr_apply_Q(matrix_base<NumericT> const & A, tsqr_factors<NumericT> const & factors, matrix_base<NumericT> & B)
+    {
+      assert(B.size1() == factors.rows && bool("Size mismatch in tsqr_apply_Q()"));
+
+      detail::tsqr_host_buffer<NumericT> A_buffer(const_cast<viennacl::backend::mem_handle &>(A.handle()));
+      detail::tsqr_host_buffer<NumericT> B_buffer(B.handle());
+      detail::tsqr_apply(detail::tsqr_host_accessor<NumericT>(A_buffer.get(), A), factors,
+                         detail::tsqr_host_accessor<NumericT>(B_buffer.get(), B), B.size2(), false);
+      B_buffer.sync();
+    }
+
+    /** @brief Computes Q b, where Q is the implicit orthogonal factor of a TSQR factorization obtained from inplace_tsqr(). */
+    template<typename NumericT>
+    void tsqr_apply_Q(matrix_base<NumericT> const & A, tsqr_factors<NumericT> const & factors, vector_base<NumericT> & b)
+    {
+      assert(b.size() == factors.rows && bool("Size mismatch in tsqr_apply_Q()"));
+
+      detail::tsqr_host_buffer<NumericT> A_buffer(const_cast<viennacl::backend::mem_handle &>(A.handle()));
+      detail::tsqr_host_buffer<NumericT> b_buffer(b.handle());
+      detail::tsqr_apply(detail::tsqr_host_accessor<NumericT>(A_buffer.get(), A), factors,
+                         detail::tsqr_host_accessor<NumericT>(b_buffer.get(), b), 1, false);
+      b_buffer.sync();
+    }
+
+
+
 
   } //linalg
 } //viennacl
@@ -74,6 +74,12 @@ namespace viennacl
       {
         enum { value = true };
       };
+
+      template<typename ScalarType, unsigned int BLOCKSIZE>
+      struct row_scaling_for_viennacl< viennacl::bsr_matrix<ScalarType, BLOCKSIZE> >
+      {
+        enum { value = true };
+      };
     }
     /** \endcond */
 
@@ -119,6 +119,48 @@ namespace viennacl
     }
 
 
+    // trans(A) * x
+
+    /** @brief Carries out matrix-vector multiplication with a transposed sparse matrix
+    *
+    * Implementation of the convenience expression result = prod(trans(mat), vec);
+    *
+    * @param mat    The transposed matrix
+    * @param vec    The vector
+    * @param result The result vector
+    */
+    template<typename SparseMatrixType, class ScalarType>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const matrix_expression<const SparseMatrixType, const SparseMatrixType, op_trans> & mat,
+              const viennacl::vector_base<ScalarType> & vec,
+                    viennacl::vector_base<ScalarType> & result)
+    {
+      assert( (mat.lhs().size2() == result.size()) && bool("Size check failed for transposed sparse matrix-vector product: size2(mat) != size(result)"));
+      assert( (mat.lhs().size1() == vec.size())    && bool("Size check failed for transposed sparse matrix-vector product: size1(mat) != size(x)"));
+
+      switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, result);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::prod_impl(mat, vec, result);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::prod_impl(mat, vec, result);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
     // A * B
     /** @brief Carries out matrix-matrix multiplication first matrix being sparse
     *
@@ -201,6 +243,39 @@ namespace viennacl
       }
     }
 
+    /** @brief Carries out the sparse matrix-matrix product C = A * B with compressed_matrix
+    *
+    * Implementation of the convenience expression C = prod(A, B);
+    *
+    * @param A      The left hand side factor
+    * @param B      The right hand side factor
+    * @param C      The result matrix. Its sparsity pattern is replaced by the one of the product.
+    */
+    template<typename NumericT, unsigned int AlignmentV>
+    void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & A,
+                   const viennacl::compressed_matrix<NumericT, AlignmentV> & B,
+                         viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+    {
+      assert( (A.size2() == B.size1()) && bool("Size check failed for sparse matrix-matrix product: size2(A) != size1(B)"));
+      assert( (C.size1() == A.size1()) && (C.size2() == B.size2()) && bool("Size check failed for sparse matrix-matrix product: size of C does not match"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(A, B, C);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::prod_impl(A, B, C);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
     /** @brief Carries out triangular inplace solves
     *
     * @param mat    The matrix
@@ -335,6 +335,39 @@ struct is_hyb_matrix<viennacl::hyb_matrix<ScalarType, AlignmentV> >
 };
 /** \endcond */
 
+//
+// is_bsr_matrix
+//
+/** \cond */
+template<typename ScalarType, unsigned int BlockSize>
+struct is_bsr_matrix<viennacl::bsr_matrix<ScalarType, BlockSize> >
+{
+  enum { value = true };
+};
+/** \endcond */
+
+//
+// is_compact_compressed_matrix
+//
+/** \cond */
+template<typename ScalarType, typename ValueT, typename IndexT>
+struct is_compact_compressed_matrix<viennacl::compact_compressed_matrix<ScalarType, ValueT, IndexT> >
+{
+  enum { value = true };
+};
+/** \endcond */
+
+//
+// is_symmetric_compressed_matrix
+//
+/** \cond */
+template<typename ScalarType>
+struct is_symmetric_compressed_matrix<viennacl::symmetric_compressed_matrix<ScalarType> >
+{
+  enum { value = true };
+};
+/** \endcond */
+
 
 //
 // is_any_sparse_matrix
@@ -382,6 +415,24 @@ struct is_any_sparse_matrix<viennacl::hyb_matrix<ScalarType, AlignmentV> >
   enum { value = true };
 };
 
+template<typename ScalarType, unsigned int BlockSize>
+struct is_any_sparse_matrix<viennacl::bsr_matrix<ScalarType, BlockSize> >
+{
+  enum { value = true };
+};
+
+template<typename ScalarType, typename ValueT, typename IndexT>
+struct is_any_sparse_matrix<viennacl::compact_compressed_matrix<ScalarType, ValueT, IndexT> >
+{
+  enum { value = true };
+};
+
+template<typename ScalarType>
+struct is_any_sparse_matrix<viennacl::symmetric_compressed_matrix<ScalarType> >
+{
+  enum { value = true };
+};
+
 template<typename T>
 struct is_any_sparse_matrix<const T>
 {
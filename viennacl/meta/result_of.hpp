@@ -423,6 +423,24 @@ struct cpu_value_type<viennacl::hyb_matrix<T, AlignmentV> >
   typedef typename cpu_value_type<T>::type    type;
 };
 
+template<typename T, unsigned int BlockSize>
+struct cpu_value_type<viennacl::bsr_matrix<T, BlockSize> >
+{
+  typedef typename cpu_value_type<T>::type    type;
+};
+
+template<typename T, typename ValueT, typename IndexT>
+struct cpu_value_type<viennacl::compact_compressed_matrix<T, ValueT, IndexT> >
+{
+  typedef typename cpu_value_type<T>::type    type;
+};
+
+template<typename T>
+struct cpu_value_type<viennacl::symmetric_compressed_matrix<T> >
+{
+  typedef typename cpu_value_type<T>::type    type;
+};
+
 template<typename T, unsigned int AlignmentV>
 struct cpu_value_type<viennacl::circulant_matrix<T, AlignmentV> >
 {
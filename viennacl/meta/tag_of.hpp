@@ -260,6 +260,24 @@ namespace traits
     typedef viennacl::tag_viennacl  type;
   };
 
+  template< typename T, unsigned int B>
+  struct tag_of< viennacl::bsr_matrix<T,B> >
+  {
+    typedef viennacl::tag_viennacl  type;
+  };
+
+  template< typename T, typename V, typename I>
+  struct tag_of< viennacl::compact_compressed_matrix<T,V,I> >
+  {
+    typedef viennacl::tag_viennacl  type;
+  };
+
+  template< typename T>
+  struct tag_of< viennacl::symmetric_compressed_matrix<T> >
+  {
+    typedef viennacl::tag_viennacl  type;
+  };
+
   template< typename T, unsigned int I>
   struct tag_of< viennacl::circulant_matrix<T,I> >
   {
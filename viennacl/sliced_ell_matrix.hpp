@@ -25,11 +25,16 @@
 */
 
 
+#include <algorithm>
+#include <vector>
+
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
 
 #include "viennacl/tools/tools.hpp"
 
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+
 #include "viennacl/linalg/sparse_matrix_operations.hpp"
 
 namespace viennacl
@@ -40,7 +45,9 @@ namespace viennacl
   * Can be seen as a block-wise ELLPACK format, where C rows are accumulated into the same block
   * for which a column-wise storage is used. Enables fully-coalesced reads from global memory.
   *
-  * Note: Currently \f$ \sigma \f$ is fixed to 1, since the sorting of rows
+  * Within windows of \f$ \sigma \f$ consecutive rows, the rows are sorted by their number of nonzeros in order to reduce the padding.
+  * The resulting row permutation is stored along with the matrix and applied when writing the result of a matrix-vector product.
+  * Currently only the host backend supports the permutation, hence \f$ \sigma \f$ is set to 1 by copy() for matrices in other memory domains.
   */
 template<typename ScalarT, typename IndexT /* see forwards.h = unsigned int */>
 class sliced_ell_matrix
@@ -50,21 +57,31 @@ public:
   typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<ScalarT>::ResultType>   value_type;
   typedef vcl_size_t                                                                              size_type;
 
-  explicit sliced_ell_matrix() : rows_(0), cols_(0), rows_per_block_(0) {}
+  explicit sliced_ell_matrix() : rows_(0), cols_(0), rows_per_block_(0), sigma_(0) {}
 
+  /** @brief Constructor for a matrix of the given size.
+  *
+  * @param num_rows             Number of rows
+  * @param num_cols             Number of columns
+  * @param num_rows_per_block_  The parameter C, i.e. the number of rows in a block. If zero, a default depending on the memory domain is chosen by copy().
+  * @param sorting_window       The parameter sigma, i.e. the number of consecutive rows within which rows are sorted by their number of nonzeros. If zero, a default depending on the memory domain is chosen by copy().
+  */
   sliced_ell_matrix(size_type num_rows,
                     size_type num_cols,
-                    size_type num_rows_per_block_ = 0)
+                    size_type num_rows_per_block_ = 0,
+                    size_type sorting_window = 0)
     : rows_(num_rows),
       cols_(num_cols),
-      rows_per_block_(num_rows_per_block_) {}
+      rows_per_block_(num_rows_per_block_),
+      sigma_(sorting_window) {}
 
-  explicit sliced_ell_matrix(viennacl::context ctx) : rows_(0), cols_(0), rows_per_block_(0)
+  explicit sliced_ell_matrix(viennacl::context ctx) : rows_(0), cols_(0), rows_per_block_(0), sigma_(0)
   {
     columns_per_block_.switch_active_handle_id(ctx.memory_type());
     column_indices_.switch_active_handle_id(ctx.memory_type());
     block_start_.switch_active_handle_id(ctx.memory_type());
     elements_.switch_active_handle_id(ctx.memory_type());
+    row_indices_.switch_active_handle_id(ctx.memory_type());
 
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
@@ -73,6 +90,7 @@ public:
       column_indices_.opencl_handle().context(ctx.opencl_context());
       block_start_.opencl_handle().context(ctx.opencl_context());
       elements_.opencl_handle().context(ctx.opencl_context());
+      row_indices_.opencl_handle().context(ctx.opencl_context());
     }
 #endif
   }
@@ -89,6 +107,14 @@ public:
     viennacl::backend::memory_create(column_indices_,    host_column_buffer.element_size() * internal_size1(),                         viennacl::traits::context(column_indices_),    host_column_buffer.get());
     viennacl::backend::memory_create(block_start_,       host_block_start_buffer.element_size() * ((rows_ - 1) / rows_per_block_ + 1), viennacl::traits::context(block_start_),       host_block_start_buffer.get());
     viennacl::backend::memory_create(elements_,          sizeof(ScalarT) * 1,                                                          viennacl::traits::context(elements_),          &(host_elements[0]));
+
+    if (sigma_ > 1)
+    {
+      viennacl::backend::typesafe_host_array<IndexT> host_row_indices(row_indices_, (rows_ / rows_per_block_ + 1) * rows_per_block_);
+      for (vcl_size_t i = 0; i < host_row_indices.size(); ++i)
+        host_row_indices.set(i, i);
+      viennacl::backend::memory_create(row_indices_, host_row_indices.raw_size(), viennacl::traits::context(row_indices_), host_row_indices.get());
+    }
   }
 
   vcl_size_t internal_size1() const { return viennacl::tools::align_to_multiple<vcl_size_t>(rows_, rows_per_block_); }
@@ -99,6 +125,9 @@ public:
 
   vcl_size_t rows_per_block() const { return rows_per_block_; }
 
+  /** @brief Returns the size of the windows within which rows are sorted. If larger than one, handle4() holds the row permutation. */
+  vcl_size_t sigma() const { return sigma_; }
+
   //vcl_size_t nnz() const { return rows_ * maxnnz_; }
   //vcl_size_t internal_nnz() const { return internal_size1() * internal_maxnnz(); }
 
@@ -114,6 +143,10 @@ public:
   handle_type & handle()       { return elements_; }
   const handle_type & handle() const { return elements_; }
 
+  /** @brief Returns the handle to the row permutation: The i-th row stored in the matrix is row handle4()[i] of the original matrix. Only set up if sigma() is larger than one. */
+  handle_type & handle4()       { return row_indices_; }
+  const handle_type & handle4() const { return row_indices_; }
+
 #if defined(_MSC_VER) && _MSC_VER < 1500          //Visual Studio 2005 needs special treatment
   template<typename CPUMatrixT>
   friend void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix & gpu_matrix );
@@ -122,29 +155,50 @@ public:
   friend void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT2, IndexT2> & gpu_matrix );
 #endif
 
+  friend struct viennacl::io::detail::binary_access;
+
 private:
   vcl_size_t rows_;
   vcl_size_t cols_;
   vcl_size_t rows_per_block_; //parameter C in the paper by Kreutzer et al.
+  vcl_size_t sigma_;          //parameter sigma in the paper by Kreutzer et al.
 
   handle_type columns_per_block_;
   handle_type column_indices_;
   handle_type block_start_;
   handle_type elements_;
+  handle_type row_indices_;
 };
 
+namespace detail
+{
+  /** @brief Compares rows by their number of nonzeros, longest rows first. */
+  class sliced_ell_row_length_comparator
+  {
+  public:
+    sliced_ell_row_length_comparator(std::vector<vcl_size_t> const & row_lengths) : row_lengths_(row_lengths) {}
+
+    bool operator()(vcl_size_t a, vcl_size_t b) const { return row_lengths_[a] > row_lengths_[b]; }
+
+  private:
+    std::vector<vcl_size_t> const & row_lengths_;
+  };
+}
+
 template<typename CPUMatrixT, typename ScalarT, typename IndexT>
 void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT, IndexT> & gpu_matrix )
 {
   assert( (gpu_matrix.size1() == 0 || viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
   assert( (gpu_matrix.size2() == 0 || viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
 
+  viennacl::context ctx = traits::context(gpu_matrix.handle1());
   if (gpu_matrix.rows_per_block() == 0) // not yet initialized by user. Set defaults.
   {
-    viennacl::context ctx = traits::context(gpu_matrix.handle1());
     gpu_matrix.rows_per_block_ = 128;
 
-    if (ctx.memory_type() == CUDA_MEMORY)
+    if (ctx.memory_type() == MAIN_MEMORY) // two SIMD registers per block
+      gpu_matrix.rows_per_block_ = 2 * viennacl::linalg::host_based::active_simd_register_bytes() / sizeof(ScalarT);
+    else if (ctx.memory_type() == CUDA_MEMORY)
       gpu_matrix.rows_per_block_ = 256;
     else if (ctx.memory_type() == OPENCL_MEMORY)
     {
@@ -155,71 +209,102 @@ void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT, IndexT> & gp
     }
   }
 
+  if (ctx.memory_type() != MAIN_MEMORY)
+    gpu_matrix.sigma_ = 1;
+  else if (gpu_matrix.sigma() == 0) // not yet initialized by user. Sort within a few blocks in order to retain the locality of the accesses to the vector.
+    gpu_matrix.sigma_ = 16 * gpu_matrix.rows_per_block();
+  else if (gpu_matrix.sigma() > 1)  // windows consist of full blocks
+    gpu_matrix.sigma_ = viennacl::tools::align_to_multiple<vcl_size_t>(gpu_matrix.sigma(), gpu_matrix.rows_per_block());
+
   if (viennacl::traits::size1(cpu_matrix) > 0 && viennacl::traits::size2(cpu_matrix) > 0)
   {
-    //determine max capacity for row
-    IndexT columns_in_current_block = 0;
-    vcl_size_t row_counter_in_current_block = 0;
-    vcl_size_t total_element_buffer_size = 0;
-    viennacl::backend::typesafe_host_array<IndexT> columns_in_block_buffer(gpu_matrix.handle1(), viennacl::traits::size1(cpu_matrix) / gpu_matrix.rows_per_block() + 1);
+    vcl_size_t rows = viennacl::traits::size1(cpu_matrix);
+    vcl_size_t C    = gpu_matrix.rows_per_block();
+    vcl_size_t num_blocks = rows / C + 1;
+
+    //determine number of entries in each row
+    std::vector<vcl_size_t> row_lengths(rows);
     for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
     {
-      ++row_counter_in_current_block;
       vcl_size_t entries_in_row = 0;
       for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
         ++entries_in_row;
+      row_lengths[row_it.index1()] = entries_in_row;
+    }
+
+    //sort rows within each window. Position i holds row row_indices[i], padding rows at the end have no counterpart in the matrix
+    std::vector<vcl_size_t> row_indices(num_blocks * C);
+    for (vcl_size_t i = 0; i < row_indices.size(); ++i)
+      row_indices[i] = i;
+    if (gpu_matrix.sigma() > 1)
+    {
+      for (vcl_size_t window_start = 0; window_start < rows; window_start += gpu_matrix.sigma())
+        std::stable_sort(row_indices.begin() + static_cast<long>(window_start),
+                         row_indices.begin() + static_cast<long>(std::min(window_start + gpu_matrix.sigma(), rows)),
+                         detail::sliced_ell_row_length_comparator(row_lengths));
+    }
 
-      columns_in_current_block = std::max(columns_in_current_block, static_cast<IndexT>(entries_in_row));
+    std::vector<vcl_size_t> row_positions(rows);
+    for (vcl_size_t i = 0; i < rows; ++i)
+      row_positions[row_indices[i]] = i;
 
-      if ( (row_it.index1() % gpu_matrix.rows_per_block() == gpu_matrix.rows_per_block() - 1)
-           || row_it.index1() == viennacl::traits::size1(cpu_matrix) - 1)
-      {
-        total_element_buffer_size += columns_in_current_block * gpu_matrix.rows_per_block();
-        columns_in_block_buffer.set(row_it.index1() / gpu_matrix.rows_per_block(), columns_in_current_block);
-        columns_in_current_block = 0;
-      }
+    //determine max capacity for each block
+    vcl_size_t total_element_buffer_size = 0;
+    viennacl::backend::typesafe_host_array<IndexT> columns_in_block_buffer(gpu_matrix.handle1(), num_blocks);
+    viennacl::backend::typesafe_host_array<IndexT> block_start(gpu_matrix.handle3(), (rows - 1) / C + 1);
+    for (vcl_size_t block_index = 0; block_index < (rows - 1) / C + 1; ++block_index)
+    {
+      vcl_size_t columns_in_current_block = 0;
+      for (vcl_size_t i = block_index * C; i < std::min((block_index + 1) * C, rows); ++i)
+        columns_in_current_block = std::max(columns_in_current_block, row_lengths[row_indices[i]]);
+
+      block_start.set(block_index, total_element_buffer_size);
+      columns_in_block_buffer.set(block_index, columns_in_current_block);
+      total_element_buffer_size += columns_in_current_block * C;
     }
 
     //setup GPU matrix
     gpu_matrix.rows_ = cpu_matrix.size1();
     gpu_matrix.cols_ = cpu_matrix.size2();
 
+    // padding entries are zeros in the last column of their row, so that no conditionals are needed when computing products
     viennacl::backend::typesafe_host_array<IndexT> coords(gpu_matrix.handle2(), total_element_buffer_size);
-    viennacl::backend::typesafe_host_array<IndexT> block_start(gpu_matrix.handle3(), (viennacl::traits::size1(cpu_matrix) - 1) / gpu_matrix.rows_per_block() + 1);
     std::vector<ScalarT> elements(total_element_buffer_size, 0);
 
-    vcl_size_t block_offset = 0;
-    vcl_size_t block_index  = 0;
-    vcl_size_t row_in_block = 0;
     for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
     {
-      vcl_size_t entry_in_row = 0;
+      vcl_size_t position     = row_positions[row_it.index1()];
+      vcl_size_t block_index  = position / C;
+      vcl_size_t row_in_block = position % C;
+      vcl_size_t block_offset = block_start[block_index];
 
+      vcl_size_t entry_in_row = 0;
+      vcl_size_t last_column  = 0;
       for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
       {
-        vcl_size_t buffer_index = block_offset + entry_in_row * gpu_matrix.rows_per_block() + row_in_block;
+        vcl_size_t buffer_index = block_offset + entry_in_row * C + row_in_block;
         coords.set(buffer_index, col_it.index2());
         elements[buffer_index] = *col_it;
+        last_column = col_it.index2();
         entry_in_row++;
       }
 
-      ++row_in_block;
-
-      // check for end of block:
-      if ( (row_it.index1() % gpu_matrix.rows_per_block() == gpu_matrix.rows_per_block() - 1)
-           || row_it.index1() == viennacl::traits::size1(cpu_matrix) - 1)
-      {
-        block_start.set(block_index, static_cast<IndexT>(block_offset));
-        block_offset += columns_in_block_buffer[block_index] * gpu_matrix.rows_per_block();
-        ++block_index;
-        row_in_block = 0;
-      }
+      for (; entry_in_row < columns_in_block_buffer[block_index]; ++entry_in_row)
+        coords.set(block_offset + entry_in_row * C + row_in_block, last_column);
     }
 
     viennacl::backend::memory_create(gpu_matrix.handle1(), columns_in_block_buffer.raw_size(), traits::context(gpu_matrix.handle1()), columns_in_block_buffer.get());
     viennacl::backend::memory_create(gpu_matrix.handle2(), coords.raw_size(),                  traits::context(gpu_matrix.handle2()), coords.get());
     viennacl::backend::memory_create(gpu_matrix.handle3(), block_start.raw_size(),             traits::context(gpu_matrix.handle3()), block_start.get());
     viennacl::backend::memory_create(gpu_matrix.handle(),  sizeof(ScalarT) * elements.size(),  traits::context(gpu_matrix.handle()), &(elements[0]));
+
+    if (gpu_matrix.sigma() > 1)
+    {
+      viennacl::backend::typesafe_host_array<IndexT> row_index_buffer(gpu_matrix.handle4(), row_indices.size());
+      for (vcl_size_t i = 0; i < row_indices.size(); ++i)
+        row_index_buffer.set(i, row_indices[i]);
+      viennacl::backend::memory_create(gpu_matrix.handle4(), row_index_buffer.raw_size(), traits::context(gpu_matrix.handle4()), row_index_buffer.get());
+    }
   }
 }
 
@@ -0,0 +1,443 @@
+#ifndef VIENNACL_SYMMETRIC_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_SYMMETRIC_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/symmetric_compressed_matrix.hpp
+    @brief Implementation of the symmetric_compressed_matrix class, storing the upper triangle of a symmetric sparse matrix in CSR format
+*/
+
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/adapter.hpp"
+
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+/** @brief Sparse matrix class for symmetric matrices, storing only the diagonal and the upper triangle in compressed sparse row (CSR) format.
+    *
+    * Compared to a compressed_matrix, the memory footprint and the number of bytes loaded in a sparse matrix-vector product are halved.
+    * Each stored entry a_ij with i < j is used for both y_i += a_ij x_j and y_j += a_ij x_i within a single pass over the matrix.
+    * Entries below the diagonal are ignored when copying a matrix from the host or from a compressed_matrix.
+    *
+    * @tparam NumericT    The floating point type (either float or double, checked at compile time)
+    */
+template<class NumericT>
+class symmetric_compressed_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>   value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  symmetric_compressed_matrix() : size_(0), nonzeros_(0) {}
+
+  explicit symmetric_compressed_matrix(viennacl::context ctx) : size_(0), nonzeros_(0)
+  {
+    init_handles(ctx);
+  }
+
+  /** @brief Construction of a symmetric_compressed_matrix with the supplied number of rows and columns. All entries are zero. */
+  explicit symmetric_compressed_matrix(vcl_size_t size, viennacl::context ctx = viennacl::context()) : size_(size), nonzeros_(0)
+  {
+    init_handles(ctx);
+    clear();
+  }
+
+  /** @brief Sets the row array, the column indices, and the values of the upper triangle.
+  *
+  * @param row_jumper   Array of size rows + 1 with the offsets of the rows in the arrays of column indices and values
+  * @param col_buffer   Array of size nonzeros with the column indices, which must not be smaller than the row index
+  * @param elements     Array of size nonzeros with the values
+  * @param size         Number of rows and columns of the matrix
+  * @param nonzeros     Number of entries stored in the upper triangle including the diagonal
+  */
+  void set(const void * row_jumper,
+           const void * col_buffer,
+           const NumericT * elements,
+           vcl_size_t size,
+           vcl_size_t nonzeros)
+  {
+    assert( (size > 0) && bool("Error in symmetric_compressed_matrix::set(): Number of rows must be larger than zero!"));
+    assert( (nonzeros > 0) && bool("Error in symmetric_compressed_matrix::set(): Number of nonzeros must be larger than zero!"));
+
+    viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(row_buffer_).element_size() * (size + 1), viennacl::traits::context(row_buffer_), row_jumper);
+    viennacl::backend::memory_create(col_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(col_buffer_).element_size() * nonzeros,   viennacl::traits::context(col_buffer_), col_buffer);
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT) * nonzeros,                                                                viennacl::traits::context(elements_),   elements);
+
+    size_ = size;
+    nonzeros_ = nonzeros;
+  }
+
+  /** @brief Resets all entries in the matrix back to zero without changing the matrix size. Resets the sparsity pattern. */
+  void clear()
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> host_row_buffer(row_buffer_, size_ + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> host_col_buffer(col_buffer_, 1);
+    std::vector<NumericT> host_elements(1);
+
+    viennacl::backend::memory_create(row_buffer_, host_row_buffer.raw_size(), viennacl::traits::context(row_buffer_), host_row_buffer.get());
+    viennacl::backend::memory_create(col_buffer_, host_col_buffer.raw_size(), viennacl::traits::context(col_buffer_), host_col_buffer.get());
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT),           viennacl::traits::context(elements_),   &(host_elements[0]));
+
+    nonzeros_ = 0;
+  }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return size_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return size_; }
+  /** @brief Returns the number of entries stored in the upper triangle including the diagonal */
+  vcl_size_t nnz() const { return nonzeros_; }
+
+  /** @brief Returns the OpenCL handle to the row index array */
+  const handle_type & handle1() const { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column index array */
+  const handle_type & handle2() const { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the values */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Returns the OpenCL handle to the row index array */
+  handle_type & handle1() { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column index array */
+  handle_type & handle2() { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the values */
+  handle_type & handle() { return elements_; }
+
+  /** @brief Switches the memory context of the matrix. */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up in main memory, OpenCL memory, or CUDA memory. */
+  viennacl::memory_types memory_context() const
+  {
+    return row_buffer_.get_active_handle_id();
+  }
+
+private:
+  void init_handles(viennacl::context ctx)
+  {
+    row_buffer_.switch_active_handle_id(ctx.memory_type());
+    col_buffer_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      row_buffer_.opencl_handle().context(ctx.opencl_context());
+      col_buffer_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+  }
+
+  vcl_size_t size_;
+  vcl_size_t nonzeros_;
+
+  handle_type row_buffer_;
+  handle_type col_buffer_;
+  handle_type elements_;
+};
+
+
+//
+// host to device:
+//
+
+/** @brief Copies the upper triangle of a symmetric sparse matrix from the host to a symmetric_compressed_matrix. Entries below the diagonal are ignored.
+  *
+  * There are some type requirements on the CPUMatrixT type (fulfilled by e.g. boost::numeric::ublas):
+  * - .size1() returns the number of rows
+  * - .size2() returns the number of columns
+  * - const_iterator1    is a type definition for an iterator along increasing row indices
+  * - const_iterator2    is a type definition for an iterator along increasing columns indices
+  * - The const_iterator1 type provides an iterator of type const_iterator2 via members .begin() and .end() that iterates along column indices in the current row.
+  * - The types const_iterator1 and const_iterator2 provide members functions .index1() and .index2() that return the current row and column indices respectively.
+  * - Dereferenciation of an object of type const_iterator2 returns the entry.
+  *
+  * @param cpu_matrix   A symmetric sparse matrix on the host.
+  * @param gpu_matrix   A symmetric_compressed_matrix from ViennaCL
+  */
+template<typename CPUMatrixT, typename NumericT>
+void copy(const CPUMatrixT & cpu_matrix, symmetric_compressed_matrix<NumericT> & gpu_matrix)
+{
+  assert( (viennacl::traits::size1(cpu_matrix) == viennacl::traits::size2(cpu_matrix)) && bool("Matrix is not square") );
+  assert( (gpu_matrix.size1() == 0 || viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+
+  if (cpu_matrix.size1() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), cpu_matrix.size1() + 1);
+    std::vector<unsigned int> col_buffer;
+    std::vector<NumericT>     elements;
+
+    vcl_size_t row_index = 0;
+    for (typename CPUMatrixT::const_iterator1 row_it = cpu_matrix.begin1(); row_it != cpu_matrix.end1(); ++row_it)
+    {
+      // rows not visited by the iterator are empty:
+      for (; row_index <= row_it.index1(); ++row_index)
+        row_buffer.set(row_index, col_buffer.size());
+
+      for (typename CPUMatrixT::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+      {
+        if (col_it.index2() >= row_it.index1())
+        {
+          col_buffer.push_back(static_cast<unsigned int>(col_it.index2()));
+          elements.push_back(static_cast<NumericT>(*col_it));
+        }
+      }
+    }
+    for (; row_index <= cpu_matrix.size1(); ++row_index)
+      row_buffer.set(row_index, col_buffer.size());
+
+    vcl_size_t nonzeros = col_buffer.size();
+    if (nonzeros == 0)
+    {
+      col_buffer.push_back(0);
+      elements.push_back(0);
+    }
+
+    viennacl::backend::typesafe_host_array<unsigned int> col_buffer_host(gpu_matrix.handle2(), col_buffer.size());
+    for (vcl_size_t k = 0; k < col_buffer.size(); ++k)
+      col_buffer_host.set(k, col_buffer[k]);
+
+    gpu_matrix.set(row_buffer.get(),
+                   col_buffer_host.get(),
+                   &elements[0],
+                   cpu_matrix.size1(),
+                   col_buffer.size());
+    if (nonzeros == 0)
+      gpu_matrix.clear();
+  }
+}
+
+
+/** @brief Copies the upper triangle of a symmetric sparse matrix from the host to the compute device. The host type is the std::vector< std::map < > > format .
+  *
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  * @param gpu_matrix   The symmetric_compressed_matrix from ViennaCL
+  */
+template<typename SizeT, typename NumericT>
+void copy(std::vector< std::map<SizeT, NumericT> > const & cpu_matrix,
+          symmetric_compressed_matrix<NumericT> & gpu_matrix)
+{
+  tools::const_sparse_matrix_adapter<NumericT, SizeT> temp(cpu_matrix, cpu_matrix.size(), cpu_matrix.size());
+  viennacl::copy(temp, gpu_matrix);
+}
+
+
+/** @brief Copies the upper triangle of a symmetric compressed_matrix to a symmetric_compressed_matrix in the same memory domain. The CSR arrays are passed through main memory.
+  *
+  * @param csr_matrix   The compressed_matrix
+  * @param gpu_matrix   The symmetric_compressed_matrix from ViennaCL
+  */
+template<typename NumericT, unsigned int AlignmentV>
+void copy(compressed_matrix<NumericT, AlignmentV> const & csr_matrix,
+          symmetric_compressed_matrix<NumericT> & gpu_matrix)
+{
+  assert( (csr_matrix.size1() == csr_matrix.size2()) && bool("Matrix is not square") );
+
+  if (csr_matrix.size1() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(csr_matrix.handle1(), csr_matrix.size1() + 1);
+    viennacl::backend::memory_read(csr_matrix.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+
+    vcl_size_t nonzeros = row_buffer[csr_matrix.size1()];
+    std::vector<unsigned int> host_row_buffer(csr_matrix.size1() + 1);
+    std::vector<unsigned int> host_col_buffer(std::max<vcl_size_t>(nonzeros, 1));
+    std::vector<NumericT>     host_elements(std::max<vcl_size_t>(nonzeros, 1));
+    for (vcl_size_t i = 0; i <= csr_matrix.size1(); ++i)
+      host_row_buffer[i] = static_cast<unsigned int>(row_buffer[i]);
+
+    if (nonzeros > 0)
+    {
+      viennacl::backend::typesafe_host_array<unsigned int> col_buffer(csr_matrix.handle2(), nonzeros);
+      viennacl::backend::memory_read(csr_matrix.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+      viennacl::backend::memory_read(csr_matrix.handle(),  0, sizeof(NumericT) * nonzeros, &(host_elements[0]));
+      for (vcl_size_t k = 0; k < nonzeros; ++k)
+        host_col_buffer[k] = static_cast<unsigned int>(col_buffer[k]);
+    }
+
+    tools::const_csr_matrix_adapter<NumericT> temp(&(host_row_buffer[0]), &(host_col_buffer[0]), &(host_elements[0]), csr_matrix.size1(), csr_matrix.size2());
+    viennacl::copy(temp, gpu_matrix);
+  }
+}
+
+
+//
+// device to host:
+//
+
+/** @brief Copies a symmetric_compressed_matrix to a sparse matrix on the host. Both the upper and the lower triangle are written.
+  *
+  * @param gpu_matrix   The symmetric_compressed_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host of matching size, which needs to provide write access via operator()
+  */
+template<typename CPUMatrixT, typename NumericT>
+void copy(const symmetric_compressed_matrix<NumericT> & gpu_matrix, CPUMatrixT & cpu_matrix)
+{
+  assert( (viennacl::traits::size1(cpu_matrix) == gpu_matrix.size1()) && bool("Size mismatch") );
+  assert( (viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
+
+  if (gpu_matrix.size1() > 0 && gpu_matrix.nnz() > 0)
+  {
+    viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), gpu_matrix.size1() + 1);
+    viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), gpu_matrix.nnz());
+    std::vector<NumericT> elements(gpu_matrix.nnz());
+
+    viennacl::backend::memory_read(gpu_matrix.handle1(), 0, row_buffer.raw_size(),                row_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle2(), 0, col_buffer.raw_size(),                col_buffer.get());
+    viennacl::backend::memory_read(gpu_matrix.handle(),  0, sizeof(NumericT) * elements.size(), &(elements[0]));
+
+    for (vcl_size_t row = 0; row < gpu_matrix.size1(); ++row)
+    {
+      for (vcl_size_t k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+      {
+        vcl_size_t col = col_buffer[k];
+        cpu_matrix(row, col) = elements[k];
+        if (col != row)
+          cpu_matrix(col, row) = elements[k];
+      }
+    }
+  }
+}
+
+
+/** @brief Copies a symmetric_compressed_matrix from the compute device to the host. The host type is the std::vector< std::map < > > format .
+  *
+  * @param gpu_matrix   The symmetric_compressed_matrix from ViennaCL
+  * @param cpu_matrix   A sparse matrix on the host composed of an STL vector and an STL map.
+  */
+template<typename NumericT, typename SizeT>
+void copy(const symmetric_compressed_matrix<NumericT> & gpu_matrix,
+          std::vector< std::map<SizeT, NumericT> > & cpu_matrix)
+{
+  if (cpu_matrix.size() == 0)
+    cpu_matrix.resize(gpu_matrix.size1());
+
+  assert( (cpu_matrix.size() == gpu_matrix.size1()) && bool("Size mismatch") );
+
+  tools::sparse_matrix_adapter<NumericT, SizeT> temp(cpu_matrix, gpu_matrix.size1(), gpu_matrix.size2());
+  viennacl::copy(gpu_matrix, temp);
+}
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs += temp;
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+      lhs -= temp;
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs += temp_result;
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const symmetric_compressed_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs -= temp_result;
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
@@ -0,0 +1,577 @@
+#ifndef VIENNACL_TOOLS_SPARSE_FORMAT_HPP_
+#define VIENNACL_TOOLS_SPARSE_FORMAT_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/sparse_format.hpp
+    @brief Selection of the sparse matrix format for matrix-vector products based on row statistics, and conversions between the sparse matrix types.
+
+    Typical use:
+    \code
+      viennacl::compressed_matrix<double> A;
+      viennacl::copy(host_matrix, A);
+      if (viennacl::tools::recommend_sparse_format(A) == viennacl::tools::SPARSE_FORMAT_SLICED_ELL)
+      {
+        viennacl::sliced_ell_matrix<double> A_sell(viennacl::traits::context(A));
+        viennacl::tools::convert_sparse_matrix(A, A_sell);
+        ...
+      }
+    \endcode
+*/
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/compressed_compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/tools/adapter.hpp"
+#include "viennacl/tools/timer.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/cpu_features.hpp"
+
+namespace viennacl
+{
+namespace tools
+{
+
+/** @brief The sparse matrix types available for matrix-vector products */
+enum sparse_format
+{
+  SPARSE_FORMAT_COMPRESSED = 0,  // compressed_matrix
+  SPARSE_FORMAT_COORDINATE,      // coordinate_matrix
+  SPARSE_FORMAT_ELL,             // ell_matrix
+  SPARSE_FORMAT_SLICED_ELL,      // sliced_ell_matrix
+  SPARSE_FORMAT_HYB              // hyb_matrix
+};
+
+/** @brief Statistics of the number of nonzeros per row of a sparse matrix */
+struct sparse_row_statistics
+{
+  sparse_row_statistics() : rows(0), cols(0), nnz(0), max(0), mean(0), variance(0) {}
+
+  vcl_size_t rows;
+  vcl_size_t cols;
+  vcl_size_t nnz;
+  vcl_size_t max;
+  double     mean;
+  double     variance;
+
+  /** @brief histogram[0] holds the number of empty rows, histogram[k] for k > 0 the number of rows with at least 2^(k-1) and less than 2^k nonzeros. */
+  std::vector<vcl_size_t> histogram;
+};
+
+/** @brief Computes the statistics of the number of nonzeros per row from the row array of a compressed_matrix. Only the row array is transferred to the host. */
+template<typename NumericT, unsigned int AlignmentV>
+sparse_row_statistics row_statistics(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+{
+  sparse_row_statistics stats;
+  stats.rows = A.size1();
+  stats.cols = A.size2();
+  stats.histogram.resize(1);
+  if (A.size1() == 0 || A.nnz() == 0)
+  {
+    stats.histogram[0] = A.size1();
+    return stats;
+  }
+
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+  viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+
+  double sum_of_squares = 0;
+  for (vcl_size_t i = 0; i < A.size1(); ++i)
+  {
+    vcl_size_t row_length = row_buffer[i + 1] - row_buffer[i];
+    stats.max = std::max(stats.max, row_length);
+    sum_of_squares += static_cast<double>(row_length) * static_cast<double>(row_length);
+
+    vcl_size_t bucket = 0;
+    while ((vcl_size_t(1) << bucket) <= row_length)
+      ++bucket;
+    if (bucket >= stats.histogram.size())
+      stats.histogram.resize(bucket + 1);
+    ++stats.histogram[bucket];
+  }
+
+  stats.nnz      = row_buffer[A.size1()];
+  stats.mean     = static_cast<double>(stats.nnz) / static_cast<double>(stats.rows);
+  stats.variance = std::max(0.0, sum_of_squares / static_cast<double>(stats.rows) - stats.mean * stats.mean);
+  return stats;
+}
+
+/** @brief Recommends the sparse matrix format for fast matrix-vector products in the provided memory domain based on the row statistics of the matrix.
+*
+* In main memory, sliced_ell_matrix is used whenever gather instructions are available, since its rows are sorted within small windows and thus padding is small.
+* Otherwise, compressed_matrix is used, for which the work is balanced over threads based on the nonzeros.
+*
+* On GPUs, the rules follow the usual guidelines:
+*   - ell_matrix if padding to the longest row adds at most 25 percent to the nonzeros,
+*   - hyb_matrix if only a few rows (at most five percent) are much longer than the average,
+*   - coordinate_matrix if the row lengths vary extremely (standard deviation larger than four times the mean), as for power-law graphs,
+*   - sliced_ell_matrix if the row lengths vary moderately (standard deviation at most the mean),
+*   - compressed_matrix otherwise.
+*/
+inline sparse_format recommend_sparse_format(sparse_row_statistics const & stats, viennacl::memory_types memory_type)
+{
+  if (stats.nnz == 0)
+    return SPARSE_FORMAT_COMPRESSED;
+
+  if (memory_type == viennacl::MAIN_MEMORY)
+  {
+    if (viennacl::linalg::host_based::active_simd_isa() >= viennacl::linalg::host_based::SIMD_ISA_AVX2 && stats.mean >= 2.0)
+      return SPARSE_FORMAT_SLICED_ELL;
+    return SPARSE_FORMAT_COMPRESSED;
+  }
+
+  double std_dev = std::sqrt(stats.variance);
+
+  if (static_cast<double>(stats.rows) * static_cast<double>(stats.max) <= 1.25 * static_cast<double>(stats.nnz))
+    return SPARSE_FORMAT_ELL;
+
+  // rows in the histogram buckets with at least twice the mean number of nonzeros:
+  vcl_size_t long_rows = 0;
+  for (vcl_size_t k = 1; k < stats.histogram.size(); ++k)
+    if (static_cast<double>(vcl_size_t(1) << (k - 1)) >= 2.0 * stats.mean)
+      long_rows += stats.histogram[k];
+
+  if (static_cast<double>(stats.max) > 4.0 * stats.mean && static_cast<double>(long_rows) <= 0.05 * static_cast<double>(stats.rows))
+    return SPARSE_FORMAT_HYB;
+
+  if (std_dev > 4.0 * stats.mean)
+    return SPARSE_FORMAT_COORDINATE;
+
+  if (std_dev <= stats.mean)
+    return SPARSE_FORMAT_SLICED_ELL;
+
+  return SPARSE_FORMAT_COMPRESSED;
+}
+
+/** @brief Recommends the sparse matrix format for fast matrix-vector products in the memory domain of A. */
+template<typename NumericT, unsigned int AlignmentV>
+sparse_format recommend_sparse_format(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+{
+  return recommend_sparse_format(row_statistics(A), viennacl::traits::context(A).memory_type());
+}
+
+
+namespace detail
+{
+  /** @brief A sparse matrix in the CSR format held in main memory. Used for conversions between sparse matrix types. */
+  template<typename NumericT>
+  struct host_csr_matrix
+  {
+    host_csr_matrix() : rows(0), cols(0) {}
+
+    vcl_size_t rows;
+    vcl_size_t cols;
+    std::vector<unsigned int> row_buffer;
+    std::vector<unsigned int> col_buffer;
+    std::vector<NumericT>     elements;
+
+    /** @brief Sets up the row array from the number of entries in each row, which are expected in row_buffer[1], ..., row_buffer[rows]. */
+    void finalize_row_buffer()
+    {
+      for (vcl_size_t i = 0; i < rows; ++i)
+        row_buffer[i + 1] += row_buffer[i];
+      col_buffer.resize(row_buffer[rows]);
+      elements.resize(row_buffer[rows]);
+    }
+  };
+
+  inline void read_index_buffer(viennacl::backend::mem_handle const & handle, vcl_size_t size, std::vector<unsigned int> & result)
+  {
+    result.resize(size);
+    if (size == 0)
+      return;
+
+    viennacl::backend::typesafe_host_array<unsigned int> buffer(handle, size);
+    viennacl::backend::memory_read(handle, 0, buffer.raw_size(), buffer.get());
+    for (vcl_size_t i = 0; i < size; ++i)
+      result[i] = static_cast<unsigned int>(buffer[i]);
+  }
+
+  template<typename NumericT>
+  void read_value_buffer(viennacl::backend::mem_handle const & handle, vcl_size_t size, std::vector<NumericT> & result)
+  {
+    result.resize(size);
+    if (size > 0)
+      viennacl::backend::memory_read(handle, 0, sizeof(NumericT) * size, &(result[0]));
+  }
+
+  //
+  // Extraction of the nonzeros into a CSR matrix on the host. Padding entries (zeros) of the ELL-type formats are skipped.
+  //
+
+  template<typename NumericT, unsigned int AlignmentV>
+  void extract_host_csr(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, host_csr_matrix<NumericT> & B)
+  {
+    B.rows = A.size1();
+    B.cols = A.size2();
+    read_index_buffer(A.handle1(), A.size1() + 1, B.row_buffer);
+    read_index_buffer(A.handle2(), B.row_buffer[A.size1()], B.col_buffer);
+    read_value_buffer(A.handle(),  B.row_buffer[A.size1()], B.elements);
+  }
+
+  template<typename NumericT>
+  void extract_host_csr(viennacl::compressed_compressed_matrix<NumericT> const & A, host_csr_matrix<NumericT> & B)
+  {
+    std::vector<unsigned int> row_jumper, row_indices;
+    read_index_buffer(A.handle1(), A.nnz1() + 1, row_jumper);
+    read_index_buffer(A.handle3(), A.nnz1(),     row_indices);
+
+    B.rows = A.size1();
+    B.cols = A.size2();
+    B.row_buffer.assign(A.size1() + 1, 0);
+    for (vcl_size_t i = 0; i < A.nnz1(); ++i)
+      B.row_buffer[row_indices[i] + 1] = row_jumper[i + 1] - row_jumper[i];
+    B.finalize_row_buffer();
+
+    // entries of the nonzero rows are stored consecutively in the order of the rows:
+    read_index_buffer(A.handle2(), B.col_buffer.size(), B.col_buffer);
+    read_value_buffer(A.handle(),  B.elements.size(),   B.elements);
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  void extract_host_csr(viennacl::coordinate_matrix<NumericT, AlignmentV> const & A, host_csr_matrix<NumericT> & B)
+  {
+    std::vector<unsigned int> coords;
+    std::vector<NumericT> elements;
+    read_index_buffer(A.handle12(), 2 * A.nnz(), coords);
+    read_value_buffer(A.handle(),   A.nnz(),     elements);
+
+    B.rows = A.size1();
+    B.cols = A.size2();
+    B.row_buffer.assign(A.size1() + 1, 0);
+    for (vcl_size_t k = 0; k < A.nnz(); ++k)
+      ++B.row_buffer[coords[2 * k] + 1];
+    B.finalize_row_buffer();
+
+    // stable counting sort by rows:
+    std::vector<unsigned int> next_entry(B.row_buffer.begin(), B.row_buffer.end() - 1);
+    for (vcl_size_t k = 0; k < A.nnz(); ++k)
+    {
+      unsigned int index = next_entry[coords[2 * k]]++;
+      B.col_buffer[index] = coords[2 * k + 1];
+      B.elements[index]   = elements[k];
+    }
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  void extract_host_csr(viennacl::ell_matrix<NumericT, AlignmentV> const & A, host_csr_matrix<NumericT> & B)
+  {
+    std::vector<unsigned int> coords;
+    std::vector<NumericT> elements;
+    read_index_buffer(A.handle2(), A.internal_nnz(), coords);
+    read_value_buffer(A.handle(),  A.internal_nnz(), elements);
+
+    B.rows = A.size1();
+    B.cols = A.size2();
+    B.row_buffer.assign(A.size1() + 1, 0);
+    for (vcl_size_t k = 0; k < A.maxnnz(); ++k)
+      for (vcl_size_t i = 0; i < A.size1(); ++i)
+        if (elements[k * A.internal_size1() + i] < 0 || elements[k * A.internal_size1() + i] > 0) // val != 0 without compiler warnings
+          ++B.row_buffer[i + 1];
+    B.finalize_row_buffer();
+
+    for (vcl_size_t i = 0; i < A.size1(); ++i)
+    {
+      unsigned int index = B.row_buffer[i];
+      for (vcl_size_t k = 0; k < A.maxnnz(); ++k)
+      {
+        NumericT val = elements[k * A.internal_size1() + i];
+        if (val < 0 || val > 0)
+        {
+          B.col_buffer[index] = coords[k * A.internal_size1() + i];
+          B.elements[index]   = val;
+          ++index;
+        }
+      }
+    }
+  }
+
+  template<typename NumericT, typename IndexT>
+  void extract_host_csr(viennacl::sliced_ell_matrix<NumericT, IndexT> const & A, host_csr_matrix<NumericT> & B)
+  {
+    B.rows = A.size1();
+    B.cols = A.size2();
+    B.row_buffer.assign(A.size1() + 1, 0);
+    if (A.size1() == 0 || A.rows_per_block() == 0)
+      return;
+
+    vcl_size_t C          = A.rows_per_block();
+    vcl_size_t num_blocks = (A.size1() - 1) / C + 1;
+
+    std::vector<unsigned int> columns_per_block, block_start, column_indices, row_indices;
+    std::vector<NumericT> elements;
+    read_index_buffer(A.handle1(), num_blocks, columns_per_block);
+    read_index_buffer(A.handle3(), num_blocks, block_start);
+    vcl_size_t num_entries = block_start[num_blocks - 1] + columns_per_block[num_blocks - 1] * C;
+    read_index_buffer(A.handle2(), num_entries, column_indices);
+    read_value_buffer(A.handle(),  num_entries, elements);
+    if (A.sigma() > 1)
+      read_index_buffer(A.handle4(), num_blocks * C, row_indices);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (pass == 1)
+        B.finalize_row_buffer();
+      std::vector<unsigned int> next_entry(B.row_buffer.begin(), B.row_buffer.end() - 1);
+
+      for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
+        for (vcl_size_t i = 0; i < C; ++i)
+        {
+          vcl_size_t row = (A.sigma() > 1) ? row_indices[block_idx * C + i] : block_idx * C + i;
+          if (row >= A.size1())
+            continue;
+
+          for (vcl_size_t j = 0; j < columns_per_block[block_idx]; ++j)
+          {
+            vcl_size_t offset = block_start[block_idx] + j * C + i;
+            NumericT val = elements[offset];
+            if (!(val < 0 || val > 0))
+              continue;
+
+            if (pass == 0)
+              ++B.row_buffer[row + 1];
+            else
+            {
+              unsigned int index = next_entry[row]++;
+              B.col_buffer[index] = column_indices[offset];
+              B.elements[index]   = val;
+            }
+          }
+        }
+    }
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  void extract_host_csr(viennacl::hyb_matrix<NumericT, AlignmentV> const & A, host_csr_matrix<NumericT> & B)
+  {
+    std::vector<unsigned int> ell_coords, csr_rows, csr_cols;
+    std::vector<NumericT> ell_elements, csr_elements;
+    read_index_buffer(A.handle2(), A.internal_size1() * A.internal_ellnnz(), ell_coords);
+    read_value_buffer(A.handle(),  A.internal_size1() * A.internal_ellnnz(), ell_elements);
+    read_index_buffer(A.handle3(), A.size1() + 1, csr_rows);
+    read_index_buffer(A.handle4(), A.csr_nnz(),   csr_cols);
+    read_value_buffer(A.handle5(), A.csr_nnz(),   csr_elements);
+
+    B.rows = A.size1();
+    B.cols = A.size2();
+    B.row_buffer.assign(A.size1() + 1, 0);
+    for (vcl_size_t i = 0; i < A.size1(); ++i)
+    {
+      for (vcl_size_t k = 0; k < A.ell_nnz(); ++k)
+        if (ell_elements[k * A.internal_size1() + i] < 0 || ell_elements[k * A.internal_size1() + i] > 0)
+          ++B.row_buffer[i + 1];
+      B.row_buffer[i + 1] += csr_rows[i + 1] - csr_rows[i];
+    }
+    B.finalize_row_buffer();
+
+    // the first entries of each row are in the ELL part, the remaining ones in the CSR part:
+    for (vcl_size_t i = 0; i < A.size1(); ++i)
+    {
+      unsigned int index = B.row_buffer[i];
+      for (vcl_size_t k = 0; k < A.ell_nnz(); ++k)
+      {
+        NumericT val = ell_elements[k * A.internal_size1() + i];
+        if (val < 0 || val > 0)
+        {
+          B.col_buffer[index] = ell_coords[k * A.internal_size1() + i];
+          B.elements[index]   = val;
+          ++index;
+        }
+      }
+      for (vcl_size_t k = csr_rows[i]; k < csr_rows[i + 1]; ++k, ++index)
+      {
+        B.col_buffer[index] = csr_cols[k];
+        B.elements[index]   = csr_elements[k];
+      }
+    }
+  }
+
+  template<typename NumericT, typename TargetT>
+  void copy_host_csr(host_csr_matrix<NumericT> const & A, TargetT & target)
+  {
+    if (A.rows == 0 || A.cols == 0)
+      return;
+
+    // avoid taking the address of the first entry of an empty array:
+    NumericT     dummy_value = 0;
+    unsigned int dummy_index = 0;
+    viennacl::tools::const_csr_matrix_adapter<NumericT> adapter(&(A.row_buffer[0]),
+                                                                A.col_buffer.size() > 0 ? &(A.col_buffer[0]) : &dummy_index,
+                                                                A.elements.size()   > 0 ? &(A.elements[0])   : &dummy_value,
+                                                                A.rows, A.cols);
+    viennacl::copy(adapter, target);
+  }
+}
+
+/** @brief Converts a compressed_matrix to any other sparse matrix type. The memory domain of the target is retained.
+*
+* If the source matrix resides in main memory, its arrays are passed to the target directly. Otherwise, only the three CSR arrays are transferred to the host.
+*
+* @param source   The sparse matrix to be converted
+* @param target   The sparse matrix to be set up. If it is to reside in a memory domain other than the default, construct it with the respective context.
+*/
+template<typename NumericT, unsigned int AlignmentV, typename TargetT>
+void convert_sparse_matrix(viennacl::compressed_matrix<NumericT, AlignmentV> const & source, TargetT & target)
+{
+  if (source.size1() == 0 || source.size2() == 0)
+    return;
+
+  if (viennacl::traits::context(source).memory_type() == viennacl::MAIN_MEMORY && source.nnz() > 0)
+  {
+    viennacl::tools::const_csr_matrix_adapter<NumericT> adapter(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(source.handle1()),
+                                                                viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(source.handle2()),
+                                                                viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(source.handle()),
+                                                                source.size1(), source.size2());
+    viennacl::copy(adapter, target);
+  }
+  else
+  {
+    detail::host_csr_matrix<NumericT> temp;
+    detail::extract_host_csr(source, temp);
+    detail::copy_host_csr(temp, target);
+  }
+}
+
+/** @brief Converts any sparse matrix type other than compressed_matrix to any sparse matrix type, using compressed row storage on the host as intermediate format.
+*
+* Explicitly stored zeros in ELL-type formats cannot be distinguished from padding and are dropped.
+*
+* @param source   The sparse matrix to be converted
+* @param target   The sparse matrix to be set up. If it is to reside in a memory domain other than the default, construct it with the respective context.
+*/
+template<typename SourceT, typename TargetT>
+void convert_sparse_matrix(SourceT const & source, TargetT & target)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename SourceT::value_type>::type   NumericType;
+
+  detail::host_csr_matrix<NumericType> temp;
+  detail::extract_host_csr(source, temp);
+  detail::copy_host_csr(temp, target);
+}
+
+
+namespace detail
+{
+  /** @brief Cache of the formats determined by benchmark_sparse_format(), indexed by the memory domain, the size and the row statistics of the matrix. */
+  inline std::map<std::vector<vcl_size_t>, sparse_format> & sparse_format_cache()
+  {
+    static std::map<std::vector<vcl_size_t>, sparse_format> cache;
+    return cache;
+  }
+
+  /** @brief Returns the average execution time of a matrix-vector product. */
+  template<typename SparseMatrixT, typename NumericT>
+  double time_sparse_matrix_vector_product(SparseMatrixT const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> & y, vcl_size_t num_runs)
+  {
+    y = viennacl::linalg::prod(A, x); // warmup, includes kernel compilation
+    viennacl::backend::finish();
+
+    viennacl::tools::timer timer;
+    timer.start();
+    for (vcl_size_t i = 0; i < num_runs; ++i)
+      y = viennacl::linalg::prod(A, x);
+    viennacl::backend::finish();
+    return timer.get() / static_cast<double>(num_runs);
+  }
+}
+
+/** @brief Determines the sparse matrix format with the fastest matrix-vector products for A by timing all candidates in the memory domain of A.
+*
+* The decision is cached based on the memory domain, the size and the row statistics of A, so that matrices with the same characteristics are timed only once.
+* The cache is not thread-safe.
+*
+* @param A          The matrix
+* @param num_runs   Number of matrix-vector products timed for each candidate
+*/
+template<typename NumericT, unsigned int AlignmentV>
+sparse_format benchmark_sparse_format(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t num_runs = 10)
+{
+  viennacl::context ctx = viennacl::traits::context(A);
+  sparse_row_statistics stats = row_statistics(A);
+
+  std::vector<vcl_size_t> key;
+  key.push_back(static_cast<vcl_size_t>(ctx.memory_type()));
+  key.push_back(stats.rows);
+  key.push_back(stats.cols);
+  key.push_back(stats.nnz);
+  key.push_back(stats.max);
+  key.insert(key.end(), stats.histogram.begin(), stats.histogram.end());
+
+  std::map<std::vector<vcl_size_t>, sparse_format>::const_iterator it = detail::sparse_format_cache().find(key);
+  if (it != detail::sparse_format_cache().end())
+    return it->second;
+
+  sparse_format best_format = SPARSE_FORMAT_COMPRESSED;
+  if (stats.nnz > 0)
+  {
+    viennacl::vector<NumericT> x = viennacl::scalar_vector<NumericT>(A.size2(), NumericT(1), ctx);
+    viennacl::vector<NumericT> y(A.size1(), ctx);
+
+    double best_time = detail::time_sparse_matrix_vector_product(A, x, y, num_runs);
+
+    {
+      viennacl::coordinate_matrix<NumericT> B(ctx);
+      convert_sparse_matrix(A, B);
+      double t = detail::time_sparse_matrix_vector_product(B, x, y, num_runs);
+      if (t < best_time) { best_time = t; best_format = SPARSE_FORMAT_COORDINATE; }
+    }
+
+    {
+      viennacl::ell_matrix<NumericT> B(ctx);
+      convert_sparse_matrix(A, B);
+      double t = detail::time_sparse_matrix_vector_product(B, x, y, num_runs);
+      if (t < best_time) { best_time = t; best_format = SPARSE_FORMAT_ELL; }
+    }
+
+    {
+      viennacl::sliced_ell_matrix<NumericT> B(ctx);
+      convert_sparse_matrix(A, B);
+      double t = detail::time_sparse_matrix_vector_product(B, x, y, num_runs);
+      if (t < best_time) { best_time = t; best_format = SPARSE_FORMAT_SLICED_ELL; }
+    }
+
+    {
+      viennacl::hyb_matrix<NumericT> B(ctx);
+      convert_sparse_matrix(A, B);
+      double t = detail::time_sparse_matrix_vector_product(B, x, y, num_runs);
+      if (t < best_time) { best_time = t; best_format = SPARSE_FORMAT_HYB; }
+    }
+  }
+
+  detail::sparse_format_cache()[key] = best_format;
+  return best_format;
+}
+
+/** @brief Clears the cache of the formats determined by benchmark_sparse_format() */
+inline void clear_sparse_format_cache() { detail::sparse_format_cache().clear(); }
+
+} //namespace tools
+} //namespace viennacl
+
+
+#endif
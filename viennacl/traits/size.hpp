@@ -155,6 +155,14 @@ size(vector_expression<const SparseMatrixType, const VectorType, op_prod> const
   return proxy.lhs().size1();
 }
 
+template<typename SparseMatrixType, typename VectorType>
+typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value,
+vcl_size_t >::type
+size(vector_expression<const matrix_expression<const SparseMatrixType, const SparseMatrixType, op_trans>, const VectorType, op_prod> const & proxy)
+{
+  return proxy.lhs().lhs().size2();
+}
+
 template<typename T, unsigned int A, typename VectorType>
 vcl_size_t size(vector_expression<const circulant_matrix<T, A>, const VectorType, op_prod> const & proxy) { return proxy.lhs().size1();  }
 